@@ -0,0 +1,100 @@
+//
+//  Arena.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "Arena.h"
+
+#include <cstring>
+#include <new>
+
+namespace flx {
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}
+
+Arena::Arena(size_t blockSize)
+    : blockSize_(blockSize), current_(0), offset_(0), inUse_(0) {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+Arena::~Arena() {
+    for (size_t i = 0; i < blocks_.size(); i++) {
+        ::operator delete(blocks_[i].data);
+    }
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    if (current_ < blocks_.size()) {
+        Block& block = blocks_[current_];
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+        size_t start = alignUp(base + offset_, alignment) - base;
+        if (start + size <= block.size) {
+            offset_ = start + size;
+            inUse_ += size;
+            stats_.allocations++;
+            stats_.bytesAllocated += size;
+            if (inUse_ > stats_.peakBytes) {
+                stats_.peakBytes = inUse_;
+            }
+            return block.data + start;
+        }
+    }
+    return allocateSlow(size, alignment);
+}
+
+// Move on to the next held block big enough for size, or add one
+void* Arena::allocateSlow(size_t size, size_t alignment) {
+    size_t needed = size + alignment;
+    size_t next = current_ < blocks_.size() ? current_ + 1 : blocks_.size();
+    while (next < blocks_.size() && blocks_[next].size < needed) {
+        next++;
+    }
+    if (next == blocks_.size()) {
+        Block block;
+        block.size = needed > blockSize_ ? needed : blockSize_;
+        block.data = static_cast<uint8_t*>(::operator new(block.size));
+        blocks_.push_back(block);
+        stats_.blocks = blocks_.size();
+        stats_.blockBytes += block.size;
+    }
+    current_ = next;
+    offset_ = 0;
+    return allocate(size, alignment);
+}
+
+bool Arena::reset() {
+    if (stats_.live > 0) {
+        stats_.deferredResets++;
+        return false;
+    }
+    current_ = 0;
+    offset_ = 0;
+    inUse_ = 0;
+    stats_.resets++;
+    return true;
+}
+
+void Arena::trim() {
+    if (inUse_ > 0 || blocks_.size() <= 1) {
+        return;
+    }
+    for (size_t i = 1; i < blocks_.size(); i++) {
+        stats_.blockBytes -= blocks_[i].size;
+        ::operator delete(blocks_[i].data);
+    }
+    blocks_.resize(1);
+    stats_.blocks = 1;
+    current_ = 0;
+    offset_ = 0;
+}
+
+}
@@ -0,0 +1,111 @@
+//
+//  Arena.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_Arena_h
+#define TracVentory_Arena_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace flx {
+
+struct ArenaStats {
+    uint64_t allocations;       // since the arena was created
+    uint64_t bytesAllocated;
+    uint64_t resets;
+    uint64_t deferredResets;    // reset() calls refused because objects were live
+    size_t live;                // objects created and not yet destroyed
+    size_t blocks;              // blocks currently held
+    size_t blockBytes;
+    size_t peakBytes;           // most bytes in use between two resets
+};
+
+// Arena hands out memory from large blocks by bumping a pointer and takes
+// it all back at once in reset(), keeping the blocks for the next burst.
+// Objects made with create() are counted until destroy(), so a reset while
+// any are still alive is refused (and counted) rather than corrupting them.
+// Not thread safe.
+class Arena {
+public:
+    explicit Arena(size_t blockSize = 16 * 1024);
+    ~Arena();
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        stats_.live++;
+        return object;
+    }
+
+    template <typename T>
+    void destroy(T* object) {
+        if (object) {
+            object->~T();
+            stats_.live--;
+        }
+    }
+
+    // Rewind to empty. Returns false, changing nothing, while objects from
+    // create() are alive.
+    bool reset();
+    // Return all blocks beyond the first to the heap (after a reset).
+    void trim();
+
+    size_t bytesInUse() const { return inUse_; }
+    const ArenaStats& stats() const { return stats_; }
+
+private:
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+
+    struct Block {
+        uint8_t* data;
+        size_t size;
+    };
+
+    void* allocateSlow(size_t size, size_t alignment);
+
+    std::vector<Block> blocks_;
+    size_t blockSize_;
+    size_t current_;            // block being bumped
+    size_t offset_;             // into the current block
+    size_t inUse_;
+    ArenaStats stats_;
+};
+
+// unique_ptr support, so arena objects release themselves like heap ones
+template <typename T>
+struct ArenaDeleter {
+    Arena* arena;
+
+    ArenaDeleter() : arena(NULL) {}
+    explicit ArenaDeleter(Arena* owner) : arena(owner) {}
+
+    void operator()(T* object) const {
+        if (arena) {
+            arena->destroy(object);
+        }
+    }
+};
+
+template <typename T>
+using ArenaPtr = std::unique_ptr<T, ArenaDeleter<T> >;
+
+template <typename T, typename... Args>
+ArenaPtr<T> makeArenaPtr(Arena& arena, Args&&... args) {
+    return ArenaPtr<T>(arena.create<T>(std::forward<Args>(args)...), ArenaDeleter<T>(&arena));
+}
+
+}
+
+#endif
@@ -0,0 +1,580 @@
+//
+//  BarcodeDecoder.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "BarcodeDecoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace flx {
+
+namespace {
+
+// Darkest to lightest pixel of a scanline below this is not a barcode
+const unsigned kMinContrast = 32;
+// A run may be this far from its pattern width on average, in tenths of a
+// module
+const unsigned kMaxRunError = 4;
+// Quiet zone before a barcode, in modules; the standards ask for 7 to 10,
+// but a tight region of interest may crop it
+const unsigned kMinQuietModules = 3;
+const size_t kMaxCode128Symbols = 48;
+
+// EAN digits as space, bar, space, bar widths: the L (odd parity) code.
+// The G code is each reversed, and the R code (right half, starting with a
+// bar) has the L widths.
+const uint8_t kEanDigits[20][4] = {
+    { 3, 2, 1, 1 }, { 2, 2, 2, 1 }, { 2, 1, 2, 2 }, { 1, 4, 1, 1 }, { 1, 1, 3, 2 },
+    { 1, 2, 3, 1 }, { 1, 1, 1, 4 }, { 1, 3, 1, 2 }, { 1, 2, 1, 3 }, { 3, 1, 1, 2 },
+    { 1, 1, 2, 3 }, { 1, 2, 2, 2 }, { 2, 2, 1, 2 }, { 1, 1, 4, 1 }, { 2, 3, 1, 1 },
+    { 1, 3, 2, 1 }, { 4, 1, 1, 1 }, { 2, 1, 3, 1 }, { 3, 1, 2, 1 }, { 2, 1, 1, 3 }
+};
+
+// Which of the six left digits of an EAN-13 use the G code (bit 5 is the
+// first), for each implied first digit
+const uint8_t kEanFirstDigitParity[10] = { 0x00, 0x0B, 0x0D, 0x0E, 0x13, 0x19, 0x1C, 0x15, 0x16, 0x1A };
+
+// Code 128 symbols as bar, space, bar, space, bar, space widths; 103-105 are
+// the start codes and 106 the stop pattern less its final two-module bar
+const uint8_t kCode128Symbols[107][6] = {
+    { 2, 1, 2, 2, 2, 2 }, { 2, 2, 2, 1, 2, 2 }, { 2, 2, 2, 2, 2, 1 }, { 1, 2, 1, 2, 2, 3 },
+    { 1, 2, 1, 3, 2, 2 }, { 1, 3, 1, 2, 2, 2 }, { 1, 2, 2, 2, 1, 3 }, { 1, 2, 2, 3, 1, 2 },
+    { 1, 3, 2, 2, 1, 2 }, { 2, 2, 1, 2, 1, 3 }, { 2, 2, 1, 3, 1, 2 }, { 2, 3, 1, 2, 1, 2 },
+    { 1, 1, 2, 2, 3, 2 }, { 1, 2, 2, 1, 3, 2 }, { 1, 2, 2, 2, 3, 1 }, { 1, 1, 3, 2, 2, 2 },
+    { 1, 2, 3, 1, 2, 2 }, { 1, 2, 3, 2, 2, 1 }, { 2, 2, 3, 2, 1, 1 }, { 2, 2, 1, 1, 3, 2 },
+    { 2, 2, 1, 2, 3, 1 }, { 2, 1, 3, 2, 1, 2 }, { 2, 2, 3, 1, 1, 2 }, { 3, 1, 2, 1, 3, 1 },
+    { 3, 1, 1, 2, 2, 2 }, { 3, 2, 1, 1, 2, 2 }, { 3, 2, 1, 2, 2, 1 }, { 3, 1, 2, 2, 1, 2 },
+    { 3, 2, 2, 1, 1, 2 }, { 3, 2, 2, 2, 1, 1 }, { 2, 1, 2, 1, 2, 3 }, { 2, 1, 2, 3, 2, 1 },
+    { 2, 3, 2, 1, 2, 1 }, { 1, 1, 1, 3, 2, 3 }, { 1, 3, 1, 1, 2, 3 }, { 1, 3, 1, 3, 2, 1 },
+    { 1, 1, 2, 3, 1, 3 }, { 1, 3, 2, 1, 1, 3 }, { 1, 3, 2, 3, 1, 1 }, { 2, 1, 1, 3, 1, 3 },
+    { 2, 3, 1, 1, 1, 3 }, { 2, 3, 1, 3, 1, 1 }, { 1, 1, 2, 1, 3, 3 }, { 1, 1, 2, 3, 3, 1 },
+    { 1, 3, 2, 1, 3, 1 }, { 1, 1, 3, 1, 2, 3 }, { 1, 1, 3, 3, 2, 1 }, { 1, 3, 3, 1, 2, 1 },
+    { 3, 1, 3, 1, 2, 1 }, { 2, 1, 1, 3, 3, 1 }, { 2, 3, 1, 1, 3, 1 }, { 2, 1, 3, 1, 1, 3 },
+    { 2, 1, 3, 3, 1, 1 }, { 2, 1, 3, 1, 3, 1 }, { 3, 1, 1, 1, 2, 3 }, { 3, 1, 1, 3, 2, 1 },
+    { 3, 3, 1, 1, 2, 1 }, { 3, 1, 2, 1, 1, 3 }, { 3, 1, 2, 3, 1, 1 }, { 3, 3, 2, 1, 1, 1 },
+    { 3, 1, 4, 1, 1, 1 }, { 2, 2, 1, 4, 1, 1 }, { 4, 3, 1, 1, 1, 1 }, { 1, 1, 1, 2, 2, 4 },
+    { 1, 1, 1, 4, 2, 2 }, { 1, 2, 1, 1, 2, 4 }, { 1, 2, 1, 4, 2, 1 }, { 1, 4, 1, 1, 2, 2 },
+    { 1, 4, 1, 2, 2, 1 }, { 1, 1, 2, 2, 1, 4 }, { 1, 1, 2, 4, 1, 2 }, { 1, 2, 2, 1, 1, 4 },
+    { 1, 2, 2, 4, 1, 1 }, { 1, 4, 2, 1, 1, 2 }, { 1, 4, 2, 2, 1, 1 }, { 2, 4, 1, 2, 1, 1 },
+    { 2, 2, 1, 1, 1, 4 }, { 4, 1, 3, 1, 1, 1 }, { 2, 4, 1, 1, 1, 2 }, { 1, 3, 4, 1, 1, 1 },
+    { 1, 1, 1, 2, 4, 2 }, { 1, 2, 1, 1, 4, 2 }, { 1, 2, 1, 2, 4, 1 }, { 1, 1, 4, 2, 1, 2 },
+    { 1, 2, 4, 1, 1, 2 }, { 1, 2, 4, 2, 1, 1 }, { 4, 1, 1, 2, 1, 2 }, { 4, 2, 1, 1, 1, 2 },
+    { 4, 2, 1, 2, 1, 1 }, { 2, 1, 2, 1, 4, 1 }, { 2, 1, 4, 1, 2, 1 }, { 4, 1, 2, 1, 2, 1 },
+    { 1, 1, 1, 1, 4, 3 }, { 1, 1, 1, 3, 4, 1 }, { 1, 3, 1, 1, 4, 1 }, { 1, 1, 4, 1, 1, 3 },
+    { 1, 1, 4, 3, 1, 1 }, { 4, 1, 1, 1, 1, 3 }, { 4, 1, 1, 3, 1, 1 }, { 1, 1, 3, 1, 4, 1 },
+    { 1, 1, 4, 1, 3, 1 }, { 3, 1, 1, 1, 4, 1 }, { 4, 1, 1, 1, 3, 1 }, { 2, 1, 1, 4, 1, 2 },
+    { 2, 1, 1, 2, 1, 4 }, { 2, 1, 1, 2, 3, 2 }, { 2, 3, 3, 1, 1, 1 }
+};
+
+const unsigned kCode128StartA = 103;
+const unsigned kCode128Stop = 106;
+
+enum Code128Set { kSetA, kSetB, kSetC };
+
+unsigned sumRuns(const uint16_t* runs, size_t count) {
+    unsigned total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += runs[i];
+    }
+    return total;
+}
+
+// Whether runs, spanning modules in all, fit pattern: the distance of each
+// run from its width (scaled by total / modules so integers do) averages
+// under kMaxRunError tenths of a module. Returns that distance, or UINT_MAX.
+unsigned patternError(const uint16_t* runs, const uint8_t* pattern, unsigned count, unsigned modules, unsigned total) {
+    unsigned error = 0;
+    for (unsigned i = 0; i < count; i++) {
+        int difference = static_cast<int>(runs[i] * modules) - static_cast<int>(pattern[i] * total);
+        error += static_cast<unsigned>(difference < 0 ? -difference : difference);
+    }
+    return error * 10 <= kMaxRunError * count * total ? error : ~0U;
+}
+
+// The closest of patterns to runs, or -1 if none is close enough
+int matchPattern(const uint16_t* runs, const uint8_t (*patterns)[4], unsigned patternCount) {
+    unsigned total = sumRuns(runs, 4);
+    unsigned best = ~0U;
+    int match = -1;
+    for (unsigned i = 0; i < patternCount; i++) {
+        unsigned error = patternError(runs, patterns[i], 4, 7, total);
+        if (error < best) {
+            best = error;
+            match = static_cast<int>(i);
+        }
+    }
+    return match;
+}
+
+int matchCode128(const uint16_t* runs) {
+    unsigned total = sumRuns(runs, 6);
+    unsigned best = ~0U;
+    int match = -1;
+    for (unsigned i = 0; i <= kCode128Stop; i++) {
+        unsigned error = patternError(runs, kCode128Symbols[i], 6, 11, total);
+        if (error < best) {
+            best = error;
+            match = static_cast<int>(i);
+        }
+    }
+    return match;
+}
+
+// A run of about one module, as guard bars are; blur thickens or thins them
+bool isGuardRun(uint16_t run, unsigned modules, unsigned total) {
+    return run * modules * 5 >= total * 2 && run * modules * 5 <= total * 9;
+}
+
+bool hasQuietZone(const std::vector<uint16_t>& runs, size_t start, unsigned modules, unsigned total) {
+    return start > 0 && runs[start - 1] * modules >= kMinQuietModules * total;
+}
+
+void appendWidths(const uint8_t* widths, size_t count, bool bar, std::vector<uint8_t>& modules) {
+    for (size_t i = 0; i < count; i++, bar = !bar) {
+        modules.insert(modules.end(), widths[i], bar ? 1 : 0);
+    }
+}
+
+// Check digit of digits (without one), weights 3 and 1 alternating back from
+// the last digit
+unsigned eanCheckDigit(const char* digits, size_t count) {
+    unsigned sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += static_cast<unsigned>(digits[i] - '0') * ((count - i) % 2 ? 3 : 1);
+    }
+    return (10 - sum % 10) % 10;
+}
+
+}
+
+bool encodeBarcode(BarcodeFormat format, const std::string& text, std::vector<uint8_t>& modules) {
+    static const uint8_t guard[3] = { 1, 1, 1 };
+    static const uint8_t middle[5] = { 1, 1, 1, 1, 1 };
+    modules.clear();
+    if (format == kBarcodeEan13 || format == kBarcodeUpcA || format == kBarcodeEan8) {
+        std::string digits = format == kBarcodeUpcA ? "0" + text : text;
+        size_t length = format == kBarcodeEan8 ? 8 : 13;
+        if (digits.size() != length && digits.size() != length - 1) {
+            return false;
+        }
+        for (size_t i = 0; i < digits.size(); i++) {
+            if (digits[i] < '0' || digits[i] > '9') {
+                return false;
+            }
+        }
+        char check = static_cast<char>('0' + eanCheckDigit(digits.data(), length - 1));
+        if (digits.size() == length - 1) {
+            digits += check;
+        }
+        else if (digits[length - 1] != check) {
+            return false;
+        }
+        // EAN-13 carries its first digit in the parity of the left half
+        size_t first = length == 13 ? 1 : 0;
+        size_t half = (length - first) / 2;
+        unsigned parity = length == 13 ? kEanFirstDigitParity[digits[0] - '0'] : 0;
+        appendWidths(guard, 3, true, modules);
+        for (size_t i = 0; i < half; i++) {
+            bool g = (parity >> (half - 1 - i)) & 1;
+            appendWidths(kEanDigits[digits[first + i] - '0' + (g ? 10 : 0)], 4, false, modules);
+        }
+        appendWidths(middle, 5, false, modules);
+        for (size_t i = 0; i < half; i++) {
+            appendWidths(kEanDigits[digits[first + half + i] - '0'], 4, true, modules);
+        }
+        appendWidths(guard, 3, true, modules);
+        return true;
+    }
+    if (format != kBarcodeCode128 || text.empty() || text.size() > kMaxCode128Symbols - 2) {
+        return false;
+    }
+
+    bool numeric = text.size() % 2 == 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] < 32 || text[i] > 126) {
+            return false;
+        }
+        numeric = numeric && text[i] >= '0' && text[i] <= '9';
+    }
+    std::vector<unsigned> symbols(1, numeric ? kCode128StartA + kSetC : kCode128StartA + kSetB);
+    for (size_t i = 0; i < text.size(); i += numeric ? 2 : 1) {
+        symbols.push_back(numeric ? static_cast<unsigned>((text[i] - '0') * 10 + text[i + 1] - '0') :
+                                    static_cast<unsigned>(text[i] - 32));
+    }
+    unsigned checksum = symbols[0];
+    for (size_t i = 1; i < symbols.size(); i++) {
+        checksum += symbols[i] * static_cast<unsigned>(i);
+    }
+    symbols.push_back(checksum % 103);
+    symbols.push_back(kCode128Stop);
+    for (size_t i = 0; i < symbols.size(); i++) {
+        appendWidths(kCode128Symbols[symbols[i]], 6, true, modules);
+    }
+    modules.insert(modules.end(), 2, 1);
+    return true;
+}
+
+LumaFrame::LumaFrame() : width_(0), height_(0) {
+}
+
+bool LumaFrame::prepare(size_t width, size_t height, const FrameRegion& region, unsigned xFactor, unsigned yFactor,
+                        FrameRegion& clipped) {
+    clipped.x = std::min(region.x, width);
+    clipped.y = std::min(region.y, height);
+    clipped.width = std::min(region.width, width - clipped.x);
+    clipped.height = std::min(region.height, height - clipped.y);
+    bool valid = xFactor > 0 && yFactor > 0 && yFactor <= 256;
+    width_ = valid ? clipped.width / xFactor : 0;
+    height_ = valid ? clipped.height / yFactor : 0;
+    pixels_.resize(width_ * height_);
+    sums_.resize(width_ * xFactor);
+    return width_ > 0 && height_ > 0;
+}
+
+void LumaFrame::store(uint8_t* out, unsigned xFactor, unsigned yFactor) {
+    // Divide by multiplying with a 16-bit fixed point reciprocal. Locals
+    // only: out could alias the members, which would stop vectorization.
+    unsigned count = xFactor * yFactor;
+    unsigned reciprocal = (65536 + count / 2) / count;
+    const uint16_t* __restrict sums = &sums_[0];
+    size_t width = width_;
+    if (xFactor == 1) {
+        for (size_t x = 0; x < width; x++) {
+            out[x] = static_cast<uint8_t>((sums[x] * reciprocal + 32768) >> 16);
+        }
+        return;
+    }
+    if (xFactor == 2) {
+        for (size_t x = 0; x < width; x++) {
+            out[x] = static_cast<uint8_t>(((sums[x * 2] + sums[x * 2 + 1]) * reciprocal + 32768) >> 16);
+        }
+        return;
+    }
+    for (size_t x = 0; x < width; x++) {
+        unsigned sum = 0;
+        for (unsigned i = 0; i < xFactor; i++) {
+            sum += sums[x * xFactor + i];
+        }
+        out[x] = static_cast<uint8_t>(std::min((sum * reciprocal + 32768) >> 16, 255u));
+    }
+}
+
+void LumaFrame::fromLuma(const uint8_t* plane, size_t width, size_t height, size_t bytesPerRow,
+                         const FrameRegion& region, unsigned xFactor, unsigned yFactor) {
+    FrameRegion clipped;
+    if (!prepare(width, height, region, xFactor, yFactor, clipped)) {
+        return;
+    }
+    size_t span = width_ * xFactor;
+    for (size_t y = 0; y < height_; y++) {
+        const uint8_t* in = plane + (clipped.y + y * yFactor) * bytesPerRow + clipped.x;
+        if (xFactor == 1 && yFactor == 1) {
+            memcpy(&pixels_[y * width_], in, width_);
+            continue;
+        }
+        // Kept simple, with restrict locals, so the compiler vectorizes it
+        uint16_t* __restrict sums = &sums_[0];
+        const uint8_t* __restrict first = in;
+        for (size_t x = 0; x < span; x++) {
+            sums[x] = first[x];
+        }
+        for (unsigned i = 1; i < yFactor; i++) {
+            const uint8_t* __restrict next = in + i * bytesPerRow;
+            for (size_t x = 0; x < span; x++) {
+                sums[x] = static_cast<uint16_t>(sums[x] + next[x]);
+            }
+        }
+        store(&pixels_[y * width_], xFactor, yFactor);
+    }
+}
+
+void LumaFrame::fromBgra(const uint8_t* pixels, size_t width, size_t height, size_t bytesPerRow,
+                         const FrameRegion& region, unsigned xFactor, unsigned yFactor) {
+    FrameRegion clipped;
+    if (!prepare(width, height, region, xFactor, yFactor, clipped)) {
+        return;
+    }
+    size_t span = width_ * xFactor;
+    for (size_t y = 0; y < height_; y++) {
+        const uint8_t* in = pixels + (clipped.y + y * yFactor) * bytesPerRow + clipped.x * 4;
+        std::fill(sums_.begin(), sums_.end(), 0);
+        uint16_t* sums = &sums_[0];
+        for (unsigned i = 0; i < yFactor; i++, in += bytesPerRow) {
+            // BT.601 luma in 8-bit fixed point
+            for (size_t x = 0; x < span; x++) {
+                unsigned luma = (29 * in[x * 4] + 150 * in[x * 4 + 1] + 77 * in[x * 4 + 2] + 128) >> 8;
+                sums[x] = static_cast<uint16_t>(sums[x] + luma);
+            }
+        }
+        store(&pixels_[y * width_], xFactor, yFactor);
+    }
+}
+
+BarcodeDecoder::BarcodeDecoder(unsigned scanlines, unsigned agreement)
+    : scanlines_(scanlines ? scanlines : 1), agreement_(agreement ? agreement : 1) {
+}
+
+bool BarcodeDecoder::decode(const LumaFrame& frame, Barcode& barcode) {
+    candidates_.clear();
+    size_t height = frame.height();
+    if (height == 0) {
+        return false;
+    }
+    size_t lines = std::min<size_t>(scanlines_, height);
+    size_t step = std::max<size_t>(height / (lines + 1), 1);
+    for (size_t i = 0; i < lines; i++) {
+        // Middle first, then alternately above and below it
+        size_t distance = (i + 1) / 2 * step;
+        if (distance > height / 2 || (i % 2 == 0 && height / 2 + distance >= height)) {
+            break;
+        }
+        size_t y = i % 2 ? height / 2 - distance : height / 2 + distance;
+        Barcode read;
+        if (!decodeRow(frame.row(y), frame.width(), read)) {
+            continue;
+        }
+        bool known = false;
+        for (size_t c = 0; c < candidates_.size(); c++) {
+            Barcode& candidate = candidates_[c];
+            if (candidate.format == read.format && candidate.text == read.text) {
+                known = true;
+                if (++candidate.rows >= agreement_) {
+                    barcode = candidate;
+                    return true;
+                }
+            }
+        }
+        if (!known) {
+            read.rows = 1;
+            if (agreement_ == 1) {
+                barcode = read;
+                return true;
+            }
+            candidates_.push_back(read);
+        }
+    }
+    return false;
+}
+
+bool BarcodeDecoder::decodeRow(const uint8_t* row, size_t width, Barcode& barcode) {
+    if (width < 3) {
+        return false;
+    }
+    uint8_t darkest = 255;
+    uint8_t lightest = 0;
+    for (size_t x = 0; x < width; x++) {
+        darkest = std::min(darkest, row[x]);
+        lightest = std::max(lightest, row[x]);
+    }
+    if (static_cast<unsigned>(lightest - darkest) < kMinContrast) {
+        return false;
+    }
+
+    // Threshold a [1 2 1] smoothing of the row, without branches so it
+    // vectorizes; dark_ is 1 on bars
+    unsigned threshold = (static_cast<unsigned>(darkest) + lightest) * 2;
+    dark_.resize(width);
+    uint8_t* __restrict dark = &dark_[0];
+    dark[0] = row[0] * 4u < threshold;
+    dark[width - 1] = row[width - 1] * 4u < threshold;
+    for (size_t x = 1; x + 1 < width; x++) {
+        dark[x] = static_cast<uint8_t>(row[x - 1] + 2u * row[x] + row[x + 1] < threshold);
+    }
+
+    runs_.clear();
+    uint16_t run = 1;
+    for (size_t x = 1; x < width; x++) {
+        if (dark[x] == dark[x - 1] && run < UINT16_MAX) {
+            run++;
+        }
+        else {
+            runs_.push_back(run);
+            run = 1;
+        }
+    }
+    runs_.push_back(run);
+
+    bool firstIsBar = dark[0] != 0;
+    if (decodeRuns(firstIsBar, barcode)) {
+        return true;
+    }
+    // Read right to left, for a barcode upside down
+    std::reverse(runs_.begin(), runs_.end());
+    bool lastIsBar = runs_.size() % 2 ? firstIsBar : !firstIsBar;
+    return decodeRuns(lastIsBar, barcode);
+}
+
+bool BarcodeDecoder::decodeRuns(bool firstIsBar, Barcode& barcode) {
+    for (size_t start = firstIsBar ? 2 : 1; start < runs_.size(); start += 2) {
+        if (decodeEan(start, 13, barcode) || decodeEan(start, 8, barcode) || decodeCode128(start, barcode)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BarcodeDecoder::decodeEan(size_t start, size_t digits, Barcode& barcode) const {
+    // Guard, half the digits, middle guard, the other half, guard
+    size_t half = digits / 2;
+    size_t runCount = 3 + half * 4 + 5 + half * 4 + 3;
+    if (start + runCount > runs_.size()) {
+        return false;
+    }
+    const uint16_t* runs = &runs_[start];
+    unsigned modules = static_cast<unsigned>(3 + half * 7 + 5 + half * 7 + 3);
+    unsigned total = sumRuns(runs, runCount);
+    if (!hasQuietZone(runs_, start, modules, total)) {
+        return false;
+    }
+    for (size_t i = 0; i < 3; i++) {
+        if (!isGuardRun(runs[i], modules, total) || !isGuardRun(runs[runCount - 1 - i], modules, total)) {
+            return false;
+        }
+    }
+    size_t middle = 3 + half * 4;
+    for (size_t i = 0; i < 5; i++) {
+        if (!isGuardRun(runs[middle + i], modules, total)) {
+            return false;
+        }
+    }
+
+    char text[13] = { 0 };
+    size_t first = digits == 13 ? 1 : 0;
+    unsigned parity = 0;
+    for (size_t i = 0; i < half; i++) {
+        int match = matchPattern(runs + 3 + i * 4, kEanDigits, 20);
+        if (match < 0) {
+            return false;
+        }
+        parity = parity << 1 | (match >= 10);
+        text[first + i] = static_cast<char>('0' + match % 10);
+    }
+    for (size_t i = 0; i < half; i++) {
+        int match = matchPattern(runs + middle + 5 + i * 4, kEanDigits, 10);
+        if (match < 0) {
+            return false;
+        }
+        text[first + half + i] = static_cast<char>('0' + match);
+    }
+    if (digits == 13) {
+        const uint8_t* found = std::find(kEanFirstDigitParity, kEanFirstDigitParity + 10, parity);
+        if (found == kEanFirstDigitParity + 10) {
+            return false;
+        }
+        text[0] = static_cast<char>('0' + (found - kEanFirstDigitParity));
+    }
+    else if (parity != 0) {
+        return false;
+    }
+
+    if (eanCheckDigit(text, digits - 1) != static_cast<unsigned>(text[digits - 1] - '0')) {
+        return false;
+    }
+
+    if (digits == 13 && text[0] == '0') {
+        barcode.format = kBarcodeUpcA;
+        barcode.text.assign(text + 1, 12);
+    }
+    else {
+        barcode.format = digits == 13 ? kBarcodeEan13 : kBarcodeEan8;
+        barcode.text.assign(text, digits);
+    }
+    barcode.rows = 1;
+    return true;
+}
+
+bool BarcodeDecoder::decodeCode128(size_t start, Barcode& barcode) const {
+    // Start, a data symbol, the check symbol and the stop pattern at least
+    if (start + 6 * 3 + 7 > runs_.size()) {
+        return false;
+    }
+    int startCode = matchCode128(&runs_[start]);
+    if (startCode < static_cast<int>(kCode128StartA) || startCode >= static_cast<int>(kCode128Stop) ||
+        !hasQuietZone(runs_, start, 11, sumRuns(&runs_[start], 6))) {
+        return false;
+    }
+
+    uint8_t symbols[kMaxCode128Symbols];
+    size_t count = 0;
+    size_t position = start + 6;
+    for (;;) {
+        if (position + 6 > runs_.size() || count == kMaxCode128Symbols) {
+            return false;
+        }
+        int symbol = matchCode128(&runs_[position]);
+        if (symbol == static_cast<int>(kCode128Stop)) {
+            // The stop pattern ends in a bar two modules wide
+            unsigned total = sumRuns(&runs_[position], 6);
+            if (position + 6 >= runs_.size() || runs_[position + 6] * 11 * 2 < total * 3 ||
+                runs_[position + 6] * 11 * 2 > total * 5) {
+                return false;
+            }
+            break;
+        }
+        if (symbol < 0 || symbol >= static_cast<int>(kCode128StartA)) {
+            return false;
+        }
+        symbols[count++] = static_cast<uint8_t>(symbol);
+        position += 6;
+    }
+    if (count < 2) {
+        return false;
+    }
+
+    unsigned checksum = static_cast<unsigned>(startCode);
+    for (size_t i = 0; i + 1 < count; i++) {
+        checksum += symbols[i] * static_cast<unsigned>(i + 1);
+    }
+    if (checksum % 103 != symbols[count - 1]) {
+        return false;
+    }
+
+    std::string text;
+    Code128Set set = static_cast<Code128Set>(startCode - kCode128StartA);
+    bool shifted = false;
+    for (size_t i = 0; i + 1 < count; i++) {
+        unsigned value = symbols[i];
+        Code128Set current = shifted ? (set == kSetA ? kSetB : kSetA) : set;
+        shifted = false;
+        if (current == kSetC) {
+            if (value < 100) {
+                text += static_cast<char>('0' + value / 10);
+                text += static_cast<char>('0' + value % 10);
+            }
+            else if (value == 100) {
+                set = kSetB;
+            }
+            else if (value == 101) {
+                set = kSetA;
+            }
+            else if (i > 0) {
+                text += '\x1d';     // FNC1 separates GS1 fields
+            }
+            continue;
+        }
+        if (value < 96) {
+            text += static_cast<char>(current == kSetB || value < 64 ? value + 32 : value - 64);
+            continue;
+        }
+        switch (value) {
+            case 98: shifted = true; break;
+            case 99: set = kSetC; break;
+            case 100: if (current == kSetA) set = kSetB; break;     // FNC4 in set B
+            case 101: if (current == kSetB) set = kSetA; break;     // FNC4 in set A
+            case 102: if (i > 0) text += '\x1d'; break;
+            default: break;                                         // FNC2, FNC3
+        }
+    }
+
+    barcode.format = kBarcodeCode128;
+    barcode.text = text;
+    barcode.rows = 1;
+    return true;
+}
+
+}
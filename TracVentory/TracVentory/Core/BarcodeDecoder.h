@@ -0,0 +1,112 @@
+//
+//  BarcodeDecoder.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_BarcodeDecoder_h
+#define TracVentory_BarcodeDecoder_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace flx {
+
+enum BarcodeFormat : uint8_t {
+    kBarcodeNone = 0,
+    kBarcodeEan13,
+    kBarcodeEan8,
+    kBarcodeUpcA,           // an EAN-13 whose first digit is 0
+    kBarcodeCode128
+};
+
+struct Barcode {
+    BarcodeFormat format;
+    std::string text;       // digits, or the Code 128 characters
+    unsigned rows;          // scanlines that read the same barcode
+};
+
+// Part of a camera frame, in pixels of the frame
+struct FrameRegion {
+    size_t x;
+    size_t y;
+    size_t width;
+    size_t height;
+};
+
+// The bars (1) and spaces (0) of a barcode, one entry per module, without
+// quiet zones. text is the digits, with or without the check digit, or for
+// Code 128 printable ASCII (an even number of digits goes in code set C).
+// False if text cannot be encoded or its check digit is wrong.
+bool encodeBarcode(BarcodeFormat format, const std::string& text, std::vector<uint8_t>& modules);
+
+// LumaFrame is the 8-bit luminance of a region of a camera frame, shrunk by
+// averaging blocks of xFactor x yFactor pixels. For a barcode lying across
+// the frame, averaging rows (yFactor) loses nothing and evens out sensor
+// noise, while xFactor must leave a module at least two pixels wide. Its
+// buffers are reused from frame to frame, so filling it does not allocate
+// once warmed up.
+class LumaFrame {
+public:
+    LumaFrame();
+
+    // From the luma plane of a 4:2:0 biplanar frame (what the camera
+    // delivers natively), or from 32-bit BGRA. region is clipped to the frame.
+    void fromLuma(const uint8_t* plane, size_t width, size_t height, size_t bytesPerRow,
+                  const FrameRegion& region, unsigned xFactor, unsigned yFactor);
+    void fromBgra(const uint8_t* pixels, size_t width, size_t height, size_t bytesPerRow,
+                  const FrameRegion& region, unsigned xFactor, unsigned yFactor);
+
+    const uint8_t* row(size_t y) const { return &pixels_[y * width_]; }
+    size_t width() const { return width_; }
+    size_t height() const { return height_; }
+
+private:
+    // Clip region, size the output; false if nothing is left
+    bool prepare(size_t width, size_t height, const FrameRegion& region, unsigned xFactor, unsigned yFactor,
+                 FrameRegion& clipped);
+    // Average the blocks summed into sums_
+    void store(uint8_t* out, unsigned xFactor, unsigned yFactor);
+
+    std::vector<uint8_t> pixels_;
+    std::vector<uint16_t> sums_;
+    size_t width_;
+    size_t height_;
+};
+
+// BarcodeDecoder reads EAN-13, UPC-A, EAN-8 and Code 128 barcodes lying
+// roughly horizontally in a LumaFrame. It reads a number of scanlines from
+// the middle outwards: each is smoothed, thresholded halfway between its
+// darkest and lightest pixel and cut into runs of bars and spaces, which are
+// matched against the symbol patterns in both directions. A barcode counts
+// once enough scanlines agree on it, which weeds out the odd misread that
+// passes a check digit.
+//
+// Not thread safe; give each decoding queue its own decoder.
+class BarcodeDecoder {
+public:
+    explicit BarcodeDecoder(unsigned scanlines = 12, unsigned agreement = 2);
+
+    bool decode(const LumaFrame& frame, Barcode& barcode);
+    // One scanline on its own
+    bool decodeRow(const uint8_t* row, size_t width, Barcode& barcode);
+
+private:
+    bool decodeRuns(bool firstIsBar, Barcode& barcode);
+    bool decodeEan(size_t start, size_t digits, Barcode& barcode) const;
+    bool decodeCode128(size_t start, Barcode& barcode) const;
+
+    unsigned scanlines_;
+    unsigned agreement_;
+    std::vector<uint8_t> dark_;
+    std::vector<uint16_t> runs_;
+    std::vector<Barcode> candidates_;
+};
+
+}
+
+#endif
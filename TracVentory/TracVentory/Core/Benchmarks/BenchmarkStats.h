@@ -0,0 +1,52 @@
+//
+//  BenchmarkStats.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  The clock and percentiles the benchmarks report with, so a p99 means
+//  the same thing in every results file.
+//
+
+#ifndef TracVentory_BenchmarkStats_h
+#define TracVentory_BenchmarkStats_h
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace flx {
+namespace bench {
+
+typedef std::chrono::steady_clock Clock;
+
+// Monotonic nanoseconds from an arbitrary start, the same for every thread
+inline uint64_t nowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+inline double nanosSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Nearest rank: the smallest value at least p (0 to 1) of the values are at
+// or below. 0 for no values.
+inline double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    double rank = std::ceil(p * values.size());
+    size_t index = rank < 1 ? 0 : std::min(values.size() - 1, static_cast<size_t>(rank) - 1);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+}
+}
+
+#endif
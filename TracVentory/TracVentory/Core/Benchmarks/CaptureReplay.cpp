@@ -0,0 +1,169 @@
+//
+//  CaptureReplay.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Replays a reader session capture (see FLXReaderSession) through
+//  flx::CommandSession, the portable counterpart of the SDK's packet queue
+//  and response processor, and reports throughput per command:
+//
+//      c++ -std=c++11 -O2 -I.. CaptureReplay.cpp ../SessionCapture.cpp ../CommandSession.cpp
+//          ../ReaderProtocol.cpp ../PacketFramer.cpp ../Arena.cpp
+//          ../CommandScheduler.cpp ../RetryPolicy.cpp ../CommandTable.cpp
+//          -o capture_replay
+//      ./capture_replay --generate shift.flxcap [reads]
+//      ./capture_replay shift.flxcap [speed]
+//
+//  speed 0 (the default) replays as fast as possible, 1 at the recorded pace.
+//  --generate writes a synthetic capture of continuous-scan tag reads split
+//  into Bluetooth-sized chunks, for when no field capture is at hand.
+//
+
+#include "CommandSession.h"
+#include "CommandTable.h"
+#include "SessionCapture.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Writes nowhere: outbound traffic in a capture is only counted
+class NullTransport : public flx::Transport {
+public:
+    virtual void write(const uint8_t*, size_t) {}
+};
+
+class CountingHandler : public flx::ResponseHandler {
+public:
+    uint64_t perCommand[256];
+
+    CountingHandler() { memset(perCommand, 0, sizeof(perCommand)); }
+
+    virtual void onResponse(const flx::ReaderCommand&, const flx::ReaderResponse& response) {
+        perCommand[response.command]++;
+    }
+
+    virtual void onAsyncResponse(const flx::ReaderResponse& response) {
+        perCommand[response.command]++;
+    }
+};
+
+int generate(const char* path, size_t reads) {
+    flx::CaptureWriter writer;
+    if (!writer.open(path)) {
+        fprintf(stderr, "cannot create %s\n", path);
+        return 1;
+    }
+
+    // The app starts scanning, then the reader streams asynchronous tag reads
+    uint8_t packet[flx::kMaxPacketSize];
+    uint8_t start[] = { 0x01 };
+    writer.record(flx::kCaptureOutbound, packet, flx::encodePacket(flx::kCmdSetScanning, start, sizeof(start), packet));
+
+    std::mt19937 random(42);
+    std::vector<uint8_t> stream;
+    for (size_t i = 0; i < reads; i++) {
+        uint8_t epc[12] = { 0x30, 0x14, 0x2C, 0x7A };
+        for (int b = 4; b < 12; b++) {
+            epc[b] = static_cast<uint8_t>(random());
+        }
+        uint32_t seconds = static_cast<uint32_t>(i / 20);
+        flx::ReaderTimestamp time = { 26, 10, 19, static_cast<uint8_t>(8 + seconds / 3600 % 12),
+                                      static_cast<uint8_t>(seconds / 60 % 60), static_cast<uint8_t>(seconds % 60) };
+        size_t size = flx::encodeAsyncMarker(packet);
+        stream.insert(stream.end(), packet, packet + size);
+        size = flx::encodeTagRead(flx::kCmdGetTagId, epc, sizeof(epc), time, packet);
+        stream.insert(stream.end(), packet, packet + size);
+
+        // Deliver in the chunk sizes the accessory stream hands us
+        while (stream.size() >= 64) {
+            size_t chunk = 16 + random() % 49;
+            writer.record(flx::kCaptureInbound, stream.data(), chunk);
+            stream.erase(stream.begin(), stream.begin() + chunk);
+            if (i % 200 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+    }
+    if (!stream.empty()) {
+        writer.record(flx::kCaptureInbound, stream.data(), stream.size());
+    }
+    printf("wrote %llu records, %llu bytes\n",
+           static_cast<unsigned long long>(writer.recordCount()),
+           static_cast<unsigned long long>(writer.byteCount()));
+    writer.close();
+    return 0;
+}
+
+int replay(const char* path, double speed) {
+    flx::CaptureReader reader;
+    if (!reader.open(path)) {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 1;
+    }
+
+    NullTransport transport;
+    flx::CommandSession session(transport);
+    CountingHandler handler;
+    session.addHandler(&handler);
+    uint64_t inboundBytes = 0;
+    uint64_t outboundRecords = 0;
+    uint64_t lastTimestamp = 0;
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    uint64_t records = flx::replayCapture(reader, speed, [&](const flx::CaptureRecord& record) {
+        lastTimestamp = record.timestampNs;
+        if (record.direction == flx::kCaptureOutbound) {
+            outboundRecords++;
+            return;
+        }
+        inboundBytes += record.length;
+        session.onDataReceived(record.data, record.length);
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    printf("records      %llu (%llu outbound)%s\n",
+           static_cast<unsigned long long>(records),
+           static_cast<unsigned long long>(outboundRecords),
+           reader.truncated() ? ", truncated tail" : "");
+    printf("captured     %.3f s\n", lastTimestamp / 1e9);
+    printf("replayed     %.3f s\n", seconds);
+    printf("inbound      %llu bytes, %.1f MB/s\n",
+           static_cast<unsigned long long>(inboundBytes), inboundBytes / seconds / 1e6);
+    const flx::SessionStats& stats = session.stats();
+    uint64_t responses = stats.responses + stats.asyncResponses + stats.unmatched;
+    printf("responses    %llu, %.0f/s (%llu async, %llu unmatched)\n",
+           static_cast<unsigned long long>(responses), responses / seconds,
+           static_cast<unsigned long long>(stats.asyncResponses),
+           static_cast<unsigned long long>(stats.unmatched));
+    for (int command = 0; command < 256; command++) {
+        if (handler.perCommand[command]) {
+            const flx::CommandDescriptor* descriptor = flx::CommandTable::describe(static_cast<uint8_t>(command));
+            printf("  0x%02X %-18s %llu\n", command, descriptor ? descriptor->name : "?",
+                   static_cast<unsigned long long>(handler.perCommand[command]));
+        }
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc > 2 && strcmp(argv[1], "--generate") == 0) {
+        return generate(argv[2], argc > 3 ? strtoul(argv[3], NULL, 10) : 1000000);
+    }
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s capture [speed] | --generate capture [reads]\n", argv[0]);
+        return 1;
+    }
+    return replay(argv[1], argc > 2 ? atof(argv[2]) : 0);
+}
@@ -0,0 +1,204 @@
+//
+//  EpcDecoderBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Checks decodeEpc against the GS1 Tag Data Standard examples and a round
+//  trip of random SGTIN/GRAI/GIAI-96 tags through encodeEpc, then times
+//  turning tag bytes into a pure identity URI against the usual string
+//  route (hex string, binary digit string, substr and stoull per field):
+//
+//      c++ -std=c++11 -O2 -I.. EpcDecoderBenchmark.cpp ../EpcDecoder.cpp
+//          -o epc_decoder
+//      ./epc_decoder [--json results.json] [tags]
+//
+//  Reported: nanoseconds per tag for each, and any tag the two disagree on
+//  or that does not round-trip (there must be none).
+//
+
+#include "EpcDecoder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// The string route: what decoding looks like starting from [tag toString]
+std::string stringDecode(const uint8_t* bytes) {
+    static const char digits[] = "0123456789ABCDEF";
+    std::string hex;
+    for (size_t i = 0; i < flx::kEpc96Size; i++) {
+        hex += digits[bytes[i] >> 4];
+        hex += digits[bytes[i] & 0x0F];
+    }
+    std::string binary;
+    for (size_t i = 0; i < hex.size(); i++) {
+        int nibble = static_cast<int>(std::stoul(hex.substr(i, 1), NULL, 16));
+        for (int bit = 3; bit >= 0; bit--) {
+            binary += (nibble >> bit) & 1 ? '1' : '0';
+        }
+    }
+    int header = static_cast<int>(std::stoul(binary.substr(0, 8), NULL, 2));
+    int partition = static_cast<int>(std::stoul(binary.substr(11, 3), NULL, 2));
+    static const int companyBits[] = { 40, 37, 34, 30, 27, 24, 20 };
+    static const int companyDigits[] = { 12, 11, 10, 9, 8, 7, 6 };
+    if (partition > 6) {
+        return "";
+    }
+    int referenceBits = (header == 0x34 ? 82 : 44) - companyBits[partition];
+    unsigned long long company = std::stoull(binary.substr(14, companyBits[partition]), NULL, 2);
+    unsigned long long reference = std::stoull(binary.substr(14 + companyBits[partition], referenceBits), NULL, 2);
+    std::ostringstream uri;
+    uri.fill('0');
+    uri << (header == 0x30 ? "urn:epc:id:sgtin:" : header == 0x33 ? "urn:epc:id:grai:" : "urn:epc:id:giai:");
+    uri.width(companyDigits[partition]);
+    uri << company << '.';
+    if (header == 0x34) {
+        uri << reference;
+    }
+    else {
+        int referenceDigits = (header == 0x30 ? 13 : 12) - companyDigits[partition];
+        if (referenceDigits > 0) {
+            uri.width(referenceDigits);
+            uri << reference;
+        }
+        uri << '.' << std::stoull(binary.substr(58, 38), NULL, 2);
+    }
+    return uri.str();
+}
+
+bool expect(const char* hex, const char* uri, uint64_t gtin) {
+    uint8_t bytes[flx::kEpc96Size];
+    for (size_t i = 0; i < sizeof(bytes); i++) {
+        unsigned value;
+        sscanf(hex + i * 2, "%2x", &value);
+        bytes[i] = static_cast<uint8_t>(value);
+    }
+    flx::Epc epc;
+    char text[64];
+    bool ok = flx::decodeEpc(bytes, sizeof(bytes), epc) && flx::formatEpcUri(epc, text, sizeof(text)) &&
+              strcmp(text, uri) == 0 && flx::epcGtin(epc) == gtin;
+    if (!ok) {
+        fprintf(stderr, "%s: expected %s\n", hex, uri);
+    }
+    return ok;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    size_t count = 200000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            count = strtoul(argv[i], NULL, 10);
+        }
+    }
+
+    // Tag Data Standard examples, and a GTIN-14 worked by hand
+    bool known = expect("3074257BF7194E4000001A85", "urn:epc:id:sgtin:0614141.812345.6789", 80614141123458ULL) &&
+                 expect("3374257BF40C0E400000162E", "urn:epc:id:grai:0614141.12345.5678", 0) &&
+                 // A 12-digit company prefix leaves no asset type digits
+                 expect("3300393243F164000000162E", "urn:epc:id:grai:061414112345..5678", 0) &&
+                 expect("3474257BF400000000BC6038", "urn:epc:id:giai:0614141.12345400", 0);
+
+    std::mt19937_64 random(42);
+    const flx::EpcScheme schemes[] = { flx::kEpcSgtin96, flx::kEpcGrai96, flx::kEpcGiai96 };
+    static const uint64_t limits[] = { 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+                                       10000000000ULL, 100000000000ULL, 1000000000000ULL };
+    static const int giaiBits[] = { 42, 45, 48, 52, 55, 58, 62 };
+    std::vector<uint8_t> tags(count * flx::kEpc96Size);
+    size_t roundTripFailures = 0;
+    for (size_t i = 0; i < count; i++) {
+        flx::Epc epc;
+        epc.scheme = schemes[i % 3];
+        epc.filter = static_cast<uint8_t>(random() % 8);
+        epc.partition = static_cast<uint8_t>(random() % 7);
+        epc.companyPrefix = random() % limits[6 - epc.partition];
+        // Reference digits left by the partition; GIAI is bounded by its bits
+        uint64_t references = epc.scheme == flx::kEpcSgtin96 ? 10 : 1;
+        for (int p = 0; p < epc.partition; p++) {
+            references *= 10;
+        }
+        if (epc.scheme == flx::kEpcGiai96) {
+            references = 1ULL << giaiBits[epc.partition];
+        }
+        epc.reference = random() % references;
+        epc.serial = epc.scheme == flx::kEpcGiai96 ? 0 : random() % (1ULL << 38);
+        uint8_t* bytes = &tags[i * flx::kEpc96Size];
+        flx::Epc decoded;
+        if (!flx::encodeEpc(epc, bytes) || !flx::decodeEpc(bytes, flx::kEpc96Size, decoded) ||
+            decoded.companyPrefix != epc.companyPrefix || decoded.reference != epc.reference ||
+            decoded.serial != epc.serial || decoded.filter != epc.filter) {
+            roundTripFailures++;
+        }
+    }
+
+    size_t checksum = 0;
+    char uri[64];
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < count; i++) {
+        flx::Epc epc;
+        if (flx::decodeEpc(&tags[i * flx::kEpc96Size], flx::kEpc96Size, epc)) {
+            checksum += flx::formatEpcUri(epc, uri, sizeof(uri));
+        }
+    }
+    double bitsNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    size_t disagreements = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) {
+        checksum += stringDecode(&tags[i * flx::kEpc96Size]).size();
+    }
+    double stringNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+    for (size_t i = 0; i < count; i += 97) {
+        flx::Epc epc;
+        flx::decodeEpc(&tags[i * flx::kEpc96Size], flx::kEpc96Size, epc);
+        flx::formatEpcUri(epc, uri, sizeof(uri));
+        disagreements += stringDecode(&tags[i * flx::kEpc96Size]) != uri;
+    }
+
+    start = Clock::now();
+    uint64_t fields = 0;
+    for (size_t i = 0; i < count; i++) {
+        flx::Epc epc;
+        if (flx::decodeEpc(&tags[i * flx::kEpc96Size], flx::kEpc96Size, epc)) {
+            fields += epc.companyPrefix ^ epc.reference;
+        }
+    }
+    double decodeNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    bool ok = known && roundTripFailures == 0 && disagreements == 0;
+    char json[512];
+    snprintf(json, sizeof(json),
+             "{\n  \"benchmark\": \"epc_decoder\",\n"
+             "  \"tags\": %zu, \"known_vectors\": %s, \"round_trip_failures\": %zu, \"disagreements\": %zu,\n"
+             "  \"decode_ns\": %.1f, \"decode_uri_ns\": %.1f, \"string_route_ns\": %.1f, \"speedup\": %.1f\n}\n",
+             count, known ? "true" : "false", roundTripFailures, disagreements,
+             decodeNs, bitsNs, stringNs, stringNs / bitsNs);
+    fputs(json, stdout);
+    fprintf(stderr, "checksum %zu %llu\n", checksum, static_cast<unsigned long long>(fields));
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json, file);
+        fclose(file);
+    }
+    return ok ? 0 : 1;
+}
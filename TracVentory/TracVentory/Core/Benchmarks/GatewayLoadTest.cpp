@@ -0,0 +1,312 @@
+//
+//  GatewayLoadTest.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Load test for TagGateway: a simulated reader streams tag reads through a
+//  CommandSession at a fixed rate while subscribers read them back over TCP
+//  and a Unix socket, one of them deliberately slow:
+//
+//      c++ -std=c++11 -O2 -pthread -I.. GatewayLoadTest.cpp ../TagGateway.cpp
+//          ../CommandSession.cpp ../LoopbackDevice.cpp ../ReaderProtocol.cpp
+//          ../PacketFramer.cpp ../Arena.cpp ../CommandScheduler.cpp
+//          ../RetryPolicy.cpp ../CommandTable.cpp -o gateway_load
+//      ./gateway_load [--json results.json] [tags_per_sec] [seconds] [subscribers]
+//
+//  Reported: delivered rate, end-to-end latency from the session handing a
+//  tag to the gateway to a fast subscriber parsing it (p50/p99), frames per
+//  socket write, and what the slow subscriber received and was told it
+//  dropped. Every fast subscriber must receive every tag. The slow one
+//  reads through a small socket buffer so its queue overflows; what it
+//  received and was told it dropped must add up to every tag.
+//
+
+#include "CommandSession.h"
+#include "LoopbackDevice.h"
+#include "TagGateway.h"
+#include "BenchmarkStats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+using flx::bench::Clock;
+using flx::bench::nowNs;
+using flx::bench::percentile;
+
+uint64_t tagIndex(const uint8_t* id, size_t length) {
+    uint64_t index = 0;
+    for (size_t i = length >= 6 ? length - 6 : 0; i < length; i++) {
+        index = (index << 8) | id[i];
+    }
+    return index;
+}
+
+// When each tag was handed to the gateway, by index
+std::vector<std::atomic<uint64_t> >* publishedAt;
+
+class PublishClock : public flx::ResponseHandler {
+public:
+    virtual void onResponse(const flx::ReaderCommand&, const flx::ReaderResponse&) {}
+    virtual void onAsyncResponse(const flx::ReaderResponse& response) {
+        if (response.tag) {
+            uint64_t index = tagIndex(response.tag->tagId.data(), response.tag->tagId.size());
+            if (index < publishedAt->size()) {
+                (*publishedAt)[index].store(nowNs(), std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+struct Subscriber {
+    bool slow;
+    bool unixSocket;
+    std::atomic<uint64_t> tags;     // watched by the main thread
+    std::atomic<uint64_t> dropped;
+    uint64_t bytes;
+    bool helloSeen;
+    std::vector<double> latenciesUs;
+};
+
+// receiveBuffer 0 keeps the system's socket buffer
+int connectTo(bool unixSocket, const std::string& path, uint16_t port, int receiveBuffer) {
+    if (unixSocket) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (receiveBuffer > 0) {
+            setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+        }
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (receiveBuffer > 0) {
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+    }
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Read frames until the gateway closes the connection
+void consume(int fd, Subscriber* subscriber) {
+    std::vector<uint8_t> buffer(64 * 1024);
+    size_t filled = 0;
+    for (;;) {
+        ssize_t length = recv(fd, &buffer[filled], subscriber->slow ? 4096 : buffer.size() - filled, 0);
+        if (length <= 0) {
+            break;
+        }
+        subscriber->bytes += length;
+        filled += length;
+        size_t offset = 0;
+        while (filled - offset >= 2) {
+            size_t frameLength = (buffer[offset] << 8) | buffer[offset + 1];
+            if (filled - offset < 2 + frameLength) {
+                break;
+            }
+            const uint8_t* frame = &buffer[offset + 2];
+            switch (frame[0]) {
+                case flx::kFrameHello:
+                    subscriber->helloSeen = true;
+                    break;
+                case flx::kFrameTag: {
+                    size_t idLength = frame[3 + flx::kTimestampSize];
+                    uint64_t index = tagIndex(frame + 4 + flx::kTimestampSize, idLength);
+                    subscriber->tags++;
+                    if (!subscriber->slow && index < publishedAt->size()) {
+                        uint64_t sent = (*publishedAt)[index].load(std::memory_order_relaxed);
+                        subscriber->latenciesUs.push_back((nowNs() - sent) / 1000.0);
+                    }
+                    break;
+                }
+                case flx::kFrameDropped:
+                    subscriber->dropped += (static_cast<uint32_t>(frame[1]) << 24) | (frame[2] << 16) | (frame[3] << 8) | frame[4];
+                    break;
+            }
+            offset += 2 + frameLength;
+        }
+        memmove(&buffer[0], &buffer[offset], filled - offset);
+        filled -= offset;
+        if (subscriber->slow) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    close(fd);
+}
+
+flx::TagRead makeTag(size_t index) {
+    flx::TagRead read;
+    uint8_t epc[12] = { 0x30, 0x14, 0x2C, 0x7A, 0x00, 0x00, 0, 0, 0, 0, 0, 0 };
+    for (int i = 0; i < 6; i++) {
+        epc[11 - i] = static_cast<uint8_t>(index >> (i * 8));
+    }
+    read.tagId.assign(epc, epc + sizeof(epc));
+    flx::ReaderTimestamp time = { 26, 10, 19, 12, static_cast<uint8_t>(index / 60 % 60), static_cast<uint8_t>(index % 60) };
+    read.time = time;
+    return read;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    double rate = numbers.size() > 0 ? numbers[0] : 100000;
+    double seconds = numbers.size() > 1 ? numbers[1] : 2;
+    size_t fastSubscribers = numbers.size() > 2 ? static_cast<size_t>(numbers[2]) : 4;
+    size_t total = static_cast<size_t>(rate * seconds);
+
+    std::vector<std::atomic<uint64_t> > published(total);
+    publishedAt = &published;
+
+    std::string path = "/tmp/flx_gateway_" + std::to_string(getpid()) + ".sock";
+    flx::TagGateway gateway;
+    if (!gateway.listenTcp(0) || !gateway.listenUnix(path) || !gateway.start()) {
+        fprintf(stderr, "cannot start the gateway\n");
+        return 1;
+    }
+
+    // Fast subscribers alternate between TCP and the Unix socket; the last
+    // one is slow
+    std::vector<Subscriber> subscribers(fastSubscribers + 1);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < subscribers.size(); i++) {
+        Subscriber& subscriber = subscribers[i];
+        subscriber.slow = i == fastSubscribers;
+        subscriber.unixSocket = i % 2 == 1;
+        subscriber.tags = 0;
+        subscriber.dropped = 0;
+        subscriber.bytes = 0;
+        subscriber.helloSeen = false;
+        subscriber.latenciesUs.reserve(total);
+        int fd = connectTo(subscriber.unixSocket, path, gateway.tcpPort(), subscriber.slow ? 4096 : 0);
+        if (fd < 0) {
+            fprintf(stderr, "cannot connect subscriber %zu\n", i);
+            return 1;
+        }
+        threads.push_back(std::thread(consume, fd, &subscriber));
+    }
+    while (gateway.stats().subscribers < subscribers.size()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    flx::LoopbackDevice device;
+    device.streamTagReads(total, [](size_t index, flx::TagRead& read) {
+        read = makeTag(index);
+    });
+    flx::CommandSession session(device);
+    device.attach(&session);
+    PublishClock clock;
+    session.addHandler(&clock);
+    session.addHandler(&gateway);
+
+    // Deliver at the target rate, a millisecond's worth at a time
+    Clock::time_point start = Clock::now();
+    while (session.stats().asyncResponses < total) {
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        uint64_t due = std::min<uint64_t>(total, static_cast<uint64_t>(elapsed * rate) + 1);
+        while (session.stats().asyncResponses < due && device.pump() > 0) {
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+    double publishSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Let the fast subscribers catch up, then close everyone
+    Clock::time_point deadline = Clock::now() + std::chrono::seconds(10);
+    for (size_t i = 0; i < fastSubscribers; i++) {
+        while (subscribers[i].tags < total && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    double deliverSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // The slow subscriber drains its queue, and then learns what it missed
+    Subscriber& slow = subscribers[fastSubscribers];
+    deadline = Clock::now() + std::chrono::seconds(30);
+    while (slow.tags + slow.dropped < total && Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    flx::GatewayStats stats = gateway.stats();
+    gateway.stop();
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    bool complete = true;
+    std::vector<double> latencies;
+    uint64_t minimum = total;
+    for (size_t i = 0; i < fastSubscribers; i++) {
+        complete = complete && subscribers[i].tags == total && subscribers[i].helloSeen;
+        minimum = std::min<uint64_t>(minimum, subscribers[i].tags);
+        latencies.insert(latencies.end(), subscribers[i].latenciesUs.begin(), subscribers[i].latenciesUs.end());
+    }
+    bool slowAccounted = slow.tags + slow.dropped == total && stats.framesDropped > 0;
+    complete = complete && slowAccounted;
+
+    char json[1024];
+    snprintf(json, sizeof(json),
+             "{\n  \"benchmark\": \"tag_gateway\",\n"
+             "  \"tags\": %zu, \"fast_subscribers\": %zu, \"target_tags_per_sec\": %.0f,\n"
+             "  \"delivered_tags_per_sec\": %.0f, \"fast_min_received\": %llu, \"complete\": %s,\n"
+             "  \"latency_p50_us\": %.1f, \"latency_p99_us\": %.1f,\n"
+             "  \"frames_per_write\": %.1f, \"bytes_written\": %llu,\n"
+             "  \"slow_received\": %llu, \"slow_dropped_reported\": %llu, \"frames_dropped\": %llu,\n"
+             "  \"slow_accounted\": %s\n}\n",
+             total, fastSubscribers, rate,
+             total / deliverSeconds, static_cast<unsigned long long>(minimum), complete ? "true" : "false",
+             percentile(latencies, 0.50), percentile(latencies, 0.99),
+             stats.writes ? static_cast<double>(stats.framesQueued) / stats.writes : 0,
+             static_cast<unsigned long long>(stats.bytesWritten),
+             static_cast<unsigned long long>(slow.tags.load()), static_cast<unsigned long long>(slow.dropped),
+             static_cast<unsigned long long>(stats.framesDropped), slowAccounted ? "true" : "false");
+    fputs(json, stdout);
+    fprintf(stderr, "published in %.2f s\n", publishSeconds);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json, file);
+        fclose(file);
+    }
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,293 @@
+//
+//  GeoIndexBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Nearest-location lookups in flx::GeoIndex against comparing every
+//  location, at 10k locations:
+//
+//      c++ -std=c++11 -O2 -I.. GeoIndexBenchmark.cpp ../GeoIndex.cpp -o geo_index
+//      ./geo_index [--json results.json] [locations] [queries]
+//
+//  Locations are rooms and buildings clustered around sites, with sites by
+//  the antimeridian and inside the Arctic circle, plus a scattering over
+//  the whole globe. Most queries stand near a location, as a device at a
+//  check-in does; the rest are anywhere, where the nearest location may be
+//  thousands of kilometers off. Two queries are timed: the single nearest
+//  location at any distance, and the five nearest within a kilometer.
+//
+//  Reported per query kind: mean, p50 and p99 time of the index and of the
+//  scan, and the geohash cells the index looked at. The scan computes the
+//  haversine distance to every location, as the app would with
+//  CLLocation's distanceFromLocation: and no index. Every index answer is
+//  checked against the scan; errors counts the ones that differ. Build,
+//  move and remove times cover keeping the index in step with sync.
+//
+
+#include "GeoIndex.h"
+#include "BenchmarkStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using flx::bench::Clock;
+using flx::bench::nanosSince;
+using flx::bench::percentile;
+
+struct Location {
+    std::string key;
+    double latitude;
+    double longitude;
+};
+
+// Site centers: offices and warehouses, one on each side of the
+// antimeridian and two north of the Arctic circle
+const double kSites[][2] = {
+    { 40.7128, -74.0060 }, { 34.0522, -118.2437 }, { 41.8781, -87.6298 }, { 29.7604, -95.3698 },
+    { 47.6062, -122.3321 }, { 51.5074, -0.1278 }, { 48.8566, 2.3522 }, { 52.5200, 13.4050 },
+    { 35.6762, 139.6503 }, { 1.3521, 103.8198 }, { -33.8688, 151.2093 }, { -23.5505, -46.6333 },
+    { 19.4326, -99.1332 }, { 28.6139, 77.2090 }, { -26.2041, 28.0473 }, { 55.7558, 37.6173 },
+    { -18.1248, 178.4501 }, { -13.8333, -171.7500 }, { 69.6492, 18.9553 }, { 78.2232, 15.6267 }
+};
+const size_t kSiteCount = sizeof(kSites) / sizeof(kSites[0]);
+
+double metersToLatitude(double meters) {
+    return meters / 111195.0;
+}
+
+double metersToLongitude(double meters, double latitude) {
+    return meters / (111195.0 * std::cos(latitude * 3.14159265358979323846 / 180.0));
+}
+
+double wrap(double longitude) {
+    if (longitude >= 180.0) {
+        return longitude - 360.0;
+    }
+    return longitude < -180.0 ? longitude + 360.0 : longitude;
+}
+
+// Within radius meters of a coordinate
+void jitter(double latitude, double longitude, double radius, std::mt19937& random,
+            double& outLatitude, double& outLongitude) {
+    std::uniform_real_distribution<double> offset(-radius, radius);
+    outLatitude = std::max(-90.0, std::min(90.0, latitude + metersToLatitude(offset(random))));
+    outLongitude = wrap(longitude + metersToLongitude(offset(random), latitude));
+}
+
+void randomCoordinate(std::mt19937& random, double& latitude, double& longitude) {
+    // Uniform over the sphere, not over the latitude/longitude rectangle
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    latitude = std::asin(unit(random)) * 180.0 / 3.14159265358979323846;
+    longitude = wrap(unit(random) * 180.0);
+}
+
+std::vector<Location> makeLocations(size_t count, std::mt19937& random) {
+    std::vector<Location> locations(count);
+    for (size_t i = 0; i < count; i++) {
+        Location& location = locations[i];
+        char key[16];
+        snprintf(key, sizeof(key), "loc%06u", static_cast<unsigned>(i));
+        location.key = key;
+        if (i % 10 == 9) {
+            randomCoordinate(random, location.latitude, location.longitude);
+        }
+        else {
+            const double* site = kSites[random() % kSiteCount];
+            jitter(site[0], site[1], 3000, random, location.latitude, location.longitude);
+        }
+    }
+    return locations;
+}
+
+std::vector<flx::GeoHit> scan(const std::vector<Location>& locations, double latitude, double longitude,
+                              size_t limit, double maxMeters) {
+    std::vector<flx::GeoHit> hits;
+    for (size_t i = 0; i < locations.size(); i++) {
+        double meters = flx::GeoIndex::distanceMeters(latitude, longitude, locations[i].latitude, locations[i].longitude);
+        if (meters <= maxMeters) {
+            flx::GeoHit hit = { locations[i].key, meters };
+            hits.push_back(hit);
+        }
+    }
+    size_t count = std::min(limit, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + count, hits.end(),
+                      [](const flx::GeoHit& a, const flx::GeoHit& b) { return a.meters < b.meters; });
+    hits.resize(count);
+    return hits;
+}
+
+// Equal distances may come back in either order; compare the distances
+bool sameAnswer(const std::vector<flx::GeoHit>& a, const std::vector<flx::GeoHit>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (std::fabs(a[i].meters - b[i].meters) > 1e-3) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double mean(const std::vector<double>& values) {
+    double total = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        total += values[i];
+    }
+    return values.empty() ? 0 : total / values.size();
+}
+
+struct Query {
+    double latitude;
+    double longitude;
+};
+
+struct QueryKind {
+    const char* name;
+    size_t limit;
+    double maxMeters;
+};
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    size_t count = numbers.size() > 0 ? static_cast<size_t>(numbers[0]) : 10000;
+    size_t queryCount = numbers.size() > 1 ? static_cast<size_t>(numbers[1]) : 5000;
+
+    std::mt19937 random(42);
+    std::vector<Location> locations = makeLocations(count, random);
+
+    flx::GeoIndex index;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < locations.size(); i++) {
+        index.put(locations[i].key, locations[i].latitude, locations[i].longitude);
+    }
+    double buildMs = nanosSince(start) / 1e6;
+
+    std::vector<Query> queries(queryCount);
+    for (size_t i = 0; i < queryCount; i++) {
+        if (i % 5 == 4 || locations.empty()) {
+            randomCoordinate(random, queries[i].latitude, queries[i].longitude);
+        }
+        else {
+            const Location& near = locations[random() % locations.size()];
+            jitter(near.latitude, near.longitude, 150, random, queries[i].latitude, queries[i].longitude);
+        }
+    }
+
+    const QueryKind kinds[] = {
+        { "nearest", 1, std::numeric_limits<double>::infinity() },
+        { "nearest5_within_1km", 5, 1000 }
+    };
+    const size_t kindCount = sizeof(kinds) / sizeof(kinds[0]);
+
+    std::string runs;
+    unsigned long long errors = 0;
+    for (size_t k = 0; k < kindCount; k++) {
+        std::vector<double> indexNanos;
+        std::vector<double> scanNanos;
+        indexNanos.reserve(queryCount);
+        scanNanos.reserve(queryCount);
+        index.resetStats();
+        size_t found = 0;
+        for (size_t i = 0; i < queryCount; i++) {
+            start = Clock::now();
+            std::vector<flx::GeoHit> hits = index.nearest(queries[i].latitude, queries[i].longitude,
+                                                          kinds[k].limit, kinds[k].maxMeters);
+            indexNanos.push_back(nanosSince(start));
+
+            start = Clock::now();
+            std::vector<flx::GeoHit> expected = scan(locations, queries[i].latitude, queries[i].longitude,
+                                                     kinds[k].limit, kinds[k].maxMeters);
+            scanNanos.push_back(nanosSince(start));
+
+            found += hits.empty() ? 0 : 1;
+            if (!sameAnswer(hits, expected)) {
+                errors++;
+            }
+        }
+        char line[512];
+        snprintf(line, sizeof(line),
+                 "%s    { \"query\": \"%s\", \"answered\": %.3f, \"index_ns_mean\": %.0f, \"index_ns_p50\": %.0f,"
+                 " \"index_ns_p99\": %.0f, \"scan_ns_mean\": %.0f, \"scan_ns_p50\": %.0f, \"scan_ns_p99\": %.0f,"
+                 " \"cells_per_query\": %.1f }",
+                 runs.empty() ? "" : ",\n", kinds[k].name,
+                 queryCount ? static_cast<double>(found) / queryCount : 0,
+                 mean(indexNanos), percentile(indexNanos, 0.5), percentile(indexNanos, 0.99),
+                 mean(scanNanos), percentile(scanNanos, 0.5), percentile(scanNanos, 0.99),
+                 queryCount ? static_cast<double>(index.cellsVisited()) / queryCount : 0);
+        runs += line;
+    }
+
+    // A sync moving a tenth of the locations, then deleting a tenth
+    size_t changes = count / 10;
+    start = Clock::now();
+    for (size_t i = 0; i < changes; i++) {
+        Location& location = locations[random() % locations.size()];
+        jitter(location.latitude, location.longitude, 500, random, location.latitude, location.longitude);
+        index.put(location.key, location.latitude, location.longitude);
+    }
+    double moveNs = changes ? nanosSince(start) / changes : 0;
+    start = Clock::now();
+    for (size_t i = 0; i < changes && !locations.empty(); i++) {
+        size_t at = random() % locations.size();
+        index.remove(locations[at].key);
+        locations[at] = locations.back();
+        locations.pop_back();
+    }
+    double removeNs = changes ? nanosSince(start) / changes : 0;
+    for (size_t i = 0; i < queryCount / 10; i++) {
+        std::vector<flx::GeoHit> hits = index.nearest(queries[i].latitude, queries[i].longitude, 3, 5000);
+        if (!sameAnswer(hits, scan(locations, queries[i].latitude, queries[i].longitude, 3, 5000))) {
+            errors++;
+        }
+    }
+    if (index.size() != locations.size()) {
+        errors++;
+    }
+
+    std::string json = "{\n  \"benchmark\": \"geo_index\",\n";
+    char header[256];
+    snprintf(header, sizeof(header),
+             "  \"locations\": %zu, \"queries\": %zu, \"build_ms\": %.2f, \"move_ns\": %.0f, \"remove_ns\": %.0f,\n"
+             "  \"runs\": [\n",
+             count, queryCount, buildMs, moveNs, removeNs);
+    json += header;
+    json += runs;
+    char footer[64];
+    snprintf(footer, sizeof(footer), "\n  ],\n  \"errors\": %llu\n}\n", errors);
+    json += footer;
+
+    fputs(json.c_str(), stdout);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json.c_str(), file);
+        fclose(file);
+    }
+    return errors == 0 ? 0 : 1;
+}
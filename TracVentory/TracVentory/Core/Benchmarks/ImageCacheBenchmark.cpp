@@ -0,0 +1,313 @@
+//
+//  ImageCacheBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Scrolling the item list over the two image cache tiers, simulated one
+//  tick (a row scrolled) at a time. Images are fetched the way the app does:
+//  decoded images from a ByteLruCache in memory, else the thumbnail file
+//  from a ByteLruCache-indexed disk cache (ready a tick later), else from
+//  Parse (ready several ticks later), which also fills the disk cache:
+//
+//      c++ -std=c++11 -O2 -I.. ImageCacheBenchmark.cpp ../ImageCache.cpp
+//          -o image_cache
+//      ./image_cache [--json results.json] [items] [memory MB] [prefetch rows]
+//
+//  A session flings down the list, reads back up a stretch and jumps around;
+//  the same session runs again over the warm disk cache, as the next launch
+//  would. Reported per configuration: rows that appeared with their image
+//  already decoded, fetches from disk and network, evictions, and the bytes
+//  decoded per row. The full-size configuration lists the photo itself,
+//  which does not fit the memory budget and is decoded on every
+//  appearance; the thumbnail configurations never decode a photo.
+//
+
+#include "ImageCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const size_t kVisibleRows = 11;
+const unsigned kDiskTicks = 1;
+const unsigned kNetworkTicks = 6;
+const size_t kDiskBudget = 64 << 20;
+
+const flx::PixelSize kPhoto = { 3264, 2448 };
+const uint32_t kThumbnailPixels = 120;
+const size_t kThumbnailFileBytes = 6 * 1024;
+
+struct Config {
+    const char* name;
+    bool thumbnails;
+    size_t memoryBudget;
+    size_t prefetchRows;
+};
+
+struct Result {
+    uint64_t appearances;       // rows coming into view
+    uint64_t ready;             // of them, with the image already decoded
+    uint64_t diskReads;
+    uint64_t networkFetches;
+    uint64_t evictions;
+    uint64_t fullDecodes;
+    double decodedBytes;        // bytes decoded into images
+    double nsPerOperation;      // cache lookups and inserts
+};
+
+std::string fileKey(size_t item, bool thumbnail) {
+    char key[64];
+    snprintf(key, sizeof(key), "tfss-%08zx-%s.jpg", item * 2654435761u % 0xFFFFFFFFu, thumbnail ? "thumb" : "photo");
+    return key;
+}
+
+// Top rows over time: flings, reading, scrolling back, a jump to the top
+std::vector<size_t> makeSession(size_t items) {
+    std::vector<size_t> tops;
+    size_t top = 0;
+    size_t limit = items > kVisibleRows ? items - kVisibleRows : 0;
+    for (int round = 0; round < 6; round++) {
+        // Fling down 1500 rows, 3 a tick, slowing to 1
+        for (size_t moved = 0; moved < 1500 && top < limit;) {
+            size_t step = moved < 1200 ? 3 : 1;
+            top = top + step < limit ? top + step : limit;
+            moved += step;
+            tops.push_back(top);
+        }
+        // Read a while
+        for (int i = 0; i < 20; i++) {
+            tops.push_back(top);
+        }
+        // Back up 300 rows
+        for (int i = 0; i < 300 && top > 0; i++) {
+            tops.push_back(--top);
+        }
+        if (round == 3) {
+            // Scroll to top
+            top = 0;
+            tops.push_back(top);
+        }
+    }
+    return tops;
+}
+
+struct Pending {
+    size_t item;
+    bool fromNetwork;
+};
+
+Result run(const Config& config, const std::vector<size_t>& session, flx::ByteLruCache<bool>& disk) {
+    Result result = Result();
+    flx::ByteLruCache<int> memory(config.memoryBudget);
+    std::map<unsigned long long, std::vector<Pending> > completions;
+    std::vector<bool> inFlight;
+    size_t operations = 0;
+    Clock::time_point start = Clock::now();
+
+    flx::PixelSize shown = config.thumbnails ? flx::thumbnailSize(kPhoto, kThumbnailPixels) : kPhoto;
+    size_t shownBytes = flx::decodedBytes(shown);
+
+    size_t previousTop = session.empty() ? 0 : session[0];
+    size_t items = 0;
+    for (size_t i = 0; i < session.size(); i++) {
+        items = session[i] + kVisibleRows > items ? session[i] + kVisibleRows : items;
+    }
+    inFlight.assign(items + 1000, false);
+
+    auto request = [&](size_t item, unsigned long long tick) {
+        if (item >= inFlight.size() || inFlight[item]) {
+            return;
+        }
+        std::string key = fileKey(item, config.thumbnails);
+        operations++;
+        if (memory.contains(key)) {
+            return;
+        }
+        inFlight[item] = true;
+        operations++;
+        bool onDisk = config.thumbnails && disk.contains(key);
+        Pending pending = { item, !onDisk };
+        if (onDisk) {
+            result.diskReads++;
+        }
+        else {
+            result.networkFetches++;
+        }
+        completions[tick + (onDisk ? kDiskTicks : kNetworkTicks)].push_back(pending);
+    };
+
+    for (unsigned long long tick = 0; tick < session.size(); tick++) {
+        // Fetches finishing now are decoded into the memory tier
+        std::map<unsigned long long, std::vector<Pending> >::iterator done = completions.find(tick);
+        if (done != completions.end()) {
+            for (size_t d = 0; d < done->second.size(); d++) {
+                const Pending& pending = done->second[d];
+                std::string key = fileKey(pending.item, config.thumbnails);
+                memory.insert(key, 1, shownBytes);
+                operations++;
+                result.decodedBytes += shownBytes;
+                if (!config.thumbnails) {
+                    result.fullDecodes++;
+                }
+                if (pending.fromNetwork && config.thumbnails) {
+                    disk.insert(key, true, kThumbnailFileBytes);
+                    operations++;
+                }
+                inFlight[pending.item] = false;
+            }
+            completions.erase(done);
+        }
+
+        size_t top = session[tick];
+        for (size_t row = top; row < top + kVisibleRows; row++) {
+            bool appeared = tick == 0 || row < previousTop || row >= previousTop + kVisibleRows;
+            if (!appeared) {
+                continue;
+            }
+            result.appearances++;
+            int unused;
+            operations++;
+            if (memory.lookup(fileKey(row, config.thumbnails), unused)) {
+                result.ready++;
+            }
+            else {
+                request(row, tick);
+            }
+        }
+        // Prefetch in the direction of travel
+        if (top >= previousTop) {
+            for (size_t row = top + kVisibleRows; row < top + kVisibleRows + config.prefetchRows; row++) {
+                request(row, tick);
+            }
+        }
+        else {
+            for (size_t ahead = 1; ahead <= config.prefetchRows && ahead <= top; ahead++) {
+                request(top - ahead, tick);
+            }
+        }
+        previousTop = top;
+    }
+    result.evictions = memory.stats().evictions;
+    result.nsPerOperation = operations ?
+        std::chrono::duration<double, std::nano>(Clock::now() - start).count() / operations : 0;
+    return result;
+}
+
+uint64_t checkHelpers() {
+    uint64_t errors = 0;
+    flx::PixelSize size = flx::thumbnailSize(kPhoto, 120);
+    errors += size.width != 120 || size.height != 90;
+    flx::PixelSize tall = { 1000, 4000 };
+    size = flx::thumbnailSize(tall, 120);
+    errors += size.width != 30 || size.height != 120;
+    flx::PixelSize small = { 80, 60 };
+    size = flx::thumbnailSize(small, 120);
+    errors += size.width != 80 || size.height != 60;
+    errors += flx::cacheFileName("tfss-1-photo.jpg").size() != 20;
+    errors += flx::cacheFileName("http://files.parse.com/x/tfss-1-photo.jpg") ==
+              flx::cacheFileName("http://files.parse.com/y/tfss-1-photo.jpg");
+    errors += flx::cacheFileName("a.b/c").find('.') != std::string::npos;
+
+    // Budget by bytes: a large value pushes several small ones out
+    flx::ByteLruCache<int> cache(100);
+    std::vector<std::string> evicted;
+    for (int i = 0; i < 10; i++) {
+        cache.insert(std::to_string(i), i, 10, &evicted);
+    }
+    int value;
+    cache.lookup("0", value);
+    cache.insert("big", 0, 35, &evicted);
+    errors += evicted.size() != 4 || evicted[0] != "1" || !cache.contains("0") || cache.bytes() != 95;
+    cache.insert("huge", 0, 101, &evicted);
+    errors += cache.contains("huge") || cache.stats().rejected != 1;
+    return errors;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    size_t items = numbers.size() > 0 ? static_cast<size_t>(numbers[0]) : 100000;
+    size_t memoryBudget = static_cast<size_t>((numbers.size() > 1 ? numbers[1] : 8) * (1 << 20));
+    size_t prefetchRows = numbers.size() > 2 ? static_cast<size_t>(numbers[2]) : 20;
+
+    std::vector<size_t> session = makeSession(items);
+    const Config configs[] = {
+        { "full_size", false, memoryBudget, 0 },
+        { "thumbnails", true, memoryBudget, 0 },
+        { "thumbnails_prefetch", true, memoryBudget, prefetchRows }
+    };
+    const size_t count = sizeof(configs) / sizeof(configs[0]);
+
+    std::string runs;
+    uint64_t thumbnailFullDecodes = 0;
+    for (size_t c = 0; c < count; c++) {
+        // A cold launch, then the next one over the disk cache it left
+        flx::ByteLruCache<bool> disk(kDiskBudget);
+        for (int launch = 0; launch < 2; launch++) {
+            Result result = run(configs[c], session, disk);
+            if (configs[c].thumbnails) {
+                thumbnailFullDecodes += result.fullDecodes;
+            }
+            char line[512];
+            snprintf(line, sizeof(line),
+                     "%s    { \"config\": \"%s\", \"launch\": \"%s\", \"appearances\": %llu, \"ready\": %.3f,"
+                     " \"disk_reads\": %llu, \"network\": %llu, \"evictions\": %llu, \"full_decodes\": %llu,"
+                     " \"decoded_kb_per_row\": %.1f, \"ns_per_op\": %.0f }",
+                     runs.empty() ? "" : ",\n", configs[c].name, launch == 0 ? "cold" : "warm",
+                     static_cast<unsigned long long>(result.appearances),
+                     result.appearances ? static_cast<double>(result.ready) / result.appearances : 0,
+                     static_cast<unsigned long long>(result.diskReads),
+                     static_cast<unsigned long long>(result.networkFetches),
+                     static_cast<unsigned long long>(result.evictions),
+                     static_cast<unsigned long long>(result.fullDecodes),
+                     result.appearances ? result.decodedBytes / 1024 / result.appearances : 0,
+                     result.nsPerOperation);
+            runs += line;
+        }
+    }
+    uint64_t errors = checkHelpers();
+
+    std::string json = "{\n  \"benchmark\": \"image_cache\",\n";
+    char header[256];
+    snprintf(header, sizeof(header),
+             "  \"items\": %zu, \"ticks\": %zu, \"memory_mb\": %.1f, \"prefetch_rows\": %zu,\n  \"runs\": [\n",
+             items, session.size(), memoryBudget / 1048576.0, prefetchRows);
+    json += header;
+    json += runs;
+    char footer[128];
+    snprintf(footer, sizeof(footer), "\n  ],\n  \"thumbnail_full_decodes\": %llu, \"errors\": %llu\n}\n",
+             static_cast<unsigned long long>(thumbnailFullDecodes), static_cast<unsigned long long>(errors));
+    json += footer;
+
+    fputs(json.c_str(), stdout);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json.c_str(), file);
+        fclose(file);
+    }
+    return errors == 0 && thumbnailFullDecodes == 0 ? 0 : 1;
+}
@@ -0,0 +1,284 @@
+//
+//  InventoryTotalsBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Keeping inventory totals with flx::InventoryTotals as items change,
+//  against adding them up from every item when a dashboard asks, at 100k
+//  items:
+//
+//      c++ -std=c++11 -O2 -I.. InventoryTotalsBenchmark.cpp ../InventoryTotals.cpp -o inventory_totals
+//      ./inventory_totals [--json results.json] [items] [events] [locations]
+//
+//  Items are spread over locations, a dozen categories, eleven conditions
+//  (the 0 to 10 slider) and three statuses. Events are what the app
+//  applies: check-ins and check-outs (status and location), edits (cost and
+//  condition), and items added and deleted by sync.
+//
+//  Reported: time to build the totals from the store, time per event
+//  (mean and p99), and the time to answer a dashboard (the total, every
+//  location and every category) from the totals and by scanning. After the
+//  events, the totals are checked against ones rebuilt from scratch and
+//  against the scan; errors counts the groups that differ.
+//
+
+#include "InventoryTotals.h"
+#include "BenchmarkStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using flx::bench::Clock;
+using flx::bench::nanosSince;
+typedef std::unordered_map<std::string, flx::ItemFacts> Items;
+
+const char* kCategories[] = { "Laptop", "Scanner", "Printer", "Switch", "Handheld", "Monitor",
+                              "Tablet", "Phone", "Projector", "Camera", "Radio", "Tool" };
+const char* kStatuses[] = { "Checked In", "Checked Out", "In Repair" };
+
+template <size_t N>
+const char* pick(const char* (&list)[N], std::mt19937& random) {
+    return list[random() % N];
+}
+
+std::string locationName(size_t i) {
+    char name[16];
+    snprintf(name, sizeof(name), "LOC%04u", static_cast<unsigned>(i));
+    return name;
+}
+
+flx::ItemFacts makeItem(size_t locations, std::mt19937& random) {
+    flx::ItemFacts facts;
+    facts.locationID = locationName(random() % locations);
+    facts.category = pick(kCategories, random);
+    facts.condition = std::to_string(random() % 11);
+    facts.status = pick(kStatuses, random);
+    facts.costCents = 1000 + random() % 500000;
+    return facts;
+}
+
+// What a screen without the totals does: add up every item
+struct ScanTotals {
+    std::map<std::string, std::pair<uint64_t, int64_t> > total;
+    std::map<std::string, std::pair<uint64_t, int64_t> > byLocation;
+    std::map<std::string, std::pair<uint64_t, int64_t> > byCategory;
+    std::map<std::string, uint64_t> byStatus;
+    std::map<std::string, uint64_t> byCondition;
+};
+
+ScanTotals scanTotals(const Items& items) {
+    ScanTotals totals;
+    for (Items::const_iterator it = items.begin(); it != items.end(); ++it) {
+        const flx::ItemFacts& facts = it->second;
+        std::pair<uint64_t, int64_t>& all = totals.total[std::string()];
+        all.first++;
+        all.second += facts.costCents;
+        std::pair<uint64_t, int64_t>& location = totals.byLocation[facts.locationID];
+        location.first++;
+        location.second += facts.costCents;
+        std::pair<uint64_t, int64_t>& category = totals.byCategory[facts.category];
+        category.first++;
+        category.second += facts.costCents;
+        totals.byStatus[facts.status]++;
+        totals.byCondition[facts.condition]++;
+    }
+    return totals;
+}
+
+bool sameSummary(const flx::InventorySummary& a, const flx::InventorySummary& b) {
+    std::vector<std::pair<std::string, uint64_t> > conditionsA = a.byCondition;
+    std::vector<std::pair<std::string, uint64_t> > conditionsB = b.byCondition;
+    std::vector<std::pair<std::string, uint64_t> > statusesA = a.byStatus;
+    std::vector<std::pair<std::string, uint64_t> > statusesB = b.byStatus;
+    std::sort(conditionsA.begin(), conditionsA.end());
+    std::sort(conditionsB.begin(), conditionsB.end());
+    std::sort(statusesA.begin(), statusesA.end());
+    std::sort(statusesB.begin(), statusesB.end());
+    return a.count == b.count && a.costCents == b.costCents && conditionsA == conditionsB && statusesA == statusesB;
+}
+
+// Groups of the incremental totals that differ from rebuilt ones or the scan
+unsigned long long check(const flx::InventoryTotals& totals, const Items& items, size_t locations) {
+    unsigned long long errors = 0;
+    flx::InventoryTotals rebuilt;
+    for (Items::const_iterator it = items.begin(); it != items.end(); ++it) {
+        rebuilt.put(it->first, it->second);
+    }
+    ScanTotals scanned = scanTotals(items);
+
+    errors += sameSummary(totals.total(), rebuilt.total()) ? 0 : 1;
+    flx::InventorySummary total = totals.total();
+    errors += total.count == items.size() && total.costCents == scanned.total[std::string()].second ? 0 : 1;
+    for (size_t i = 0; i < total.byStatus.size(); i++) {
+        errors += total.byStatus[i].second == scanned.byStatus[total.byStatus[i].first] ? 0 : 1;
+    }
+    for (size_t i = 0; i < total.byCondition.size(); i++) {
+        errors += total.byCondition[i].second == scanned.byCondition[total.byCondition[i].first] ? 0 : 1;
+    }
+    for (size_t l = 0; l < locations; l++) {
+        std::string location = locationName(l);
+        flx::InventorySummary summary = totals.location(location);
+        errors += sameSummary(summary, rebuilt.location(location)) ? 0 : 1;
+        std::pair<uint64_t, int64_t> expected = scanned.byLocation[location];
+        errors += summary.count == expected.first && summary.costCents == expected.second ? 0 : 1;
+        for (size_t c = 0; c < sizeof(kCategories) / sizeof(kCategories[0]); c++) {
+            errors += sameSummary(totals.locationCategory(location, kCategories[c]),
+                                  rebuilt.locationCategory(location, kCategories[c])) ? 0 : 1;
+        }
+    }
+    for (size_t c = 0; c < sizeof(kCategories) / sizeof(kCategories[0]); c++) {
+        flx::InventorySummary summary = totals.category(kCategories[c]);
+        errors += sameSummary(summary, rebuilt.category(kCategories[c])) ? 0 : 1;
+        std::pair<uint64_t, int64_t> expected = scanned.byCategory[kCategories[c]];
+        errors += summary.count == expected.first && summary.costCents == expected.second ? 0 : 1;
+    }
+    return errors;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    size_t itemCount = numbers.size() > 0 ? static_cast<size_t>(numbers[0]) : 100000;
+    size_t eventCount = numbers.size() > 1 ? static_cast<size_t>(numbers[1]) : 1000000;
+    size_t locations = numbers.size() > 2 ? static_cast<size_t>(numbers[2]) : 500;
+    if (locations == 0) {
+        locations = 1;
+    }
+
+    std::mt19937 random(42);
+    Items items;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < itemCount; i++) {
+        keys.push_back("obj" + std::to_string(i));
+        items[keys.back()] = makeItem(locations, random);
+    }
+
+    flx::InventoryTotals totals;
+    Clock::time_point start = Clock::now();
+    for (Items::const_iterator it = items.begin(); it != items.end(); ++it) {
+        totals.put(it->first, it->second);
+    }
+    double buildMs = nanosSince(start) / 1e6;
+
+    std::vector<double> eventNanos;
+    eventNanos.reserve(eventCount);
+    size_t nextKey = itemCount;
+    for (size_t e = 0; e < eventCount; e++) {
+        unsigned kind = random() % 100;
+        if (kind < 5 || keys.empty()) {
+            // Added by sync
+            keys.push_back("obj" + std::to_string(nextKey++));
+            flx::ItemFacts facts = makeItem(locations, random);
+            items[keys.back()] = facts;
+            start = Clock::now();
+            totals.put(keys.back(), facts);
+            eventNanos.push_back(nanosSince(start));
+            continue;
+        }
+        size_t at = random() % keys.size();
+        const std::string key = keys[at];
+        if (kind < 10) {
+            // Deleted by sync
+            items.erase(key);
+            keys[at] = keys.back();
+            keys.pop_back();
+            start = Clock::now();
+            totals.remove(key);
+            eventNanos.push_back(nanosSince(start));
+            continue;
+        }
+        flx::ItemFacts& facts = items[key];
+        if (kind < 70) {
+            // Checked in somewhere, or out
+            if (random() % 2) {
+                facts.status = "Checked In";
+                facts.locationID = locationName(random() % locations);
+            }
+            else {
+                facts.status = "Checked Out";
+            }
+        }
+        else {
+            facts.condition = std::to_string(random() % 11);
+            facts.costCents = 1000 + random() % 500000;
+        }
+        start = Clock::now();
+        totals.put(key, facts);
+        eventNanos.push_back(nanosSince(start));
+    }
+    double eventMean = 0;
+    for (size_t i = 0; i < eventNanos.size(); i++) {
+        eventMean += eventNanos[i];
+    }
+    eventMean = eventNanos.empty() ? 0 : eventMean / eventNanos.size();
+    double eventP99 = 0;
+    if (!eventNanos.empty()) {
+        size_t at = static_cast<size_t>(0.99 * (eventNanos.size() - 1));
+        std::nth_element(eventNanos.begin(), eventNanos.begin() + at, eventNanos.end());
+        eventP99 = eventNanos[at];
+    }
+
+    // A dashboard: the total, then every location and every category
+    const int dashboards = 20;
+    size_t groups = 0;
+    start = Clock::now();
+    for (int d = 0; d < dashboards; d++) {
+        flx::InventorySummary total = totals.total();
+        groups += total.count ? 1 : 0;
+        groups += totals.locations().size();
+        groups += totals.categories().size();
+    }
+    double dashboardUs = nanosSince(start) / 1e3 / dashboards;
+    start = Clock::now();
+    for (int d = 0; d < dashboards; d++) {
+        ScanTotals scanned = scanTotals(items);
+        groups -= scanned.total.size() + scanned.byLocation.size() + scanned.byCategory.size();
+    }
+    double scanUs = nanosSince(start) / 1e3 / dashboards;
+
+    unsigned long long errors = check(totals, items, locations);
+    errors += groups == 0 ? 0 : 1;
+
+    char json[1024];
+    snprintf(json, sizeof(json),
+             "{\n  \"benchmark\": \"inventory_totals\",\n"
+             "  \"items\": %zu, \"events\": %zu, \"locations\": %zu,\n"
+             "  \"build_ms\": %.2f, \"event_ns_mean\": %.0f, \"event_ns_p99\": %.0f,\n"
+             "  \"dashboard_us\": %.1f, \"scan_dashboard_us\": %.1f,\n"
+             "  \"errors\": %llu\n}\n",
+             totals.size(), eventCount, locations, buildMs, eventMean, eventP99, dashboardUs, scanUs, errors);
+
+    fputs(json, stdout);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json, file);
+        fclose(file);
+    }
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+//
+//  LocationAuditBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Per-read cost of flx::LocationAudit during a continuous-scan burst:
+//
+//      c++ -std=c++11 -O2 -I.. LocationAuditBenchmark.cpp ../LocationAudit.cpp ../TagSet.cpp -o audit_bench
+//      ./audit_bench [--json results.json] [expected] [reads]
+//
+//  Reported: time to load the expected tags, nanoseconds per read, the
+//  found, missing and unexpected counts, and the time to list the missing
+//  and unexpected tags.
+//
+
+#include "LocationAudit.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// A 96-bit EPC with a shared company prefix and a serial number
+flx::TagKey epc(uint64_t serial) {
+    uint8_t bytes[12] = { 0x30, 0x14, 0x2C, 0x7A, 0x00, 0x00, 0, 0, 0, 0, 0, 0 };
+    for (int i = 0; i < 6; i++) {
+        bytes[11 - i] = static_cast<uint8_t>(serial >> (i * 8));
+    }
+    flx::TagKey key;
+    flx::tagKeyFromBytes(bytes, sizeof(bytes), key);
+    return key;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    size_t expected = numbers.size() > 0 ? static_cast<size_t>(numbers[0]) : 20000;
+    size_t reads = numbers.size() > 1 ? static_cast<size_t>(numbers[1]) : 2000000;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    flx::LocationAudit audit(expected);
+    for (size_t i = 0; i < expected; i++) {
+        audit.addExpected(epc(i));
+    }
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Readers report each tag many times; 90% of tags present, 3% strays
+    std::mt19937_64 random(7);
+    std::vector<flx::TagKey> stream;
+    stream.reserve(reads);
+    for (size_t i = 0; i < reads; i++) {
+        uint64_t r = random() % 1000;
+        if (r < 30) {
+            stream.push_back(epc(expected + random() % (expected / 10 + 1)));
+        }
+        else {
+            stream.push_back(epc(random() % (expected * 9 / 10)));
+        }
+    }
+
+    start = std::chrono::steady_clock::now();
+    size_t found = 0;
+    for (size_t i = 0; i < stream.size(); i++) {
+        if (audit.recordRead(stream[i]) == flx::kAuditFound) {
+            found++;
+        }
+    }
+    double scanNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    size_t missing = audit.missingKeys().size();
+    size_t unexpected = audit.unexpectedKeys().size();
+    double reportMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    bool consistent = found == audit.foundCount() && missing == audit.missingCount() && unexpected == audit.unexpectedCount();
+
+    char json[1024];
+    snprintf(json, sizeof(json),
+             "{\n  \"benchmark\": \"location_audit\",\n"
+             "  \"expected\": %zu, \"reads\": %zu, \"load_ms\": %.2f,\n"
+             "  \"read_ns\": %.1f, \"m_reads_per_sec\": %.1f,\n"
+             "  \"found\": %zu, \"missing\": %zu, \"unexpected\": %zu, \"report_ms\": %.2f,\n"
+             "  \"consistent\": %s\n}\n",
+             audit.expectedCount(), audit.readCount(), loadMs, scanNs / reads, reads * 1000.0 / scanNs,
+             audit.foundCount(), missing, unexpected, reportMs, consistent ? "true" : "false");
+    fputs(json, stdout);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json, file);
+        fclose(file);
+    }
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,420 @@
+//
+//  ReaderStackBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  End-to-end cost of the reader stack (command build, session write,
+//  framing, ResponseFactory, handler dispatch) against a LoopbackDevice,
+//  for continuous-scan tag reads, a getEntry drain and HF block reads:
+//
+//      c++ -std=c++11 -O2 -I.. ReaderStackBenchmark.cpp ../CommandSession.cpp ../LoopbackDevice.cpp
+//          ../ReaderProtocol.cpp ../PacketFramer.cpp ../Arena.cpp ../CommandScheduler.cpp
+//          ../RetryPolicy.cpp ../CommandTable.cpp -o stack_bench
+//      ./stack_bench [--json results.json] [scale]
+//
+//  Results are printed as JSON (and written to the --json file) so runs can
+//  be compared release to release. Per scenario:
+//
+//      packets_per_sec         response packets dispatched per second
+//      allocations_per_packet  heap allocations in the stack per packet
+//      dispatch_p50_us/p99_us  from the chunk that completes a packet
+//                              reaching the session to its handler call
+//      cpu_ms_per_1k_tags      process CPU time per 1000 tag reads, entries
+//                              or block reads
+//      arena_peak_bytes        most response memory the session held at once
+//      interactive_p50_us/p99  for the drain_with_scans scenarios: from
+//                              queueing a GetTagId during a bulk getEntry
+//                              drain to its response, with and without the
+//                              priority scheduler
+//
+//  get_entry_drain_completions repeats the drain with a completion per
+//  command instead of a registered handler; get_entry_drain_faults with
+//  every 50th command NACKed ChecksumFailed and resent (retries);
+//  get_entry_drain_lost with every 50th response lost, so the command times
+//  out and is resent. The last two fail the run unless every entry arrives.
+//
+
+#include "CommandSession.h"
+#include "LoopbackDevice.h"
+#include "BenchmarkStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace {
+
+uint64_t allocations = 0;
+
+}
+
+void* operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+namespace {
+
+using flx::bench::Clock;
+using flx::bench::percentile;
+
+struct Result {
+    std::string name;
+    uint64_t packets;
+    uint64_t items;
+    double seconds;
+    double cpuSeconds;
+    uint64_t allocations;
+    size_t arenaPeakBytes;
+    uint64_t retries;
+    uint64_t timeouts;
+    std::vector<double> latenciesUs;
+    std::vector<double> interactiveUs;
+};
+
+// The session's clock in get_entry_drain_lost, moved on only when the
+// device has gone quiet, so timeouts fire exactly when nothing else can
+uint64_t simulatedNow = 1;
+
+uint64_t simulatedClock() {
+    return simulatedNow;
+}
+
+double cpuSeconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// Records when each response reaches the handlers, relative to the start
+// of the chunk that completed it.
+class LatencyHandler : public flx::ResponseHandler {
+public:
+    Clock::time_point chunkStart;
+    std::vector<double> latenciesUs;
+    std::deque<Clock::time_point> interactiveSent;
+    std::vector<double> interactiveUs;
+    uint64_t items;
+    uint64_t checksum;
+
+    LatencyHandler() : items(0), checksum(0) {}
+
+    virtual void onResponse(const flx::ReaderCommand& command, const flx::ReaderResponse& response) {
+        if (command.command == flx::kCmdGetTagId && !interactiveSent.empty()) {
+            interactiveUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - interactiveSent.front()).count());
+            interactiveSent.pop_front();
+        }
+        record(response);
+    }
+
+    virtual void onAsyncResponse(const flx::ReaderResponse& response) {
+        record(response);
+    }
+
+    void record(const flx::ReaderResponse& response) {
+        latenciesUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - chunkStart).count());
+        if (response.tag) {
+            checksum += response.tag->tagId.back();
+            items++;
+        }
+        else if (response.command == flx::kCmdReadBlocks) {
+            checksum += response.payload.size();
+            items++;
+        }
+    }
+};
+
+flx::TagRead makeTag(size_t index) {
+    flx::TagRead read;
+    uint8_t epc[12] = { 0x30, 0x14, 0x2C, 0x7A, 0x00, 0x00, 0, 0, 0, 0, 0, 0 };
+    for (int i = 0; i < 6; i++) {
+        epc[11 - i] = static_cast<uint8_t>(index >> (i * 8));
+    }
+    read.tagId.assign(epc, epc + sizeof(epc));
+    flx::ReaderTimestamp time = { 26, 10, 19, static_cast<uint8_t>(index / 3600 % 24),
+                                  static_cast<uint8_t>(index / 60 % 60), static_cast<uint8_t>(index % 60) };
+    read.time = time;
+    return read;
+}
+
+// Run the session until the device has nothing more to say. queue(session,
+// handler) runs inside the measured window, since building and queueing
+// commands is part of the cost; tick(session, handler, iteration) runs before
+// every chunk.
+template <typename Q, typename T>
+Result run(const char* name, flx::LoopbackDevice& device, Q queue, T tick) {
+    flx::CommandSession session(device);
+    device.attach(&session);
+    LatencyHandler handler;
+    session.addHandler(&handler);
+
+    Result result;
+    result.name = name;
+    handler.latenciesUs.reserve(1 << 20);
+
+    double cpuStart = cpuSeconds();
+    uint64_t allocationsStart = allocations;
+    Clock::time_point start = Clock::now();
+
+    queue(session, handler);
+    for (size_t iteration = 0; ; iteration++) {
+        tick(session, handler, iteration);
+        handler.chunkStart = Clock::now();
+        if (device.pump() == 0) {
+            break;
+        }
+    }
+
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.allocations = allocations - allocationsStart;
+    result.cpuSeconds = cpuSeconds() - cpuStart;
+    result.packets = session.stats().responses + session.stats().asyncResponses;
+    result.items = handler.items;
+    result.arenaPeakBytes = session.arenaStats().peakBytes;
+    result.retries = session.stats().retries;
+    result.timeouts = session.stats().timeouts;
+    result.latenciesUs.swap(handler.latenciesUs);
+    result.interactiveUs.swap(handler.interactiveUs);
+    if (handler.checksum == 0) {
+        fprintf(stderr, "%s: no data dispatched\n", name);
+    }
+    device.attach(NULL);
+    return result;
+}
+
+template <typename Q>
+Result run(const char* name, flx::LoopbackDevice& device, Q queue) {
+    return run(name, device, queue, [](flx::CommandSession&, LatencyHandler&, size_t) {});
+}
+
+// A getEntry drain with a user pressing scan every 200 chunks
+Result runDrainWithScans(const char* name, size_t entries, bool prioritized) {
+    flx::LoopbackDevice device;
+    std::vector<flx::TagRead> log;
+    for (size_t i = 0; i < entries; i++) {
+        log.push_back(makeTag(i));
+    }
+    device.setEntries(log);
+    flx::TagRead scanned = makeTag(entries);
+    device.setTag(std::vector<uint8_t>(scanned.tagId.begin(), scanned.tagId.end()), 0, 4);
+
+    flx::CommandPriority bulk = prioritized ? flx::kPriorityBulk : flx::kPriorityNormal;
+    flx::CommandPriority interactive = prioritized ? flx::kPriorityInteractive : flx::kPriorityNormal;
+    return run(name, device, [entries, bulk](flx::CommandSession& session, LatencyHandler&) {
+        for (size_t i = 0; i < entries; i++) {
+            uint8_t index[2] = { static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i) };
+            session.send(flx::kCmdGetEntry, index, sizeof(index), bulk);
+        }
+    }, [interactive](flx::CommandSession& session, LatencyHandler& handler, size_t iteration) {
+        if (iteration % 200 == 0 && session.queuedCommands() > 0) {
+            handler.interactiveSent.push_back(Clock::now());
+            session.send(flx::kCmdGetTagId, NULL, 0, interactive);
+        }
+    });
+}
+
+std::string toJson(std::vector<Result>& results) {
+    std::string json = "{\n  \"benchmark\": \"reader_stack\",\n  \"scenarios\": [\n";
+    char line[512];
+    for (size_t i = 0; i < results.size(); i++) {
+        Result& result = results[i];
+        double p50 = percentile(result.latenciesUs, 0.50);
+        double p99 = percentile(result.latenciesUs, 0.99);
+        char interactive[128] = "";
+        if (!result.interactiveUs.empty()) {
+            snprintf(interactive, sizeof(interactive), ", \"interactive_p50_us\": %.1f, \"interactive_p99_us\": %.1f",
+                     percentile(result.interactiveUs, 0.50), percentile(result.interactiveUs, 0.99));
+        }
+        if (result.retries > 0) {
+            size_t used = strlen(interactive);
+            snprintf(interactive + used, sizeof(interactive) - used, ", \"retries\": %llu",
+                     static_cast<unsigned long long>(result.retries));
+        }
+        if (result.timeouts > 0) {
+            size_t used = strlen(interactive);
+            snprintf(interactive + used, sizeof(interactive) - used, ", \"timeouts\": %llu",
+                     static_cast<unsigned long long>(result.timeouts));
+        }
+        snprintf(line, sizeof(line),
+                 "    {\"name\": \"%s\", \"packets\": %llu, \"tags\": %llu, \"seconds\": %.4f, "
+                 "\"packets_per_sec\": %.0f, \"allocations_per_packet\": %.2f, "
+                 "\"dispatch_p50_us\": %.3f, \"dispatch_p99_us\": %.3f, \"cpu_ms_per_1k_tags\": %.3f, \"arena_peak_bytes\": %zu%s}%s\n",
+                 result.name.c_str(),
+                 static_cast<unsigned long long>(result.packets),
+                 static_cast<unsigned long long>(result.items),
+                 result.seconds,
+                 result.packets / result.seconds,
+                 result.packets ? static_cast<double>(result.allocations) / result.packets : 0,
+                 p50, p99,
+                 result.items ? result.cpuSeconds * 1000 * 1000 / result.items : 0,
+                 result.arenaPeakBytes,
+                 interactive,
+                 i + 1 < results.size() ? "," : "");
+        json += line;
+    }
+    json += "  ]\n}\n";
+    return json;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    double scale = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            scale = atof(argv[i]);
+        }
+    }
+    size_t tagReads = static_cast<size_t>(200000 * scale);
+    size_t entries = std::min<size_t>(static_cast<size_t>(20000 * scale), 0xffff);
+    size_t blockReads = static_cast<size_t>(20000 * scale);
+
+    std::vector<Result> results;
+
+    {
+        flx::LoopbackDevice device;
+        device.streamTagReads(tagReads, [](size_t index, flx::TagRead& read) {
+            read = makeTag(index);
+        });
+        results.push_back(run("tag_reads", device, [](flx::CommandSession&, LatencyHandler&) {}));
+    }
+
+    {
+        flx::LoopbackDevice device;
+        std::vector<flx::TagRead> log;
+        for (size_t i = 0; i < entries; i++) {
+            log.push_back(makeTag(i));
+        }
+        device.setEntries(log);
+        results.push_back(run("get_entry_drain", device, [entries](flx::CommandSession& session, LatencyHandler&) {
+            session.send(flx::kCmdGetEntryCount);
+            for (size_t i = 0; i < entries; i++) {
+                uint8_t index[2] = { static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i) };
+                session.send(flx::kCmdGetEntry, index, sizeof(index));
+            }
+        }));
+        results.push_back(run("get_entry_drain_completions", device, [entries](flx::CommandSession& session, LatencyHandler& handler) {
+            session.removeHandler(&handler);
+            for (size_t i = 0; i < entries; i++) {
+                uint8_t index[2] = { static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i) };
+                session.send(flx::kCmdGetEntry, index, sizeof(index), flx::kPriorityNormal,
+                             [&handler](const flx::ReaderResponse& response) {
+                    handler.record(response);
+                });
+            }
+        }));
+    }
+
+    {
+        flx::LoopbackDevice device;
+        std::vector<flx::TagRead> log;
+        for (size_t i = 0; i < entries; i++) {
+            log.push_back(makeTag(i));
+        }
+        device.setEntries(log);
+        device.failEvery(50, flx::kStatusChecksumFailed);
+        results.push_back(run("get_entry_drain_faults", device, [entries](flx::CommandSession& session, LatencyHandler&) {
+            // Resend at once; the loopback has nothing to wait out
+            flx::RetryPolicy immediate = { 3, 0, 0 };
+            session.setRetryPolicy(flx::kCmdGetEntry, immediate);
+            for (size_t i = 0; i < entries; i++) {
+                uint8_t index[2] = { static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i) };
+                session.send(flx::kCmdGetEntry, index, sizeof(index));
+            }
+        }));
+    }
+
+    {
+        flx::LoopbackDevice device;
+        std::vector<flx::TagRead> log;
+        for (size_t i = 0; i < entries; i++) {
+            log.push_back(makeTag(i));
+        }
+        device.setEntries(log);
+        device.loseEvery(50);
+        results.push_back(run("get_entry_drain_lost", device, [entries](flx::CommandSession& session, LatencyHandler&) {
+            session.setClock(&simulatedClock);
+            flx::RetryPolicy immediate = { 3, 0, 0 };
+            session.setRetryPolicy(flx::kCmdGetEntry, immediate);
+            for (size_t i = 0; i < entries; i++) {
+                uint8_t index[2] = { static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i) };
+                session.send(flx::kCmdGetEntry, index, sizeof(index));
+            }
+        }, [&device](flx::CommandSession& session, LatencyHandler&, size_t) {
+            // Nothing more is coming: wait out the response timeout
+            if (device.pending() == 0 && session.awaitingResponse()) {
+                simulatedNow = session.nextRetryAt();
+                session.pollRetries();
+            }
+        }));
+    }
+
+    {
+        flx::LoopbackDevice device;
+        uint8_t uid[8] = { 0xE0, 0x04, 0x01, 0x00, 0x12, 0x34, 0x56, 0x78 };
+        device.setTag(std::vector<uint8_t>(uid, uid + sizeof(uid)), 64, 4);
+        results.push_back(run("hf_block_reads", device, [blockReads](flx::CommandSession& session, LatencyHandler&) {
+            for (size_t i = 0; i < blockReads; i++) {
+                uint8_t params[2] = { static_cast<uint8_t>(i % 8 * 8), 8 };
+                session.send(flx::kCmdReadBlocks, params, sizeof(params));
+            }
+        }));
+    }
+
+    results.push_back(runDrainWithScans("drain_with_scans_fifo", entries, false));
+    results.push_back(runDrainWithScans("drain_with_scans_priority", entries, true));
+
+    bool complete = true;
+    for (size_t i = 0; i < results.size(); i++) {
+        if ((results[i].name == "get_entry_drain_faults" || results[i].name == "get_entry_drain_lost") &&
+            results[i].items != entries) {
+            fprintf(stderr, "%s: %llu of %zu entries\n", results[i].name.c_str(),
+                    static_cast<unsigned long long>(results[i].items), entries);
+            complete = false;
+        }
+    }
+
+    std::string json = toJson(results);
+    fputs(json.c_str(), stdout);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json.c_str(), file);
+        fclose(file);
+    }
+    return complete ? 0 : 1;
+}
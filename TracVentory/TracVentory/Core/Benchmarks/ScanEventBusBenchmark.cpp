@@ -0,0 +1,359 @@
+//
+//  ScanEventBusBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Simulated scanners publishing into a ScanEventBus from their own threads
+//  as fast as they can, drained by one consumer thread that is woken the way
+//  the app schedules its drain block: only when publish asks for it. The
+//  same load then goes through a mutex-guarded deque, the obvious
+//  alternative:
+//
+//      c++ -std=c++11 -O2 -pthread -I.. ScanEventBusBenchmark.cpp
+//          ../ScanEventBus.cpp -o scan_event_bus
+//      ./scan_event_bus [--json results.json] [codes] [capacity]
+//
+//  The pen reads each tag three times (held over it), the sled reads
+//  barcodes twice and a tenth of the pen's tags with its RFID head, and the
+//  camera sees each of its barcodes in eight frames. Reported: events per
+//  second, publish cost (p50/p99 ns), publish to delivery latency, wakes
+//  scheduled and times the queue was full. Each distinct code must be
+//  delivered exactly once and in publication order.
+//
+
+#include "ScanEventBus.h"
+#include "BenchmarkStats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using flx::bench::Clock;
+using flx::bench::nowNs;
+using flx::bench::percentile;
+
+// A long window: every repeat in the run is a duplicate
+const uint64_t kWindowUs = 60 * 1000000ULL;
+
+// The mutex-and-deque bus, with the same dedup and wake contract
+class LockedBus {
+public:
+    LockedBus() : pending_(false), published_(0), delivered_(0), duplicates_(0) {}
+
+    bool publish(flx::ScanSource source, flx::ScanSymbology symbology, const uint8_t* bytes, size_t length,
+                 uint64_t timeUs, bool& wake) {
+        flx::ScanEvent event;
+        event.timeUs = timeUs;
+        event.source = source;
+        event.symbology = symbology;
+        event.length = static_cast<uint16_t>(length);
+        memcpy(event.bytes, bytes, length);
+        std::lock_guard<std::mutex> lock(mutex_);
+        event.sequence = published_++;
+        queue_.push_back(event);
+        wake = !pending_;
+        pending_ = true;
+        return true;
+    }
+
+    size_t drain(const std::function<void(const flx::ScanEvent& event)>& deliver) {
+        std::deque<flx::ScanEvent> events;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_ = false;
+            events.swap(queue_);
+        }
+        size_t delivered = 0;
+        for (size_t i = 0; i < events.size(); i++) {
+            const flx::ScanEvent& event = events[i];
+            std::string key(reinterpret_cast<const char*>(event.bytes), event.length);
+            key += static_cast<char>(event.symbology);
+            std::unordered_map<std::string, uint64_t>::iterator seen = lastSeen_.find(key);
+            if (seen != lastSeen_.end() && event.timeUs < seen->second + kWindowUs) {
+                seen->second = std::max(seen->second, event.timeUs);
+                duplicates_++;
+                continue;
+            }
+            lastSeen_[key] = event.timeUs;
+            deliver(event);
+            delivered++;
+        }
+        delivered_ += delivered;
+        return delivered;
+    }
+
+    flx::ScanBusStats stats() const {
+        flx::ScanBusStats stats = { published_, 0, delivered_, duplicates_ };
+        return stats;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<flx::ScanEvent> queue_;
+    bool pending_;
+    uint64_t published_;
+    uint64_t delivered_;
+    uint64_t duplicates_;
+    std::unordered_map<std::string, uint64_t> lastSeen_;
+};
+
+// One simulated scanner's reads, in order
+struct Producer {
+    flx::ScanSource source;
+    std::vector<std::pair<flx::ScanSymbology, std::string> > reads;
+};
+
+std::string tagId(uint32_t serial) {
+    std::string id("\x30\x14\x2C\x7A\x00\x00\x00\x00", 8);
+    for (int i = 3; i >= 0; i--) {
+        id += static_cast<char>(serial >> (i * 8));
+    }
+    return id;
+}
+
+std::vector<Producer> makeProducers(size_t codes) {
+    std::vector<Producer> producers(3);
+    producers[0].source = flx::kScanSourceIdBlue;
+    producers[1].source = flx::kScanSourceLinea;
+    producers[2].source = flx::kScanSourceCamera;
+    for (size_t i = 0; i < codes; i++) {
+        std::string tag = tagId(static_cast<uint32_t>(i));
+        for (int r = 0; r < 3; r++) {
+            producers[0].reads.push_back(std::make_pair(flx::kSymbologyEpc, tag));
+        }
+        char ean[32];
+        snprintf(ean, sizeof(ean), "590%010u", static_cast<unsigned>(i));
+        for (int r = 0; r < 2; r++) {
+            producers[1].reads.push_back(std::make_pair(flx::kSymbologyEan13, std::string(ean)));
+        }
+        if (i % 10 == 0) {
+            producers[1].reads.push_back(std::make_pair(flx::kSymbologyEpc, tag));
+        }
+        char label[32];
+        snprintf(label, sizeof(label), "LOC-%06u", static_cast<unsigned>(i));
+        for (int r = 0; r < 8; r++) {
+            producers[2].reads.push_back(std::make_pair(flx::kSymbologyCode128, std::string(label)));
+        }
+    }
+    return producers;
+}
+
+struct RunResult {
+    double seconds;
+    uint64_t events;
+    uint64_t delivered;
+    uint64_t duplicates;
+    uint64_t wakes;
+    uint64_t full;          // publishes retried because the queue was full
+    double publishP50Ns;
+    double publishP99Ns;
+    double latencyP50Us;
+    double latencyP99Us;
+    uint64_t errors;        // codes delivered other than once, or out of order
+};
+
+template <typename Bus>
+RunResult run(Bus& bus, const std::vector<Producer>& producers, size_t distinct) {
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    bool scheduled = false;
+    bool finished = false;
+    std::atomic<uint64_t> wakes(0);
+    std::atomic<uint64_t> full(0);
+
+    RunResult result = RunResult();
+    std::unordered_map<std::string, unsigned> deliveries;
+    std::vector<double> latencies;
+    uint64_t lastSequence = 0;
+    bool first = true;
+
+    std::function<void(const flx::ScanEvent&)> deliver = [&](const flx::ScanEvent& event) {
+        std::string key(reinterpret_cast<const char*>(event.bytes), event.length);
+        key += static_cast<char>(event.symbology);
+        deliveries[key]++;
+        if (!first && event.sequence <= lastSequence) {
+            result.errors++;
+        }
+        first = false;
+        lastSequence = event.sequence;
+        latencies.push_back(static_cast<double>(nowNs() / 1000 - event.timeUs));
+    };
+
+    // The consumer: a drain block scheduled on a serial queue
+    std::thread consumer([&]() {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        for (;;) {
+            wakeCondition.wait(lock, [&]() { return scheduled || finished; });
+            if (!scheduled && finished) {
+                break;
+            }
+            scheduled = false;
+            lock.unlock();
+            bus.drain(deliver);
+            lock.lock();
+        }
+    });
+
+    std::vector<std::vector<double> > publishNs(producers.size());
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers.size(); p++) {
+        threads.push_back(std::thread([&, p]() {
+            const Producer& producer = producers[p];
+            std::vector<double>& costs = publishNs[p];
+            costs.reserve(producer.reads.size());
+            for (size_t i = 0; i < producer.reads.size(); i++) {
+                const std::string& code = producer.reads[i].second;
+                bool wake = false;
+                for (;;) {
+                    Clock::time_point before = Clock::now();
+                    bool published = bus.publish(producer.source, producer.reads[i].first,
+                                                 reinterpret_cast<const uint8_t*>(code.data()), code.size(),
+                                                 nowNs() / 1000, wake);
+                    costs.push_back(std::chrono::duration<double, std::nano>(Clock::now() - before).count());
+                    if (published) {
+                        break;
+                    }
+                    full++;
+                    std::this_thread::yield();
+                }
+                if (wake) {
+                    wakes++;
+                    std::lock_guard<std::mutex> lock(wakeMutex);
+                    scheduled = true;
+                    wakeCondition.notify_one();
+                }
+            }
+        }));
+    }
+    for (size_t p = 0; p < threads.size(); p++) {
+        threads[p].join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        finished = true;
+        wakeCondition.notify_one();
+    }
+    consumer.join();
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Everything published was drained: nothing may be left behind
+    bus.drain(deliver);
+
+    flx::ScanBusStats stats = bus.stats();
+    result.events = stats.published;
+    result.delivered = stats.delivered;
+    result.duplicates = stats.duplicates;
+    result.wakes = wakes.load();
+    result.full = full.load();
+    for (std::unordered_map<std::string, unsigned>::iterator it = deliveries.begin(); it != deliveries.end(); ++it) {
+        if (it->second != 1) {
+            result.errors++;
+        }
+    }
+    if (deliveries.size() != distinct) {
+        result.errors += distinct > deliveries.size() ? distinct - deliveries.size() : deliveries.size() - distinct;
+    }
+
+    std::vector<double> costs;
+    for (size_t p = 0; p < publishNs.size(); p++) {
+        costs.insert(costs.end(), publishNs[p].begin(), publishNs[p].end());
+    }
+    result.publishP50Ns = percentile(costs, 0.50);
+    result.publishP99Ns = percentile(costs, 0.99);
+    result.latencyP50Us = percentile(latencies, 0.50);
+    result.latencyP99Us = percentile(latencies, 0.99);
+    return result;
+}
+
+// Repeats inside the window are dropped and the window slides while a code
+// keeps being read; after a gap as long as the window it is a new scan, and
+// so is a read stamped well before the last (the clock was set back)
+uint64_t checkWindow() {
+    flx::ScanEventBus bus(16, 1000000);
+    const uint8_t tag[] = { 0x30, 0x14, 0x2C, 0x7A };
+    const uint64_t times[] = { 0, 400000, 1200000, 2200000, 3300000, 100000, 500000 };
+    const size_t expected = 4;      // at 0, 2.2 s, 3.3 s and 0.1 s after the clock was set back
+    bool wake = false;
+    for (size_t i = 0; i < sizeof(times) / sizeof(times[0]); i++) {
+        bus.publish(flx::kScanSourceSimulated, flx::kSymbologyEpc, tag, sizeof(tag), times[i], wake);
+    }
+    size_t delivered = bus.drain([](const flx::ScanEvent&) {});
+    // Unchanged bytes under another symbology are another code
+    bus.publish(flx::kScanSourceSimulated, flx::kSymbologyCode128, tag, sizeof(tag), 3300000, wake);
+    delivered += bus.drain([](const flx::ScanEvent&) {});
+    return delivered == expected + 1 ? 0 : 1;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    size_t codes = numbers.size() > 0 ? static_cast<size_t>(numbers[0]) : 50000;
+    size_t capacity = numbers.size() > 1 ? static_cast<size_t>(numbers[1]) : 1024;
+
+    std::vector<Producer> producers = makeProducers(codes);
+    // Tags, EAN-13s and labels; the sled's tags are the pen's
+    size_t distinct = codes * 3;
+
+    flx::ScanEventBus bus(capacity, kWindowUs);
+    RunResult lockFree = run(bus, producers, distinct);
+    LockedBus locked;
+    RunResult baseline = run(locked, producers, distinct);
+    uint64_t windowErrors = checkWindow();
+
+    char json[1024];
+    snprintf(json, sizeof(json),
+             "{\n  \"benchmark\": \"scan_event_bus\",\n"
+             "  \"codes\": %zu, \"capacity\": %zu, \"events\": %llu, \"distinct\": %zu,\n"
+             "  \"mpsc\": { \"events_per_s\": %.0f, \"publish_p50_ns\": %.0f, \"publish_p99_ns\": %.0f,"
+             " \"latency_p50_us\": %.0f, \"latency_p99_us\": %.0f, \"delivered\": %llu, \"duplicates\": %llu,"
+             " \"wakes\": %llu, \"full\": %llu, \"errors\": %llu },\n"
+             "  \"mutex_deque\": { \"events_per_s\": %.0f, \"publish_p50_ns\": %.0f, \"publish_p99_ns\": %.0f,"
+             " \"latency_p50_us\": %.0f, \"latency_p99_us\": %.0f, \"delivered\": %llu, \"duplicates\": %llu,"
+             " \"wakes\": %llu, \"errors\": %llu },\n"
+             "  \"window_errors\": %llu\n}\n",
+             codes, capacity, static_cast<unsigned long long>(lockFree.events), distinct,
+             lockFree.events / lockFree.seconds, lockFree.publishP50Ns, lockFree.publishP99Ns,
+             lockFree.latencyP50Us, lockFree.latencyP99Us, static_cast<unsigned long long>(lockFree.delivered),
+             static_cast<unsigned long long>(lockFree.duplicates), static_cast<unsigned long long>(lockFree.wakes),
+             static_cast<unsigned long long>(lockFree.full), static_cast<unsigned long long>(lockFree.errors),
+             baseline.events / baseline.seconds, baseline.publishP50Ns, baseline.publishP99Ns,
+             baseline.latencyP50Us, baseline.latencyP99Us, static_cast<unsigned long long>(baseline.delivered),
+             static_cast<unsigned long long>(baseline.duplicates), static_cast<unsigned long long>(baseline.wakes),
+             static_cast<unsigned long long>(baseline.errors), static_cast<unsigned long long>(windowErrors));
+    fputs(json, stdout);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json, file);
+        fclose(file);
+    }
+    return lockFree.errors == 0 && baseline.errors == 0 && windowErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,265 @@
+//
+//  ScanJournalBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Throughput and crash test for ScanJournal. Appends tag events the size
+//  FLXCheckInOutEngine journals at a fixed rate (0: as fast as possible),
+//  then kills a child process mid-append and a torn tail into a journal,
+//  and checks recovery:
+//
+//      c++ -std=c++11 -O2 -pthread -I.. ScanJournalBenchmark.cpp
+//          ../ScanJournal.cpp -o scan_journal
+//      ./scan_journal [--json results.json] [events_per_sec] [seconds]
+//
+//  Reported: append latency (p50/p99/max), records per commit, the slowest
+//  commit, and whether every record up to the durable sequence survived
+//  SIGKILL and whether a torn tail was cut off without losing the records
+//  before it.
+//
+
+#include "ScanJournal.h"
+#include "BenchmarkStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using flx::bench::Clock;
+using flx::bench::percentile;
+
+// About what a check-in/out entry serializes to
+size_t makeEvent(uint64_t index, char* buffer, size_t size) {
+    return snprintf(buffer, size,
+                    "{\"eventId\":\"%016llX-%08X\",\"tagId\":\"30142C7A0000%012llX\","
+                    "\"action\":\"out\",\"assetId\":\"asset-%llu\",\"timestamp\":%.3f}",
+                    static_cast<unsigned long long>(index), static_cast<unsigned>(index * 2654435761u),
+                    static_cast<unsigned long long>(index), static_cast<unsigned long long>(index % 5000),
+                    1792400000.0 + index * 0.001);
+}
+
+bool eventMatches(uint64_t sequence, const uint8_t* data, size_t length) {
+    char expected[256];
+    size_t expectedLength = makeEvent(sequence - 1, expected, sizeof(expected));
+    return length == expectedLength && memcmp(data, expected, length) == 0;
+}
+
+// Count intact records (sequence n holds event n - 1) and find the first gap
+size_t verify(flx::ScanJournal& journal, bool& intact) {
+    intact = true;
+    uint64_t expected = 1;
+    size_t count = journal.forEach([&](uint64_t sequence, const uint8_t* data, size_t length) {
+        if (sequence != expected++ || !eventMatches(sequence, data, length)) {
+            intact = false;
+        }
+    });
+    return count;
+}
+
+// The child appends until killed, reporting each durable sequence through
+// a pipe; the parent kills it mid-burst and reopens the journal
+bool crashTest(const std::string& path, uint64_t& durable, size_t& recovered) {
+    unlink(path.c_str());
+    int pipes[2];
+    if (pipe(pipes) != 0) {
+        return false;
+    }
+    pid_t child = fork();
+    if (child == 0) {
+        close(pipes[0]);
+        flx::ScanJournal journal;
+        flx::JournalOptions options;
+        options.commitIntervalMs = 2;
+        if (!journal.open(path, options)) {
+            _exit(1);
+        }
+        char event[256];
+        uint64_t reported = 0;
+        for (uint64_t index = 0; ; index++) {
+            journal.append(event, makeEvent(index, event, sizeof(event)));
+            uint64_t now = journal.durableSequence();
+            if (now != reported) {
+                reported = now;
+                if (write(pipes[1], &reported, sizeof(reported)) != sizeof(reported)) {
+                    _exit(1);
+                }
+            }
+        }
+    }
+    close(pipes[1]);
+    durable = 0;
+    uint64_t value;
+    Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(300);
+    while (Clock::now() < deadline && read(pipes[0], &value, sizeof(value)) == sizeof(value)) {
+        durable = value;
+    }
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+    while (read(pipes[0], &value, sizeof(value)) == sizeof(value)) {
+        durable = value;
+    }
+    close(pipes[0]);
+
+    flx::ScanJournal journal;
+    if (!journal.open(path)) {
+        return false;
+    }
+    bool intact;
+    recovered = verify(journal, intact);
+    return intact && recovered >= durable;
+}
+
+// Scribble a half-written record after the last one and reopen
+bool tornTailTest(const std::string& path, size_t records, uint64_t& truncated) {
+    unlink(path.c_str());
+    {
+        flx::ScanJournal journal;
+        if (!journal.open(path)) {
+            return false;
+        }
+        char event[256];
+        for (size_t index = 0; index < records; index++) {
+            journal.append(event, makeEvent(index, event, sizeof(event)));
+        }
+        journal.close();
+    }
+    off_t end = flx::kJournalHeaderSize;
+    {
+        flx::ScanJournal journal;
+        journal.open(path);
+        journal.forEach([&](uint64_t, const uint8_t*, size_t length) {
+            end += (flx::kJournalRecordHeaderSize + length + 7) & ~static_cast<size_t>(7);
+        });
+    }
+    int fd = open(path.c_str(), O_RDWR);
+    uint8_t torn[40];
+    uint32_t length = 120;
+    uint64_t sequence = records + 1;
+    memset(torn, 0xA5, sizeof(torn));
+    memcpy(torn, &length, sizeof(length));
+    memcpy(torn + 8, &sequence, sizeof(sequence));
+    bool written = pwrite(fd, torn, sizeof(torn), end) == static_cast<ssize_t>(sizeof(torn));
+    close(fd);
+
+    flx::ScanJournal journal;
+    if (!written || !journal.open(path)) {
+        return false;
+    }
+    bool intact;
+    size_t recovered = verify(journal, intact);
+    truncated = journal.stats().truncatedBytes;
+    // The next append must follow the survivors
+    char event[256];
+    bool continues = journal.append(event, makeEvent(records, event, sizeof(event))) == records + 1;
+    return intact && recovered == records && truncated > 0 && continues;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    double rate = numbers.size() > 0 ? numbers[0] : 20000;
+    double seconds = numbers.size() > 1 ? numbers[1] : 2;
+    std::string path = "/tmp/flx_journal_" + std::to_string(getpid()) + ".journal";
+
+    // Throughput: append at the target rate, compacting as the consumer
+    // marks events applied a batch behind
+    unlink(path.c_str());
+    flx::ScanJournal journal;
+    flx::JournalOptions options;
+    options.maxBytes = 256 << 20;
+    if (!journal.open(path, options)) {
+        fprintf(stderr, "cannot open %s\n", path.c_str());
+        return 1;
+    }
+    std::vector<double> latencies;
+    char event[256];
+    uint64_t total = 0;
+    Clock::time_point start = Clock::now();
+    Clock::time_point end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    while (Clock::now() < end) {
+        if (rate > 0) {
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (total >= elapsed * rate) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                continue;
+            }
+        }
+        size_t length = makeEvent(total, event, sizeof(event));
+        Clock::time_point before = Clock::now();
+        uint64_t sequence = journal.append(event, length);
+        latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - before).count());
+        if (sequence == 0) {
+            fprintf(stderr, "append failed at %llu\n", static_cast<unsigned long long>(total));
+            return 1;
+        }
+        total++;
+        if (total % 50000 == 0) {
+            journal.markApplied(total - 10000);
+            journal.compact();
+        }
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    journal.commit();
+    flx::JournalStats stats = journal.stats();
+    bool durable = journal.durableSequence() == total;
+    journal.close();
+
+    uint64_t crashDurable = 0;
+    size_t crashRecovered = 0;
+    bool crashOk = crashTest(path, crashDurable, crashRecovered);
+    uint64_t truncated = 0;
+    bool tornOk = tornTailTest(path, 1000, truncated);
+    unlink(path.c_str());
+
+    char json[1024];
+    snprintf(json, sizeof(json),
+             "{\n  \"benchmark\": \"scan_journal\",\n"
+             "  \"events\": %llu, \"events_per_sec\": %.0f, \"all_durable\": %s,\n"
+             "  \"append_p50_us\": %.2f, \"append_p99_us\": %.2f, \"append_max_us\": %.1f,\n"
+             "  \"commits\": %llu, \"records_per_commit\": %.1f, \"max_commit_ms\": %.2f, \"compactions\": %llu,\n"
+             "  \"crash_durable\": %llu, \"crash_recovered\": %zu, \"crash_ok\": %s,\n"
+             "  \"torn_tail_truncated_bytes\": %llu, \"torn_tail_ok\": %s\n}\n",
+             static_cast<unsigned long long>(total), total / elapsed, durable ? "true" : "false",
+             percentile(latencies, 0.50), percentile(latencies, 0.99),
+             latencies.empty() ? 0 : *std::max_element(latencies.begin(), latencies.end()),
+             static_cast<unsigned long long>(stats.commits),
+             stats.commits ? static_cast<double>(stats.appended) / stats.commits : 0,
+             stats.maxCommitNs / 1e6, static_cast<unsigned long long>(stats.compactions),
+             static_cast<unsigned long long>(crashDurable), crashRecovered, crashOk ? "true" : "false",
+             static_cast<unsigned long long>(truncated), tornOk ? "true" : "false");
+    fputs(json, stdout);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json, file);
+        fclose(file);
+    }
+    return durable && crashOk && tornOk ? 0 : 1;
+}
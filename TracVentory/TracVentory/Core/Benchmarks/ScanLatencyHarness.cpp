@@ -0,0 +1,259 @@
+//
+//  ScanLatencyHarness.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Scan-to-screen latency of the check-in/out path. An injector thread
+//  presses the reader's button at a controlled rate: each press is the async
+//  Button packet and the async tag read that follows it, handed to a
+//  simulated main thread the way the accessory stream delivers bytes. That
+//  thread runs a CommandSession whose UI-bound handler does what
+//  FLXCheckInOutController does with a scan, and it also renders a frame
+//  every display refresh, so a slow handler shows up both as scan latency
+//  and as dropped frames:
+//
+//      c++ -std=c++11 -O2 -pthread -I.. ScanLatencyHarness.cpp ../ScanLatency.cpp
+//          ../CommandSession.cpp ../ReaderProtocol.cpp ../PacketFramer.cpp
+//          ../Arena.cpp ../CommandScheduler.cpp ../RetryPolicy.cpp
+//          ../CommandTable.cpp -o scan_latency
+//      ./scan_latency [--json results.json] [--poisson] [--budget-ms 33]
+//          [scans_per_sec] [seconds] [handler_us] [render_us]
+//
+//  --poisson spaces the presses randomly around the rate instead of evenly.
+//  handler_us stands in for the work of recording a scan, render_us for a
+//  frame's drawing.
+//
+//  Reported: latency from injection to the handler observing the scan
+//  (p50/p90/p99/max), scans never observed, frames rendered and dropped at
+//  60 Hz and the longest gap between frames. Fails if a scan goes unobserved
+//  or p99 is over the budget (two frames by default).
+//
+
+#include "CommandSession.h"
+#include "ScanLatency.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const double kFrameIntervalMs = 1000.0 / 60;
+
+uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+void spin(uint64_t us) {
+    uint64_t until = nowNs() + us * 1000;
+    while (nowNs() < until) {
+    }
+}
+
+class NullTransport : public flx::Transport {
+public:
+    virtual void write(const uint8_t*, size_t) {}
+};
+
+// The main run loop: work posted from other threads, and a frame at every
+// refresh it is free for. Like a display link, a refresh missed while work
+// ran is skipped, not made up.
+class MainLoop {
+public:
+    MainLoop(flx::ScanLatencyRecorder& recorder, uint64_t renderUs)
+        : recorder_(recorder), renderUs_(renderUs), stopping_(false) {}
+
+    void post(const std::function<void()>& work) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(work);
+        wake_.notify_one();
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        wake_.notify_one();
+    }
+
+    void run() {
+        const uint64_t interval = static_cast<uint64_t>(kFrameIntervalMs * 1e6);
+        uint64_t nextFrame = nowNs() + interval;
+        for (;;) {
+            std::function<void()> work;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (queue_.empty() && !stopping_ && nowNs() < nextFrame) {
+                    wake_.wait_for(lock, std::chrono::nanoseconds(nextFrame - nowNs()));
+                }
+                if (stopping_) {
+                    return;
+                }
+                if (!queue_.empty()) {
+                    work = queue_.front();
+                    queue_.pop_front();
+                }
+            }
+            if (work) {
+                work();
+            }
+            uint64_t now = nowNs();
+            if (now >= nextFrame) {
+                recorder_.frame(now);
+                spin(renderUs_);
+                nextFrame += (now - nextFrame) / interval * interval + interval;
+            }
+        }
+    }
+
+private:
+    flx::ScanLatencyRecorder& recorder_;
+    uint64_t renderUs_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<std::function<void()> > queue_;
+    bool stopping_;
+};
+
+// What FLXCheckInOutController does with a scan: show the tag id without its
+// leading zeros and record it (handlerUs of work)
+class CheckInOutHandler : public flx::ResponseHandler {
+public:
+    CheckInOutHandler(flx::ScanLatencyRecorder& recorder, uint64_t handlerUs)
+        : presses(0), recorder_(recorder), handlerUs_(handlerUs) {}
+
+    uint64_t presses;
+    std::string shown;
+
+    virtual void onResponse(const flx::ReaderCommand&, const flx::ReaderResponse&) {}
+
+    virtual void onAsyncResponse(const flx::ReaderResponse& response) {
+        if (response.command == flx::kCmdButton) {
+            presses++;
+            return;
+        }
+        uint64_t index;
+        if (!response.tag || !flx::scanProbeIndex(response.tag->tagId.data(), response.tag->tagId.size(), index)) {
+            return;
+        }
+        static const char digits[] = "0123456789ABCDEF";
+        std::string tagId;
+        for (size_t i = 0; i < response.tag->tagId.size(); i++) {
+            tagId += digits[response.tag->tagId[i] >> 4];
+            tagId += digits[response.tag->tagId[i] & 0x0F];
+        }
+        shown = tagId.substr(std::min(tagId.find_first_not_of('0'), tagId.size()));
+        spin(handlerUs_);
+        recorder_.observed(index, nowNs());
+    }
+
+private:
+    flx::ScanLatencyRecorder& recorder_;
+    uint64_t handlerUs_;
+};
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    bool poisson = false;
+    double budgetMs = 2 * kFrameIntervalMs;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--budget-ms") == 0 && i + 1 < argc) {
+            budgetMs = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--poisson") == 0) {
+            poisson = true;
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    double rate = numbers.size() > 0 ? numbers[0] : 20;
+    double seconds = numbers.size() > 1 ? numbers[1] : 3;
+    uint64_t handlerUs = numbers.size() > 2 ? static_cast<uint64_t>(numbers[2]) : 200;
+    uint64_t renderUs = numbers.size() > 3 ? static_cast<uint64_t>(numbers[3]) : 4000;
+    size_t scans = static_cast<size_t>(rate * seconds);
+
+    flx::ScanLatencyRecorder recorder(scans, kFrameIntervalMs);
+    NullTransport transport;
+    flx::CommandSession session(transport);
+    CheckInOutHandler handler(recorder, handlerUs);
+    session.addHandler(&handler);
+    MainLoop loop(recorder, renderUs);
+
+    std::thread injector([&]() {
+        std::mt19937 random(42);
+        std::exponential_distribution<double> gap(rate);
+        double due = 0;
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < scans; i++) {
+            due += poisson ? gap(random) : 1 / rate;
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(due)));
+
+            uint32_t second = static_cast<uint32_t>(due);
+            flx::ReaderTimestamp time = { 26, 10, 19, 12, static_cast<uint8_t>(second / 60 % 60), static_cast<uint8_t>(second % 60) };
+            std::vector<uint8_t> bytes(2 * flx::kMaxPacketSize);
+            bytes.resize(flx::encodeButtonScan(i, time, bytes.data(), bytes.size()));
+            recorder.injected(i, nowNs());
+            loop.post([&session, bytes]() {
+                session.onDataReceived(bytes.data(), bytes.size());
+            });
+        }
+        // Give the stragglers a second, then stop the loop
+        Clock::time_point deadline = Clock::now() + std::chrono::seconds(1);
+        while (recorder.observedCount() < scans && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        loop.stop();
+    });
+    loop.run();
+    injector.join();
+
+    flx::ScanLatencyReport report = recorder.report();
+    bool ok = report.observed == scans && handler.presses == scans && report.p99Ms <= budgetMs;
+
+    char json[1024];
+    snprintf(json, sizeof(json),
+             "{\n  \"benchmark\": \"scan_latency\",\n"
+             "  \"scans\": %zu, \"scans_per_sec\": %.1f, \"arrival\": \"%s\", \"handler_us\": %llu, \"render_us\": %llu,\n"
+             "  \"observed\": %zu, \"button_presses\": %llu,\n"
+             "  \"latency_p50_ms\": %.2f, \"latency_p90_ms\": %.2f, \"latency_p99_ms\": %.2f, \"latency_max_ms\": %.2f,\n"
+             "  \"frames\": %zu, \"dropped_frames\": %zu, \"longest_frame_ms\": %.1f,\n"
+             "  \"budget_ms\": %.1f, \"ok\": %s\n}\n",
+             scans, rate, poisson ? "poisson" : "steady",
+             static_cast<unsigned long long>(handlerUs), static_cast<unsigned long long>(renderUs),
+             report.observed, static_cast<unsigned long long>(handler.presses),
+             report.p50Ms, report.p90Ms, report.p99Ms, report.maxMs,
+             report.frames, report.droppedFrames, report.longestFrameMs,
+             budgetMs, ok ? "true" : "false");
+    fputs(json, stdout);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json, file);
+        fclose(file);
+    }
+    return ok ? 0 : 1;
+}
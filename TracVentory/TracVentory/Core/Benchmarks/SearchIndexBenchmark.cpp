@@ -0,0 +1,173 @@
+//
+//  SearchIndexBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Type-ahead latency of flx::SearchIndex at 100k items. Builds on any
+//  C++11 toolchain:
+//
+//      c++ -std=c++11 -O2 -I.. SearchIndexBenchmark.cpp ../SearchIndex.cpp -o search_bench
+//      ./search_bench [--json results.json] [items]
+//
+//  Reported: build time, type-ahead latency over every prefix of a few
+//  typed queries (mean and worst), the time for a round of edits and
+//  removes, and a query afterwards. Also churns a smaller index until it compacts, with some items that have
+//  no searchable text, and fails unless every item still finds itself.
+//
+
+#include "SearchIndex.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* kMakes[] = { "Zebra", "Motorola", "Honeywell", "Dell", "Apple", "Lenovo", "Cisco", "Brother", "Canon", "Epson" };
+const char* kModels[] = { "MC3190", "TC51", "CT60", "Latitude", "MacBook", "ThinkPad", "Catalyst", "HL-L2350", "imageCLASS", "WorkForce" };
+const char* kCategories[] = { "Laptop", "Scanner", "Printer", "Switch", "Handheld", "Monitor" };
+const char* kWords[] = { "spare", "loaner", "warehouse", "dock", "repair", "returned", "battery", "cracked", "screen", "charger", "cable", "shelf" };
+
+template <size_t N>
+const char* pick(const char* (&list)[N], std::mt19937& random) {
+    return list[random() % N];
+}
+
+double millisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+flx::SearchDocument makeDocument(size_t i, std::mt19937& random) {
+    char itemId[32];
+    snprintf(itemId, sizeof(itemId), "E20034%010zX", i * 7919 + 12345);
+    flx::SearchDocument document;
+    document[flx::kSearchFieldItemId] = itemId;
+    document[flx::kSearchFieldMake] = pick(kMakes, random);
+    document[flx::kSearchFieldModel] = pick(kModels, random);
+    document[flx::kSearchFieldCategory] = pick(kCategories, random);
+    document[flx::kSearchFieldNotes] = std::string(pick(kWords, random)) + " " + pick(kWords, random) + " bay " + std::to_string(random() % 400);
+    return document;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    size_t items = numbers.size() > 0 ? static_cast<size_t>(numbers[0]) : 100000;
+    std::mt19937 random(42);
+    flx::SearchIndex index;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < items; i++) {
+        index.put("obj" + std::to_string(i), makeDocument(i, random));
+    }
+    double buildMs = millisSince(start);
+    size_t terms = index.termCount();
+
+    // What a user types into the search bar, one keystroke at a time
+    const char* typed[] = { "zebra mc3190", "thinkpad cracked screen", "e2003400", "honeywell ct60 spare", "bay 12" };
+    double worst = 0;
+    double total = 0;
+    size_t queries = 0;
+    for (size_t q = 0; q < sizeof(typed) / sizeof(typed[0]); q++) {
+        std::string text = typed[q];
+        for (size_t length = 1; length <= text.size(); length++) {
+            start = std::chrono::steady_clock::now();
+            std::vector<flx::SearchHit> hits = index.search(text.substr(0, length), 50);
+            double elapsed = millisSince(start);
+            worst = std::max(worst, elapsed);
+            total += elapsed;
+            queries++;
+            if (length == text.size()) {
+                fprintf(stderr, "query \"%s\": %zu hits, %.3f ms\n", text.c_str(), hits.size(), elapsed);
+            }
+        }
+    }
+
+    // Items edited while the list is open
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < items / 10; i++) {
+        size_t target = random() % items;
+        index.put("obj" + std::to_string(target), makeDocument(target, random));
+    }
+    double updateMs = millisSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < items / 10; i++) {
+        index.remove("obj" + std::to_string(random() % items));
+    }
+    double removeMs = millisSince(start);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<flx::SearchHit> hits = index.search("z", 50);
+    double afterUpdatesMs = millisSince(start);
+
+    // Churn enough to compact, with items that have no searchable text (and
+    // so no postings) among them; every item must still find itself
+    flx::SearchIndex churned;
+    const size_t churnItems = 5000;
+    std::vector<bool> live(churnItems, true);
+    for (size_t round = 0; round < 4; round++) {
+        for (size_t i = 0; i < churnItems; i++) {
+            flx::SearchDocument document = i % 50 == 0 ? flx::SearchDocument() : makeDocument(i, random);
+            churned.put("obj" + std::to_string(i), document);
+        }
+    }
+    for (size_t i = 0; i < churnItems; i += 7) {
+        churned.remove("obj" + std::to_string(i));
+        live[i] = false;
+    }
+    for (size_t i = 0; i < churnItems; i += 50) {
+        churned.put("obj" + std::to_string(i), makeDocument(i, random));
+        live[i] = true;
+    }
+    size_t lost = 0;
+    size_t liveCount = 0;
+    for (size_t i = 0; i < churnItems; i++) {
+        if (!live[i]) {
+            continue;
+        }
+        liveCount++;
+        std::vector<flx::SearchHit> found = churned.search(makeDocument(i, random)[flx::kSearchFieldItemId], 1);
+        lost += found.size() == 1 && found[0].key == "obj" + std::to_string(i) ? 0 : 1;
+    }
+    lost += churned.size() == liveCount ? 0 : 1;
+
+    char json[1024];
+    snprintf(json, sizeof(json),
+             "{\n  \"benchmark\": \"search_index\",\n"
+             "  \"items\": %zu, \"terms\": %zu, \"build_ms\": %.1f,\n"
+             "  \"typeahead_queries\": %zu, \"typeahead_mean_ms\": %.3f, \"typeahead_worst_ms\": %.3f,\n"
+             "  \"updates\": %zu, \"update_ms\": %.1f, \"remove_ms\": %.1f, \"items_left\": %zu,\n"
+             "  \"query_after_updates_ms\": %.3f, \"query_after_updates_hits\": %zu,\n"
+             "  \"churn_items\": %zu, \"churn_without_terms\": %zu, \"churn_lost\": %zu\n}\n",
+             items, terms, buildMs, queries, total / queries, worst,
+             items / 10, updateMs, removeMs, index.size(), afterUpdatesMs, hits.size(),
+             churned.size(), churnItems / 50, lost);
+    fputs(json, stdout);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json, file);
+        fclose(file);
+    }
+    return worst < 10.0 && lost == 0 ? 0 : 1;
+}
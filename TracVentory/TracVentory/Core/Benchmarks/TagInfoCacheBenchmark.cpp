@@ -0,0 +1,213 @@
+//
+//  TagInfoCacheBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Repeat cycle counts of the same stock through a CommandSession and a
+//  LoopbackDevice. Each tag met needs its GetTagInfo geometry and its TID;
+//  both are looked up in a TagInfoCache first and only fetched from the
+//  reader on a miss. Every cycle starts from a cache saved by the previous
+//  one and loaded back, as the next session of the app would:
+//
+//      c++ -std=c++11 -O2 -I.. TagInfoCacheBenchmark.cpp ../TagInfoCache.cpp
+//          ../CommandSession.cpp ../LoopbackDevice.cpp ../ReaderProtocol.cpp
+//          ../PacketFramer.cpp ../Arena.cpp ../CommandScheduler.cpp
+//          ../RetryPolicy.cpp ../CommandTable.cpp -o tag_info_cache
+//      ./tag_info_cache [--json results.json] [tags] [cycles] [capacity]
+//
+//  Each cycle counts 90% of the stock in random order, and 3% of it is new
+//  stock replacing old. Reported: round trips sent against the two per tag
+//  without a cache, hit rate per cycle, lookup cost and the cache file's
+//  size and save/load times. Cached answers must equal the reader's.
+//
+
+#include "CommandSession.h"
+#include "LoopbackDevice.h"
+#include "TagInfoCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const uint8_t kTidWords = 6;
+
+std::vector<uint8_t> makeTagId(uint32_t serial) {
+    std::vector<uint8_t> id = { 0x30, 0x14, 0x2C, 0x7A, 0x00, 0x00, 0, 0, 0, 0, 0, 0 };
+    for (int i = 0; i < 4; i++) {
+        id[11 - i] = static_cast<uint8_t>(serial >> (i * 8));
+    }
+    return id;
+}
+
+double seconds(Clock::time_point since) {
+    return std::chrono::duration<double>(Clock::now() - since).count();
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    size_t tags = numbers.size() > 0 ? static_cast<size_t>(numbers[0]) : 5000;
+    size_t cycles = numbers.size() > 1 ? static_cast<size_t>(numbers[1]) : 5;
+    size_t capacity = numbers.size() > 2 ? static_cast<size_t>(numbers[2]) : 16384;
+
+    std::string path = "/tmp/flx_tag_info_" + std::to_string(getpid()) + ".cache";
+    unlink(path.c_str());
+
+    flx::LoopbackDevice device;
+    flx::CommandSession session(device);
+    device.attach(&session);
+
+    std::mt19937 random(42);
+    std::vector<uint32_t> stock(tags);
+    for (size_t i = 0; i < tags; i++) {
+        stock[i] = static_cast<uint32_t>(i);
+    }
+    uint32_t nextSerial = static_cast<uint32_t>(tags);
+
+    uint64_t encounters = 0;
+    uint64_t roundTrips = 0;
+    uint64_t mismatches = 0;
+    uint64_t lookupNs = 0;
+    double saveSeconds = 0;
+    double loadSeconds = 0;
+    std::vector<double> hitRates;
+    flx::TagInfoCacheStats total;
+    memset(&total, 0, sizeof(total));
+
+    for (size_t cycle = 0; cycle < cycles; cycle++) {
+        flx::TagInfoCache cache(capacity);
+        Clock::time_point start = Clock::now();
+        cache.load(path);
+        loadSeconds += seconds(start);
+
+        std::shuffle(stock.begin(), stock.end(), random);
+        size_t counted = tags * 9 / 10;
+        for (size_t i = 0; i < counted; i++) {
+            std::vector<uint8_t> tagId = makeTagId(stock[i]);
+            device.setTag(tagId, 28, 4);
+            encounters++;
+
+            std::vector<uint8_t> info;
+            std::vector<uint8_t> answer;
+            std::vector<uint8_t>* answerPointer = &answer;
+            Clock::time_point lookup = Clock::now();
+            bool hit = cache.lookup(flx::kTagInfoGeometry, tagId.data(), tagId.size(), info);
+            lookupNs += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - lookup).count();
+            if (!hit || cycle + 1 == cycles) {
+                // The last cycle also asks the reader, to check what the cache said
+                session.send(flx::kCmdGetTagInfo, tagId.data(), tagId.size(), flx::kPriorityNormal,
+                             [answerPointer](const flx::ReaderResponse& response) {
+                    answerPointer->assign(response.payload.data(), response.payload.data() + response.payload.size());
+                });
+                device.pumpAll();
+                roundTrips += !hit;
+                if (!hit) {
+                    cache.insert(flx::kTagInfoGeometry, tagId.data(), tagId.size(), answer.data(), answer.size());
+                }
+                else if (answer != info) {
+                    mismatches++;
+                }
+            }
+
+            lookup = Clock::now();
+            hit = cache.lookup(flx::kTagInfoTid, tagId.data(), tagId.size(), info);
+            lookupNs += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - lookup).count();
+            if (!hit || cycle + 1 == cycles) {
+                uint8_t params[] = { flx::kLoopbackTidBank, 0, kTidWords };
+                session.send(flx::kCmdReadUhf, params, sizeof(params), flx::kPriorityNormal,
+                             [answerPointer](const flx::ReaderResponse& response) {
+                    answerPointer->assign(response.payload.data(), response.payload.data() + response.payload.size());
+                });
+                device.pumpAll();
+                roundTrips += !hit;
+                if (!hit) {
+                    cache.insert(flx::kTagInfoTid, tagId.data(), tagId.size(), answer.data(), answer.size());
+                }
+                else if (answer != info) {
+                    mismatches++;
+                }
+            }
+        }
+
+        const flx::TagInfoCacheStats& stats = cache.stats();
+        hitRates.push_back(stats.hitRate());
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.evictions += stats.evictions;
+
+        start = Clock::now();
+        if (!cache.save(path)) {
+            fprintf(stderr, "cannot save %s\n", path.c_str());
+            return 1;
+        }
+        saveSeconds += seconds(start);
+
+        // New stock replaces some of the old before the next count
+        for (size_t i = 0; i < tags * 3 / 100; i++) {
+            stock[random() % tags] = nextSerial++;
+        }
+    }
+
+    struct stat info;
+    off_t fileSize = stat(path.c_str(), &info) == 0 ? info.st_size : 0;
+    unlink(path.c_str());
+
+    std::string perCycle;
+    for (size_t i = 0; i < hitRates.size(); i++) {
+        char rate[16];
+        snprintf(rate, sizeof(rate), "%s%.3f", i ? ", " : "", hitRates[i]);
+        perCycle += rate;
+    }
+
+    uint64_t uncached = encounters * 2;
+    char json[1024];
+    snprintf(json, sizeof(json),
+             "{\n  \"benchmark\": \"tag_info_cache\",\n"
+             "  \"tags\": %zu, \"cycles\": %zu, \"capacity\": %zu, \"encounters\": %llu,\n"
+             "  \"round_trips_uncached\": %llu, \"round_trips_sent\": %llu, \"round_trips_saved\": %.3f,\n"
+             "  \"hit_rate\": %.3f, \"hit_rate_per_cycle\": [%s], \"evictions\": %llu,\n"
+             "  \"lookup_ns\": %.0f, \"file_bytes\": %lld, \"save_ms\": %.2f, \"load_ms\": %.2f,\n"
+             "  \"mismatches\": %llu\n}\n",
+             tags, cycles, capacity, static_cast<unsigned long long>(encounters),
+             static_cast<unsigned long long>(uncached), static_cast<unsigned long long>(roundTrips),
+             uncached ? 1 - static_cast<double>(roundTrips) / uncached : 0,
+             total.hitRate(), perCycle.c_str(), static_cast<unsigned long long>(total.evictions),
+             total.hits + total.misses ? static_cast<double>(lookupNs) / (total.hits + total.misses) : 0,
+             static_cast<long long>(fileSize), saveSeconds * 1000 / cycles, loadSeconds * 1000 / cycles,
+             static_cast<unsigned long long>(mismatches));
+    fputs(json, stdout);
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json, file);
+        fclose(file);
+    }
+    return mismatches == 0 ? 0 : 1;
+}
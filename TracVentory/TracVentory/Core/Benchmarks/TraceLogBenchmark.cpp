@@ -0,0 +1,176 @@
+//
+//  TraceLogBenchmark.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+//  Cost of logging a tag read with FLX_TRACE (disabled and enabled) against
+//  formatting it and writing it out synchronously, which is what NSLog does
+//  before it even reaches the system log. Then several threads log at a
+//  continuous-scan rate while the writer thread drains to a file:
+//
+//      c++ -std=c++11 -O2 -pthread -I.. TraceLogBenchmark.cpp ../TraceLog.cpp
+//          -o trace_bench
+//      ./trace_bench [--json results.json] [calls] [threads] [reads_per_sec]
+//
+//  Reported: nanoseconds per call for each, and for the threaded run the
+//  records logged, dropped (ring full) and formatted by the writer. No
+//  record may be dropped.
+//
+
+#include "TraceLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const size_t kThreadedReads = 25000;
+
+const uint8_t kTag[12] = { 0x30, 0x14, 0x2C, 0x7A, 0x00, 0x00, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78 };
+
+double nanosecondsPerCall(Clock::time_point start, size_t calls) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls;
+}
+
+// What NSLog costs at the least: format, then one write per message
+double synchronousWrite(size_t calls, const char* path) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    char line[256];
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < calls; i++) {
+        char hex[sizeof(kTag) * 2 + 1];
+        for (size_t b = 0; b < sizeof(kTag); b++) {
+            snprintf(hex + b * 2, 3, "%02X", kTag[b]);
+        }
+        int length = snprintf(line, sizeof(line), "Got tag id: %s entry %zu rssi %d\n", hex, i, -42);
+        if (write(fd, line, length) != length) {
+            break;
+        }
+    }
+    double result = nanosecondsPerCall(start, calls);
+    close(fd);
+    unlink(path);
+    return result;
+}
+
+// Only the calls are timed; the ring is emptied between batches so this
+// measures recording, not drops
+double traced(size_t calls) {
+    Clock::duration elapsed(0);
+    for (size_t done = 0; done < calls; ) {
+        size_t batch = std::min<size_t>(1000, calls - done);
+        Clock::time_point start = Clock::now();
+        for (size_t i = done; i < done + batch; i++) {
+            FLX_TRACE("Got tag id: %s entry %u rssi %d", flx::TraceHex(kTag, sizeof(kTag)), i, -42);
+        }
+        elapsed += Clock::now() - start;
+        done += batch;
+        flx::TraceLog::drain([](const char*, size_t) {});
+    }
+    return std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    std::vector<double> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+        else {
+            numbers.push_back(atof(argv[i]));
+        }
+    }
+    size_t calls = numbers.size() > 0 ? static_cast<size_t>(numbers[0]) : 1000000;
+    size_t threads = numbers.size() > 1 ? static_cast<size_t>(numbers[1]) : 4;
+    double rate = numbers.size() > 2 ? numbers[2] : 50000;
+    std::string path = "/tmp/flx_trace_" + std::to_string(getpid()) + ".log";
+
+    double syncNs = synchronousWrite(calls, path.c_str());
+
+    flx::TraceLog::setEnabled(false);
+    double disabledNs = traced(calls);
+
+    flx::TraceLog::setEnabled(true);
+    double enabledNs = traced(calls);
+    // Formatting happens off the logging thread; measured for reference
+    flx::TraceLog::drain([](const char*, size_t) {});
+    size_t drained = 0;
+    for (size_t i = 0; i < 1000; i++) {
+        FLX_TRACE("Got tag id: %s entry %u rssi %d", flx::TraceHex(kTag, sizeof(kTag)), i, -42);
+    }
+    std::string sample;
+    Clock::time_point start = Clock::now();
+    drained = flx::TraceLog::drain([&sample](const char* line, size_t length) {
+        if (sample.empty()) {
+            sample.assign(line, length - 1);
+        }
+    });
+    double formatNs = nanosecondsPerCall(start, drained);
+
+    // Threads each logging a continuous scan's worth of reads while the
+    // writer drains every 10 ms; nothing should be dropped
+    flx::TraceLog::startWriter(path, 10);
+    flx::TraceStats before = flx::TraceLog::stats();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+        workers.push_back(std::thread([rate, t] {
+            Clock::time_point begin = Clock::now();
+            for (size_t i = 0; i < kThreadedReads; i++) {
+                if (i % 100 == 0) {
+                    std::this_thread::sleep_until(begin + std::chrono::microseconds(static_cast<int64_t>(i * 1e6 / rate)));
+                }
+                FLX_TRACE("worker %u tag %s entry %u", t, flx::TraceHex(kTag, sizeof(kTag)), i);
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    flx::TraceLog::stopWriter();
+    flx::TraceStats after = flx::TraceLog::stats();
+    unlink(path.c_str());
+
+    uint64_t logged = after.records - before.records;
+    uint64_t dropped = after.dropped - before.dropped;
+    uint64_t written = after.formatted - before.formatted;
+    bool complete = logged == threads * kThreadedReads && dropped == 0 && written == logged;
+
+    char json[1024];
+    snprintf(json, sizeof(json),
+             "{\n  \"benchmark\": \"trace_log\",\n"
+             "  \"calls\": %zu, \"sync_write_ns\": %.1f, \"trace_disabled_ns\": %.2f, \"trace_enabled_ns\": %.1f,\n"
+             "  \"format_ns_per_record\": %.1f,\n"
+             "  \"threads\": %zu, \"reads_per_sec_per_thread\": %.0f, \"logged\": %llu, \"dropped\": %llu, \"written\": %llu,\n"
+             "  \"complete\": %s\n}\n",
+             calls, syncNs, disabledNs, enabledNs, formatNs,
+             threads, rate, static_cast<unsigned long long>(logged), static_cast<unsigned long long>(dropped),
+             static_cast<unsigned long long>(written), complete ? "true" : "false");
+    fputs(json, stdout);
+    fprintf(stderr, "%s\n", sample.c_str());
+    if (jsonPath) {
+        FILE* file = fopen(jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 1;
+        }
+        fputs(json, file);
+        fclose(file);
+    }
+    return complete ? 0 : 1;
+}
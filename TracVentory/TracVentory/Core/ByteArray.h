@@ -0,0 +1,191 @@
+//
+//  ByteArray.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_ByteArray_h
+#define TracVentory_ByteArray_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace flx {
+
+// A non-owning view of bytes, e.g. a packet payload inside a receive buffer.
+// Valid only as long as the bytes it points at.
+class ByteSlice {
+public:
+    ByteSlice() : data_(NULL), size_(0) {}
+    ByteSlice(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const uint8_t* begin() const { return data_; }
+    const uint8_t* end() const { return data_ + size_; }
+    uint8_t operator[](size_t index) const { return data_[index]; }
+
+    // The bytes from offset on, at most length of them
+    ByteSlice slice(size_t offset, size_t length = SIZE_MAX) const {
+        if (offset > size_) {
+            offset = size_;
+        }
+        return ByteSlice(data_ + offset, length < size_ - offset ? length : size_ - offset);
+    }
+
+    bool operator==(const ByteSlice& other) const {
+        return size_ == other.size_ && (size_ == 0 || memcmp(data_, other.data_, size_) == 0);
+    }
+    bool operator!=(const ByteSlice& other) const { return !(*this == other); }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+};
+
+// ByteArray is the byte buffer of the reader stack, in the role CByteArray
+// plays in the SDK. Nearly every command and response carries 4-40 bytes,
+// so up to kInlineCapacity bytes are stored in the object itself and only
+// longer payloads (block dumps, property blobs) go to the heap.
+class ByteArray {
+public:
+    static const size_t kInlineCapacity = 64;
+
+    ByteArray() : data_(inline_), size_(0), capacity_(kInlineCapacity) {}
+    ByteArray(const uint8_t* data, size_t size) : data_(inline_), size_(0), capacity_(kInlineCapacity) {
+        assign(data, size);
+    }
+    explicit ByteArray(const ByteSlice& slice) : data_(inline_), size_(0), capacity_(kInlineCapacity) {
+        assign(slice.data(), slice.size());
+    }
+    ByteArray(const ByteArray& other) : data_(inline_), size_(0), capacity_(kInlineCapacity) {
+        assign(other.data_, other.size_);
+    }
+    ByteArray(ByteArray&& other) : data_(inline_), size_(0), capacity_(kInlineCapacity) {
+        take(other);
+    }
+    ~ByteArray() {
+        if (!isInline()) {
+            ::operator delete(data_);
+        }
+    }
+
+    ByteArray& operator=(const ByteArray& other) {
+        if (this != &other) {
+            assign(other.data_, other.size_);
+        }
+        return *this;
+    }
+    ByteArray& operator=(ByteArray&& other) {
+        if (this != &other) {
+            if (!isInline()) {
+                ::operator delete(data_);
+                data_ = inline_;
+                capacity_ = kInlineCapacity;
+            }
+            size_ = 0;
+            take(other);
+        }
+        return *this;
+    }
+
+    void assign(const uint8_t* data, size_t size) {
+        reserve(size);
+        if (size > 0) {
+            memmove(data_, data, size);
+        }
+        size_ = size;
+    }
+    void assign(const uint8_t* first, const uint8_t* last) { assign(first, static_cast<size_t>(last - first)); }
+
+    void append(const uint8_t* data, size_t size) {
+        reserve(size_ + size);
+        if (size > 0) {
+            memcpy(data_ + size_, data, size);
+        }
+        size_ += size;
+    }
+    void push_back(uint8_t byte) {
+        if (size_ == capacity_) {
+            reserve(capacity_ * 2);
+        }
+        data_[size_++] = byte;
+    }
+
+    void resize(size_t size) {
+        reserve(size);
+        if (size > size_) {
+            memset(data_ + size_, 0, size - size_);
+        }
+        size_ = size;
+    }
+    void reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            grow(capacity);
+        }
+    }
+    void clear() { size_ = 0; }
+
+    uint8_t* data() { return data_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+    bool isInline() const { return data_ == inline_; }
+
+    uint8_t* begin() { return data_; }
+    uint8_t* end() { return data_ + size_; }
+    const uint8_t* begin() const { return data_; }
+    const uint8_t* end() const { return data_ + size_; }
+    uint8_t& operator[](size_t index) { return data_[index]; }
+    uint8_t operator[](size_t index) const { return data_[index]; }
+    uint8_t back() const { return data_[size_ - 1]; }
+
+    ByteSlice slice(size_t offset = 0, size_t length = SIZE_MAX) const { return ByteSlice(data_, size_).slice(offset, length); }
+    operator ByteSlice() const { return ByteSlice(data_, size_); }
+
+private:
+    void grow(size_t capacity) {
+        if (capacity < capacity_ * 2) {
+            capacity = capacity_ * 2;
+        }
+        uint8_t* data = static_cast<uint8_t*>(::operator new(capacity));
+        if (size_ > 0) {
+            memcpy(data, data_, size_);
+        }
+        if (!isInline()) {
+            ::operator delete(data_);
+        }
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    // Move other's bytes into this (empty, inline) array
+    void take(ByteArray& other) {
+        if (other.isInline()) {
+            memcpy(inline_, other.inline_, other.size_);
+        }
+        else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_;
+            other.capacity_ = kInlineCapacity;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    uint8_t* data_;
+    size_t size_;
+    size_t capacity_;
+    uint8_t inline_[kInlineCapacity];
+};
+
+}
+
+#endif
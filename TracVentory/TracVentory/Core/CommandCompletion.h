@@ -0,0 +1,111 @@
+//
+//  CommandCompletion.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_CommandCompletion_h
+#define TracVentory_CommandCompletion_h
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace flx {
+
+struct ReaderResponse;
+
+// CommandCompletion holds the callback that resolves one command: called
+// exactly once with its response, its NACK, or a kStatusDisposing response if
+// the session closes first. The callable is stored inside the command (up to
+// four pointers of captures), so sending with a completion allocates nothing
+// that std::function or a future's shared state would.
+class CommandCompletion {
+public:
+    static const size_t kStorageSize = 4 * sizeof(void*);
+
+    CommandCompletion() : invoke_(NULL), manage_(NULL) {}
+
+    template <typename F>
+    CommandCompletion(F f) : invoke_(&invokeImpl<F>), manage_(&manageImpl<F>) {
+        static_assert(sizeof(F) <= kStorageSize, "Completion captures too much; capture a pointer instead");
+        static_assert(alignof(F) <= alignof(Storage), "Completion is over-aligned");
+        new (&storage_) F(std::move(f));
+    }
+
+    CommandCompletion(CommandCompletion&& other) : invoke_(NULL), manage_(NULL) {
+        take(other);
+    }
+
+    CommandCompletion& operator=(CommandCompletion&& other) {
+        if (this != &other) {
+            destroy();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~CommandCompletion() {
+        destroy();
+    }
+
+    explicit operator bool() const { return invoke_ != NULL; }
+
+    // Call and release the callback; later calls do nothing.
+    void complete(const ReaderResponse& response) {
+        if (invoke_) {
+            CommandCompletion callback(std::move(*this));
+            callback.invoke_(&callback.storage_, response);
+        }
+    }
+
+private:
+    CommandCompletion(const CommandCompletion&);
+    CommandCompletion& operator=(const CommandCompletion&);
+
+    typedef std::aligned_storage<kStorageSize, alignof(void*)>::type Storage;
+    enum Operation { kMove, kDestroy };
+
+    template <typename F>
+    static void invokeImpl(void* storage, const ReaderResponse& response) {
+        (*static_cast<F*>(storage))(response);
+    }
+
+    template <typename F>
+    static void manageImpl(Operation operation, void* storage, void* destination) {
+        F* callable = static_cast<F*>(storage);
+        if (operation == kMove) {
+            new (destination) F(std::move(*callable));
+        }
+        callable->~F();
+    }
+
+    void take(CommandCompletion& other) {
+        if (other.manage_) {
+            other.manage_(kMove, &other.storage_, &storage_);
+        }
+        invoke_ = other.invoke_;
+        manage_ = other.manage_;
+        other.invoke_ = NULL;
+        other.manage_ = NULL;
+    }
+
+    void destroy() {
+        if (manage_) {
+            manage_(kDestroy, &storage_, NULL);
+        }
+        invoke_ = NULL;
+        manage_ = NULL;
+    }
+
+    Storage storage_;
+    void (*invoke_)(void* storage, const ReaderResponse& response);
+    void (*manage_)(Operation operation, void* storage, void* destination);
+};
+
+}
+
+#endif
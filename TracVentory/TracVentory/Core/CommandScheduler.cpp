@@ -0,0 +1,88 @@
+//
+//  CommandScheduler.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "CommandScheduler.h"
+
+#include <utility>
+
+namespace flx {
+
+CommandScheduler::CommandScheduler()
+    : inFlightTotal_(0), depth_(1) {
+    for (int priority = 0; priority < kPriorityCount; priority++) {
+        window_[priority] = SIZE_MAX;
+        inFlight_[priority] = 0;
+    }
+}
+
+void CommandScheduler::enqueue(ReaderCommand&& command) {
+    if (command.priority >= kPriorityCount) {
+        command.priority = kPriorityNormal;
+    }
+    queues_[command.priority].push_back(std::move(command));
+}
+
+void CommandScheduler::enqueueFront(ReaderCommand&& command) {
+    if (command.priority >= kPriorityCount) {
+        command.priority = kPriorityNormal;
+    }
+    queues_[command.priority].push_front(std::move(command));
+}
+
+bool CommandScheduler::dequeue(ReaderCommand& command) {
+    if (inFlightTotal_ >= depth_) {
+        return false;
+    }
+    for (int priority = 0; priority < kPriorityCount; priority++) {
+        std::deque<ReaderCommand>& queue = queues_[priority];
+        if (queue.empty() || inFlight_[priority] >= window_[priority]) {
+            continue;
+        }
+        command = std::move(queue.front());
+        queue.pop_front();
+        inFlight_[priority]++;
+        inFlightTotal_++;
+        return true;
+    }
+    return false;
+}
+
+void CommandScheduler::completed(CommandPriority priority) {
+    if (priority < kPriorityCount && inFlight_[priority] > 0) {
+        inFlight_[priority]--;
+        inFlightTotal_--;
+    }
+}
+
+void CommandScheduler::clear() {
+    for (int priority = 0; priority < kPriorityCount; priority++) {
+        queues_[priority].clear();
+        inFlight_[priority] = 0;
+    }
+    inFlightTotal_ = 0;
+}
+
+void CommandScheduler::clear(std::vector<ReaderCommand>& dropped) {
+    for (int priority = 0; priority < kPriorityCount; priority++) {
+        std::deque<ReaderCommand>& queue = queues_[priority];
+        for (size_t i = 0; i < queue.size(); i++) {
+            dropped.push_back(std::move(queue[i]));
+        }
+    }
+    clear();
+}
+
+size_t CommandScheduler::queued() const {
+    size_t count = 0;
+    for (int priority = 0; priority < kPriorityCount; priority++) {
+        count += queues_[priority].size();
+    }
+    return count;
+}
+
+}
@@ -0,0 +1,84 @@
+//
+//  CommandScheduler.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_CommandScheduler_h
+#define TracVentory_CommandScheduler_h
+
+#include "ByteArray.h"
+#include "CommandCompletion.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace flx {
+
+enum CommandPriority : uint8_t {
+    kPriorityInteractive = 0,   // the user is waiting: scan button, tag lookup
+    kPriorityNormal,
+    kPriorityBulk,              // entry drains, memory dumps
+    kPriorityCount
+};
+
+struct ReaderCommand {
+    uint8_t command;
+    CommandPriority priority;
+    ByteArray params;
+    uint8_t retries;                // resends after a transient NACK so far
+    CommandCompletion completion;   // if set, resolves this command instead of the handlers
+};
+
+// CommandScheduler replaces the single FIFO of IDBlueSession with a queue per
+// priority class. Whenever a command completes the next one is taken from
+// the most urgent class that has room, so an interactive scan waits for at
+// most the command already on the wire, never for a queued bulk download.
+//
+// The pipeline depth bounds how many commands are in flight overall (1, as
+// the reader answers one at a time, unless it is known to buffer more); each
+// class also has its own in-flight window, so bulk work can be kept from
+// filling the whole pipeline.
+class CommandScheduler {
+public:
+    CommandScheduler();
+
+    void setPipelineDepth(size_t depth) { depth_ = depth > 0 ? depth : 1; }
+    size_t pipelineDepth() const { return depth_; }
+    void setWindow(CommandPriority priority, size_t window) { window_[priority] = window > 0 ? window : 1; }
+    size_t window(CommandPriority priority) const { return window_[priority]; }
+
+    void enqueue(ReaderCommand&& command);
+    // Queue ahead of the rest of its class, as for a resend
+    void enqueueFront(ReaderCommand&& command);
+
+    // Move the next command that may be sent now into command and count it
+    // as in flight. False if nothing may be sent.
+    bool dequeue(ReaderCommand& command);
+    // A command taken with dequeue() was answered or dropped.
+    void completed(CommandPriority priority);
+
+    void clear();
+    // Move every queued command into dropped, in priority order, and clear.
+    void clear(std::vector<ReaderCommand>& dropped);
+
+    size_t queued() const;
+    size_t queued(CommandPriority priority) const { return queues_[priority].size(); }
+    size_t inFlight() const { return inFlightTotal_; }
+    size_t inFlight(CommandPriority priority) const { return inFlight_[priority]; }
+
+private:
+    std::deque<ReaderCommand> queues_[kPriorityCount];
+    size_t window_[kPriorityCount];
+    size_t inFlight_[kPriorityCount];
+    size_t inFlightTotal_;
+    size_t depth_;
+};
+
+}
+
+#endif
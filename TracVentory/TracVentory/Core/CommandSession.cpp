@@ -0,0 +1,296 @@
+//
+//  CommandSession.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "CommandSession.h"
+#include "CommandTable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace flx {
+
+namespace {
+
+// Far longer than any IDBLUE command takes to answer over Bluetooth
+const uint64_t kDefaultResponseTimeout = 1000000000ull;
+
+uint64_t steadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+CommandSession::CommandSession(Transport& transport)
+    : transport_(transport), responseTimeout_(kDefaultResponseTimeout), clock_(&steadyNanoseconds), nextAsync_(false) {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+void CommandSession::addHandler(ResponseHandler* handler) {
+    if (std::find(handlers_.begin(), handlers_.end(), handler) == handlers_.end()) {
+        handlers_.push_back(handler);
+    }
+}
+
+void CommandSession::removeHandler(ResponseHandler* handler) {
+    handlers_.erase(std::remove(handlers_.begin(), handlers_.end(), handler), handlers_.end());
+}
+
+void CommandSession::send(uint8_t command, const uint8_t* params, size_t length, CommandPriority priority) {
+    send(command, params, length, priority, CommandCompletion());
+}
+
+void CommandSession::send(uint8_t command, const uint8_t* params, size_t length,
+                          CommandPriority priority, CommandCompletion completion) {
+    ReaderCommand queued;
+    queued.command = command;
+    queued.priority = priority;
+    if (length > 0) {
+        queued.params.assign(params, params + length);
+    }
+    queued.retries = 0;
+    queued.completion = std::move(completion);
+    uint16_t status = validateCommand(command, params, length);
+    if (status != kStatusOk) {
+        reject(queued, status);
+        return;
+    }
+    scheduler_.enqueue(std::move(queued));
+    sendNext();
+}
+
+void CommandSession::reset() {
+    std::vector<ReaderCommand> dropped;
+    for (size_t i = 0; i < inFlight_.size(); i++) {
+        dropped.push_back(std::move(inFlight_[i].command));
+    }
+    inFlight_.clear();
+    for (size_t i = 0; i < retries_.size(); i++) {
+        dropped.push_back(std::move(retries_[i].command));
+    }
+    retries_.clear();
+    scheduler_.clear(dropped);
+    framer_.reset();
+    nextAsync_ = false;
+    if (arena_.reset()) {
+        arena_.trim();
+    }
+    // Resolve last: a completion may already queue the next command
+    for (size_t i = 0; i < dropped.size(); i++) {
+        dispose(dropped[i]);
+    }
+}
+
+void CommandSession::dispose(ReaderCommand& command) {
+    if (command.completion) {
+        ReaderResponse response;
+        response.command = command.command;
+        response.status = kStatusDisposing;
+        response.async = false;
+        command.completion.complete(response);
+    }
+}
+
+void CommandSession::reject(ReaderCommand& command, uint16_t status) {
+    stats_.rejected++;
+    ReaderResponse response;
+    response.command = command.command;
+    response.status = status;
+    response.async = false;
+    if (command.completion) {
+        command.completion.complete(response);
+        return;
+    }
+    for (size_t i = 0; i < handlers_.size(); i++) {
+        handlers_[i]->onResponse(command, response);
+    }
+}
+
+// Queue command again if its policy allows another resend for status
+bool CommandSession::retry(ReaderCommand& command, uint16_t status) {
+    if (!isTransientStatus(status)) {
+        stats_.permanentFailures++;
+        return false;
+    }
+    const RetryPolicy& policy = retryPolicies_.get(command.command);
+    if (command.retries >= policy.maxRetries) {
+        if (policy.maxRetries > 0) {
+            stats_.retriesExhausted++;
+        }
+        return false;
+    }
+    command.retries++;
+    stats_.retries++;
+    uint64_t backoff = policy.backoffNanoseconds(command.retries);
+    if (backoff == 0) {
+        scheduler_.enqueueFront(std::move(command));
+    }
+    else {
+        PendingRetry pending;
+        pending.due = clock_() + backoff;
+        pending.command = std::move(command);
+        retries_.push_back(std::move(pending));
+    }
+    return true;
+}
+
+// The response or NACK a command ends with, to its completion or the handlers
+void CommandSession::resolve(ReaderCommand& command, const ReaderResponse& response) {
+    if (command.completion) {
+        stats_.completions++;
+        command.completion.complete(response);
+    }
+    else {
+        for (size_t i = 0; i < handlers_.size(); i++) {
+            handlers_[i]->onResponse(command, response);
+        }
+    }
+}
+
+size_t CommandSession::pollRetries() {
+    uint64_t now = clock_();
+    size_t expired = expireInFlight(now);
+    return resendDue(now) + expired;
+}
+
+// Fail commands the reader has not answered by their deadline, as if it had
+// NACKed them with kStatusTimeout. Sent in order with one timeout, so the
+// oldest is due first.
+size_t CommandSession::expireInFlight(uint64_t now) {
+    size_t expired = 0;
+    while (!inFlight_.empty() && inFlight_.front().deadline != 0 && inFlight_.front().deadline <= now) {
+        ReaderCommand command(std::move(inFlight_.front().command));
+        inFlight_.erase(inFlight_.begin());
+        scheduler_.completed(command.priority);
+        stats_.timeouts++;
+        expired++;
+        if (!retry(command, kStatusTimeout)) {
+            ReaderResponse response;
+            response.command = command.command;
+            response.status = kStatusTimeout;
+            response.async = false;
+            resolve(command, response);
+        }
+    }
+    if (expired > 0) {
+        sendNext();
+    }
+    return expired;
+}
+
+size_t CommandSession::resendDue(uint64_t now) {
+    if (retries_.empty()) {
+        return 0;
+    }
+    size_t due = 0;
+    // Back to front so that, queued at the front, they keep their order
+    for (size_t i = retries_.size(); i-- > 0; ) {
+        if (retries_[i].due <= now) {
+            scheduler_.enqueueFront(std::move(retries_[i].command));
+            retries_.erase(retries_.begin() + i);
+            due++;
+        }
+    }
+    if (due > 0) {
+        sendNext();
+    }
+    return due;
+}
+
+uint64_t CommandSession::nextRetryAt() const {
+    uint64_t next = 0;
+    for (size_t i = 0; i < retries_.size(); i++) {
+        if (next == 0 || retries_[i].due < next) {
+            next = retries_[i].due;
+        }
+    }
+    if (!inFlight_.empty() && inFlight_.front().deadline != 0 &&
+        (next == 0 || inFlight_.front().deadline < next)) {
+        next = inFlight_.front().deadline;
+    }
+    return next;
+}
+
+// Fill whatever room the scheduler has
+void CommandSession::sendNext() {
+    ReaderCommand command;
+    while (scheduler_.dequeue(command)) {
+        uint8_t packet[kMaxPacketSize];
+        size_t size = encodePacket(command.command, command.params.data(), command.params.size(), packet);
+        if (size == 0) {
+            // Cannot be framed; nothing will ever answer it
+            scheduler_.completed(command.priority);
+            dispose(command);
+            continue;
+        }
+        InFlight sent;
+        sent.deadline = responseTimeout_ > 0 ? clock_() + responseTimeout_ : 0;
+        sent.command = std::move(command);
+        inFlight_.push_back(std::move(sent));
+        stats_.commandsSent++;
+        transport_.write(packet, size);
+    }
+}
+
+void CommandSession::onDataReceived(const uint8_t* data, size_t length) {
+    resendDue(clock_());
+    framer_.feed(data, length, [this](const PacketView& packet) {
+        dispatch(packet);
+    });
+    // The burst is over; handlers only borrow responses, so nothing should
+    // still live in the arena.
+    arena_.reset();
+    // After the burst: it may have held the answer
+    expireInFlight(clock_());
+}
+
+void CommandSession::dispatch(const PacketView& packet) {
+    if (packet.header == kCmdAsyncPacket && packet.payloadLength == 0) {
+        nextAsync_ = true;
+        return;
+    }
+    bool async = nextAsync_;
+    nextAsync_ = false;
+
+    ArenaPtr<ReaderResponse> response = factory_.createResponse(packet, async, arena_);
+    if (!response) {
+        return;
+    }
+
+    if (async) {
+        stats_.asyncResponses++;
+        for (size_t i = 0; i < handlers_.size(); i++) {
+            handlers_[i]->onAsyncResponse(*response);
+        }
+        return;
+    }
+
+    if (inFlight_.empty() || inFlight_.front().command.command != response->command) {
+        stats_.unmatched++;
+        return;
+    }
+
+    stats_.responses++;
+    ReaderCommand command(std::move(inFlight_.front().command));
+    inFlight_.erase(inFlight_.begin());
+    scheduler_.completed(command.priority);
+    if (response->status != kStatusOk) {
+        stats_.nacks++;
+        if (retry(command, response->status)) {
+            sendNext();
+            return;
+        }
+    }
+
+    resolve(command, *response);
+    sendNext();
+}
+
+}
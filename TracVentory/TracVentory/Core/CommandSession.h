@@ -0,0 +1,156 @@
+//
+//  CommandSession.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_CommandSession_h
+#define TracVentory_CommandSession_h
+
+#include "Arena.h"
+#include "CommandScheduler.h"
+#include "PacketFramer.h"
+#include "ReaderProtocol.h"
+#include "RetryPolicy.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace flx {
+
+// Where a session writes command packets: the accessory stream on a device,
+// a socket, or a LoopbackDevice.
+class Transport {
+public:
+    virtual ~Transport() {}
+    virtual void write(const uint8_t* data, size_t length) = 0;
+};
+
+// The IResponseHandler of the portable stack. Every registered handler sees
+// every response to commands sent without a completion, as in the SDK.
+class ResponseHandler {
+public:
+    virtual ~ResponseHandler() {}
+    // A response to a queued command, or its NACK (status != kStatusOk)
+    virtual void onResponse(const ReaderCommand& command, const ReaderResponse& response) = 0;
+    // A response the reader sent on its own (button press, continuous scan)
+    virtual void onAsyncResponse(const ReaderResponse& response) = 0;
+};
+
+struct SessionStats {
+    uint64_t commandsSent;
+    uint64_t responses;
+    uint64_t asyncResponses;
+    uint64_t nacks;
+    uint64_t completions;       // responses resolved by a completion rather than the handlers
+    uint64_t retries;           // resends after a transient NACK or a timeout
+    uint64_t retriesExhausted;  // transient NACKs reported after the last resend
+    uint64_t permanentFailures; // NACKs no resend could cure, reported at once
+    uint64_t timeouts;          // commands the reader did not answer in time
+    uint64_t rejected;          // never sent: the CommandTable does not allow them
+    uint64_t unmatched;         // responses that answer no queued command
+};
+
+// CommandSession is the portable counterpart of IDBlueSession and its
+// IDBlueResponseProcessor: commands are queued by priority (see
+// CommandScheduler) and answered in the order sent, incoming bytes are
+// framed, turned into responses by a ResponseFactory and dispatched to the
+// handlers. A command NACKed with a transient status is resent as its
+// RetryPolicy allows before anyone sees the NACK; so is one the reader has
+// not answered within the response timeout, which fails as kStatusTimeout
+// rather than holding the pipeline. Responses are built in a per-session
+// arena that is reset whenever a chunk of input has been fully dispatched,
+// so a continuous scan does not touch the heap per response. Not thread
+// safe.
+class CommandSession {
+public:
+    explicit CommandSession(Transport& transport);
+
+    void addHandler(ResponseHandler* handler);
+    void removeHandler(ResponseHandler* handler);
+
+    // Queue a command; it is written once the scheduler gives it a slot. A
+    // command or payload the CommandTable does not allow is answered at once
+    // with the NACK the reader would send (kStatusInvalidCommand or
+    // kStatusInvalidValue).
+    void send(uint8_t command, const uint8_t* params = NULL, size_t length = 0,
+              CommandPriority priority = kPriorityNormal);
+    // Queue a command resolved by its own completion: it is called once with
+    // the response or NACK to this command, and no handler sees either. If
+    // the session is reset first it is called with kStatusDisposing.
+    void send(uint8_t command, const uint8_t* params, size_t length,
+              CommandPriority priority, CommandCompletion completion);
+
+    // Feed bytes received from the reader.
+    void onDataReceived(const uint8_t* data, size_t length);
+
+    // Resends wait out their backoff and sent commands their response
+    // deadline; the owner calls pollRetries() when nextRetryAt() (monotonic
+    // nanoseconds, 0 if none) comes around. Data arriving also sends any
+    // resends that are due and fails commands past their deadline.
+    void setRetryPolicy(uint8_t command, const RetryPolicy& policy) { retryPolicies_.set(command, policy); }
+    const RetryPolicy& retryPolicy(uint8_t command) const { return retryPolicies_.get(command); }
+    size_t pollRetries();
+    uint64_t nextRetryAt() const;
+    size_t pendingRetries() const { return retries_.size(); }
+    // How long a sent command waits for its response (default 1 s; 0 waits
+    // for ever). A response arriving after its command timed out answers
+    // the resend, or is counted as unmatched.
+    void setResponseTimeout(uint64_t nanoseconds) { responseTimeout_ = nanoseconds; }
+    uint64_t responseTimeout() const { return responseTimeout_; }
+    // Monotonic nanoseconds; steady_clock unless replaced (tests, replay)
+    void setClock(uint64_t (*clock)()) { clock_ = clock; }
+
+    // Drop queued commands and buffered input, as when the session closes.
+    // Completions of dropped commands are resolved with kStatusDisposing.
+    void reset();
+
+    CommandScheduler& scheduler() { return scheduler_; }
+    size_t queuedCommands() const { return scheduler_.queued(); }
+    bool awaitingResponse() const { return !inFlight_.empty() || !retries_.empty(); }
+    const SessionStats& stats() const { return stats_; }
+    const ArenaStats& arenaStats() const { return arena_.stats(); }
+
+private:
+    CommandSession(const CommandSession&);
+    CommandSession& operator=(const CommandSession&);
+
+    void sendNext();
+    void dispose(ReaderCommand& command);
+    void reject(ReaderCommand& command, uint16_t status);
+    bool retry(ReaderCommand& command, uint16_t status);
+    void resolve(ReaderCommand& command, const ReaderResponse& response);
+    size_t resendDue(uint64_t now);
+    size_t expireInFlight(uint64_t now);
+
+    struct PendingRetry {
+        uint64_t due;
+        ReaderCommand command;
+    };
+    struct InFlight {
+        uint64_t deadline;          // 0: no timeout
+        ReaderCommand command;
+    };
+    void dispatch(const PacketView& packet);
+
+    Transport& transport_;
+    Arena arena_;
+    PacketFramer framer_;
+    ResponseFactory factory_;
+    CommandScheduler scheduler_;
+    std::vector<InFlight> inFlight_;        // in the order sent; at most the pipeline depth
+    std::vector<PendingRetry> retries_;
+    RetryPolicyTable retryPolicies_;
+    uint64_t responseTimeout_;
+    uint64_t (*clock_)();
+    std::vector<ResponseHandler*> handlers_;
+    bool nextAsync_;
+    SessionStats stats_;
+};
+
+}
+
+#endif
@@ -0,0 +1,49 @@
+//
+//  CommandTable.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "CommandTable.h"
+
+namespace flx {
+
+constexpr CommandDescriptor CommandTable::rows[];
+constexpr size_t CommandTable::kCount;
+constexpr uint8_t CommandTable::kNoRow;
+
+namespace {
+
+// Every row's command finds that row: no command is listed twice
+constexpr bool unique(size_t row = 0) {
+    return row == CommandTable::kCount || (CommandTable::find(CommandTable::rows[row].command) == row && unique(row + 1));
+}
+
+constexpr bool wellFormed(size_t row = 0) {
+    return row == CommandTable::kCount ||
+           (CommandTable::rows[row].minPayload <= CommandTable::rows[row].maxPayload &&
+            (!CommandTable::rows[row].has(kCommandBoolean) || CommandTable::rows[row].maxPayload == 1) &&
+            wellFormed(row + 1));
+}
+
+static_assert(CommandTable::kCount < CommandTable::kNoRow, "Too many rows for a byte index");
+static_assert(unique(), "A command is listed twice");
+static_assert(wellFormed(), "A row's payload sizes are inconsistent");
+static_assert(detail::CommandIndex::rows[kCmdGetEntry] == CommandTable::find(kCmdGetEntry), "Index out of step with the table");
+
+}
+
+uint16_t validateCommand(uint8_t command, const uint8_t* params, size_t length) {
+    const CommandDescriptor* descriptor = CommandTable::describe(command);
+    if (!descriptor || descriptor->has(kCommandFromReader)) {
+        return kStatusInvalidCommand;
+    }
+    if (!descriptor->accepts(length) || (descriptor->has(kCommandBoolean) && params[0] > 1)) {
+        return kStatusInvalidValue;
+    }
+    return kStatusOk;
+}
+
+}
@@ -0,0 +1,197 @@
+//
+//  CommandTable.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_CommandTable_h
+#define TracVentory_CommandTable_h
+
+#include "PacketFramer.h"
+#include "ReaderProtocol.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flx {
+
+// What the payload of a response holds, and so how it is parsed
+enum ResponseShape : uint8_t {
+    kResponseEmpty,     // nothing the stack looks at
+    kResponseData,      // opaque bytes (property values, names, UHF data)
+    kResponseCount,     // 2-byte big-endian count
+    kResponseBlocks,    // first block, block count, block data
+    kResponseTagRead    // tag id length, tag id, timestamp
+};
+
+enum CommandFlags : uint8_t {
+    kCommandRetriable = 0x01,   // reads or sets state; safe to resend
+    kCommandBoolean = 0x02,     // the one payload byte is 0 or 1
+    kCommandUnsolicited = 0x04, // the reader also sends its response on its own
+    kCommandFromReader = 0x08   // never sent by the host
+};
+
+const uint8_t kVariablePayload = static_cast<uint8_t>(kMaxPayloadSize);
+
+// One command of the IDBLUE protocol: the payload sizes it accepts, the
+// command its response carries and how that response is parsed. The
+// SDK spreads this over a command class per layout (ByteCommand,
+// UShortCommand, ReadBlocksCommand, ...) and response classes registered
+// with ResponseFactory at run time; here it is one row.
+struct CommandDescriptor {
+    uint8_t command;
+    const char* name;
+    uint8_t minPayload;
+    uint8_t maxPayload;         // kVariablePayload: up to a full packet
+    uint8_t response;           // command id of the answer
+    ResponseShape shape;
+    uint8_t minResponse;        // shorter answers are malformed
+    uint8_t flags;
+
+    constexpr bool fixedPayload() const { return minPayload == maxPayload; }
+    constexpr bool accepts(size_t length) const { return length >= minPayload && length <= maxPayload; }
+    constexpr bool has(CommandFlags flag) const { return (flags & flag) != 0; }
+};
+
+// CommandTable is the protocol in one place. The encoders below check
+// payload sizes against it at compile time, validateCommand() and the
+// ResponseFactory consult it with one indexed load per packet, and the
+// retry policy takes its retriable commands from it. Adding a command is
+// adding a row; the static_asserts in CommandTable.cpp reject a duplicate
+// or malformed one.
+struct CommandTable {
+    static constexpr CommandDescriptor rows[] = {
+        // command                name                  payload               response               shape             resp  flags
+        { kCmdNoOp,               "NoOp",               0, 0,                 kCmdNoOp,              kResponseEmpty,   0, kCommandRetriable },
+        { kCmdGetTagId,           "GetTagId",           0, 0,                 kCmdGetTagId,          kResponseTagRead, 1 + kTimestampSize, kCommandRetriable | kCommandUnsolicited },
+        { kCmdBeep,               "Beep",               1, 1,                 kCmdBeep,              kResponseEmpty,   0, 0 },
+        { kCmdSetProperty,        "SetProperty",        3, kVariablePayload,  kCmdSetProperty,       kResponseData,    0, kCommandRetriable },
+        { kCmdGetProperty,        "GetProperty",        2, 2,                 kCmdGetProperty,       kResponseData,    0, kCommandRetriable },
+        { kCmdSaveProperties,     "SaveProperties",     0, 0,                 kCmdSaveProperties,    kResponseEmpty,   0, 0 },
+        { kCmdLoadProperties,     "LoadProperties",     0, 0,                 kCmdLoadProperties,    kResponseEmpty,   0, 0 },
+        { kCmdReadBlock,          "ReadBlock",          1, kVariablePayload,  kCmdReadBlock,         kResponseBlocks,  2, kCommandRetriable | kCommandUnsolicited },
+        { kCmdReadBlocks,         "ReadBlocks",         2, kVariablePayload,  kCmdReadBlocks,        kResponseBlocks,  2, kCommandRetriable | kCommandUnsolicited },
+        { kCmdWriteBlock,         "WriteBlock",         2, kVariablePayload,  kCmdWriteBlock,        kResponseEmpty,   0, kCommandUnsolicited },
+        { kCmdWriteBlocks,        "WriteBlocks",        3, kVariablePayload,  kCmdWriteBlocks,       kResponseEmpty,   0, kCommandUnsolicited },
+        { kCmdGetTagInfo,         "GetTagInfo",         0, kVariablePayload,  kCmdGetTagInfo,        kResponseData,    0, kCommandRetriable },
+        { kCmdLockBlock,          "LockBlock",          1, kVariablePayload,  kCmdLockBlock,         kResponseEmpty,   0, 0 },
+        { kCmdNack,               "Nack",               3, kVariablePayload,  kCmdNack,              kResponseData,    3, kCommandFromReader },
+        { kCmdGetStatus,          "GetStatus",          0, 0,                 kCmdGetStatus,         kResponseData,    0, kCommandRetriable },
+        { kCmdSetScanning,        "SetScanning",        1, 1,                 kCmdSetScanning,       kResponseEmpty,   0, kCommandRetriable | kCommandBoolean },
+        { kCmdWriteUhf,           "WriteUhf",           1, kVariablePayload,  kCmdWriteUhf,          kResponseData,    0, 0 },
+        { kCmdReadUhf,            "ReadUhf",            1, kVariablePayload,  kCmdReadUhf,           kResponseData,    0, kCommandRetriable },
+        { kCmdLockUhf,            "LockUhf",            1, kVariablePayload,  kCmdLockUhf,           kResponseData,    0, 0 },
+        { kCmdSetKillPassword,    "SetKillPassword",    1, kVariablePayload,  kCmdSetKillPassword,   kResponseData,    0, 0 },
+        { kCmdKill,               "Kill",               1, kVariablePayload,  kCmdKill,              kResponseData,    0, 0 },
+        { kCmdBootloaderMode,     "BootloaderMode",     0, 0,                 kCmdBootloaderMode,    kResponseEmpty,   0, 0 },
+        { kCmdSetBluetoothPin,    "SetBluetoothPin",    1, kVariablePayload,  kCmdSetBluetoothPin,   kResponseEmpty,   0, 0 },
+        { kCmdGetBluetoothPin,    "GetBluetoothPin",    0, 0,                 kCmdGetBluetoothPin,   kResponseData,    0, kCommandRetriable },
+        { kCmdSetBluetoothName,   "SetBluetoothName",   1, kVariablePayload,  kCmdSetBluetoothName,  kResponseEmpty,   0, 0 },
+        { kCmdGetBluetoothName,   "GetBluetoothName",   0, 0,                 kCmdGetBluetoothName,  kResponseData,    0, kCommandRetriable },
+        { kCmdBootloaderActive,   "BootloaderActive",   0, 0,                 kCmdBootloaderActive,  kResponseData,    0, 0 },
+        { kCmdGetEntryCount,      "GetEntryCount",      0, 0,                 kCmdGetEntryCount,     kResponseCount,   2, kCommandRetriable },
+        { kCmdGetEntry,           "GetEntry",           2, 2,                 kCmdGetEntry,          kResponseTagRead, 1 + kTimestampSize, kCommandRetriable },
+        { kCmdClearEntries,       "ClearEntries",       0, 0,                 kCmdClearEntries,      kResponseEmpty,   0, 0 },
+        { kCmdAsyncPacket,        "AsyncPacket",        0, 0,                 kCmdAsyncPacket,       kResponseEmpty,   0, kCommandFromReader },
+        { kCmdFactoryReset,       "FactoryReset",       0, 0,                 kCmdFactoryReset,      kResponseEmpty,   0, 0 },
+        { kCmdBeginCommands,      "BeginCommands",      0, 0,                 kCmdBeginCommands,     kResponseEmpty,   0, 0 },
+        { kCmdEndCommands,        "EndCommands",        0, 0,                 kCmdEndCommands,       kResponseEmpty,   0, 0 },
+        { kCmdPowerDown,          "PowerDown",          0, 0,                 kCmdPowerDown,         kResponseEmpty,   0, 0 },
+        { kCmdTurnOffBluetooth,   "TurnOffBluetooth",   0, 0,                 kCmdTurnOffBluetooth,  kResponseEmpty,   0, 0 },
+        { kCmdTurnOnBluetooth,    "TurnOnBluetooth",    0, 0,                 kCmdTurnOnBluetooth,   kResponseEmpty,   0, 0 },
+        { kCmdHeartbeat,          "Heartbeat",          0, 0,                 kCmdHeartbeat,         kResponseEmpty,   0, kCommandRetriable },
+        { kCmdEnableChannel,      "EnableChannel",      1, 1,                 kCmdEnableChannel,     kResponseEmpty,   0, kCommandBoolean },
+        { kCmdButton,             "Button",             0, 0,                 kCmdButton,            kResponseEmpty,   0, kCommandFromReader | kCommandUnsolicited }
+    };
+    static constexpr size_t kCount = sizeof(rows) / sizeof(rows[0]);
+    static constexpr uint8_t kNoRow = 0xFF;
+
+    // Row of command, or kNoRow; usable in constant expressions
+    static constexpr uint8_t find(uint8_t command, size_t row = 0) {
+        return row == kCount ? kNoRow : rows[row].command == command ? static_cast<uint8_t>(row) : find(command, row + 1);
+    }
+
+    static constexpr bool accepts(uint8_t command, size_t length) {
+        return find(command) != kNoRow && !rows[find(command)].has(kCommandFromReader) && rows[find(command)].accepts(length);
+    }
+
+    // The descriptor of command, or NULL: one load from a 256-entry index
+    // built at compile time
+    static const CommandDescriptor* describe(uint8_t command);
+};
+
+namespace detail {
+
+// The index: slot c holds the row of command c. C++11 has no
+// std::index_sequence, so the 256 slots are spelled out by recursion.
+template <size_t... I>
+struct CommandSlots {
+    static constexpr uint8_t rows[sizeof...(I)] = { CommandTable::find(static_cast<uint8_t>(I))... };
+};
+
+template <size_t... I>
+constexpr uint8_t CommandSlots<I...>::rows[sizeof...(I)];
+
+template <size_t N, size_t... I>
+struct MakeCommandSlots : MakeCommandSlots<N - 1, N - 1, I...> {};
+
+template <size_t... I>
+struct MakeCommandSlots<0, I...> {
+    typedef CommandSlots<I...> type;
+};
+
+typedef MakeCommandSlots<256>::type CommandIndex;
+
+}
+
+inline const CommandDescriptor* CommandTable::describe(uint8_t command) {
+    uint8_t row = detail::CommandIndex::rows[command];
+    return row == kNoRow ? NULL : &rows[row];
+}
+
+// kStatusOk, or the status the reader would NACK the command with:
+// kStatusInvalidCommand for an unknown or reader-only command,
+// kStatusInvalidValue for a payload the command does not take.
+uint16_t validateCommand(uint8_t command, const uint8_t* params, size_t length);
+
+// Packet builders whose payload size is checked against the table when
+// they compile, for the fixed layouts of the SDK's SimpleCommand,
+// ByteCommand, BooleanCommand and UShortCommand.
+template <uint8_t Command>
+size_t encodeCommand(uint8_t* out) {
+    static_assert(CommandTable::accepts(Command, 0), "Command takes a payload");
+    return encodePacket(Command, NULL, 0, out);
+}
+
+template <uint8_t Command, size_t N>
+size_t encodeCommand(const uint8_t (&params)[N], uint8_t* out) {
+    static_assert(CommandTable::accepts(Command, N), "Payload size does not fit the command");
+    return encodePacket(Command, params, N, out);
+}
+
+template <uint8_t Command>
+size_t encodeByteCommand(uint8_t value, uint8_t* out) {
+    static_assert(CommandTable::accepts(Command, 1), "Command does not take one byte");
+    return encodePacket(Command, &value, 1, out);
+}
+
+template <uint8_t Command>
+size_t encodeBooleanCommand(bool value, uint8_t* out) {
+    static_assert(CommandTable::find(Command) != CommandTable::kNoRow &&
+                  CommandTable::rows[CommandTable::find(Command)].has(kCommandBoolean), "Command is not boolean");
+    uint8_t byte = value ? 1 : 0;
+    return encodePacket(Command, &byte, 1, out);
+}
+
+template <uint8_t Command>
+size_t encodeUShortCommand(uint16_t value, uint8_t* out) {
+    static_assert(CommandTable::accepts(Command, 2), "Command does not take a 16-bit value");
+    uint8_t params[2] = { static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value) };
+    return encodePacket(Command, params, sizeof(params), out);
+}
+
+}
+
+#endif
@@ -0,0 +1,242 @@
+//
+//  EpcDecoder.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "EpcDecoder.h"
+
+#include <cstddef>
+
+namespace flx {
+
+namespace {
+
+// One row of a partition table: how the 44 (or 82) bits after the header,
+// filter and partition split between company prefix and reference
+struct PartitionRow {
+    uint8_t companyBits;
+    uint8_t companyDigits;
+    uint8_t referenceBits;
+    uint8_t referenceDigits;
+};
+
+struct SchemeLayout {
+    const PartitionRow* partitions;
+    uint8_t serialBits;
+    bool paddedReference;       // reference printed at fixed width
+};
+
+const PartitionRow kSgtinPartitions[7] = {
+    { 40, 12, 4, 1 }, { 37, 11, 7, 2 }, { 34, 10, 10, 3 }, { 30, 9, 14, 4 },
+    { 27, 8, 17, 5 }, { 24, 7, 20, 6 }, { 20, 6, 24, 7 }
+};
+const PartitionRow kGraiPartitions[7] = {
+    { 40, 12, 4, 0 }, { 37, 11, 7, 1 }, { 34, 10, 10, 2 }, { 30, 9, 14, 3 },
+    { 27, 8, 17, 4 }, { 24, 7, 20, 5 }, { 20, 6, 24, 6 }
+};
+const PartitionRow kGiaiPartitions[7] = {
+    { 40, 12, 42, 13 }, { 37, 11, 45, 14 }, { 34, 10, 48, 15 }, { 30, 9, 52, 16 },
+    { 27, 8, 55, 17 }, { 24, 7, 58, 18 }, { 20, 6, 62, 19 }
+};
+
+const SchemeLayout kSgtinLayout = { kSgtinPartitions, 38, true };
+const SchemeLayout kGraiLayout = { kGraiPartitions, 38, true };
+const SchemeLayout kGiaiLayout = { kGiaiPartitions, 0, false };
+
+const uint64_t kPowersOf10[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+// Header, filter and partition
+const unsigned kFieldsOffset = 14;
+
+const SchemeLayout* layoutFor(uint8_t header) {
+    switch (header) {
+        case kEpcSgtin96: return &kSgtinLayout;
+        case kEpcGrai96: return &kGraiLayout;
+        case kEpcGiai96: return &kGiaiLayout;
+        default: return NULL;
+    }
+}
+
+// The 96 bits as a 64-bit high word and a 32-bit low word
+struct Bits96 {
+    uint64_t high;
+    uint32_t low;
+
+    uint64_t field(unsigned offset, unsigned width) const {
+        if (width == 0) {
+            return 0;
+        }
+        unsigned end = offset + width;
+        uint64_t mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+        if (end <= 64) {
+            return (high >> (64 - end)) & mask;
+        }
+        if (offset >= 64) {
+            return (static_cast<uint64_t>(low) >> (96 - end)) & mask;
+        }
+        return ((high << (end - 64)) | (static_cast<uint64_t>(low) >> (96 - end))) & mask;
+    }
+
+    void set(unsigned offset, unsigned width, uint64_t value) {
+        for (unsigned i = 0; i < width; i++) {
+            unsigned bit = offset + width - 1 - i;
+            uint64_t one = (value >> i) & 1;
+            if (bit < 64) {
+                high |= one << (63 - bit);
+            }
+            else {
+                low |= static_cast<uint32_t>(one << (95 - bit));
+            }
+        }
+    }
+};
+
+char* putDecimal(uint64_t value, unsigned width, char* out, char* end) {
+    char digits[20];
+    unsigned count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (count < width && count < sizeof(digits)) {
+        digits[count++] = '0';
+    }
+    if (out == NULL || end - out < static_cast<ptrdiff_t>(count)) {
+        return NULL;
+    }
+    while (count > 0) {
+        *out++ = digits[--count];
+    }
+    return out;
+}
+
+char* putText(const char* text, char* out, char* end) {
+    for (; out && *text; text++) {
+        if (out == end) {
+            return NULL;
+        }
+        *out++ = *text;
+    }
+    return out;
+}
+
+}
+
+bool decodeEpc(const uint8_t* bytes, size_t length, Epc& epc) {
+    if (length != kEpc96Size) {
+        return false;
+    }
+    const SchemeLayout* layout = layoutFor(bytes[0]);
+    if (!layout) {
+        return false;
+    }
+    Bits96 bits;
+    bits.high = 0;
+    for (int i = 0; i < 8; i++) {
+        bits.high = (bits.high << 8) | bytes[i];
+    }
+    bits.low = (static_cast<uint32_t>(bytes[8]) << 24) | (bytes[9] << 16) | (bytes[10] << 8) | bytes[11];
+
+    uint8_t partition = static_cast<uint8_t>(bits.field(11, 3));
+    if (partition > 6) {
+        return false;
+    }
+    const PartitionRow& row = layout->partitions[partition];
+    epc.scheme = static_cast<EpcScheme>(bytes[0]);
+    epc.filter = static_cast<uint8_t>(bits.field(8, 3));
+    epc.partition = partition;
+    epc.companyDigits = row.companyDigits;
+    epc.referenceDigits = layout->paddedReference ? row.referenceDigits : 0;
+    epc.companyPrefix = bits.field(kFieldsOffset, row.companyBits);
+    epc.reference = bits.field(kFieldsOffset + row.companyBits, row.referenceBits);
+    epc.serial = bits.field(kFieldsOffset + row.companyBits + row.referenceBits, layout->serialBits);
+
+    // A field holding more digits than the partition allows is not GS1
+    return epc.companyPrefix < kPowersOf10[row.companyDigits] &&
+           epc.reference < kPowersOf10[row.referenceDigits];
+}
+
+bool encodeEpc(const Epc& epc, uint8_t* out) {
+    const SchemeLayout* layout = layoutFor(epc.scheme);
+    if (!layout || epc.partition > 6 || epc.filter > 7) {
+        return false;
+    }
+    const PartitionRow& row = layout->partitions[epc.partition];
+    if (epc.companyPrefix >= kPowersOf10[row.companyDigits] || epc.reference >= kPowersOf10[row.referenceDigits] ||
+        (layout->serialBits < 64 && epc.serial >> layout->serialBits)) {
+        return false;
+    }
+    Bits96 bits = { 0, 0 };
+    bits.set(0, 8, epc.scheme);
+    bits.set(8, 3, epc.filter);
+    bits.set(11, 3, epc.partition);
+    bits.set(kFieldsOffset, row.companyBits, epc.companyPrefix);
+    bits.set(kFieldsOffset + row.companyBits, row.referenceBits, epc.reference);
+    bits.set(kFieldsOffset + row.companyBits + row.referenceBits, layout->serialBits, epc.serial);
+    for (int i = 0; i < 8; i++) {
+        out[i] = static_cast<uint8_t>(bits.high >> (56 - i * 8));
+    }
+    for (int i = 0; i < 4; i++) {
+        out[8 + i] = static_cast<uint8_t>(bits.low >> (24 - i * 8));
+    }
+    return true;
+}
+
+size_t formatEpcUri(const Epc& epc, char* out, size_t capacity) {
+    const char* scheme;
+    switch (epc.scheme) {
+        case kEpcSgtin96: scheme = "urn:epc:id:sgtin:"; break;
+        case kEpcGrai96: scheme = "urn:epc:id:grai:"; break;
+        case kEpcGiai96: scheme = "urn:epc:id:giai:"; break;
+        default: return 0;
+    }
+    if (capacity == 0) {
+        return 0;
+    }
+    char* end = out + capacity - 1;
+    char* next = putText(scheme, out, end);
+    next = putDecimal(epc.companyPrefix, epc.companyDigits, next, end);
+    next = putText(".", next, end);
+    // GRAI-96 with a 12-digit company prefix has no asset type digits: the
+    // field is empty, not "0". GIAI's width 0 means unpadded.
+    if (epc.referenceDigits > 0 || epc.scheme == kEpcGiai96) {
+        next = putDecimal(epc.reference, epc.referenceDigits, next, end);
+    }
+    if (epc.scheme != kEpcGiai96) {
+        next = putText(".", next, end);
+        next = putDecimal(epc.serial, 0, next, end);
+    }
+    if (!next) {
+        return 0;
+    }
+    *next = '\0';
+    return static_cast<size_t>(next - out);
+}
+
+uint64_t epcGtin(const Epc& epc) {
+    if (epc.scheme != kEpcSgtin96 || epc.referenceDigits == 0) {
+        return 0;
+    }
+    // The item reference leads with the indicator digit, which leads the GTIN
+    uint64_t scale = kPowersOf10[epc.referenceDigits - 1];
+    uint64_t indicator = epc.reference / scale;
+    uint64_t rest = epc.reference % scale;
+    uint64_t gtin = indicator * kPowersOf10[12] + epc.companyPrefix * kPowersOf10[12 - epc.companyDigits] + rest;
+
+    unsigned sum = 0;
+    uint64_t digits = gtin;
+    for (unsigned i = 0; i < 13; i++, digits /= 10) {
+        sum += static_cast<unsigned>(digits % 10) * (i % 2 == 0 ? 3 : 1);
+    }
+    return gtin * 10 + (10 - sum % 10) % 10;
+}
+
+}
@@ -0,0 +1,60 @@
+//
+//  EpcDecoder.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_EpcDecoder_h
+#define TracVentory_EpcDecoder_h
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flx {
+
+// EPC header values of the 96-bit GS1 schemes we tag stock with
+enum EpcScheme : uint8_t {
+    kEpcUnknown = 0x00,
+    kEpcSgtin96 = 0x30,     // trade item: GTIN and serial
+    kEpcGrai96 = 0x33,      // returnable asset: asset type and serial
+    kEpcGiai96 = 0x34       // individual asset: asset reference
+};
+
+const size_t kEpc96Size = 12;
+
+// The fields of a decoded EPC. reference is the SGTIN item reference (with
+// its indicator digit), the GRAI asset type or the GIAI individual asset
+// reference; serial is 0 for GIAI.
+struct Epc {
+    EpcScheme scheme;
+    uint8_t filter;
+    uint8_t partition;
+    uint8_t companyDigits;
+    uint8_t referenceDigits;    // fixed width; 0 for GIAI (no leading zeros)
+    uint64_t companyPrefix;
+    uint64_t reference;
+    uint64_t serial;
+};
+
+// Decode SGTIN-96, GRAI-96 or GIAI-96 straight from the tag bytes (EPC bank,
+// most significant byte first), with the partition tables of the GS1 Tag
+// Data Standard. False for any other header, a length other than 12 or
+// fields that are out of range.
+bool decodeEpc(const uint8_t* bytes, size_t length, Epc& epc);
+
+// The 12 tag bytes of epc; false if a field does not fit its partition.
+bool encodeEpc(const Epc& epc, uint8_t* out);
+
+// The pure identity URI, e.g. urn:epc:id:giai:0614141.12345400: the same
+// for every tag of the asset whatever its filter value. Returns the length
+// written (NUL terminated), 0 if it does not fit in capacity.
+size_t formatEpcUri(const Epc& epc, char* out, size_t capacity);
+
+// GTIN-14 of an SGTIN, check digit included; 0 for other schemes.
+uint64_t epcGtin(const Epc& epc);
+
+}
+
+#endif
@@ -0,0 +1,258 @@
+//
+//  GeoIndex.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "GeoIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace flx {
+
+namespace {
+
+const double kEarthRadiusMeters = 6371008.8;
+const double kRadiansPerDegree = 3.14159265358979323846 / 180.0;
+
+// Bits per axis of the first cells looked at: about 600 m of longitude at
+// the equator, the size of a site. Each coarser step quarters the number of
+// cells.
+const int kFinestLevel = 16;
+const int kLevelStep = 2;
+
+const double kUnbounded = std::numeric_limits<double>::infinity();
+
+// Spread the bits of v into the even bits of the result
+uint64_t spreadBits(uint32_t v) {
+    uint64_t x = v;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2)) & 0x3333333333333333ULL;
+    x = (x | (x << 1)) & 0x5555555555555555ULL;
+    return x;
+}
+
+uint64_t interleave(uint32_t x, uint32_t y) {
+    return (spreadBits(x) << 1) | spreadBits(y);
+}
+
+bool validCoordinate(double latitude, double longitude) {
+    return latitude >= -90.0 && latitude <= 90.0 && longitude >= -180.0 && longitude <= 180.0;
+}
+
+// 180 is the same meridian as -180
+double wrapLongitude(double longitude) {
+    return longitude >= 180.0 ? longitude - 360.0 : longitude;
+}
+
+void unitVector(double latitude, double longitude, double* unit) {
+    double phi = latitude * kRadiansPerDegree;
+    double lambda = longitude * kRadiansPerDegree;
+    unit[0] = std::cos(phi) * std::cos(lambda);
+    unit[1] = std::cos(phi) * std::sin(lambda);
+    unit[2] = std::sin(phi);
+}
+
+// Squared chord of a great circle distance, and back
+double chord2(double meters) {
+    if (meters >= 3.14159265358979323846 * kEarthRadiusMeters) {
+        return kUnbounded;
+    }
+    double half = std::sin(meters / kEarthRadiusMeters / 2);
+    return 4 * half * half;
+}
+
+double chordMeters(double chord2) {
+    return 2 * kEarthRadiusMeters * std::asin(std::min(1.0, std::sqrt(chord2) / 2));
+}
+
+uint32_t quantizeLatitude(double latitude) {
+    double q = (latitude + 90.0) / 180.0 * 4294967296.0;
+    return q >= 4294967295.0 ? 0xFFFFFFFFU : static_cast<uint32_t>(q);
+}
+
+uint32_t quantizeLongitude(double longitude) {
+    double q = (wrapLongitude(longitude) + 180.0) / 360.0 * 4294967296.0;
+    return q >= 4294967295.0 ? 0xFFFFFFFFU : static_cast<uint32_t>(q);
+}
+
+}
+
+GeoIndex::GeoIndex() : cellsVisited_(0) {
+}
+
+double GeoIndex::distanceMeters(double latitude1, double longitude1,
+                                double latitude2, double longitude2) {
+    double sinLatitude = std::sin((latitude2 - latitude1) * kRadiansPerDegree / 2);
+    double sinLongitude = std::sin((longitude2 - longitude1) * kRadiansPerDegree / 2);
+    double a = sinLatitude * sinLatitude +
+               std::cos(latitude1 * kRadiansPerDegree) * std::cos(latitude2 * kRadiansPerDegree) *
+               sinLongitude * sinLongitude;
+    return 2 * kEarthRadiusMeters * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+uint64_t GeoIndex::geohash(double latitude, double longitude) {
+    return interleave(quantizeLongitude(longitude), quantizeLatitude(latitude));
+}
+
+bool GeoIndex::put(const std::string& key, double latitude, double longitude) {
+    if (!validCoordinate(latitude, longitude)) {
+        return false;
+    }
+    uint32_t slot;
+    std::unordered_map<std::string, uint32_t>::const_iterator found = keyToSlot_.find(key);
+    if (found != keyToSlot_.end()) {
+        slot = found->second;
+        unlink(slot);
+    }
+    else if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        points_[slot].key = key;
+        keyToSlot_[key] = slot;
+    }
+    else {
+        slot = static_cast<uint32_t>(points_.size());
+        points_.push_back(Point());
+        points_[slot].key = key;
+        keyToSlot_[key] = slot;
+    }
+    Point& point = points_[slot];
+    double unit[3];
+    unitVector(latitude, longitude, unit);
+    point.x = unit[0];
+    point.y = unit[1];
+    point.z = unit[2];
+    point.hash = geohash(latitude, longitude);
+    HashList::value_type entry(point.hash, slot);
+    byHash_.insert(std::lower_bound(byHash_.begin(), byHash_.end(), entry), entry);
+    return true;
+}
+
+bool GeoIndex::remove(const std::string& key) {
+    std::unordered_map<std::string, uint32_t>::iterator found = keyToSlot_.find(key);
+    if (found == keyToSlot_.end()) {
+        return false;
+    }
+    uint32_t slot = found->second;
+    unlink(slot);
+    keyToSlot_.erase(found);
+    points_[slot].key.clear();
+    freeSlots_.push_back(slot);
+    return true;
+}
+
+void GeoIndex::clear() {
+    points_.clear();
+    freeSlots_.clear();
+    keyToSlot_.clear();
+    byHash_.clear();
+}
+
+void GeoIndex::unlink(uint32_t slot) {
+    HashList::value_type entry(points_[slot].hash, slot);
+    HashList::iterator it = std::lower_bound(byHash_.begin(), byHash_.end(), entry);
+    if (it != byHash_.end() && *it == entry) {
+        byHash_.erase(it);
+    }
+}
+
+void GeoIndex::collectCell(uint64_t first, uint64_t last, const double* unit, double maxChord2) const {
+    cellsVisited_++;
+    HashList::const_iterator it = std::lower_bound(byHash_.begin(), byHash_.end(),
+                                                   HashList::value_type(first, 0));
+    for (; it != byHash_.end() && it->first <= last; ++it) {
+        const Point& point = points_[it->second];
+        double dx = point.x - unit[0];
+        double dy = point.y - unit[1];
+        double dz = point.z - unit[2];
+        double distance = dx * dx + dy * dy + dz * dz;
+        if (distance <= maxChord2) {
+            candidates_.push_back(std::make_pair(distance, it->second));
+        }
+    }
+}
+
+std::vector<GeoHit> GeoIndex::nearest(double latitude, double longitude,
+                                      size_t limit, double maxMeters) const {
+    std::vector<GeoHit> hits;
+    if (limit == 0 || byHash_.empty() || !validCoordinate(latitude, longitude)) {
+        return hits;
+    }
+    longitude = wrapLongitude(longitude);
+    uint32_t x = quantizeLongitude(longitude);
+    uint32_t y = quantizeLatitude(latitude);
+    double cosLatitude = std::cos(latitude * kRadiansPerDegree);
+    double unit[3];
+    unitVector(latitude, longitude, unit);
+    double maxChord2 = chord2(maxMeters);
+
+    for (int level = kFinestLevel; ; level = std::max(level - kLevelStep, 0)) {
+        candidates_.clear();
+        double reach = kUnbounded;
+
+        if (level == 0) {
+            collectCell(0, std::numeric_limits<uint64_t>::max(), unit, maxChord2);
+        }
+        else {
+            int64_t cells = static_cast<int64_t>(1) << level;
+            int64_t cellX = x >> (32 - level);
+            int64_t cellY = y >> (32 - level);
+            double cellLatitude = 180.0 / cells;
+            double cellLongitude = 360.0 / cells;
+            int shift = 64 - 2 * level;
+
+            // Rows stop at the poles; columns wrap around
+            int64_t firstRow = std::max<int64_t>(cellY - 1, 0);
+            int64_t lastRow = std::min<int64_t>(cellY + 1, cells - 1);
+            int64_t firstColumn = cells >= 3 ? cellX - 1 : 0;
+            int64_t lastColumn = cells >= 3 ? cellX + 1 : cells - 1;
+            for (int64_t row = firstRow; row <= lastRow; row++) {
+                for (int64_t column = firstColumn; column <= lastColumn; column++) {
+                    uint32_t wrapped = static_cast<uint32_t>((column + cells) % cells);
+                    uint64_t first = interleave(wrapped, static_cast<uint32_t>(row)) << shift;
+                    uint64_t last = first + ((static_cast<uint64_t>(1) << shift) - 1);
+                    collectCell(first, last, unit, maxChord2);
+                }
+            }
+
+            // How far the block reaches from the coordinate in every direction
+            double south = cellY > 0 ? latitude - (-90.0 + firstRow * cellLatitude) : kUnbounded;
+            double north = cellY < cells - 1 ? (-90.0 + (lastRow + 1) * cellLatitude) - latitude : kUnbounded;
+            reach = std::min(south, north) * kRadiansPerDegree * kEarthRadiusMeters;
+            if (cells >= 3) {
+                double west = longitude - (-180.0 + firstColumn * cellLongitude);
+                double east = (-180.0 + (lastColumn + 1) * cellLongitude) - longitude;
+                double span = std::min(std::min(west, east), 180.0) * kRadiansPerDegree;
+                // Meridians converge, so east and west the block reaches least
+                // at its latitude furthest from the equator
+                double poleward = std::max(std::fabs(-90.0 + firstRow * cellLatitude),
+                                           std::fabs(-90.0 + (lastRow + 1) * cellLatitude));
+                double scale = std::sqrt(cosLatitude * std::cos(poleward * kRadiansPerDegree));
+                double across = 2 * kEarthRadiusMeters * std::asin(std::min(1.0, scale * std::sin(span / 2)));
+                reach = std::min(reach, across);
+            }
+        }
+
+        size_t count = std::min(limit, candidates_.size());
+        std::partial_sort(candidates_.begin(), candidates_.begin() + count, candidates_.end());
+        double reachChord2 = chord2(reach);
+        bool complete = count == limit && candidates_[count - 1].first <= reachChord2;
+        if (level == 0 || complete || maxChord2 <= reachChord2) {
+            hits.reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                GeoHit hit = { points_[candidates_[i].second].key, chordMeters(candidates_[i].first) };
+                hits.push_back(hit);
+            }
+            return hits;
+        }
+    }
+}
+
+}
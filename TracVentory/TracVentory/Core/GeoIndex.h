@@ -0,0 +1,91 @@
+//
+//  GeoIndex.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_GeoIndex_h
+#define TracVentory_GeoIndex_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flx {
+
+struct GeoHit {
+    std::string key;
+    double meters;
+};
+
+// GeoIndex finds the points nearest a coordinate, for proposing the location
+// a device is at without asking the server.
+//
+// Points are ordered by geohash: 32 bits of longitude and 32 of latitude,
+// interleaved, so that every geohash cell at every precision is one
+// contiguous range of the ordering. A query looks at the 3x3 block of cells
+// around the coordinate, finest precision first. Anything outside the block
+// is at least as far as the nearest edge of the block, so once the k-th
+// best point found is closer than that edge the answer is exact; otherwise
+// the next coarser block is tried, up to the whole world. Longitude wraps
+// at the antimeridian. Distances are great circle (haversine) in meters.
+//
+// Not thread safe; callers serialize access.
+class GeoIndex {
+public:
+    GeoIndex();
+
+    // Insert or move the point stored under key. Returns false, and leaves
+    // the index unchanged, if the coordinate is not a valid one.
+    bool put(const std::string& key, double latitude, double longitude);
+    bool remove(const std::string& key);
+    void clear();
+
+    size_t size() const { return keyToSlot_.size(); }
+
+    // Up to limit points within maxMeters of the coordinate, nearest first.
+    std::vector<GeoHit> nearest(double latitude, double longitude,
+                                size_t limit, double maxMeters) const;
+
+    static double distanceMeters(double latitude1, double longitude1,
+                                 double latitude2, double longitude2);
+
+    // The 64 bit geohash of a coordinate, longitude bit first
+    static uint64_t geohash(double latitude, double longitude);
+
+    // Cells looked at by the queries since the last reset, for tuning
+    size_t cellsVisited() const { return cellsVisited_; }
+    void resetStats() { cellsVisited_ = 0; }
+
+private:
+    // Points are compared by the chord between them on the unit sphere,
+    // which orders them as the great circle does without any trigonometry
+    struct Point {
+        double x, y, z;
+        uint64_t hash;
+        std::string key;
+    };
+    // (geohash, slot) of every point, sorted. Locations change far less
+    // often than they are looked up, and a query walks many short ranges,
+    // which a sorted array serves from the cache.
+    typedef std::vector<std::pair<uint64_t, uint32_t> > HashList;
+
+    std::vector<Point> points_;
+    std::vector<uint32_t> freeSlots_;
+    std::unordered_map<std::string, uint32_t> keyToSlot_;
+    HashList byHash_;
+    // Squared chord and slot of the points in the block being looked at
+    mutable std::vector<std::pair<double, uint32_t> > candidates_;
+    mutable size_t cellsVisited_;
+
+    void unlink(uint32_t slot);
+    void collectCell(uint64_t first, uint64_t last, const double* unit, double maxChord2) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,57 @@
+//
+//  ImageCache.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "ImageCache.h"
+
+#include <cstdio>
+
+namespace flx {
+
+PixelSize thumbnailSize(PixelSize source, uint32_t maxPixels) {
+    PixelSize size = source;
+    uint32_t longer = source.width > source.height ? source.width : source.height;
+    if (longer <= maxPixels || longer == 0) {
+        return size;
+    }
+    // Round to nearest, but keep a sliver of a panorama at least a pixel
+    size.width = static_cast<uint32_t>((static_cast<uint64_t>(source.width) * maxPixels + longer / 2) / longer);
+    size.height = static_cast<uint32_t>((static_cast<uint64_t>(source.height) * maxPixels + longer / 2) / longer);
+    if (size.width == 0) {
+        size.width = 1;
+    }
+    if (size.height == 0) {
+        size.height = 1;
+    }
+    return size;
+}
+
+std::string cacheFileName(const std::string& key) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < key.size(); i++) {
+        hash = (hash ^ static_cast<uint8_t>(key[i])) * 1099511628211ULL;
+    }
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+    std::string fileName(name);
+
+    // Keep .jpg or .png so the file can be told apart when inspected
+    size_t dot = key.find_last_of('.');
+    size_t slash = key.find_last_of('/');
+    if (dot != std::string::npos && (slash == std::string::npos || dot > slash) && key.size() - dot <= 5) {
+        for (size_t i = dot + 1; i < key.size(); i++) {
+            char c = key[i];
+            if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))) {
+                return fileName;
+            }
+        }
+        fileName += key.substr(dot);
+    }
+    return fileName;
+}
+
+}
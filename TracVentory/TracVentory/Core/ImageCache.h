@@ -0,0 +1,177 @@
+//
+//  ImageCache.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_ImageCache_h
+#define TracVentory_ImageCache_h
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flx {
+
+struct ByteLruStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;     // entries dropped to stay within the budget
+    uint64_t rejected;      // entries larger than the whole budget, not kept
+
+    double hitRate() const { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0; }
+};
+
+// ByteLruCache keeps values charged by their size in bytes, and drops the
+// least recently used ones once the total passes the budget. It is the
+// bookkeeping of both image cache tiers: decoded images in memory, where a
+// thumbnail and a full-size photo differ a thousandfold in cost, and files
+// on disk, where the value is nothing and the evicted keys are the files to
+// delete.
+//
+// Value must be copyable; under ARC an Objective-C object pointer is. Not
+// thread safe; callers serialize access.
+template <typename Value>
+class ByteLruCache {
+public:
+    explicit ByteLruCache(size_t budget) : budget_(budget), bytes_(0) { resetStats(); }
+
+    // Copy the value into value and mark it most recently used; false on a miss.
+    bool lookup(const std::string& key, Value& value);
+    // Whether the key is cached, without counting a lookup or touching recency
+    bool contains(const std::string& key) const { return index_.count(key) != 0; }
+    // Cache value, replacing any earlier one, and evict for room. The keys
+    // evicted (not the one replaced) are appended to evicted if given.
+    void insert(const std::string& key, const Value& value, size_t bytes, std::vector<std::string>* evicted = NULL);
+    bool erase(const std::string& key);
+    void clear();
+
+    size_t size() const { return entries_.size(); }
+    size_t bytes() const { return bytes_; }
+    size_t budget() const { return budget_; }
+    // Shrinking evicts at once
+    void setBudget(size_t budget, std::vector<std::string>* evicted = NULL);
+
+    const ByteLruStats& stats() const { return stats_; }
+    void resetStats() { stats_ = ByteLruStats(); }
+
+private:
+    struct Entry {
+        std::string key;
+        Value value;
+        size_t bytes;
+    };
+    typedef std::list<Entry> EntryList;
+
+    void trim(std::vector<std::string>* evicted);
+
+    size_t budget_;
+    size_t bytes_;
+    EntryList entries_;                 // most recently used first
+    std::unordered_map<std::string, typename EntryList::iterator> index_;
+    ByteLruStats stats_;
+};
+
+struct PixelSize {
+    uint32_t width;
+    uint32_t height;
+};
+
+// The size of a thumbnail of source whose longer side is at most maxPixels,
+// keeping the aspect ratio; never larger than source.
+PixelSize thumbnailSize(PixelSize source, uint32_t maxPixels);
+
+// Bytes a decoded 32-bit image of size takes in memory
+inline size_t decodedBytes(PixelSize size) { return static_cast<size_t>(size.width) * size.height * 4; }
+
+// The name of a cache file for key (a file name or URL): 16 hex digits of
+// its FNV-1a hash, then the key's extension if it has a short one
+std::string cacheFileName(const std::string& key);
+
+template <typename Value>
+bool ByteLruCache<Value>::lookup(const std::string& key, Value& value) {
+    typename std::unordered_map<std::string, typename EntryList::iterator>::iterator found = index_.find(key);
+    if (found == index_.end()) {
+        stats_.misses++;
+        return false;
+    }
+    stats_.hits++;
+    entries_.splice(entries_.begin(), entries_, found->second);
+    value = found->second->value;
+    return true;
+}
+
+template <typename Value>
+void ByteLruCache<Value>::insert(const std::string& key, const Value& value, size_t bytes,
+                                 std::vector<std::string>* evicted) {
+    if (bytes > budget_) {
+        // It would push out everything else and still not fit
+        erase(key);
+        stats_.rejected++;
+        return;
+    }
+    typename std::unordered_map<std::string, typename EntryList::iterator>::iterator found = index_.find(key);
+    if (found != index_.end()) {
+        bytes_ -= found->second->bytes;
+        found->second->value = value;
+        found->second->bytes = bytes;
+        entries_.splice(entries_.begin(), entries_, found->second);
+    }
+    else {
+        Entry entry = { key, value, bytes };
+        entries_.push_front(entry);
+        index_[key] = entries_.begin();
+    }
+    bytes_ += bytes;
+    stats_.inserts++;
+    trim(evicted);
+}
+
+template <typename Value>
+bool ByteLruCache<Value>::erase(const std::string& key) {
+    typename std::unordered_map<std::string, typename EntryList::iterator>::iterator found = index_.find(key);
+    if (found == index_.end()) {
+        return false;
+    }
+    bytes_ -= found->second->bytes;
+    entries_.erase(found->second);
+    index_.erase(found);
+    return true;
+}
+
+template <typename Value>
+void ByteLruCache<Value>::clear() {
+    entries_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+template <typename Value>
+void ByteLruCache<Value>::setBudget(size_t budget, std::vector<std::string>* evicted) {
+    budget_ = budget;
+    trim(evicted);
+}
+
+template <typename Value>
+void ByteLruCache<Value>::trim(std::vector<std::string>* evicted) {
+    while (bytes_ > budget_ && !entries_.empty()) {
+        Entry& oldest = entries_.back();
+        if (evicted) {
+            evicted->push_back(oldest.key);
+        }
+        bytes_ -= oldest.bytes;
+        index_.erase(oldest.key);
+        entries_.pop_back();
+        stats_.evictions++;
+    }
+}
+
+}
+
+#endif
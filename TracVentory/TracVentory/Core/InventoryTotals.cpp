@@ -0,0 +1,187 @@
+//
+//  InventoryTotals.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "InventoryTotals.h"
+
+#include <limits>
+
+namespace flx {
+
+namespace {
+
+uint64_t pairKey(uint32_t location, uint32_t category) {
+    return (static_cast<uint64_t>(location) << 32) | category;
+}
+
+const uint32_t kNoName = std::numeric_limits<uint32_t>::max();
+
+}
+
+InventoryTotals::Names::Names() {
+    clear();
+}
+
+uint32_t InventoryTotals::Names::intern(const std::string& name) {
+    std::unordered_map<std::string, uint32_t>::const_iterator found = ids_.find(name);
+    if (found != ids_.end()) {
+        return found->second;
+    }
+    uint32_t id = static_cast<uint32_t>(names_.size());
+    names_.push_back(name);
+    ids_[name] = id;
+    return id;
+}
+
+uint32_t InventoryTotals::Names::find(const std::string& name) const {
+    std::unordered_map<std::string, uint32_t>::const_iterator found = ids_.find(name);
+    return found != ids_.end() ? found->second : kNoName;
+}
+
+void InventoryTotals::Names::clear() {
+    ids_.clear();
+    names_.clear();
+    intern(std::string());
+}
+
+InventoryTotals::InventoryTotals() : version_(0) {
+}
+
+void InventoryTotals::put(const std::string& key, const ItemFacts& itemFacts) {
+    Facts facts;
+    facts.location = locations_.intern(itemFacts.locationID);
+    facts.category = categories_.intern(itemFacts.category);
+    facts.condition = conditions_.intern(itemFacts.condition);
+    facts.status = statuses_.intern(itemFacts.status);
+    facts.costCents = itemFacts.costCents;
+
+    std::unordered_map<std::string, Facts>::iterator found = items_.find(key);
+    if (found != items_.end()) {
+        apply(found->second, -1);
+        found->second = facts;
+    }
+    else {
+        items_.insert(std::make_pair(key, facts));
+    }
+    apply(facts, 1);
+    version_++;
+}
+
+bool InventoryTotals::remove(const std::string& key) {
+    std::unordered_map<std::string, Facts>::iterator found = items_.find(key);
+    if (found == items_.end()) {
+        return false;
+    }
+    apply(found->second, -1);
+    items_.erase(found);
+    version_++;
+    return true;
+}
+
+void InventoryTotals::clear() {
+    locations_.clear();
+    categories_.clear();
+    conditions_.clear();
+    statuses_.clear();
+    items_.clear();
+    total_ = Group();
+    byLocation_.clear();
+    byCategory_.clear();
+    byLocationCategory_.clear();
+    version_++;
+}
+
+void InventoryTotals::apply(const Facts& facts, int64_t sign) {
+    if (facts.location >= byLocation_.size()) {
+        byLocation_.resize(locations_.size());
+    }
+    if (facts.category >= byCategory_.size()) {
+        byCategory_.resize(categories_.size());
+    }
+    applyGroup(total_, facts, sign);
+    applyGroup(byLocation_[facts.location], facts, sign);
+    applyGroup(byCategory_[facts.category], facts, sign);
+    applyGroup(byLocationCategory_[pairKey(facts.location, facts.category)], facts, sign);
+}
+
+void InventoryTotals::applyGroup(Group& group, const Facts& facts, int64_t sign) {
+    if (facts.condition >= group.byCondition.size()) {
+        group.byCondition.resize(conditions_.size(), 0);
+    }
+    if (facts.status >= group.byStatus.size()) {
+        group.byStatus.resize(statuses_.size(), 0);
+    }
+    group.count += sign;
+    group.costCents += sign * facts.costCents;
+    group.byCondition[facts.condition] += sign;
+    group.byStatus[facts.status] += sign;
+}
+
+InventorySummary InventoryTotals::summarize(const Group* group) const {
+    InventorySummary summary;
+    summary.count = group ? group->count : 0;
+    summary.costCents = group ? group->costCents : 0;
+    if (!group) {
+        return summary;
+    }
+    for (size_t i = 0; i < group->byCondition.size(); i++) {
+        if (group->byCondition[i]) {
+            summary.byCondition.push_back(std::make_pair(conditions_.name(static_cast<uint32_t>(i)), group->byCondition[i]));
+        }
+    }
+    for (size_t i = 0; i < group->byStatus.size(); i++) {
+        if (group->byStatus[i]) {
+            summary.byStatus.push_back(std::make_pair(statuses_.name(static_cast<uint32_t>(i)), group->byStatus[i]));
+        }
+    }
+    return summary;
+}
+
+InventorySummary InventoryTotals::total() const {
+    return summarize(&total_);
+}
+
+InventorySummary InventoryTotals::location(const std::string& locationID) const {
+    uint32_t id = locations_.find(locationID);
+    return summarize(id < byLocation_.size() ? &byLocation_[id] : NULL);
+}
+
+InventorySummary InventoryTotals::category(const std::string& category) const {
+    uint32_t id = categories_.find(category);
+    return summarize(id < byCategory_.size() ? &byCategory_[id] : NULL);
+}
+
+InventorySummary InventoryTotals::locationCategory(const std::string& locationID, const std::string& category) const {
+    uint32_t location = locations_.find(locationID);
+    uint32_t categoryId = categories_.find(category);
+    if (location == kNoName || categoryId == kNoName) {
+        return summarize(NULL);
+    }
+    std::unordered_map<uint64_t, Group>::const_iterator found = byLocationCategory_.find(pairKey(location, categoryId));
+    return summarize(found != byLocationCategory_.end() ? &found->second : NULL);
+}
+
+std::vector<std::pair<std::string, InventorySummary> > InventoryTotals::summarizeAll(const std::vector<Group>& groups,
+                                                                                   const Names& names) const {
+    std::vector<std::pair<std::string, InventorySummary> > summaries;
+    for (size_t i = 0; i < groups.size(); i++) {
+        if (groups[i].count) {
+            summaries.push_back(std::make_pair(names.name(static_cast<uint32_t>(i)), summarize(&groups[i])));
+        }
+    }
+    return summaries;
+}
+
+std::vector<std::pair<std::string, InventorySummary> > InventoryTotals::locations() const {
+    return summarizeAll(byLocation_, locations_);
+}
+
+std::vector<std::pair<std::string, InventorySummary> > InventoryTotals::categories() const {
+    return summarizeAll(byCategory_, categories_);
+}
+
+}
@@ -0,0 +1,130 @@
+//
+//  InventoryTotals.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_InventoryTotals_h
+#define TracVentory_InventoryTotals_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace flx {
+
+// The fields of an item the totals are kept over; empty when not set
+struct ItemFacts {
+    std::string locationID;
+    std::string category;
+    std::string condition;
+    std::string status;
+    int64_t costCents;
+};
+
+// Totals over a group of items
+struct InventorySummary {
+    uint64_t count;
+    int64_t costCents;
+    std::vector<std::pair<std::string, uint64_t> > byCondition;     // nonzero counts only
+    std::vector<std::pair<std::string, uint64_t> > byStatus;
+};
+
+// InventoryTotals keeps item count, total cost and counts by condition and
+// status for all items, per location, per category and per location and
+// category, as items change rather than by scanning them when asked. Each
+// put() takes the item's previous facts out of the totals and adds its new
+// ones, so a check-in or an edit costs the same at 100k items as at ten.
+//
+// Field values are interned to small ids and the counts kept in arrays
+// indexed by them; a group is only looked up in a hash table for the
+// location and category pair. Groups left empty stay allocated (there are
+// only as many as distinct values) and are not reported.
+//
+// Cost is kept in cents so totals never drift however many times items
+// move in and out of them.
+//
+// Not thread safe; callers serialize access.
+class InventoryTotals {
+public:
+    InventoryTotals();
+
+    // Insert or replace the facts of the item stored under key.
+    void put(const std::string& key, const ItemFacts& facts);
+    bool remove(const std::string& key);
+    void clear();
+
+    size_t size() const { return items_.size(); }
+    // Changes applied since construction; callers can tell when totals moved
+    uint64_t version() const { return version_; }
+
+    InventorySummary total() const;
+    InventorySummary location(const std::string& locationID) const;
+    InventorySummary category(const std::string& category) const;
+    InventorySummary locationCategory(const std::string& locationID, const std::string& category) const;
+
+    // Every location or category holding items, with its summary
+    std::vector<std::pair<std::string, InventorySummary> > locations() const;
+    std::vector<std::pair<std::string, InventorySummary> > categories() const;
+
+private:
+    struct Facts {
+        uint32_t location;
+        uint32_t category;
+        uint32_t condition;
+        uint32_t status;
+        int64_t costCents;
+    };
+
+    struct Group {
+        uint64_t count;
+        int64_t costCents;
+        std::vector<uint64_t> byCondition;      // by condition id
+        std::vector<uint64_t> byStatus;         // by status id
+
+        Group() : count(0), costCents(0) {}
+    };
+
+    // Strings to dense ids; id 0 is the empty string
+    class Names {
+    public:
+        Names();
+        uint32_t intern(const std::string& name);
+        // UINT32_MAX if never interned
+        uint32_t find(const std::string& name) const;
+        const std::string& name(uint32_t id) const { return names_[id]; }
+        size_t size() const { return names_.size(); }
+        void clear();
+
+    private:
+        std::unordered_map<std::string, uint32_t> ids_;
+        std::vector<std::string> names_;
+    };
+
+    void apply(const Facts& facts, int64_t sign);
+    void applyGroup(Group& group, const Facts& facts, int64_t sign);
+    InventorySummary summarize(const Group* group) const;
+    std::vector<std::pair<std::string, InventorySummary> > summarizeAll(const std::vector<Group>& groups,
+                                                                      const Names& names) const;
+
+    Names locations_;
+    Names categories_;
+    Names conditions_;
+    Names statuses_;
+
+    std::unordered_map<std::string, Facts> items_;
+    Group total_;
+    std::vector<Group> byLocation_;
+    std::vector<Group> byCategory_;
+    std::unordered_map<uint64_t, Group> byLocationCategory_;
+    uint64_t version_;
+};
+
+}
+
+#endif
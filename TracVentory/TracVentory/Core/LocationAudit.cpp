@@ -0,0 +1,61 @@
+//
+//  LocationAudit.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "LocationAudit.h"
+
+namespace flx {
+
+LocationAudit::LocationAudit(size_t expectedCount)
+    : expected_(expectedCount), unexpected_(64), reads_(0) {
+}
+
+bool LocationAudit::addExpected(const TagKey& key) {
+    bool inserted;
+    expected_.insert(key, inserted);
+    return inserted;
+}
+
+AuditOutcome LocationAudit::recordRead(const TagKey& key) {
+    reads_++;
+
+    size_t slot = expected_.find(key);
+    if (slot != TagSet::npos) {
+        return expected_.mark(slot) ? kAuditFound : kAuditDuplicate;
+    }
+
+    bool inserted;
+    unexpected_.insert(key, inserted);
+    return inserted ? kAuditUnexpected : kAuditUnexpectedDuplicate;
+}
+
+bool LocationAudit::isFound(const TagKey& key) const {
+    size_t slot = expected_.find(key);
+    return slot != TagSet::npos && expected_.isMarked(slot);
+}
+
+std::vector<TagKey> LocationAudit::missingKeys() const {
+    std::vector<TagKey> keys;
+    keys.reserve(missingCount());
+    expected_.forEach([&keys](const TagKey& key, bool marked) {
+        if (!marked) {
+            keys.push_back(key);
+        }
+    });
+    return keys;
+}
+
+std::vector<TagKey> LocationAudit::unexpectedKeys() const {
+    std::vector<TagKey> keys;
+    keys.reserve(unexpected_.size());
+    unexpected_.forEach([&keys](const TagKey& key, bool) {
+        keys.push_back(key);
+    });
+    return keys;
+}
+
+}
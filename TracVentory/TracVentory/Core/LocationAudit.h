@@ -0,0 +1,58 @@
+//
+//  LocationAudit.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_LocationAudit_h
+#define TracVentory_LocationAudit_h
+
+#include "TagSet.h"
+
+#include <vector>
+
+namespace flx {
+
+enum AuditOutcome {
+    kAuditFound = 0,            // expected tag, first read
+    kAuditDuplicate,            // expected tag, already found
+    kAuditUnexpected,           // tag not expected here, first read
+    kAuditUnexpectedDuplicate   // tag not expected here, already reported
+};
+
+// LocationAudit reconciles a stream of tag reads against the tags expected
+// at one location (a cycle count). Each read costs one hash probe, plus one
+// more for tags that are not expected, and the found / missing / unexpected
+// counts are kept current as reads arrive.
+class LocationAudit {
+public:
+    explicit LocationAudit(size_t expectedCount = 0);
+
+    // Returns false if key was already expected.
+    bool addExpected(const TagKey& key);
+
+    AuditOutcome recordRead(const TagKey& key);
+
+    size_t expectedCount() const { return expected_.size(); }
+    size_t foundCount() const { return expected_.markedCount(); }
+    size_t missingCount() const { return expected_.size() - expected_.markedCount(); }
+    size_t unexpectedCount() const { return unexpected_.size(); }
+    size_t readCount() const { return reads_; }
+
+    bool isFound(const TagKey& key) const;
+
+    // Keys for the discrepancy report, in no particular order
+    std::vector<TagKey> missingKeys() const;
+    std::vector<TagKey> unexpectedKeys() const;
+
+private:
+    TagSet expected_;
+    TagSet unexpected_;
+    size_t reads_;
+};
+
+}
+
+#endif
@@ -0,0 +1,180 @@
+//
+//  LoopbackDevice.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "LoopbackDevice.h"
+
+#include <algorithm>
+
+namespace flx {
+
+LoopbackDevice::LoopbackDevice()
+    : session_(NULL), outboxStart_(0), blockSize_(4), commands_(0), failInterval_(0), failStatus_(kStatusOk),
+      loseInterval_(0) {
+}
+
+void LoopbackDevice::setTag(const std::vector<uint8_t>& tagId, size_t blockCount, size_t blockSize) {
+    tagId_ = tagId;
+    blockSize_ = blockSize;
+    memory_.resize(blockCount * blockSize);
+    for (size_t i = 0; i < memory_.size(); i++) {
+        memory_[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+}
+
+void LoopbackDevice::write(const uint8_t* data, size_t length) {
+    framer_.feed(data, length, [this](const PacketView& command) {
+        commands_++;
+        answer(command);
+    });
+}
+
+void LoopbackDevice::queuePacket(const uint8_t* packet, size_t size) {
+    outbox_.insert(outbox_.end(), packet, packet + size);
+}
+
+void LoopbackDevice::answer(const PacketView& command) {
+    uint8_t packet[kMaxPacketSize];
+    uint8_t payload[kMaxPayloadSize];
+    static const ReaderTimestamp now = { 26, 10, 19, 12, 0, 0 };
+
+    if (loseInterval_ > 0 && commands_ % loseInterval_ == 0) {
+        return;
+    }
+    if (failInterval_ > 0 && commands_ % failInterval_ == 0) {
+        queuePacket(packet, encodeNack(command.header, failStatus_, packet));
+        return;
+    }
+
+    switch (command.header) {
+        case kCmdGetTagId:
+            if (tagId_.empty()) {
+                queuePacket(packet, encodeNack(command.header, kStatusNoData, packet));
+            }
+            else {
+                queuePacket(packet, encodeTagRead(kCmdGetTagId, tagId_.data(), tagId_.size(), now, packet));
+            }
+            break;
+
+        // Answer: the tag read (id length, id, timestamp), block count,
+        // block size
+        case kCmdGetTagInfo: {
+            size_t length = 1 + tagId_.size() + kTimestampSize;
+            if (tagId_.empty() || length + 2 > kMaxPayloadSize) {
+                queuePacket(packet, encodeNack(command.header, kStatusNoData, packet));
+                break;
+            }
+            const uint8_t stamp[kTimestampSize] = { now.year, now.month, now.day, now.hour, now.minute, now.second };
+            payload[0] = static_cast<uint8_t>(tagId_.size());
+            std::copy(tagId_.begin(), tagId_.end(), payload + 1);
+            std::copy(stamp, stamp + kTimestampSize, payload + 1 + tagId_.size());
+            payload[length] = static_cast<uint8_t>(memory_.size() / blockSize_);
+            payload[length + 1] = static_cast<uint8_t>(blockSize_);
+            queuePacket(packet, encodePacket(kCmdGetTagInfo, payload, length + 2, packet));
+            break;
+        }
+
+        // Parameters: bank, word address, word count. Only the TID bank is
+        // simulated: a fixed class and vendor, then the tag id as serial.
+        case kCmdReadUhf: {
+            size_t address = command.payloadLength > 1 ? command.payload[1] : 0;
+            size_t words = command.payloadLength > 2 ? command.payload[2] : 0;
+            if (tagId_.empty() || command.payload[0] != kLoopbackTidBank || words == 0 || words * 2 > kMaxPayloadSize) {
+                queuePacket(packet, encodeNack(command.header, tagId_.empty() ? kStatusNoData : kStatusInvalidValue, packet));
+                break;
+            }
+            static const uint8_t tidHeader[] = { 0xE2, 0x00, 0x68, 0x0A };
+            for (size_t i = 0; i < words * 2; i++) {
+                size_t at = address * 2 + i;
+                payload[i] = at < sizeof(tidHeader) ? tidHeader[at] : tagId_[(at - sizeof(tidHeader)) % tagId_.size()];
+            }
+            queuePacket(packet, encodePacket(kCmdReadUhf, payload, words * 2, packet));
+            break;
+        }
+
+        case kCmdGetEntryCount:
+            payload[0] = static_cast<uint8_t>(entries_.size() >> 8);
+            payload[1] = static_cast<uint8_t>(entries_.size());
+            queuePacket(packet, encodePacket(kCmdGetEntryCount, payload, 2, packet));
+            break;
+
+        case kCmdGetEntry: {
+            size_t index = command.payloadLength >= 2 ? (command.payload[0] << 8) | command.payload[1] : 0;
+            if (index >= entries_.size()) {
+                queuePacket(packet, encodeNack(command.header, kStatusInvalidIndex, packet));
+            }
+            else {
+                const TagRead& entry = entries_[index];
+                queuePacket(packet, encodeTagRead(kCmdGetEntry, entry.tagId.data(), entry.tagId.size(), entry.time, packet));
+            }
+            break;
+        }
+
+        case kCmdClearEntries:
+            entries_.clear();
+            queuePacket(packet, encodePacket(kCmdClearEntries, NULL, 0, packet));
+            break;
+
+        // Parameters: first block, block count. Answer: first block, block
+        // count, block data.
+        case kCmdReadBlock:
+        case kCmdReadBlocks: {
+            size_t first = command.payloadLength > 0 ? command.payload[0] : 0;
+            size_t count = command.header == kCmdReadBlock ? 1 : (command.payloadLength > 1 ? command.payload[1] : 1);
+            size_t bytes = count * blockSize_;
+            if (tagId_.empty() || (first + count) * blockSize_ > memory_.size() || 2 + bytes > kMaxPayloadSize) {
+                queuePacket(packet, encodeNack(command.header, tagId_.empty() ? kStatusNoData : kStatusInvalidIndex, packet));
+                break;
+            }
+            payload[0] = static_cast<uint8_t>(first);
+            payload[1] = static_cast<uint8_t>(count);
+            std::copy(memory_.begin() + first * blockSize_, memory_.begin() + first * blockSize_ + bytes, payload + 2);
+            queuePacket(packet, encodePacket(command.header, payload, 2 + bytes, packet));
+            break;
+        }
+
+        case kCmdSetScanning:
+        case kCmdBeep:
+        case kCmdNoOp:
+        case kCmdHeartbeat:
+            queuePacket(packet, encodePacket(command.header, NULL, 0, packet));
+            break;
+
+        default:
+            queuePacket(packet, encodeNack(command.header, kStatusInvalidCommand, packet));
+            break;
+    }
+}
+
+size_t LoopbackDevice::pump(size_t chunkSize) {
+    size_t length = std::min(chunkSize, pending());
+    if (length == 0 || !session_) {
+        return 0;
+    }
+    // Copy out first: the session may write a command (and so append to the
+    // outbox) while it handles these bytes.
+    uint8_t chunk[1024];
+    length = std::min(length, sizeof(chunk));
+    std::copy(outbox_.begin() + outboxStart_, outbox_.begin() + outboxStart_ + length, chunk);
+    outboxStart_ += length;
+    if (outboxStart_ == outbox_.size()) {
+        outbox_.clear();
+        outboxStart_ = 0;
+    }
+    session_->onDataReceived(chunk, length);
+    return length;
+}
+
+size_t LoopbackDevice::pumpAll(size_t chunkSize) {
+    size_t total = 0;
+    for (size_t delivered; (delivered = pump(chunkSize)) > 0; ) {
+        total += delivered;
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,99 @@
+//
+//  LoopbackDevice.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_LoopbackDevice_h
+#define TracVentory_LoopbackDevice_h
+
+#include "CommandSession.h"
+#include "ReaderProtocol.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace flx {
+
+// The EPC Gen 2 memory bank holding the TID (EpcMemoryBank BANK_TID)
+const uint8_t kLoopbackTidBank = 2;
+
+// LoopbackDevice is a simulated IDBLUE reader for benchmarks and tests. It
+// answers the commands written to it from an in-memory entry log and tag
+// memory, and can stream asynchronous tag reads like continuous scan.
+//
+// Answers are not delivered from inside write(): they collect in an outbox
+// that pump() hands to the session in chunks the size a Bluetooth stream
+// delivers, so a long exchange never recurses.
+class LoopbackDevice : public Transport {
+public:
+    LoopbackDevice();
+
+    void attach(CommandSession* session) { session_ = session; }
+
+    // Entries for GetEntryCount / GetEntry (parameter: index MSB, LSB)
+    void setEntries(const std::vector<TagRead>& entries) { entries_ = entries; }
+    // The tag in the field for GetTagId, GetTagInfo, block commands and
+    // TID reads (ReadUhf of kLoopbackTidBank)
+    void setTag(const std::vector<uint8_t>& tagId, size_t blockCount, size_t blockSize);
+
+    // NACK every interval-th command received with status, as a noisy link
+    // or busy reader would; 0 turns this off.
+    void failEvery(size_t interval, uint16_t status) { failInterval_ = interval; failStatus_ = status; }
+    // Leave every interval-th command received unanswered, as a response
+    // lost on the link; 0 turns this off.
+    void loseEvery(size_t interval) { loseInterval_ = interval; }
+
+    // Queue count asynchronous tag reads as continuous scan would send them,
+    // calling makeTag(index, TagRead&) for each.
+    template <typename F>
+    void streamTagReads(size_t count, F makeTag);
+
+    // Deliver up to chunkSize bytes of pending output to the session and
+    // return how many were delivered; 0 once the outbox is empty.
+    size_t pump(size_t chunkSize = 64);
+    // Pump until nothing is left, including answers to commands sent while
+    // pumping. Returns the bytes delivered.
+    size_t pumpAll(size_t chunkSize = 64);
+
+    size_t pending() const { return outbox_.size() - outboxStart_; }
+    uint64_t commandsReceived() const { return commands_; }
+
+    // Transport
+    virtual void write(const uint8_t* data, size_t length);
+
+private:
+    void answer(const PacketView& command);
+    void queuePacket(const uint8_t* packet, size_t size);
+
+    CommandSession* session_;
+    PacketFramer framer_;
+    std::vector<uint8_t> outbox_;
+    size_t outboxStart_;
+    std::vector<TagRead> entries_;
+    std::vector<uint8_t> tagId_;
+    std::vector<uint8_t> memory_;
+    size_t blockSize_;
+    uint64_t commands_;
+    size_t failInterval_;
+    uint16_t failStatus_;
+    size_t loseInterval_;
+};
+
+template <typename F>
+void LoopbackDevice::streamTagReads(size_t count, F makeTag) {
+    uint8_t packet[kMaxPacketSize];
+    TagRead read;
+    for (size_t i = 0; i < count; i++) {
+        makeTag(i, read);
+        queuePacket(packet, encodeAsyncMarker(packet));
+        queuePacket(packet, encodeTagRead(kCmdGetTagId, read.tagId.data(), read.tagId.size(), read.time, packet));
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+//
+//  PacketFramer.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "PacketFramer.h"
+
+#include <cstring>
+
+namespace flx {
+
+size_t encodePacket(uint8_t header, const uint8_t* payload, size_t payloadLength, uint8_t* out) {
+    if (payloadLength > kMaxPayloadSize) {
+        return 0;
+    }
+    out[0] = header;
+    out[1] = static_cast<uint8_t>(payloadLength >> 8);
+    out[2] = static_cast<uint8_t>(payloadLength & 0xff);
+    if (payloadLength > 0) {
+        memcpy(out + 3, payload, payloadLength);
+    }
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < payloadLength + 3; i++) {
+        checksum ^= out[i];
+    }
+    out[payloadLength + 3] = checksum;
+    return payloadLength + kMinPacketSize;
+}
+
+PacketFramer::PacketFramer()
+    : start_(0), skipped_(0) {
+    buffer_.reserve(kMaxPacketSize * 4);
+}
+
+void PacketFramer::reset() {
+    buffer_.clear();
+    start_ = 0;
+}
+
+size_t PacketFramer::frontPacketSize() const {
+    size_t available = buffer_.size() - start_;
+    if (available < 3) {
+        return 0;
+    }
+    const uint8_t* packet = &buffer_[start_];
+    size_t payloadLength = (static_cast<size_t>(packet[1]) << 8) | packet[2];
+    if (payloadLength > kMaxPayloadSize) {
+        return SIZE_MAX;
+    }
+    size_t size = payloadLength + kMinPacketSize;
+    if (available < size) {
+        return 0;
+    }
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < size - 1; i++) {
+        checksum ^= packet[i];
+    }
+    return checksum == packet[size - 1] ? size : SIZE_MAX;
+}
+
+// Drop consumed bytes once they dominate the buffer
+void PacketFramer::compact() {
+    if (start_ == buffer_.size()) {
+        buffer_.clear();
+        start_ = 0;
+    }
+    else if (start_ > kMaxPacketSize && start_ * 2 > buffer_.size()) {
+        buffer_.erase(buffer_.begin(), buffer_.begin() + start_);
+        start_ = 0;
+    }
+}
+
+}
@@ -0,0 +1,100 @@
+//
+//  PacketFramer.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_PacketFramer_h
+#define TracVentory_PacketFramer_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ByteArray.h"
+
+namespace flx {
+
+// IDBLUE packet layout (see IDBluePacket.h): header byte, payload length
+// MSB and LSB, payload, XOR checksum of all preceding bytes.
+const size_t kMinPacketSize = 4;
+const size_t kMaxPacketSize = 256;
+const size_t kMaxPayloadSize = kMaxPacketSize - kMinPacketSize;
+
+// Write a packet into out (at least payloadLength + 4 bytes). Returns the
+// packet size, or 0 if the payload is too long.
+size_t encodePacket(uint8_t header, const uint8_t* payload, size_t payloadLength, uint8_t* out);
+
+// A framed packet. payload points into the framer's buffer and is only
+// valid during the callback.
+struct PacketView {
+    uint8_t header;
+    const uint8_t* payload;
+    size_t payloadLength;
+
+    ByteSlice payloadSlice() const { return ByteSlice(payload, payloadLength); }
+};
+
+// PacketFramer splits a byte stream into packets, the way the SDK's
+// PacketQueue does: bytes that cannot start a valid packet are skipped one
+// at a time until the stream lines up again. Usable without the SDK, so
+// captured traffic can be replayed and measured on any platform.
+class PacketFramer {
+public:
+    PacketFramer();
+
+    // Append bytes and call onPacket(const PacketView&) for each complete
+    // packet. Returns the number of packets delivered.
+    template <typename F>
+    size_t feed(const uint8_t* data, size_t length, F onPacket);
+
+    void reset();
+
+    // Bytes waiting for the rest of a packet
+    size_t buffered() const { return buffer_.size() - start_; }
+    // Bytes discarded while resynchronizing
+    uint64_t skippedBytes() const { return skipped_; }
+
+private:
+    // Size of the packet at the start of the buffer, 0 if incomplete, or
+    // SIZE_MAX if the data there cannot be a packet.
+    size_t frontPacketSize() const;
+    void compact();
+
+    std::vector<uint8_t> buffer_;
+    size_t start_;
+    uint64_t skipped_;
+};
+
+template <typename F>
+size_t PacketFramer::feed(const uint8_t* data, size_t length, F onPacket) {
+    buffer_.insert(buffer_.end(), data, data + length);
+
+    size_t delivered = 0;
+    for (;;) {
+        size_t size = frontPacketSize();
+        if (size == 0) {
+            break;
+        }
+        if (size == SIZE_MAX) {
+            start_++;
+            skipped_++;
+            continue;
+        }
+        PacketView packet;
+        packet.header = buffer_[start_];
+        packet.payload = &buffer_[start_ + 3];
+        packet.payloadLength = size - kMinPacketSize;
+        onPacket(packet);
+        start_ += size;
+        delivered++;
+    }
+    compact();
+    return delivered;
+}
+
+}
+
+#endif
@@ -0,0 +1,95 @@
+//
+//  ReaderProtocol.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "ReaderProtocol.h"
+#include "CommandTable.h"
+
+#include <cstring>
+
+namespace flx {
+
+bool ResponseFactory::carriesTagRead(uint8_t command) {
+    const CommandDescriptor* descriptor = CommandTable::describe(command);
+    return descriptor && descriptor->shape == kResponseTagRead;
+}
+
+ArenaPtr<ReaderResponse> ResponseFactory::createResponse(const PacketView& packet, bool async, Arena& arena) const {
+    ArenaPtr<ReaderResponse> response = makeArenaPtr<ReaderResponse>(arena);
+    response->async = async;
+    if (packet.header == kCmdNack) {
+        if (packet.payloadLength < 3) {
+            return ArenaPtr<ReaderResponse>();
+        }
+        response->command = packet.payload[0];
+        response->status = static_cast<uint16_t>((packet.payload[1] << 8) | packet.payload[2]);
+        response->payload = ByteArray(packet.payloadSlice().slice(3));
+        return response;
+    }
+
+    // Commands missing from the table pass through as opaque data
+    const CommandDescriptor* descriptor = CommandTable::describe(packet.header);
+    if (descriptor && packet.payloadLength < descriptor->minResponse) {
+        return ArenaPtr<ReaderResponse>();
+    }
+    response->command = packet.header;
+    response->status = kStatusOk;
+    response->payload.assign(packet.payload, packet.payload + packet.payloadLength);
+    if (descriptor && descriptor->shape == kResponseTagRead) {
+        ArenaPtr<TagRead> tag = makeArenaPtr<TagRead>(arena);
+        if (!parseTagRead(packet.payload, packet.payloadLength, *tag)) {
+            return ArenaPtr<ReaderResponse>();
+        }
+        response->tag = std::move(tag);
+    }
+    return response;
+}
+
+bool parseTagRead(const uint8_t* payload, size_t length, TagRead& read) {
+    if (length < 1 || length < 1 + static_cast<size_t>(payload[0]) + kTimestampSize) {
+        return false;
+    }
+    size_t tagIdLength = payload[0];
+    read.tagId.assign(payload + 1, payload + 1 + tagIdLength);
+    const uint8_t* time = payload + 1 + tagIdLength;
+    read.time.year = time[0];
+    read.time.month = time[1];
+    read.time.day = time[2];
+    read.time.hour = time[3];
+    read.time.minute = time[4];
+    read.time.second = time[5];
+    return true;
+}
+
+size_t encodeTagRead(uint8_t command, const uint8_t* tagId, size_t tagIdLength,
+                     const ReaderTimestamp& time, uint8_t* out) {
+    uint8_t payload[kMaxPayloadSize];
+    if (tagIdLength > 0xff || 1 + tagIdLength + kTimestampSize > kMaxPayloadSize) {
+        return 0;
+    }
+    payload[0] = static_cast<uint8_t>(tagIdLength);
+    memcpy(payload + 1, tagId, tagIdLength);
+    uint8_t* stamp = payload + 1 + tagIdLength;
+    stamp[0] = time.year;
+    stamp[1] = time.month;
+    stamp[2] = time.day;
+    stamp[3] = time.hour;
+    stamp[4] = time.minute;
+    stamp[5] = time.second;
+    return encodePacket(command, payload, 1 + tagIdLength + kTimestampSize, out);
+}
+
+size_t encodeNack(uint8_t failedCommand, uint16_t status, uint8_t* out) {
+    uint8_t payload[3] = { failedCommand, static_cast<uint8_t>(status >> 8), static_cast<uint8_t>(status) };
+    return encodePacket(kCmdNack, payload, sizeof(payload), out);
+}
+
+size_t encodeAsyncMarker(uint8_t* out) {
+    return encodePacket(kCmdAsyncPacket, NULL, 0, out);
+}
+
+}
@@ -0,0 +1,140 @@
+//
+//  ReaderProtocol.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_ReaderProtocol_h
+#define TracVentory_ReaderProtocol_h
+
+#include "Arena.h"
+#include "ByteArray.h"
+#include "PacketFramer.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flx {
+
+// Command identifiers and statuses, as in IDBlue.h. What each command
+// carries and gets back is in CommandTable.h.
+enum CommandId : uint8_t {
+    kCmdNoOp = 0x00,
+    kCmdGetTagId = 0x01,
+    kCmdBeep = 0x03,
+    kCmdSetProperty = 0x08,
+    kCmdGetProperty = 0x09,
+    kCmdSaveProperties = 0x10,
+    kCmdLoadProperties = 0x11,
+    kCmdReadBlock = 0x12,
+    kCmdReadBlocks = 0x13,
+    kCmdWriteBlock = 0x15,
+    kCmdWriteBlocks = 0x16,
+    kCmdGetTagInfo = 0x18,
+    kCmdLockBlock = 0x19,
+    kCmdNack = 0x1F,
+    kCmdGetStatus = 0x23,
+    kCmdSetScanning = 0x32,
+    kCmdWriteUhf = 0x36,
+    kCmdReadUhf = 0x37,
+    kCmdLockUhf = 0x38,
+    kCmdSetKillPassword = 0x39,
+    kCmdKill = 0x3A,
+    kCmdBootloaderMode = 0x3C,
+    kCmdSetBluetoothPin = 0x40,
+    kCmdGetBluetoothPin = 0x41,
+    kCmdSetBluetoothName = 0x42,
+    kCmdGetBluetoothName = 0x43,
+    kCmdBootloaderActive = 0x5E,
+    kCmdGetEntryCount = 0x60,
+    kCmdGetEntry = 0x61,
+    kCmdClearEntries = 0x62,
+    kCmdAsyncPacket = 0x70,
+    kCmdFactoryReset = 0x74,
+    kCmdBeginCommands = 0x80,
+    kCmdEndCommands = 0x88,
+    kCmdPowerDown = 0x91,
+    kCmdTurnOffBluetooth = 0x92,
+    kCmdTurnOnBluetooth = 0x93,
+    kCmdHeartbeat = 0x96,
+    kCmdEnableChannel = 0x97,
+    kCmdButton = 0xFF
+};
+
+enum CommandStatus : uint16_t {
+    kStatusOk = 0x00,
+    kStatusFailed = 0x01,
+    kStatusError = 0x02,
+    kStatusNotImplemented = 0x03,
+    kStatusTimeout = 0x04,
+    kStatusInvalidCommand = 0x05,
+    kStatusNotPermitted = 0x06,
+    kStatusChecksumFailed = 0x07,
+    kStatusInvalidValue = 0x52,
+    kStatusInvalidIndex = 0x53,
+    kStatusBufferOverflow = 0x55,
+    kStatusIncompleteOperation = 0x56,
+    kStatusNoData = 0x1000,
+    kStatusDisposing = 0x1003  // the session closed before the reader answered
+};
+
+// An IDBLUE date and time; year counts from 2000.
+struct ReaderTimestamp {
+    uint8_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+};
+
+// A tag read carried by GetTagId, GetEntry and asynchronous scan responses:
+// tag id length, tag id, timestamp (6 bytes).
+struct TagRead {
+    ByteArray tagId;
+    ReaderTimestamp time;
+};
+
+const size_t kTimestampSize = 6;
+
+// A parsed packet from the reader, the counterpart of IDBlueResponse.
+struct ReaderResponse {
+    uint8_t command;            // command this answers, or the failed one for a NACK
+    uint16_t status;            // kStatusOk unless a NACK
+    bool async;                 // preceded by the async marker packet
+    ByteArray payload;
+    ArenaPtr<TagRead> tag;      // for responses that carry a tag read
+};
+
+// ResponseFactory turns packets into responses, the way the SDK's
+// ResponseFactory maps command identifiers to response classes; the
+// CommandTable says how each is parsed, and an answer shorter than its row
+// allows is dropped as malformed. A NACK
+// (header kCmdNack, payload: failed command, status MSB, LSB) becomes a
+// response to the failed command with its status.
+//
+// Responses and their tag reads live in the session's arena; they are
+// released with the returned pointer and the memory is reused once the
+// session resets the arena.
+class ResponseFactory {
+public:
+    ArenaPtr<ReaderResponse> createResponse(const PacketView& packet, bool async, Arena& arena) const;
+
+    static bool carriesTagRead(uint8_t command);
+};
+
+// Builders for packets in either direction. Each returns the packet size
+// written to out (kMaxPacketSize bytes), or 0 if the data does not fit.
+size_t encodeTagRead(uint8_t command, const uint8_t* tagId, size_t tagIdLength,
+                     const ReaderTimestamp& time, uint8_t* out);
+size_t encodeNack(uint8_t failedCommand, uint16_t status, uint8_t* out);
+// The marker packet that precedes an asynchronous response
+size_t encodeAsyncMarker(uint8_t* out);
+
+bool parseTagRead(const uint8_t* payload, size_t length, TagRead& read);
+
+}
+
+#endif
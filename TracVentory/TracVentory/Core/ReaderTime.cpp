@@ -0,0 +1,92 @@
+//
+//  ReaderTime.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "ReaderTime.h"
+
+namespace flx {
+
+// Howard Hinnant's days_from_civil: years start in March so the leap day
+// is last, and a 400-year era has a fixed number of days.
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+    unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    unsigned monthIndex = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2);
+}
+
+int64_t timestampToEpoch(const ReaderTimestamp& time, int32_t utcOffset) {
+    int64_t days = daysFromCivil(2000 + time.year, time.month, time.day);
+    return days * 86400 + time.hour * 3600 + time.minute * 60 + time.second - utcOffset;
+}
+
+ReaderTimestamp timestampFromEpoch(int64_t seconds, int32_t utcOffset) {
+    int64_t local = seconds + utcOffset;
+    int64_t days = (local >= 0 ? local : local - 86399) / 86400;
+    int64_t secondOfDay = local - days * 86400;
+
+    int64_t year;
+    unsigned month;
+    unsigned day;
+    civilFromDays(days, year, month, day);
+
+    ReaderTimestamp time;
+    if (year < 2000) {
+        ReaderTimestamp first = { 0, 1, 1, 0, 0, 0 };
+        return first;
+    }
+    if (year > 2255) {
+        ReaderTimestamp last = { 255, 12, 31, 23, 59, 59 };
+        return last;
+    }
+    time.year = static_cast<uint8_t>(year - 2000);
+    time.month = static_cast<uint8_t>(month);
+    time.day = static_cast<uint8_t>(day);
+    time.hour = static_cast<uint8_t>(secondOfDay / 3600);
+    time.minute = static_cast<uint8_t>(secondOfDay / 60 % 60);
+    time.second = static_cast<uint8_t>(secondOfDay % 60);
+    return time;
+}
+
+bool isValidTimestamp(const ReaderTimestamp& time) {
+    static const uint8_t kDaysInMonth[12] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (time.month < 1 || time.month > 12 || time.day < 1 || time.day > kDaysInMonth[time.month - 1] ||
+        time.hour > 23 || time.minute > 59 || time.second > 59) {
+        return false;
+    }
+    unsigned year = 2000 + time.year;
+    bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    return time.month != 2 || time.day < 29 || leap;
+}
+
+size_t timestampsToEpoch(const ReaderTimestamp* times, size_t count,
+                         const UtcOffsetWindow& window, int64_t* out) {
+    for (size_t i = 0; i < count; i++) {
+        int64_t seconds = timestampToEpoch(times[i], window.offset);
+        if (!window.covers(seconds)) {
+            return i;
+        }
+        out[i] = seconds;
+    }
+    return count;
+}
+
+}
@@ -0,0 +1,54 @@
+//
+//  ReaderTime.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_ReaderTime_h
+#define TracVentory_ReaderTime_h
+
+#include "ReaderProtocol.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flx {
+
+// Conversions between reader timestamps (local civil time, year from 2000)
+// and Unix time, done arithmetically on the six bytes instead of through a
+// calendar. utcOffset is the local time zone's offset from UTC in seconds
+// (east positive) at the instant converted.
+
+// Days from 1970-01-01 to a proleptic Gregorian date
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day);
+void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day);
+
+int64_t timestampToEpoch(const ReaderTimestamp& time, int32_t utcOffset);
+// Years outside 2000-2255 are clamped.
+ReaderTimestamp timestampFromEpoch(int64_t seconds, int32_t utcOffset);
+
+// Validate the bytes as a date the reader could have produced
+bool isValidTimestamp(const ReaderTimestamp& time);
+
+// A UTC offset that is right for a span of time, e.g. until the next
+// daylight saving transition. The owner refreshes it when an instant falls
+// outside [validFrom, validUntil).
+struct UtcOffsetWindow {
+    int64_t validFrom;
+    int64_t validUntil;
+    int32_t offset;
+
+    bool covers(int64_t seconds) const { return seconds >= validFrom && seconds < validUntil; }
+};
+
+// Convert count timestamps. Returns the number converted with window's
+// offset; conversion stops at the first one whose instant falls outside
+// the window, so the caller can refresh it and continue from there.
+size_t timestampsToEpoch(const ReaderTimestamp* times, size_t count,
+                         const UtcOffsetWindow& window, int64_t* out);
+
+}
+
+#endif
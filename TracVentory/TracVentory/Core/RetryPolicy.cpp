@@ -0,0 +1,53 @@
+//
+//  RetryPolicy.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "RetryPolicy.h"
+#include "CommandTable.h"
+
+namespace flx {
+
+// Long enough for a Bluetooth retransmit, short enough that a user waiting
+// on a scan does not notice three of them
+const RetryPolicy RetryPolicyTable::kDefaultPolicy = { 3, 20, 200 };
+const RetryPolicy RetryPolicyTable::kNoRetries = { 0, 0, 0 };
+
+uint64_t RetryPolicy::backoffNanoseconds(uint8_t retry) const {
+    uint64_t ms = initialBackoffMs;
+    for (uint8_t i = 1; i < retry && ms < maxBackoffMs; i++) {
+        ms *= 2;
+    }
+    if (ms > maxBackoffMs) {
+        ms = maxBackoffMs;
+    }
+    return ms * 1000000ull;
+}
+
+bool isTransientStatus(uint16_t status) {
+    switch (status) {
+        case kStatusTimeout:
+        case kStatusChecksumFailed:
+        case kStatusBufferOverflow:
+        case kStatusIncompleteOperation:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isIdempotentCommand(uint8_t command) {
+    const CommandDescriptor* descriptor = CommandTable::describe(command);
+    return descriptor && descriptor->has(kCommandRetriable);
+}
+
+RetryPolicyTable::RetryPolicyTable() {
+    for (int command = 0; command < 256; command++) {
+        policies_[command] = isIdempotentCommand(static_cast<uint8_t>(command)) ? kDefaultPolicy : kNoRetries;
+    }
+}
+
+}
@@ -0,0 +1,56 @@
+//
+//  RetryPolicy.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_RetryPolicy_h
+#define TracVentory_RetryPolicy_h
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flx {
+
+// How often a NACKed command is sent again before its NACK is reported.
+// Resends wait initialBackoffMs, doubling each time up to maxBackoffMs.
+struct RetryPolicy {
+    uint8_t maxRetries;         // 0: report the first NACK
+    uint32_t initialBackoffMs;
+    uint32_t maxBackoffMs;
+
+    // Wait before resend number retry (1-based)
+    uint64_t backoffNanoseconds(uint8_t retry) const;
+};
+
+// Statuses a resend can cure: a corrupted or dropped packet, a busy reader
+// or a tag that left the field mid-operation. Everything else (invalid
+// command, index or value, not permitted, no data) fails the same way again.
+bool isTransientStatus(uint16_t status);
+
+// Commands that read or set state and so can be repeated safely (marked
+// kCommandRetriable in the CommandTable). ClearEntries, writes and power
+// or Bluetooth changes are not.
+bool isIdempotentCommand(uint8_t command);
+
+// The policy per command: a few quick resends for idempotent commands, none
+// for the rest. Entries can be changed with set().
+class RetryPolicyTable {
+public:
+    RetryPolicyTable();
+
+    void set(uint8_t command, const RetryPolicy& policy) { policies_[command] = policy; }
+    const RetryPolicy& get(uint8_t command) const { return policies_[command]; }
+
+    static const RetryPolicy kDefaultPolicy;
+    static const RetryPolicy kNoRetries;
+
+private:
+    RetryPolicy policies_[256];
+};
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+//
+//  ScanEventBus.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "ScanEventBus.h"
+
+#include <cstring>
+
+namespace flx {
+
+namespace {
+
+// Codes remembered before the consumer first purges expired ones
+const size_t kMinPurge = 1024;
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// FNV-1a of the symbology and bytes: the same code from any source is the
+// same scan
+uint64_t codeHash(const ScanEvent& event) {
+    uint64_t hash = 14695981039346656037ULL;
+    hash = (hash ^ event.symbology) * 1099511628211ULL;
+    for (size_t i = 0; i < event.length; i++) {
+        hash = (hash ^ event.bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+}
+
+ScanEventQueue::ScanEventQueue(size_t capacity)
+    : cells_(new Cell[roundUpToPowerOfTwo(capacity)]), mask_(roundUpToPowerOfTwo(capacity) - 1), tail_(0), head_(0) {
+    for (size_t i = 0; i <= mask_; i++) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool ScanEventQueue::push(const ScanEvent& event) {
+    size_t position = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells_[position & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        ptrdiff_t difference = static_cast<ptrdiff_t>(sequence - position);
+        if (difference == 0) {
+            // The cell is free for this lap; claim it
+            if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                memcpy(&cell.event, &event, offsetof(ScanEvent, bytes) + event.length);
+                cell.event.sequence = position;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0) {
+            // The consumer has not yet emptied the cell from the last lap
+            return false;
+        }
+        else {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ScanEventQueue::pop(ScanEvent& event) {
+    Cell& cell = cells_[head_ & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (static_cast<ptrdiff_t>(sequence - (head_ + 1)) < 0) {
+        // Empty, or claimed by a producer still copying in
+        return false;
+    }
+    memcpy(&event, &cell.event, offsetof(ScanEvent, bytes) + cell.event.length);
+    cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    head_++;
+    return true;
+}
+
+ScanEventBus::ScanEventBus(size_t capacity, uint64_t dedupWindowUs)
+    : queue_(capacity), pending_(false), dropped_(0), delivered_(0), duplicates_(0),
+      dedupWindowUs_(dedupWindowUs), purgeAt_(kMinPurge) {
+}
+
+bool ScanEventBus::publish(ScanSource source, ScanSymbology symbology, const uint8_t* bytes, size_t length,
+                           uint64_t timeUs, bool& wake) {
+    wake = false;
+    if (length > kMaxScanBytes) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    ScanEvent event;
+    event.sequence = 0;
+    event.timeUs = timeUs;
+    event.source = source;
+    event.symbology = symbology;
+    event.length = static_cast<uint16_t>(length);
+    memcpy(event.bytes, bytes, length);
+    if (!queue_.push(event)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // Either the consumer cleared pending_ before this, and we wake it, or
+    // it clears it after and so sees the event pushed above
+    wake = !pending_.exchange(true, std::memory_order_acq_rel);
+    return true;
+}
+
+size_t ScanEventBus::drain(const std::function<void(const ScanEvent& event)>& deliver) {
+    pending_.exchange(false, std::memory_order_acq_rel);
+    size_t delivered = 0;
+    size_t duplicates = 0;
+    ScanEvent event;
+    while (queue_.pop(event)) {
+        if (isDuplicate(event)) {
+            duplicates++;
+            continue;
+        }
+        deliver(event);
+        delivered++;
+    }
+    delivered_.fetch_add(delivered, std::memory_order_relaxed);
+    duplicates_.fetch_add(duplicates, std::memory_order_relaxed);
+    return delivered;
+}
+
+ScanBusStats ScanEventBus::stats() const {
+    ScanBusStats stats;
+    stats.published = queue_.pushed();
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.delivered = delivered_.load(std::memory_order_relaxed);
+    stats.duplicates = duplicates_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool ScanEventBus::isDuplicate(const ScanEvent& event) {
+    if (dedupWindowUs_ == 0) {
+        return false;
+    }
+    if (lastSeen_.size() >= purgeAt_) {
+        for (std::unordered_map<uint64_t, uint64_t>::iterator it = lastSeen_.begin(); it != lastSeen_.end();) {
+            if (it->second + dedupWindowUs_ <= event.timeUs || it->second >= event.timeUs + dedupWindowUs_) {
+                it = lastSeen_.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+        purgeAt_ = lastSeen_.size() * 2 > kMinPurge ? lastSeen_.size() * 2 : kMinPurge;
+    }
+    // A code still being read (a pen held over a tag, a barcode in view)
+    // stays a duplicate until it has been out of sight for the window
+    std::pair<std::unordered_map<uint64_t, uint64_t>::iterator, bool> entry =
+        lastSeen_.insert(std::make_pair(codeHash(event), event.timeUs));
+    if (entry.second) {
+        return false;
+    }
+    uint64_t last = entry.first->second;
+    // Sources' reads can arrive a little out of order, and the wall clock
+    // can be set back: a read from well before the last is a new one
+    bool duplicate = event.timeUs < last + dedupWindowUs_ && event.timeUs + dedupWindowUs_ > last;
+    if (event.timeUs > last || !duplicate) {
+        entry.first->second = event.timeUs;
+    }
+    return duplicate;
+}
+
+}
@@ -0,0 +1,137 @@
+//
+//  ScanEventBus.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_ScanEventBus_h
+#define TracVentory_ScanEventBus_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+namespace flx {
+
+enum ScanSource : uint8_t {
+    kScanSourceIdBlue = 1,      // IDBLUE RFID pen
+    kScanSourceLinea,           // Linea Pro sled: barcodes and its RFID head
+    kScanSourceCamera,
+    kScanSourceSimulated        // tests and benchmarks
+};
+
+enum ScanSymbology : uint8_t {
+    kSymbologyEpc = 1,          // bytes are the tag id
+    kSymbologyEan13,            // bytes are the printed text, as for the rest
+    kSymbologyEan8,
+    kSymbologyUpcA,
+    kSymbologyCode128,
+    kSymbologyQr
+};
+
+const size_t kMaxScanBytes = 236;      // a ScanEvent is 256 bytes
+
+struct ScanEvent {
+    uint64_t sequence;          // position in the queue: the order across all sources
+    uint64_t timeUs;            // when the source read it, microseconds since 1970 by the wall
+                                // clock (IDBLUE's own, to the second); not monotonic
+    ScanSource source;
+    ScanSymbology symbology;
+    uint16_t length;
+    uint8_t bytes[kMaxScanBytes];
+};
+
+// ScanEventQueue is a bounded multi-producer, single-consumer queue of
+// ScanEvents in a ring of cells, each with its own sequence number (Vyukov's
+// design). A producer claims a cell with one compare-and-swap on the tail and
+// publishes it by storing the cell's sequence; the consumer alone moves the
+// head. Neither side locks or allocates, and a full queue is reported rather
+// than waited on.
+class ScanEventQueue {
+public:
+    // capacity is rounded up to a power of two
+    explicit ScanEventQueue(size_t capacity);
+
+    // Any thread. Copies event in, numbering it with its position in the
+    // queue. False if the queue is full.
+    bool push(const ScanEvent& event);
+    // The consumer only. False if the queue is empty.
+    bool pop(ScanEvent& event);
+
+    size_t capacity() const { return mask_ + 1; }
+    // Events pushed so far
+    uint64_t pushed() const { return tail_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        ScanEvent event;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    // Keep the producers' tail and the consumer's head on separate cache lines
+    char padding0_[64];
+    std::atomic<size_t> tail_;
+    char padding1_[64];
+    size_t head_;
+};
+
+struct ScanBusStats {
+    uint64_t published;
+    uint64_t dropped;           // the queue was full, or the scan too long
+    uint64_t delivered;
+    uint64_t duplicates;        // the same code again within the dedup window
+};
+
+// ScanEventBus is where every scanner publishes what it reads: the RFID pen,
+// a Linea sled, the camera or a simulated source, from whatever thread it
+// calls back on. Events go through a ScanEventQueue to a single consumer,
+// which drops a code read again within the dedup window (a pen held over a
+// tag, a barcode in view for several frames, one tag read by two readers)
+// and hands the rest on in order.
+//
+// publish returns whether the consumer needs waking: the first event after a
+// drain asks for it, later ones ride along, so a burst of scans schedules
+// one drain rather than one per scan.
+class ScanEventBus {
+public:
+    explicit ScanEventBus(size_t capacity = 1024, uint64_t dedupWindowUs = 1000000);
+
+    // Any thread. Sets wake when the caller must schedule a drain. False if
+    // the event was dropped.
+    bool publish(ScanSource source, ScanSymbology symbology, const uint8_t* bytes, size_t length,
+                 uint64_t timeUs, bool& wake);
+
+    // The consumer only. Hands every queued event that is not a duplicate
+    // to deliver, oldest first; returns the number delivered.
+    size_t drain(const std::function<void(const ScanEvent& event)>& deliver);
+    // The consumer only.
+    void setDedupWindow(uint64_t windowUs) { dedupWindowUs_ = windowUs; }
+
+    // Any thread
+    ScanBusStats stats() const;
+
+private:
+    bool isDuplicate(const ScanEvent& event);
+
+    ScanEventQueue queue_;
+    std::atomic<bool> pending_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> delivered_;
+    std::atomic<uint64_t> duplicates_;
+
+    // The consumer's: when each code was last delivered, by its hash
+    std::unordered_map<uint64_t, uint64_t> lastSeen_;
+    uint64_t dedupWindowUs_;
+    size_t purgeAt_;
+};
+
+}
+
+#endif
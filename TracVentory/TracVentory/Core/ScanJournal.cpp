@@ -0,0 +1,435 @@
+//
+//  ScanJournal.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "ScanJournal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace flx {
+
+namespace {
+
+const char kJournalMagic[8] = { 'F', 'L', 'X', 'J', 'R', 'N', '0', '1' };
+const size_t kAppliedOffset = 8;
+const size_t kNextSequenceOffset = 16;
+
+struct Crc32Table {
+    uint32_t entries[256];
+
+    Crc32Table() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ (crc & 1 ? 0xEDB88320u : 0);
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+const Crc32Table crcTable;
+
+inline size_t paddedRecordSize(size_t length) {
+    return (kJournalRecordHeaderSize + length + 7) & ~static_cast<size_t>(7);
+}
+
+inline uint64_t readU64(const uint8_t* p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline void writeU64(uint8_t* p, uint64_t value) {
+    memcpy(p, &value, sizeof(value));
+}
+
+uint32_t recordChecksum(uint64_t sequence, const uint8_t* data, size_t length) {
+    uint8_t bytes[8];
+    writeU64(bytes, sequence);
+    return crc32(data, length, crc32(bytes, sizeof(bytes)));
+}
+
+uint64_t steadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+uint32_t crc32(const void* data, size_t length, uint32_t crc) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = crcTable.entries[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+ScanJournal::ScanJournal()
+    : fd_(-1), base_(NULL), fileSize_(0), end_(0), syncedEnd_(0), appliedEnd_(0),
+      nextSequence_(1), durableSequence_(0), appliedSequence_(0),
+      headerDirty_(false), commitRequested_(false), stopping_(false) {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+ScanJournal::~ScanJournal() {
+    close();
+}
+
+bool ScanJournal::open(const std::string& path, const JournalOptions& options) {
+    if (base_) {
+        return false;
+    }
+    options_ = options;
+    if (options_.growBytes < 4096) {
+        options_.growBytes = 4096;
+    }
+    if (!mapFile(path)) {
+        return false;
+    }
+    path_ = path;
+    stats_.recoveredRecords = recover();
+    stopping_ = false;
+    thread_ = std::thread(&ScanJournal::commitLoop, this);
+    return true;
+}
+
+void ScanJournal::close() {
+    if (thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+    std::lock_guard<std::mutex> mapLock(mapMutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    unmapFile();
+    durable_.notify_all();
+}
+
+bool ScanJournal::mapFile(const std::string& path) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(fd_, &status) != 0) {
+        unmapFile();
+        return false;
+    }
+    fileSize_ = static_cast<size_t>(status.st_size);
+    bool created = fileSize_ < kJournalHeaderSize;
+    if (created) {
+        fileSize_ = options_.growBytes;
+        if (ftruncate(fd_, fileSize_) != 0) {
+            unmapFile();
+            return false;
+        }
+    }
+    if (fileSize_ > options_.maxBytes) {
+        options_.maxBytes = fileSize_;
+    }
+    // Reserve the whole range once so growing never moves the mapping;
+    // only the pages inside the file are ever touched
+    void* map = mmap(NULL, options_.maxBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (map == MAP_FAILED) {
+        unmapFile();
+        return false;
+    }
+    base_ = static_cast<uint8_t*>(map);
+    if (created) {
+        memcpy(base_, kJournalMagic, sizeof(kJournalMagic));
+        writeU64(base_ + kAppliedOffset, 0);
+        writeU64(base_ + kNextSequenceOffset, 1);
+        msync(base_, kJournalHeaderSize, MS_SYNC);
+    }
+    else if (memcmp(base_, kJournalMagic, sizeof(kJournalMagic)) != 0) {
+        unmapFile();
+        return false;
+    }
+    return true;
+}
+
+void ScanJournal::unmapFile() {
+    if (base_) {
+        msync(base_, end_ > 0 ? end_ : kJournalHeaderSize, MS_SYNC);
+        munmap(base_, options_.maxBytes);
+        base_ = NULL;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+// Find the end of the intact records and cut off whatever follows
+size_t ScanJournal::recover() {
+    appliedSequence_ = readU64(base_ + kAppliedOffset);
+    // The header's next sequence only matters when compaction left no
+    // records; otherwise the records carry it
+    uint64_t headerNext = readU64(base_ + kNextSequenceOffset);
+    size_t offset = kJournalHeaderSize;
+    size_t count = 0;
+    appliedEnd_ = offset;
+    nextSequence_ = 0;
+    while (offset + kJournalRecordHeaderSize <= fileSize_) {
+        uint32_t length;
+        uint32_t checksum;
+        memcpy(&length, base_ + offset, sizeof(length));
+        memcpy(&checksum, base_ + offset + 4, sizeof(checksum));
+        uint64_t sequence = readU64(base_ + offset + 8);
+        if (length == 0 || offset + paddedRecordSize(length) > fileSize_ ||
+            sequence == 0 || (count > 0 && sequence != nextSequence_) ||
+            recordChecksum(sequence, base_ + offset + kJournalRecordHeaderSize, length) != checksum) {
+            break;
+        }
+        offset += paddedRecordSize(length);
+        nextSequence_ = sequence + 1;
+        if (sequence <= appliedSequence_) {
+            appliedEnd_ = offset;
+        }
+        count++;
+    }
+
+    // Anything past the last good record is a torn write (or zeros); zero
+    // it by truncating, then regrow
+    size_t used = offset;
+    size_t written = fileSize_;
+    while (written > used && base_[written - 1] == 0) {
+        written--;
+    }
+    if (written > used) {
+        stats_.truncatedBytes = written - used;
+        size_t size = ((used + options_.growBytes - 1) / options_.growBytes) * options_.growBytes;
+        if (ftruncate(fd_, used) == 0 && ftruncate(fd_, size) == 0) {
+            fsync(fd_);
+            fileSize_ = size;
+        }
+    }
+    nextSequence_ = std::max(std::max(nextSequence_, headerNext), static_cast<uint64_t>(1));
+    end_ = syncedEnd_ = used;
+    durableSequence_ = nextSequence_ - 1;
+    return count;
+}
+
+bool ScanJournal::grow(size_t needed) {
+    if (needed <= fileSize_) {
+        return true;
+    }
+    size_t size = ((needed + options_.growBytes - 1) / options_.growBytes) * options_.growBytes;
+    if (size > options_.maxBytes || ftruncate(fd_, size) != 0) {
+        return false;
+    }
+    fileSize_ = size;
+    return true;
+}
+
+uint64_t ScanJournal::append(const void* data, size_t length) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t size = paddedRecordSize(length);
+    if (!base_ || length == 0 || length > UINT32_MAX || !grow(end_ + size + kJournalRecordHeaderSize)) {
+        stats_.appendFailures++;
+        return 0;
+    }
+    uint64_t sequence = nextSequence_++;
+    uint8_t* record = base_ + end_;
+    uint32_t length32 = static_cast<uint32_t>(length);
+    uint32_t checksum = recordChecksum(sequence, static_cast<const uint8_t*>(data), length);
+    memcpy(record, &length32, sizeof(length32));
+    memcpy(record + 4, &checksum, sizeof(checksum));
+    writeU64(record + 8, sequence);
+    memcpy(record + kJournalRecordHeaderSize, data, length);
+    memset(record + kJournalRecordHeaderSize + length, 0, size - kJournalRecordHeaderSize - length);
+    bool first = end_ == syncedEnd_;
+    end_ += size;
+    stats_.appended++;
+    bool full = sequence - durableSequence_ >= options_.commitRecords;
+    lock.unlock();
+    if (first || full) {
+        wake_.notify_one();
+    }
+    return sequence;
+}
+
+void ScanJournal::commit() {
+    uint64_t sequence = lastSequence();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        commitRequested_ = true;
+    }
+    wake_.notify_one();
+    waitDurable(sequence);
+}
+
+bool ScanJournal::waitDurable(uint64_t sequence) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (base_ && durableSequence_ < sequence) {
+        commitRequested_ = true;
+        wake_.notify_one();
+        durable_.wait(lock);
+    }
+    return durableSequence_ >= sequence;
+}
+
+uint64_t ScanJournal::lastSequence() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nextSequence_ - 1;
+}
+
+uint64_t ScanJournal::durableSequence() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return durableSequence_;
+}
+
+void ScanJournal::markApplied(uint64_t sequence) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!base_ || sequence <= appliedSequence_) {
+        return;
+    }
+    appliedSequence_ = std::min(sequence, nextSequence_ - 1);
+    writeU64(base_ + kAppliedOffset, appliedSequence_);
+    headerDirty_ = true;
+    while (appliedEnd_ < end_) {
+        uint32_t length;
+        memcpy(&length, base_ + appliedEnd_, sizeof(length));
+        if (readU64(base_ + appliedEnd_ + 8) > appliedSequence_) {
+            break;
+        }
+        appliedEnd_ += paddedRecordSize(length);
+    }
+}
+
+uint64_t ScanJournal::appliedSequence() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return appliedSequence_;
+}
+
+size_t ScanJournal::appliedBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return appliedEnd_ - kJournalHeaderSize;
+}
+
+void ScanJournal::syncRange(size_t from, size_t to, bool header) {
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t start = from / pageSize * pageSize;
+    if (to > start) {
+        msync(base_ + start, to - start, MS_SYNC);
+    }
+    if (header && start > 0) {
+        msync(base_, kJournalHeaderSize, MS_SYNC);
+    }
+}
+
+void ScanJournal::commitLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        if (end_ == syncedEnd_ && !headerDirty_ && !commitRequested_) {
+            if (stopping_) {
+                break;
+            }
+            wake_.wait(lock);
+            continue;
+        }
+        // Give a burst its interval to gather, unless enough is waiting
+        if (!stopping_ && !commitRequested_ && nextSequence_ - 1 - durableSequence_ < options_.commitRecords) {
+            wake_.wait_for(lock, std::chrono::milliseconds(options_.commitIntervalMs), [this] {
+                return stopping_ || commitRequested_ || nextSequence_ - 1 - durableSequence_ >= options_.commitRecords;
+            });
+        }
+        commitRequested_ = false;
+        lock.unlock();
+
+        // The map lock keeps compact() from moving the mapping mid-sync
+        std::lock_guard<std::mutex> mapLock(mapMutex_);
+        lock.lock();
+        if (!base_) {
+            break;
+        }
+        size_t from = syncedEnd_;
+        size_t to = end_;
+        uint64_t sequence = nextSequence_ - 1;
+        bool header = headerDirty_;
+        headerDirty_ = false;
+        lock.unlock();
+
+        uint64_t start = steadyNanoseconds();
+        syncRange(from, to, header);
+        uint64_t elapsed = steadyNanoseconds() - start;
+
+        lock.lock();
+        syncedEnd_ = std::max(syncedEnd_, to);
+        durableSequence_ = std::max(durableSequence_, sequence);
+        stats_.commits++;
+        stats_.maxCommitNs = std::max(stats_.maxCommitNs, elapsed);
+        durable_.notify_all();
+    }
+}
+
+bool ScanJournal::compact() {
+    std::lock_guard<std::mutex> mapLock(mapMutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!base_) {
+        return false;
+    }
+    std::string temporary = path_ + ".compact";
+    int fd = ::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t live = end_ - appliedEnd_;
+    size_t size = ((kJournalHeaderSize + live + options_.growBytes - 1) / options_.growBytes) * options_.growBytes;
+    uint8_t header[kJournalHeaderSize];
+    memset(header, 0, sizeof(header));
+    memcpy(header, kJournalMagic, sizeof(kJournalMagic));
+    writeU64(header + kAppliedOffset, appliedSequence_);
+    writeU64(header + kNextSequenceOffset, nextSequence_);
+    bool written = ftruncate(fd, size) == 0 &&
+                   pwrite(fd, header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                   (live == 0 || pwrite(fd, base_ + appliedEnd_, live, kJournalHeaderSize) == static_cast<ssize_t>(live)) &&
+                   fsync(fd) == 0;
+    // Map the new file before it replaces the old one, so a failure at any
+    // step leaves the journal on its current mapping
+    void* map = written ? mmap(NULL, options_.maxBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (map == MAP_FAILED || rename(temporary.c_str(), path_.c_str()) != 0) {
+        if (map != MAP_FAILED) {
+            munmap(map, options_.maxBytes);
+        }
+        ::close(fd);
+        unlink(temporary.c_str());
+        return false;
+    }
+
+    // Everything is durable in the new file; switch to it
+    munmap(base_, options_.maxBytes);
+    ::close(fd_);
+    base_ = static_cast<uint8_t*>(map);
+    fd_ = fd;
+    fileSize_ = size;
+    end_ = syncedEnd_ = kJournalHeaderSize + live;
+    appliedEnd_ = kJournalHeaderSize;
+    durableSequence_ = nextSequence_ - 1;
+    headerDirty_ = false;
+    stats_.compactions++;
+    return true;
+}
+
+JournalStats ScanJournal::stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+}
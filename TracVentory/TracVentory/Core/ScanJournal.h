@@ -0,0 +1,158 @@
+//
+//  ScanJournal.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_ScanJournal_h
+#define TracVentory_ScanJournal_h
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace flx {
+
+uint32_t crc32(const void* data, size_t length, uint32_t crc = 0);
+
+struct JournalOptions {
+    size_t commitRecords;       // sync once this many records are waiting...
+    uint32_t commitIntervalMs;  // ...or this long after the first of them
+    size_t growBytes;           // file growth step
+    size_t maxBytes;            // address space reserved; appends fail beyond it
+
+    JournalOptions()
+        : commitRecords(256), commitIntervalMs(20), growBytes(1 << 20), maxBytes(64 << 20) {}
+};
+
+struct JournalStats {
+    uint64_t appended;
+    uint64_t appendFailures;    // journal full or closed
+    uint64_t commits;           // syncs to disk
+    uint64_t maxCommitNs;
+    uint64_t recoveredRecords;  // found intact when opened
+    uint64_t truncatedBytes;    // torn tail dropped when opened
+    uint64_t compactions;
+};
+
+// ScanJournal is an append-only log of records (tag events) in a memory
+// mapped file. Appending copies the record into the mapping and returns at
+// once; a commit thread makes appended records durable in groups, syncing
+// when commitRecords are waiting or commitIntervalMs after the first, so
+// the sync cost is shared by every record of a burst.
+//
+// Each record carries its sequence number and a CRC32. Opening a journal
+// walks the records and truncates the file at the first one that is cut
+// short, fails its checksum or is out of sequence: whatever a crash tore
+// mid-write is dropped, everything before it is kept.
+//
+// Records whose effects have reached their destination can be marked
+// applied (the mark is kept in the file header); compact() rewrites the
+// file with only the records after it.
+//
+// File: header (64 bytes: "FLXJRN01", applied sequence, next sequence),
+// then records: length (4), CRC32 of sequence and data (4), sequence (8),
+// data, padded to 8 bytes. A zero length ends the records.
+class ScanJournal {
+public:
+    ScanJournal();
+    ~ScanJournal();
+
+    // Open or create the journal at path and recover it. Starts the
+    // commit thread.
+    bool open(const std::string& path, const JournalOptions& options = JournalOptions());
+    // Commit everything appended and close.
+    void close();
+    bool isOpen() const { return base_ != NULL; }
+
+    // Append a record; returns its sequence number, or 0 if the journal is
+    // closed or full (see compact()). Never waits for the disk.
+    uint64_t append(const void* data, size_t length);
+
+    // Sync everything appended so far now.
+    void commit();
+    // Wait until sequence is durable (false if the journal closed first).
+    bool waitDurable(uint64_t sequence);
+
+    uint64_t lastSequence();
+    uint64_t durableSequence();
+
+    // Records up to sequence no longer need to be kept.
+    void markApplied(uint64_t sequence);
+    uint64_t appliedSequence();
+    // Bytes held by applied records, reclaimable by compact()
+    size_t appliedBytes();
+
+    // Rewrite the journal without its applied records. Appends wait while
+    // it runs.
+    bool compact();
+
+    // Call f(sequence, data, length) for each record in the journal (applied
+    // or not), oldest first. f must not append.
+    template <typename F>
+    size_t forEach(F f);
+
+    JournalStats stats();
+
+private:
+    ScanJournal(const ScanJournal&);
+    ScanJournal& operator=(const ScanJournal&);
+
+    bool mapFile(const std::string& path);
+    void unmapFile();
+    size_t recover();
+    bool grow(size_t needed);
+    void commitLoop();
+    void syncRange(size_t from, size_t to, bool header);
+
+    std::string path_;
+    JournalOptions options_;
+    int fd_;
+    uint8_t* base_;
+    size_t fileSize_;
+
+    std::mutex mapMutex_;               // held while syncing, so the mapping stays put
+    std::mutex mutex_;                  // everything below
+    std::condition_variable wake_;      // commit thread: records waiting, or stop
+    std::condition_variable durable_;   // waiters: durableSequence_ advanced
+    size_t end_;
+    size_t syncedEnd_;
+    size_t appliedEnd_;                 // offset after the last applied record
+    uint64_t nextSequence_;
+    uint64_t durableSequence_;
+    uint64_t appliedSequence_;
+    bool headerDirty_;
+    bool commitRequested_;
+    bool stopping_;
+    JournalStats stats_;
+    std::thread thread_;
+};
+
+const size_t kJournalHeaderSize = 64;
+const size_t kJournalRecordHeaderSize = 16;
+
+template <typename F>
+size_t ScanJournal::forEach(F f) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (size_t offset = kJournalHeaderSize; offset < end_; ) {
+        uint32_t length;
+        uint64_t sequence;
+        memcpy(&length, base_ + offset, sizeof(length));
+        memcpy(&sequence, base_ + offset + 8, sizeof(sequence));
+        f(sequence, base_ + offset + kJournalRecordHeaderSize, static_cast<size_t>(length));
+        offset += (kJournalRecordHeaderSize + length + 7) & ~static_cast<size_t>(7);
+        count++;
+    }
+    return count;
+}
+
+}
+
+#endif
@@ -0,0 +1,133 @@
+//
+//  ScanLatency.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "ScanLatency.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace flx {
+
+namespace {
+
+bool append(uint8_t* out, size_t capacity, size_t& offset, const uint8_t* packet, size_t size) {
+    if (size == 0 || offset + size > capacity) {
+        return false;
+    }
+    memcpy(out + offset, packet, size);
+    offset += size;
+    return true;
+}
+
+double percentileMs(const std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+    return sorted[index] / 1e6;
+}
+
+}
+
+size_t encodeButtonScan(uint64_t index, const ReaderTimestamp& time, uint8_t* out, size_t capacity) {
+    uint8_t tagId[kScanProbeTagSize];
+    memcpy(tagId, kScanProbePrefix, sizeof(kScanProbePrefix));
+    for (size_t i = 0; i < 8; i++) {
+        tagId[sizeof(kScanProbePrefix) + i] = static_cast<uint8_t>(index >> ((7 - i) * 8));
+    }
+
+    uint8_t packet[kMaxPacketSize];
+    size_t offset = 0;
+    if (!append(out, capacity, offset, packet, encodeAsyncMarker(packet)) ||
+        !append(out, capacity, offset, packet, encodePacket(kCmdButton, NULL, 0, packet)) ||
+        !append(out, capacity, offset, packet, encodeAsyncMarker(packet)) ||
+        !append(out, capacity, offset, packet, encodeTagRead(kCmdGetTagId, tagId, sizeof(tagId), time, packet))) {
+        return 0;
+    }
+    return offset;
+}
+
+bool scanProbeIndex(const uint8_t* tagId, size_t length, uint64_t& index) {
+    if (length != kScanProbeTagSize || memcmp(tagId, kScanProbePrefix, sizeof(kScanProbePrefix)) != 0) {
+        return false;
+    }
+    index = 0;
+    for (size_t i = sizeof(kScanProbePrefix); i < length; i++) {
+        index = (index << 8) | tagId[i];
+    }
+    return true;
+}
+
+ScanLatencyRecorder::ScanLatencyRecorder(size_t scans, double frameIntervalMs)
+    : injectedAt_(scans), observedAt_(scans), observedCount_(0), frameIntervalNs_(frameIntervalMs * 1e6),
+      lastFrame_(0), frames_(0), droppedFrames_(0), longestFrame_(0) {
+    for (size_t i = 0; i < scans; i++) {
+        injectedAt_[i].store(0, std::memory_order_relaxed);
+        observedAt_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void ScanLatencyRecorder::injected(uint64_t index, uint64_t ns) {
+    if (index < injectedAt_.size()) {
+        injectedAt_[index].store(ns, std::memory_order_release);
+    }
+}
+
+bool ScanLatencyRecorder::observed(uint64_t index, uint64_t ns) {
+    if (index >= observedAt_.size()) {
+        return false;
+    }
+    // 0 means not yet; a clock that reads 0 still counts
+    uint64_t expected = 0;
+    if (!observedAt_[index].compare_exchange_strong(expected, ns ? ns : 1, std::memory_order_acq_rel)) {
+        return false;
+    }
+    observedCount_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void ScanLatencyRecorder::frame(uint64_t ns) {
+    if (frames_ > 0 && ns > lastFrame_) {
+        uint64_t elapsed = ns - lastFrame_;
+        longestFrame_ = std::max(longestFrame_, elapsed);
+        // Callbacks jitter; only a whole missed interval is a dropped frame
+        size_t intervals = static_cast<size_t>(elapsed / frameIntervalNs_ + 0.5);
+        if (intervals > 1) {
+            droppedFrames_ += intervals - 1;
+        }
+    }
+    lastFrame_ = ns;
+    frames_++;
+}
+
+ScanLatencyReport ScanLatencyRecorder::report() const {
+    std::vector<uint64_t> latencies;
+    latencies.reserve(observedAt_.size());
+    for (size_t i = 0; i < observedAt_.size(); i++) {
+        uint64_t observed = observedAt_[i].load(std::memory_order_acquire);
+        uint64_t injected = injectedAt_[i].load(std::memory_order_acquire);
+        if (observed) {
+            latencies.push_back(observed > injected ? observed - injected : 0);
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    ScanLatencyReport report;
+    report.scans = observedAt_.size();
+    report.observed = latencies.size();
+    report.p50Ms = percentileMs(latencies, 0.50);
+    report.p90Ms = percentileMs(latencies, 0.90);
+    report.p99Ms = percentileMs(latencies, 0.99);
+    report.maxMs = latencies.empty() ? 0 : latencies.back() / 1e6;
+    report.frames = frames_;
+    report.droppedFrames = droppedFrames_;
+    report.longestFrameMs = longestFrame_ / 1e6;
+    return report;
+}
+
+}
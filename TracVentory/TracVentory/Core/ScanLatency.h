@@ -0,0 +1,83 @@
+//
+//  ScanLatency.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_ScanLatency_h
+#define TracVentory_ScanLatency_h
+
+#include "ReaderProtocol.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace flx {
+
+// What a user-triggered scan looks like on the wire: the reader reports the
+// button press (an async kCmdButton), then the tag it read (an async
+// kCmdGetTagId). Harness tags carry kScanProbePrefix and the scan index, so
+// whoever observes one knows which scan it was. Returns the bytes written to
+// out (2 * kMaxPacketSize will do), 0 if they do not fit.
+size_t encodeButtonScan(uint64_t index, const ReaderTimestamp& time, uint8_t* out, size_t capacity);
+
+const uint8_t kScanProbePrefix[] = { 0xF1, 0x0A, 0x7E, 0x5C };
+const size_t kScanProbeTagSize = sizeof(kScanProbePrefix) + 8;
+
+// The scan index of a harness tag; false for any other tag.
+bool scanProbeIndex(const uint8_t* tagId, size_t length, uint64_t& index);
+
+struct ScanLatencyReport {
+    size_t scans;
+    size_t observed;            // scans the UI handler saw
+    double p50Ms;               // injected to observed
+    double p90Ms;
+    double p99Ms;
+    double maxMs;
+    size_t frames;              // display refreshes that ran
+    size_t droppedFrames;       // refreshes that should have run but did not
+    double longestFrameMs;
+};
+
+// ScanLatencyRecorder times scans from injection to the moment the UI-bound
+// handler observes them, and watches the display refresh while they run.
+// injected() and observed() may be called from different threads; frame()
+// and report() belong to the thread that drives the display (the main
+// thread in the app). Times are monotonic nanoseconds.
+//
+// A refresh callback that arrives n intervals after the previous one means
+// n - 1 frames were dropped: the thread was busy when they were due.
+class ScanLatencyRecorder {
+public:
+    explicit ScanLatencyRecorder(size_t scans, double frameIntervalMs = 1000.0 / 60);
+
+    void injected(uint64_t index, uint64_t ns);
+    // The first observation of a scan counts; returns false for repeats and
+    // indexes out of range.
+    bool observed(uint64_t index, uint64_t ns);
+    void frame(uint64_t ns);
+
+    size_t observedCount() const { return observedCount_.load(std::memory_order_acquire); }
+    ScanLatencyReport report() const;
+
+private:
+    ScanLatencyRecorder(const ScanLatencyRecorder&);
+    ScanLatencyRecorder& operator=(const ScanLatencyRecorder&);
+
+    std::vector<std::atomic<uint64_t> > injectedAt_;
+    std::vector<std::atomic<uint64_t> > observedAt_;
+    std::atomic<size_t> observedCount_;
+    double frameIntervalNs_;
+    uint64_t lastFrame_;
+    size_t frames_;
+    size_t droppedFrames_;
+    uint64_t longestFrame_;
+};
+
+}
+
+#endif
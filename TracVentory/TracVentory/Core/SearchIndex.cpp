@@ -0,0 +1,282 @@
+//
+//  SearchIndex.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "SearchIndex.h"
+
+#include <algorithm>
+
+namespace flx {
+
+namespace {
+
+const float kFieldWeights[kSearchFieldCount] = {
+    8.0f,   // kSearchFieldItemId
+    4.0f,   // kSearchFieldMake
+    4.0f,   // kSearchFieldModel
+    2.0f,   // kSearchFieldCategory
+    1.0f    // kSearchFieldNotes
+};
+
+// Retired postings are only dropped once there are at least this many
+const size_t kMinCompactPostings = 4096;
+
+float bestFieldWeight(uint8_t fields) {
+    for (int field = 0; field < kSearchFieldCount; field++) {
+        if (fields & (1 << field)) {
+            return kFieldWeights[field];
+        }
+    }
+    return 0.0f;
+}
+
+bool termHasPrefix(const std::string& term, const std::string& prefix) {
+    return term.size() >= prefix.size() && term.compare(0, prefix.size(), prefix) == 0;
+}
+
+}
+
+SearchIndex::SearchIndex()
+    : livePostings_(0), deadPostings_(0), tick_(0) {
+}
+
+void SearchIndex::tokenize(const std::string& text, std::vector<std::string>& tokens) {
+    std::string token;
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 'A' && c <= 'Z') {
+            token.push_back(static_cast<char>(c - 'A' + 'a'));
+        }
+        else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c >= 0x80) {
+            token.push_back(static_cast<char>(c));
+        }
+        else if (!token.empty()) {
+            tokens.push_back(token);
+            token.clear();
+        }
+    }
+    if (!token.empty()) {
+        tokens.push_back(token);
+    }
+}
+
+void SearchIndex::put(const std::string& key, const SearchDocument& document) {
+    std::unordered_map<std::string, uint32_t>::iterator existing = keyToSlot_.find(key);
+    if (existing != keyToSlot_.end()) {
+        retireSlot(existing->second);
+    }
+
+    // Collect each distinct term with the fields it occurs in
+    std::vector<std::pair<std::string, uint8_t> > documentTerms;
+    std::vector<std::string> tokens;
+    for (int field = 0; field < kSearchFieldCount; field++) {
+        tokens.clear();
+        tokenize(document[field], tokens);
+        for (size_t i = 0; i < tokens.size(); i++) {
+            documentTerms.push_back(std::make_pair(tokens[i], static_cast<uint8_t>(1 << field)));
+        }
+    }
+    std::sort(documentTerms.begin(), documentTerms.end());
+
+    uint32_t slot = static_cast<uint32_t>(slotKeys_.size());
+    uint32_t postings = 0;
+    for (size_t i = 0; i < documentTerms.size(); ) {
+        Posting posting;
+        posting.slot = slot;
+        posting.fields = 0;
+        size_t j = i;
+        while (j < documentTerms.size() && documentTerms[j].first == documentTerms[i].first) {
+            posting.fields |= documentTerms[j].second;
+            j++;
+        }
+        // Slots only grow, so posting lists stay sorted by slot
+        terms_[documentTerms[i].first].push_back(posting);
+        postings++;
+        i = j;
+    }
+
+    slotKeys_.push_back(key);
+    slotPostings_.push_back(postings);
+    slotRetired_.push_back(false);
+    keyToSlot_[key] = slot;
+    livePostings_ += postings;
+}
+
+bool SearchIndex::remove(const std::string& key) {
+    std::unordered_map<std::string, uint32_t>::iterator existing = keyToSlot_.find(key);
+    if (existing == keyToSlot_.end()) {
+        return false;
+    }
+    retireSlot(existing->second);
+    keyToSlot_.erase(existing);
+    return true;
+}
+
+void SearchIndex::clear() {
+    terms_.clear();
+    keyToSlot_.clear();
+    slotKeys_.clear();
+    slotPostings_.clear();
+    slotRetired_.clear();
+    livePostings_ = 0;
+    deadPostings_ = 0;
+}
+
+void SearchIndex::retireSlot(uint32_t slot) {
+    slotKeys_[slot].clear();
+    slotKeys_[slot].shrink_to_fit();
+    livePostings_ -= slotPostings_[slot];
+    deadPostings_ += slotPostings_[slot];
+    slotPostings_[slot] = 0;
+    slotRetired_[slot] = true;
+
+    if (deadPostings_ >= kMinCompactPostings && deadPostings_ > livePostings_) {
+        compact();
+    }
+}
+
+// Renumber the live slots densely and drop the postings of retired ones.
+void SearchIndex::compact() {
+    const uint32_t kRetired = UINT32_MAX;
+    std::vector<uint32_t> remap(slotKeys_.size(), kRetired);
+    std::vector<std::string> slotKeys;
+    std::vector<uint32_t> slotPostings;
+    slotKeys.reserve(keyToSlot_.size());
+    slotPostings.reserve(keyToSlot_.size());
+
+    for (uint32_t slot = 0; slot < slotKeys_.size(); slot++) {
+        if (slotRetired_[slot]) {
+            continue;
+        }
+        remap[slot] = static_cast<uint32_t>(slotKeys.size());
+        keyToSlot_[slotKeys_[slot]] = remap[slot];
+        slotKeys.push_back(slotKeys_[slot]);
+        slotPostings.push_back(slotPostings_[slot]);
+    }
+
+    for (TermMap::iterator term = terms_.begin(); term != terms_.end(); ) {
+        std::vector<Posting>& postings = term->second;
+        size_t kept = 0;
+        for (size_t i = 0; i < postings.size(); i++) {
+            if (remap[postings[i].slot] != kRetired) {
+                postings[kept] = postings[i];
+                postings[kept].slot = remap[postings[i].slot];
+                kept++;
+            }
+        }
+        if (kept == 0) {
+            terms_.erase(term++);
+            continue;
+        }
+        postings.resize(kept);
+        ++term;
+    }
+
+    slotKeys_.swap(slotKeys);
+    slotPostings_.swap(slotPostings);
+    slotRetired_.assign(slotKeys_.size(), false);
+    deadPostings_ = 0;
+}
+
+std::vector<SearchHit> SearchIndex::search(const std::string& query, size_t limit) const {
+    std::vector<SearchHit> hits;
+    std::vector<std::string> tokens;
+    tokenize(query, tokens);
+    if (tokens.empty() || limit == 0) {
+        return hits;
+    }
+
+    // Longest tokens first: they usually cover the fewest postings, and later
+    // tokens only refine the slots the earlier ones matched.
+    std::sort(tokens.begin(), tokens.end(), [](const std::string& a, const std::string& b) {
+        return a.size() != b.size() ? a.size() > b.size() : a < b;
+    });
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+
+    if (scratch_.size() < slotKeys_.size()) {
+        SlotScratch empty = { 0, 0, 0, 0.0f, 0.0f };
+        scratch_.resize(slotKeys_.size(), empty);
+    }
+
+    uint32_t queryTick = ++tick_;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> touched;
+
+    for (size_t t = 0; t < tokens.size(); t++) {
+        const std::string& token = tokens[t];
+        uint32_t tokenTick = ++tick_;
+        touched.clear();
+
+        for (TermMap::const_iterator term = terms_.lower_bound(token); term != terms_.end() && termHasPrefix(term->first, token); ++term) {
+            float coverage = term->first.size() == token.size() ? 1.0f : 0.5f + 0.5f * token.size() / term->first.size();
+            const std::vector<Posting>& postings = term->second;
+            for (size_t i = 0; i < postings.size(); i++) {
+                uint32_t slot = postings[i].slot;
+                SlotScratch& scratch = scratch_[slot];
+                if (t == 0 ? slotRetired_[slot] : (scratch.queryTick != queryTick || scratch.matched != t)) {
+                    continue;
+                }
+                float value = bestFieldWeight(postings[i].fields) * coverage;
+                if (scratch.tokenTick != tokenTick) {
+                    scratch.tokenTick = tokenTick;
+                    scratch.tokenScore = value;
+                    touched.push_back(slot);
+                }
+                else if (value > scratch.tokenScore) {
+                    scratch.tokenScore = value;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < touched.size(); i++) {
+            SlotScratch& scratch = scratch_[touched[i]];
+            if (t == 0) {
+                scratch.queryTick = queryTick;
+                scratch.matched = 0;
+                scratch.score = 0.0f;
+            }
+            scratch.matched++;
+            scratch.score += scratch.tokenScore;
+        }
+        if (t == 0) {
+            candidates.swap(touched);
+        }
+        if (candidates.empty()) {
+            return hits;
+        }
+    }
+
+    // Keep the slots that matched every token
+    size_t kept = 0;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (scratch_[candidates[i]].matched == tokens.size()) {
+            candidates[kept++] = candidates[i];
+        }
+    }
+    candidates.resize(kept);
+
+    // Posting lists are in slot order, so reversed, equal scores arrive newest
+    // first and rarely displace anything already in the top.
+    std::reverse(candidates.begin(), candidates.end());
+
+    const std::vector<SlotScratch>& scratch = scratch_;
+    size_t count = std::min(limit, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), [&scratch](uint32_t a, uint32_t b) {
+        return scratch[a].score != scratch[b].score ? scratch[a].score > scratch[b].score : a > b;
+    });
+
+    hits.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        SearchHit hit;
+        hit.key = slotKeys_[candidates[i]];
+        hit.score = scratch_[candidates[i]].score;
+        hits.push_back(hit);
+    }
+    return hits;
+}
+
+}
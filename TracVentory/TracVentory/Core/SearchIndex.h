@@ -0,0 +1,107 @@
+//
+//  SearchIndex.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_SearchIndex_h
+#define TracVentory_SearchIndex_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flx {
+
+// Indexed item fields, in decreasing ranking weight
+enum SearchField {
+    kSearchFieldItemId = 0,
+    kSearchFieldMake,
+    kSearchFieldModel,
+    kSearchFieldCategory,
+    kSearchFieldNotes,
+    kSearchFieldCount
+};
+
+typedef std::array<std::string, kSearchFieldCount> SearchDocument;
+
+struct SearchHit {
+    std::string key;
+    float score;
+};
+
+// SearchIndex is an inverted index over item text with prefix lookups, for
+// search-as-you-type. Terms live in an ordered map so that all terms starting
+// with a prefix form one contiguous range.
+//
+// Every query token is matched as a prefix and all tokens must match (AND).
+// A document scores, per token, the weight of the best field the token was
+// found in, scaled by how much of the term the token covers; exact terms
+// score highest. Ties go to the most recently put document.
+//
+// Updates are incremental: put() of an existing key retires the old document
+// slot instead of editing posting lists, and retired postings are dropped in
+// one pass once they outnumber live ones.
+//
+// Not thread safe; callers serialize access.
+class SearchIndex {
+public:
+    SearchIndex();
+
+    // Insert or replace the document stored under key.
+    void put(const std::string& key, const SearchDocument& document);
+    bool remove(const std::string& key);
+    void clear();
+
+    size_t size() const { return keyToSlot_.size(); }
+    size_t termCount() const { return terms_.size(); }
+
+    // Best matches for query, highest score first.
+    std::vector<SearchHit> search(const std::string& query, size_t limit) const;
+
+    // Split text into lowercase ASCII alphanumeric runs. Bytes >= 0x80 are
+    // kept as-is so UTF-8 text stays searchable; fold diacritics beforehand.
+    static void tokenize(const std::string& text, std::vector<std::string>& tokens);
+
+private:
+    struct Posting {
+        uint32_t slot;
+        uint8_t fields;   // bit per SearchField containing the term
+    };
+    typedef std::map<std::string, std::vector<Posting> > TermMap;
+
+    void retireSlot(uint32_t slot);
+    void compact();
+
+    TermMap terms_;
+    std::unordered_map<std::string, uint32_t> keyToSlot_;
+    std::vector<std::string> slotKeys_;        // empty once retired
+    std::vector<uint32_t> slotPostings_;       // 0 once retired, or for a document without terms
+    std::vector<bool> slotRetired_;
+    size_t livePostings_;
+    size_t deadPostings_;
+
+    // Per-query state of a slot. Entries are valid only when their tick
+    // matches the current query or token, so nothing is cleared between
+    // queries.
+    struct SlotScratch {
+        uint32_t queryTick;
+        uint32_t tokenTick;
+        uint32_t matched;
+        float tokenScore;
+        float score;
+    };
+
+    mutable std::vector<SlotScratch> scratch_;
+    mutable uint32_t tick_;
+};
+
+}
+
+#endif
@@ -0,0 +1,246 @@
+//
+//  SessionCapture.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "SessionCapture.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace flx {
+
+namespace {
+
+const char kMagic[8] = { 'F', 'L', 'X', 'C', 'A', 'P', '0', '1' };
+const size_t kHeaderSize = 16;
+const size_t kBufferSize = 64 * 1024;
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t* data, size_t size, size_t& offset, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && offset < size; shift += 7) {
+        uint8_t byte = data[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void putUInt64(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+uint64_t getUInt64(const uint8_t* data) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+bool writeAll(int fd, const uint8_t* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, length);
+        if (written < 0) {
+            return false;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+}
+
+uint64_t monotonicNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void sleepUntilMonotonic(uint64_t ns) {
+    uint64_t now = monotonicNanoseconds();
+    if (ns > now) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(ns - now));
+    }
+}
+
+CaptureWriter::CaptureWriter()
+    : fd_(-1), startNs_(0), lastNs_(0), records_(0), bytes_(0) {
+}
+
+CaptureWriter::~CaptureWriter() {
+    close();
+}
+
+bool CaptureWriter::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ >= 0) {
+        return false;
+    }
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    uint8_t header[kHeaderSize];
+    memcpy(header, kMagic, sizeof(kMagic));
+    uint64_t wallClock = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    putUInt64(header + 8, wallClock);
+    if (!writeAll(fd, header, sizeof(header))) {
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    buffer_.clear();
+    buffer_.reserve(kBufferSize);
+    startNs_ = monotonicNanoseconds();
+    lastNs_ = startNs_;
+    records_ = 0;
+    bytes_ = 0;
+    return true;
+}
+
+void CaptureWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        return;
+    }
+    flushLocked();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+void CaptureWriter::record(CaptureDirection direction, const uint8_t* data, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        return;
+    }
+    // Read under the lock, so records racing in from the inbound and
+    // outbound threads are stamped in the order they are written
+    uint64_t now = monotonicNanoseconds();
+    if (buffer_.size() + length + 21 > kBufferSize) {
+        flushLocked();
+    }
+    buffer_.push_back(direction);
+    putVarint(buffer_, now - lastNs_);
+    putVarint(buffer_, length);
+    buffer_.insert(buffer_.end(), data, data + length);
+    lastNs_ = now;
+    records_++;
+    bytes_ += length;
+}
+
+void CaptureWriter::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flushLocked();
+}
+
+void CaptureWriter::flushLocked() {
+    if (fd_ < 0 || buffer_.empty()) {
+        return;
+    }
+    writeAll(fd_, buffer_.data(), buffer_.size());
+    buffer_.clear();
+}
+
+CaptureReader::CaptureReader()
+    : map_(NULL), size_(0), offset_(0), wallClockNs_(0), timestampNs_(0), truncated_(false) {
+}
+
+CaptureReader::~CaptureReader() {
+    close();
+}
+
+bool CaptureReader::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < kHeaderSize) {
+        ::close(fd);
+        return false;
+    }
+    void* map = mmap(NULL, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    map_ = static_cast<const uint8_t*>(map);
+    size_ = static_cast<size_t>(info.st_size);
+    if (memcmp(map_, kMagic, sizeof(kMagic)) != 0) {
+        close();
+        return false;
+    }
+    madvise(const_cast<uint8_t*>(map_), size_, MADV_SEQUENTIAL);
+    wallClockNs_ = getUInt64(map_ + 8);
+    rewind();
+    return true;
+}
+
+void CaptureReader::close() {
+    if (map_) {
+        munmap(const_cast<uint8_t*>(map_), size_);
+    }
+    map_ = NULL;
+    size_ = 0;
+    offset_ = 0;
+}
+
+void CaptureReader::rewind() {
+    offset_ = kHeaderSize;
+    timestampNs_ = 0;
+    truncated_ = false;
+}
+
+bool CaptureReader::next(CaptureRecord& record) {
+    if (!map_ || offset_ >= size_) {
+        return false;
+    }
+    size_t offset = offset_;
+    uint8_t direction = map_[offset++];
+    uint64_t delta;
+    uint64_t length;
+    if (direction > kCaptureOutbound ||
+        !getVarint(map_, size_, offset, delta) ||
+        !getVarint(map_, size_, offset, length) ||
+        length > size_ - offset) {
+        truncated_ = true;
+        offset_ = size_;
+        return false;
+    }
+
+    timestampNs_ += delta;
+    record.direction = static_cast<CaptureDirection>(direction);
+    record.timestampNs = timestampNs_;
+    record.data = map_ + offset;
+    record.length = static_cast<size_t>(length);
+    offset_ = offset + static_cast<size_t>(length);
+    return true;
+}
+
+}
@@ -0,0 +1,129 @@
+//
+//  SessionCapture.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_SessionCapture_h
+#define TracVentory_SessionCapture_h
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace flx {
+
+// Capture file format (little endian):
+//
+//   header  "FLXCAP01", uint64 wall clock at start (ns since 1970)
+//   record  uint8 direction, varint ns since previous record,
+//           varint length, bytes
+//
+// Records are only ever appended. A record cut short by a crash ends the
+// capture; everything before it is still readable.
+enum CaptureDirection : uint8_t {
+    kCaptureInbound = 0,    // reader -> app (onDataReceived:withLen:)
+    kCaptureOutbound = 1    // app -> reader (write:)
+};
+
+struct CaptureRecord {
+    CaptureDirection direction;
+    uint64_t timestampNs;           // since the start of the capture
+    const uint8_t* data;
+    size_t length;
+};
+
+// CaptureWriter appends records through a 64 KB buffer, so recording costs a
+// memcpy per chunk instead of a syscall. Thread safe.
+class CaptureWriter {
+public:
+    CaptureWriter();
+    ~CaptureWriter();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return fd_ >= 0; }
+
+    void record(CaptureDirection direction, const uint8_t* data, size_t length);
+    // Write buffered records to the file.
+    void flush();
+
+    uint64_t recordCount() const { return records_; }
+    uint64_t byteCount() const { return bytes_; }
+
+private:
+    CaptureWriter(const CaptureWriter&);
+    CaptureWriter& operator=(const CaptureWriter&);
+
+    void flushLocked();
+
+    std::mutex mutex_;
+    int fd_;
+    std::vector<uint8_t> buffer_;
+    uint64_t startNs_;
+    uint64_t lastNs_;
+    uint64_t records_;
+    uint64_t bytes_;
+};
+
+// CaptureReader maps a capture file and iterates its records without
+// copying; record data points into the mapping.
+class CaptureReader {
+public:
+    CaptureReader();
+    ~CaptureReader();
+
+    bool open(const std::string& path);
+    void close();
+
+    // Next record, false at the end of the capture.
+    bool next(CaptureRecord& record);
+    void rewind();
+
+    uint64_t startWallClockNs() const { return wallClockNs_; }
+    // True if the capture ended in a partial record
+    bool truncated() const { return truncated_; }
+
+private:
+    CaptureReader(const CaptureReader&);
+    CaptureReader& operator=(const CaptureReader&);
+
+    const uint8_t* map_;
+    size_t size_;
+    size_t offset_;
+    uint64_t wallClockNs_;
+    uint64_t timestampNs_;
+    bool truncated_;
+};
+
+// Replay a capture, calling onRecord(const CaptureRecord&) for every record.
+// With speed 1.0 records are delivered at their recorded pace (2.0 twice as
+// fast, ...); with speed 0 as fast as possible. Returns the record count.
+template <typename F>
+uint64_t replayCapture(CaptureReader& reader, double speed, F onRecord);
+
+uint64_t monotonicNanoseconds();
+void sleepUntilMonotonic(uint64_t ns);
+
+template <typename F>
+uint64_t replayCapture(CaptureReader& reader, double speed, F onRecord) {
+    uint64_t count = 0;
+    uint64_t start = monotonicNanoseconds();
+    CaptureRecord record;
+    while (reader.next(record)) {
+        if (speed > 0) {
+            sleepUntilMonotonic(start + static_cast<uint64_t>(record.timestampNs / speed));
+        }
+        onRecord(record);
+        count++;
+    }
+    return count;
+}
+
+}
+
+#endif
@@ -0,0 +1,401 @@
+//
+//  TagGateway.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "TagGateway.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace flx {
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+const int kSendFlags = MSG_NOSIGNAL;
+#else
+const int kSendFlags = 0;
+#endif
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+void setNoSigPipe(int fd) {
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#else
+    (void) fd;
+#endif
+}
+
+}
+
+TagGateway::TagGateway(size_t queueBytes)
+    : queueBytes_(std::max<size_t>(queueBytes, 2 * (kGatewayFrameHeaderSize + 0xffff))),
+      tcpPort_(0), stopping_(false) {
+    wakePipe_[0] = wakePipe_[1] = -1;
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+TagGateway::~TagGateway() {
+    stop();
+}
+
+bool TagGateway::listenTcp(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    socklen_t length = sizeof(address);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(fd, 16) != 0 || !setNonBlocking(fd) ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        close(fd);
+        return false;
+    }
+    tcpPort_ = ntohs(address.sin_port);
+    listeners_.push_back(fd);
+    return true;
+}
+
+bool TagGateway::listenUnix(const std::string& path) {
+    sockaddr_un address;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(fd, 16) != 0 || !setNonBlocking(fd)) {
+        close(fd);
+        return false;
+    }
+    unixPath_ = path;
+    listeners_.push_back(fd);
+    return true;
+}
+
+bool TagGateway::start() {
+    if (listeners_.empty() || thread_.joinable() || pipe(wakePipe_) != 0) {
+        return false;
+    }
+    setNonBlocking(wakePipe_[0]);
+    setNonBlocking(wakePipe_[1]);
+    stopping_ = false;
+    thread_ = std::thread(&TagGateway::run, this);
+    return true;
+}
+
+void TagGateway::stop() {
+    if (thread_.joinable()) {
+        stopping_ = true;
+        wake();
+        thread_.join();
+    }
+    for (size_t i = 0; i < listeners_.size(); i++) {
+        close(listeners_[i]);
+    }
+    listeners_.clear();
+    if (!unixPath_.empty()) {
+        unlink(unixPath_.c_str());
+        unixPath_.clear();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    // One last write of each queue, drop count included, as far as the
+    // socket takes it without blocking
+    for (size_t i = 0; i < subscribers_.size(); i++) {
+        queueDropNotice(*subscribers_[i], 0);
+        if (subscribers_[i]->size > 0) {
+            flush(*subscribers_[i]);
+        }
+    }
+    while (!subscribers_.empty()) {
+        closeSubscriber(subscribers_.size() - 1);
+    }
+    for (int i = 0; i < 2; i++) {
+        if (wakePipe_[i] >= 0) {
+            close(wakePipe_[i]);
+            wakePipe_[i] = -1;
+        }
+    }
+}
+
+void TagGateway::onResponse(const ReaderCommand&, const ReaderResponse& response) {
+    publishTag(response);
+}
+
+void TagGateway::onAsyncResponse(const ReaderResponse& response) {
+    publishTag(response);
+}
+
+void TagGateway::publishTag(const ReaderResponse& response) {
+    if (!response.tag || response.status != kStatusOk) {
+        return;
+    }
+    const TagRead& read = *response.tag;
+    uint8_t payload[3 + kTimestampSize + 255];
+    size_t idLength = std::min<size_t>(read.tagId.size(), 255);
+    payload[0] = response.command;
+    payload[1] = response.async ? kGatewayFlagAsync : 0;
+    const ReaderTimestamp& time = read.time;
+    uint8_t stamp[kTimestampSize] = { time.year, time.month, time.day, time.hour, time.minute, time.second };
+    memcpy(payload + 2, stamp, kTimestampSize);
+    payload[2 + kTimestampSize] = static_cast<uint8_t>(idLength);
+    memcpy(payload + 3 + kTimestampSize, read.tagId.data(), idLength);
+    publish(kFrameTag, kSubscribeTags, payload, 3 + kTimestampSize + idLength);
+}
+
+void TagGateway::publishRaw(const uint8_t* data, size_t length) {
+    while (length > 0) {
+        size_t chunk = std::min<size_t>(length, 0xffff - 1);
+        publish(kFrameRaw, kSubscribeRaw, data, chunk);
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+void TagGateway::publish(uint8_t type, uint8_t mask, const uint8_t* payload, size_t length) {
+    bool wakeWriter = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.framesPublished++;
+        for (size_t i = 0; i < subscribers_.size(); i++) {
+            Subscriber& subscriber = *subscribers_[i];
+            if (!(subscriber.mask & mask)) {
+                continue;
+            }
+            bool wasEmpty = subscriber.size == 0;
+            queueDropNotice(subscriber, kGatewayFrameHeaderSize + length);
+            if (subscriber.dropped == 0 && enqueue(subscriber, type, payload, length)) {
+                stats_.framesQueued++;
+                wakeWriter = wakeWriter || wasEmpty;
+            }
+            else {
+                subscriber.dropped++;
+                stats_.framesDropped++;
+            }
+        }
+    }
+    // Only a queue that was empty needs the writer's attention; the rest
+    // are already waiting on their sockets
+    if (wakeWriter) {
+        wake();
+    }
+}
+
+bool TagGateway::enqueue(Subscriber& subscriber, uint8_t type, const uint8_t* payload, size_t length) {
+    size_t frameLength = kGatewayFrameHeaderSize + length;
+    size_t capacity = subscriber.queue.size();
+    if (capacity - subscriber.size < frameLength) {
+        return false;
+    }
+    uint8_t header[kGatewayFrameHeaderSize] = { static_cast<uint8_t>((length + 1) >> 8), static_cast<uint8_t>(length + 1), type };
+    size_t tail = (subscriber.head + subscriber.size) % capacity;
+    for (size_t part = 0; part < 2; part++) {
+        const uint8_t* data = part == 0 ? header : payload;
+        size_t remaining = part == 0 ? sizeof(header) : length;
+        while (remaining > 0) {
+            size_t run = std::min(remaining, capacity - tail);
+            memcpy(&subscriber.queue[tail], data, run);
+            data += run;
+            remaining -= run;
+            tail = (tail + run) % capacity;
+        }
+    }
+    subscriber.size += frameLength;
+    return true;
+}
+
+// Queue the count of frames the subscriber missed, if there is room for it
+// and spare bytes after it
+void TagGateway::queueDropNotice(Subscriber& subscriber, size_t spare) {
+    if (subscriber.dropped == 0) {
+        return;
+    }
+    uint8_t count[4] = { static_cast<uint8_t>(subscriber.dropped >> 24), static_cast<uint8_t>(subscriber.dropped >> 16),
+                         static_cast<uint8_t>(subscriber.dropped >> 8), static_cast<uint8_t>(subscriber.dropped) };
+    if (subscriber.queue.size() - subscriber.size >= kGatewayFrameHeaderSize + sizeof(count) + spare) {
+        enqueue(subscriber, kFrameDropped, count, sizeof(count));
+        subscriber.dropped = 0;
+    }
+}
+
+void TagGateway::wake() {
+    if (wakePipe_[1] >= 0) {
+        uint8_t byte = 1;
+        // Full pipe: the writer has wakeups pending anyway
+        ssize_t ignored = write(wakePipe_[1], &byte, 1);
+        (void) ignored;
+    }
+}
+
+void TagGateway::run() {
+    std::vector<pollfd> fds;
+    while (!stopping_) {
+        fds.clear();
+        pollfd wakeFd = { wakePipe_[0], POLLIN, 0 };
+        fds.push_back(wakeFd);
+        for (size_t i = 0; i < listeners_.size(); i++) {
+            pollfd listenFd = { listeners_[i], POLLIN, 0 };
+            fds.push_back(listenFd);
+        }
+        size_t firstSubscriber = fds.size();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < subscribers_.size(); i++) {
+                pollfd subscriberFd = { subscribers_[i]->fd, static_cast<short>(POLLIN | (subscribers_[i]->size > 0 ? POLLOUT : 0)), 0 };
+                fds.push_back(subscriberFd);
+            }
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR) {
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            uint8_t drain[256];
+            while (read(wakePipe_[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+        for (size_t i = 1; i < firstSubscriber; i++) {
+            if (fds[i].revents & POLLIN) {
+                accept(fds[i].fd);
+            }
+        }
+
+        // Subscribers only join and leave on this thread, so the list
+        // polled is still the list, with new ones appended after it
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = subscribers_.size(); i-- > 0; ) {
+            if (firstSubscriber + i >= fds.size()) {
+                continue;
+            }
+            Subscriber& subscriber = *subscribers_[i];
+            short events = fds[firstSubscriber + i].revents;
+            bool closed = (events & (POLLERR | POLLNVAL)) != 0;
+            if (!closed && (events & (POLLIN | POLLHUP))) {
+                readSubscription(subscriber, closed);
+            }
+            if (!closed && subscriber.size > 0) {
+                closed = !flush(subscriber);
+                // Don't leave the count for a frame that may never come
+                queueDropNotice(subscriber, 0);
+            }
+            if (closed) {
+                closeSubscriber(i);
+            }
+        }
+    }
+}
+
+void TagGateway::accept(int listener) {
+    for (;;) {
+        int fd = ::accept(listener, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+        setNonBlocking(fd);
+        setNoSigPipe(fd);
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+        Subscriber* subscriber = new Subscriber;
+        subscriber->fd = fd;
+        subscriber->mask = kSubscribeTags;
+        subscriber->queue.resize(queueBytes_);
+        subscriber->head = 0;
+        subscriber->size = 0;
+        subscriber->dropped = 0;
+        uint8_t hello[2] = { kGatewayProtocolVersion, subscriber->mask };
+        enqueue(*subscriber, kFrameHello, hello, sizeof(hello));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscribers_.push_back(subscriber);
+        stats_.subscribersAccepted++;
+    }
+}
+
+// Write as much of the queue as the socket takes, in one call. False if the
+// subscriber is gone.
+bool TagGateway::flush(Subscriber& subscriber) {
+    size_t capacity = subscriber.queue.size();
+    size_t first = std::min(subscriber.size, capacity - subscriber.head);
+    iovec parts[2];
+    parts[0].iov_base = &subscriber.queue[subscriber.head];
+    parts[0].iov_len = first;
+    parts[1].iov_base = &subscriber.queue[0];
+    parts[1].iov_len = subscriber.size - first;
+    msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = parts;
+    message.msg_iovlen = parts[1].iov_len > 0 ? 2 : 1;
+
+    ssize_t written = sendmsg(subscriber.fd, &message, kSendFlags);
+    if (written < 0) {
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+    stats_.writes++;
+    stats_.bytesWritten += written;
+    subscriber.head = (subscriber.head + written) % capacity;
+    subscriber.size -= written;
+    if (subscriber.size == 0) {
+        subscriber.head = 0;
+    }
+    return true;
+}
+
+void TagGateway::readSubscription(Subscriber& subscriber, bool& closed) {
+    uint8_t input[64];
+    ssize_t length = recv(subscriber.fd, input, sizeof(input), 0);
+    if (length == 0 || (length < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        closed = true;
+    }
+    else if (length > 0) {
+        subscriber.mask = input[length - 1];
+    }
+}
+
+void TagGateway::closeSubscriber(size_t index) {
+    close(subscribers_[index]->fd);
+    delete subscribers_[index];
+    subscribers_.erase(subscribers_.begin() + index);
+}
+
+GatewayStats TagGateway::stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    GatewayStats stats = stats_;
+    stats.subscribers = subscribers_.size();
+    return stats;
+}
+
+}
@@ -0,0 +1,135 @@
+//
+//  TagGateway.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_TagGateway_h
+#define TracVentory_TagGateway_h
+
+#include "CommandSession.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace flx {
+
+// Gateway protocol. Every frame is a 2-byte big-endian length (of what
+// follows), a type byte and the payload:
+//
+//   kFrameHello    version, subscription mask         sent on connect
+//   kFrameTag      command, flags (bit 0: async),     one decoded tag read
+//                  timestamp (6), id length, id
+//   kFrameRaw      bytes as received from the reader  if subscribed
+//   kFrameDropped  count (4, big-endian)              frames this subscriber
+//                                                     missed; sent once its
+//                                                     queue has room again
+//
+// A subscriber may send one byte at any time: the new subscription mask.
+enum GatewayFrameType : uint8_t {
+    kFrameHello = 0x00,
+    kFrameTag = 0x01,
+    kFrameRaw = 0x02,
+    kFrameDropped = 0x03
+};
+
+enum GatewaySubscription : uint8_t {
+    kSubscribeTags = 0x01,
+    kSubscribeRaw = 0x02
+};
+
+const uint8_t kGatewayProtocolVersion = 1;
+const size_t kGatewayFrameHeaderSize = 3;
+const uint8_t kGatewayFlagAsync = 0x01;
+
+struct GatewayStats {
+    uint64_t framesPublished;   // frames offered to subscribers (once each)
+    uint64_t framesQueued;      // copies queued, summed over subscribers
+    uint64_t framesDropped;     // copies dropped because a queue was full
+    uint64_t bytesWritten;
+    uint64_t writes;            // socket writes; framesQueued / writes is the batching
+    uint64_t subscribersAccepted;
+    size_t subscribers;         // connected now
+};
+
+// TagGateway serves the tag reads a CommandSession decodes (and optionally
+// the raw reader bytes) to back-office consumers over a local TCP or Unix
+// socket. Register it as a ResponseHandler of the session.
+//
+// Publishing only copies the frame into each subscriber's bounded queue and
+// never blocks the session: a subscriber that falls a full queue behind
+// loses frames, and is told how many with a kFrameDropped frame. A
+// gateway thread writes each queue out with one socket write per wakeup,
+// so a burst of reads reaches a subscriber in a few large writes.
+class TagGateway : public ResponseHandler {
+public:
+    explicit TagGateway(size_t queueBytes = 256 * 1024);
+    virtual ~TagGateway();
+
+    // Listen on 127.0.0.1:port (0 picks one; see tcpPort()) or a Unix
+    // socket path, replacing a stale socket file. Call before start().
+    bool listenTcp(uint16_t port);
+    bool listenUnix(const std::string& path);
+    uint16_t tcpPort() const { return tcpPort_; }
+
+    bool start();
+    // Close every subscriber and the listening sockets, after one last
+    // non-blocking write of what is queued for each.
+    void stop();
+
+    // Raw bytes from the reader, for subscribers that asked for them.
+    void publishRaw(const uint8_t* data, size_t length);
+
+    // ResponseHandler
+    virtual void onResponse(const ReaderCommand& command, const ReaderResponse& response);
+    virtual void onAsyncResponse(const ReaderResponse& response);
+
+    GatewayStats stats();
+
+private:
+    TagGateway(const TagGateway&);
+    TagGateway& operator=(const TagGateway&);
+
+    struct Subscriber {
+        int fd;
+        uint8_t mask;
+        std::vector<uint8_t> queue;     // ring buffer of whole frames
+        size_t head;
+        size_t size;
+        uint32_t dropped;               // since the last kFrameDropped
+    };
+
+    void publishTag(const ReaderResponse& response);
+    void publish(uint8_t type, uint8_t mask, const uint8_t* payload, size_t length);
+    static bool enqueue(Subscriber& subscriber, uint8_t type, const uint8_t* payload, size_t length);
+    static void queueDropNotice(Subscriber& subscriber, size_t spare);
+    void wake();
+    void run();
+    void accept(int listener);
+    bool flush(Subscriber& subscriber);
+    void readSubscription(Subscriber& subscriber, bool& closed);
+    void closeSubscriber(size_t index);
+
+    size_t queueBytes_;
+    std::vector<int> listeners_;
+    std::string unixPath_;
+    uint16_t tcpPort_;
+    int wakePipe_[2];
+    std::atomic<bool> stopping_;
+    std::thread thread_;
+
+    std::mutex mutex_;                  // subscribers_, their queues, stats_
+    std::vector<Subscriber*> subscribers_;
+    GatewayStats stats_;
+};
+
+}
+
+#endif
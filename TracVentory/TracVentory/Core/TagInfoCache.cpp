@@ -0,0 +1,212 @@
+//
+//  TagInfoCache.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "TagInfoCache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace flx {
+
+namespace {
+
+// File: magic, entry count (4), then per entry, oldest first: key length
+// (2), info length (2), key, info. Little-endian.
+const char kCacheMagic[8] = { 'F', 'L', 'X', 'T', 'I', 'C', '0', '1' };
+const size_t kCacheHeaderSize = sizeof(kCacheMagic) + 4;
+
+void putU16(std::vector<uint8_t>& out, size_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+size_t getU16(const uint8_t* data) {
+    return data[0] | (data[1] << 8);
+}
+
+}
+
+TagInfoCache::TagInfoCache(size_t capacity) : capacity_(capacity) {
+    resetStats();
+}
+
+std::string TagInfoCache::makeKey(TagInfoKind kind, const uint8_t* tagId, size_t tagIdLength) {
+    std::string key(1 + tagIdLength, static_cast<char>(kind));
+    memcpy(&key[1], tagId, tagIdLength);
+    return key;
+}
+
+bool TagInfoCache::lookup(TagInfoKind kind, const uint8_t* tagId, size_t tagIdLength, std::vector<uint8_t>& info) {
+    std::unordered_map<std::string, EntryList::iterator>::iterator found = index_.find(makeKey(kind, tagId, tagIdLength));
+    if (found == index_.end()) {
+        stats_.misses++;
+        return false;
+    }
+    stats_.hits++;
+    entries_.splice(entries_.begin(), entries_, found->second);
+    info = found->second->info;
+    return true;
+}
+
+void TagInfoCache::insert(TagInfoKind kind, const uint8_t* tagId, size_t tagIdLength, const uint8_t* info, size_t infoLength) {
+    if (capacity_ == 0 || tagIdLength > 0xFFFE || infoLength > 0xFFFF) {
+        return;
+    }
+    std::string key = makeKey(kind, tagId, tagIdLength);
+    put(key, info, infoLength);
+    stats_.inserts++;
+    trim();
+}
+
+void TagInfoCache::put(std::string& key, const uint8_t* info, size_t infoLength) {
+    std::unordered_map<std::string, EntryList::iterator>::iterator found = index_.find(key);
+    if (found != index_.end()) {
+        found->second->info.assign(info, info + infoLength);
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return;
+    }
+    entries_.push_front(Entry());
+    entries_.front().key.swap(key);
+    entries_.front().info.assign(info, info + infoLength);
+    index_[entries_.front().key] = entries_.begin();
+}
+
+void TagInfoCache::trim() {
+    while (entries_.size() > capacity_) {
+        index_.erase(entries_.back().key);
+        entries_.pop_back();
+        stats_.evictions++;
+    }
+}
+
+bool TagInfoCache::erase(TagInfoKind kind, const uint8_t* tagId, size_t tagIdLength) {
+    std::unordered_map<std::string, EntryList::iterator>::iterator found = index_.find(makeKey(kind, tagId, tagIdLength));
+    if (found == index_.end()) {
+        return false;
+    }
+    entries_.erase(found->second);
+    index_.erase(found);
+    return true;
+}
+
+void TagInfoCache::clear() {
+    entries_.clear();
+    index_.clear();
+}
+
+void TagInfoCache::setCapacity(size_t capacity) {
+    capacity_ = capacity;
+    trim();
+}
+
+void TagInfoCache::resetStats() {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+bool TagInfoCache::save(const std::string& path) const {
+    std::vector<uint8_t> data(kCacheMagic, kCacheMagic + sizeof(kCacheMagic));
+    uint32_t count = static_cast<uint32_t>(entries_.size());
+    for (int i = 0; i < 4; i++) {
+        data.push_back(static_cast<uint8_t>(count >> (i * 8)));
+    }
+    // Oldest first, so that loading in file order restores the recency order
+    for (EntryList::const_reverse_iterator entry = entries_.rbegin(); entry != entries_.rend(); ++entry) {
+        putU16(data, entry->key.size());
+        putU16(data, entry->info.size());
+        data.insert(data.end(), entry->key.begin(), entry->key.end());
+        data.insert(data.end(), entry->info.begin(), entry->info.end());
+    }
+
+    std::string temporary = path + ".tmp";
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    const uint8_t* next = data.data();
+    size_t left = data.size();
+    while (left > 0) {
+        ssize_t written = ::write(fd, next, left);
+        if (written < 0) {
+            break;
+        }
+        next += written;
+        left -= static_cast<size_t>(written);
+    }
+    bool written = left == 0 && fsync(fd) == 0;
+    ::close(fd);
+    if (!written || rename(temporary.c_str(), path.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool TagInfoCache::load(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    std::vector<uint8_t> data;
+    if (fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(kCacheHeaderSize)) {
+        data.resize(static_cast<size_t>(info.st_size));
+        size_t filled = 0;
+        while (filled < data.size()) {
+            ssize_t length = ::read(fd, &data[filled], data.size() - filled);
+            if (length <= 0) {
+                break;
+            }
+            filled += static_cast<size_t>(length);
+        }
+        data.resize(filled);
+    }
+    ::close(fd);
+    if (data.size() < kCacheHeaderSize || memcmp(data.data(), kCacheMagic, sizeof(kCacheMagic)) != 0) {
+        return false;
+    }
+
+    // Check the whole file before replacing anything
+    uint32_t count = 0;
+    for (int i = 3; i >= 0; i--) {
+        count = (count << 8) | data[sizeof(kCacheMagic) + i];
+    }
+    size_t offset = kCacheHeaderSize;
+    for (uint32_t i = 0; i < count; i++) {
+        if (data.size() - offset < 4) {
+            return false;
+        }
+        size_t keyLength = getU16(&data[offset]);
+        size_t infoLength = getU16(&data[offset + 2]);
+        if (keyLength == 0 || data.size() - offset - 4 < keyLength + infoLength) {
+            return false;
+        }
+        offset += 4 + keyLength + infoLength;
+    }
+    if (offset != data.size()) {
+        return false;
+    }
+
+    clear();
+    offset = kCacheHeaderSize;
+    for (uint32_t i = 0; i < count; i++) {
+        size_t keyLength = getU16(&data[offset]);
+        size_t infoLength = getU16(&data[offset + 2]);
+        std::string key(reinterpret_cast<const char*>(&data[offset + 4]), keyLength);
+        put(key, &data[offset + 4 + keyLength], infoLength);
+        offset += 4 + keyLength + infoLength;
+    }
+    stats_.loaded += count;
+    trim();
+    return true;
+}
+
+}
@@ -0,0 +1,92 @@
+//
+//  TagInfoCache.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_TagInfoCache_h
+#define TracVentory_TagInfoCache_h
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flx {
+
+// What is cached about a tag; each kind is cached separately
+enum TagInfoKind : uint8_t {
+    kTagInfoGeometry = 0,   // GetTagInfo: block count and size
+    kTagInfoTid = 1         // the TID bank (chip vendor, model, serial)
+};
+
+struct TagInfoCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;     // least recently used entries dropped for room
+    uint64_t loaded;        // entries read back by load()
+
+    double hitRate() const { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0; }
+};
+
+// TagInfoCache keeps what GetTagInfo and TID reads return for each tag, so a
+// tag met again (the next cycle count of the same shelf) is answered without
+// a round trip to the reader. That metadata is fixed when the chip is made,
+// so entries never go stale; the cache is bounded instead, dropping the
+// least recently used entry when full.
+//
+// save() writes the entries to a file (oldest first, to a temporary file
+// renamed over the old one) and load() reads them back in the next session.
+// A file that is torn or not a cache is ignored as a whole.
+//
+// Not thread safe; callers serialize access.
+class TagInfoCache {
+public:
+    explicit TagInfoCache(size_t capacity = 4096);
+
+    // Copy what is cached for the tag into info and mark it most recently
+    // used; false (a miss) if nothing is.
+    bool lookup(TagInfoKind kind, const uint8_t* tagId, size_t tagIdLength, std::vector<uint8_t>& info);
+    // Cache what the reader answered for the tag, replacing any earlier entry.
+    void insert(TagInfoKind kind, const uint8_t* tagId, size_t tagIdLength, const uint8_t* info, size_t infoLength);
+    bool erase(TagInfoKind kind, const uint8_t* tagId, size_t tagIdLength);
+    void clear();
+
+    size_t size() const { return entries_.size(); }
+    size_t capacity() const { return capacity_; }
+    // Shrinking evicts the least recently used entries at once.
+    void setCapacity(size_t capacity);
+
+    bool save(const std::string& path) const;
+    // Replace the contents with the file's; false if it could not be read.
+    bool load(const std::string& path);
+
+    const TagInfoCacheStats& stats() const { return stats_; }
+    void resetStats();
+
+private:
+    // Key: kind, then the tag id
+    struct Entry {
+        std::string key;
+        std::vector<uint8_t> info;
+    };
+    typedef std::list<Entry> EntryList;
+
+    static std::string makeKey(TagInfoKind kind, const uint8_t* tagId, size_t tagIdLength);
+    void put(std::string& key, const uint8_t* info, size_t infoLength);
+    void trim();
+
+    size_t capacity_;
+    EntryList entries_;                 // most recently used first
+    std::unordered_map<std::string, EntryList::iterator> index_;
+    TagInfoCacheStats stats_;
+};
+
+}
+
+#endif
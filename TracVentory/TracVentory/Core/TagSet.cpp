@@ -0,0 +1,172 @@
+//
+//  TagSet.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "TagSet.h"
+
+#include <algorithm>
+
+namespace flx {
+
+namespace {
+
+// Shift one 4-bit digit into the low end of a 128-bit value
+bool shiftInNibble(TagKey& key, unsigned nibble) {
+    if (key.hi >> 60) {
+        return false;
+    }
+    key.hi = (key.hi << 4) | (key.lo >> 60);
+    key.lo = (key.lo << 4) | nibble;
+    return true;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// MurmurHash3 finalizer; tag ids share long prefixes, so mix every bit
+uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+}
+
+bool tagKeyFromBytes(const uint8_t* bytes, size_t length, TagKey& key) {
+    key.hi = 0;
+    key.lo = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (!shiftInNibble(key, bytes[i] >> 4) || !shiftInNibble(key, bytes[i] & 0x0f)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool tagKeyFromHex(const char* hex, size_t length, TagKey& key) {
+    key.hi = 0;
+    key.lo = 0;
+    for (size_t i = 0; i < length; i++) {
+        char c = hex[i];
+        if (c == ' ' || c == ':' || c == '-') {
+            continue;
+        }
+        int value = hexValue(c);
+        if (value < 0 || !shiftInNibble(key, static_cast<unsigned>(value))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string tagKeyToHex(const TagKey& key) {
+    static const char kDigits[] = "0123456789ABCDEF";
+    char buffer[33];
+    size_t length = 0;
+    bool leading = true;
+    for (int i = 31; i >= 0; i--) {
+        uint64_t word = i >= 16 ? key.hi : key.lo;
+        unsigned nibble = static_cast<unsigned>((word >> ((i % 16) * 4)) & 0x0f);
+        if (leading && nibble == 0 && i > 0) {
+            continue;
+        }
+        leading = false;
+        buffer[length++] = kDigits[nibble];
+    }
+    return std::string(buffer, length);
+}
+
+const size_t TagSet::npos;
+
+TagSet::TagSet(size_t expected)
+    : mask_(0), size_(0), marked_(0) {
+    reserve(expected);
+}
+
+void TagSet::reserve(size_t count) {
+    // Keep the load factor at or below 1/2 so probe runs stay short
+    size_t capacity = 16;
+    while (capacity < count * 2) {
+        capacity <<= 1;
+    }
+    if (capacity > state_.size()) {
+        rehash(capacity);
+    }
+}
+
+void TagSet::clear() {
+    std::fill(state_.begin(), state_.end(), static_cast<uint8_t>(kEmpty));
+    size_ = 0;
+    marked_ = 0;
+}
+
+size_t TagSet::probe(const TagKey& key) const {
+    size_t slot = static_cast<size_t>(mix(key.hi ^ mix(key.lo))) & mask_;
+    while (state_[slot] != kEmpty && keys_[slot] != key) {
+        slot = (slot + 1) & mask_;
+    }
+    return slot;
+}
+
+size_t TagSet::find(const TagKey& key) const {
+    size_t slot = probe(key);
+    return state_[slot] == kEmpty ? npos : slot;
+}
+
+size_t TagSet::insert(const TagKey& key, bool& inserted) {
+    if ((size_ + 1) * 2 > state_.size()) {
+        rehash(state_.size() * 2);
+    }
+    size_t slot = probe(key);
+    inserted = state_[slot] == kEmpty;
+    if (inserted) {
+        keys_[slot] = key;
+        state_[slot] = kPresent;
+        size_++;
+    }
+    return slot;
+}
+
+bool TagSet::mark(size_t slot) {
+    if (state_[slot] != kPresent) {
+        return false;
+    }
+    state_[slot] = kMarked;
+    marked_++;
+    return true;
+}
+
+void TagSet::rehash(size_t capacity) {
+    std::vector<TagKey> keys(capacity);
+    std::vector<uint8_t> state(capacity, static_cast<uint8_t>(kEmpty));
+    keys_.swap(keys);
+    state_.swap(state);
+    mask_ = capacity - 1;
+
+    for (size_t i = 0; i < state.size(); i++) {
+        if (state[i] != kEmpty) {
+            size_t slot = probe(keys[i]);
+            keys_[slot] = keys[i];
+            state_[slot] = state[i];
+        }
+    }
+}
+
+}
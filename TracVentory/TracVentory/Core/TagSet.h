@@ -0,0 +1,94 @@
+//
+//  TagSet.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_TagSet_h
+#define TracVentory_TagSet_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace flx {
+
+// The canonical form of an RFID tag id: its numeric value, so that raw tag
+// bytes, "00 00 E0 04 ..." from CByteArray toString and the zero-trimmed
+// itemID saved on an item all map to the same key. Holds ids of up to 128
+// significant bits (64-bit HF UIDs and 96-bit EPCs).
+struct TagKey {
+    uint64_t hi;
+    uint64_t lo;
+
+    bool operator==(const TagKey& other) const { return hi == other.hi && lo == other.lo; }
+    bool operator!=(const TagKey& other) const { return !(*this == other); }
+    bool operator<(const TagKey& other) const { return hi != other.hi ? hi < other.hi : lo < other.lo; }
+};
+
+// Build a key from tag bytes, most significant first. Returns false if the
+// id has more than 16 significant bytes.
+bool tagKeyFromBytes(const uint8_t* bytes, size_t length, TagKey& key);
+
+// Build a key from hex digits. Spaces and other separators are skipped;
+// returns false for any other character or more than 32 significant digits.
+bool tagKeyFromHex(const char* hex, size_t length, TagKey& key);
+
+// Uppercase hex without leading zeros, the way itemID is stored
+std::string tagKeyToHex(const TagKey& key);
+
+// TagSet is an open-addressing hash set of tag keys with one mark bit per
+// key. Keys and state live in flat arrays, so lookups and inserts touch one
+// or two cache lines and never allocate unless the set has to grow.
+class TagSet {
+public:
+    static const size_t npos = SIZE_MAX;
+
+    explicit TagSet(size_t expected = 0);
+
+    // Make room for count keys without rehashing.
+    void reserve(size_t count);
+    void clear();
+
+    // Slot of key, inserting it if needed. inserted reports which happened.
+    // Slots stay valid until the set grows.
+    size_t insert(const TagKey& key, bool& inserted);
+    size_t find(const TagKey& key) const;
+    bool contains(const TagKey& key) const { return find(key) != npos; }
+
+    size_t size() const { return size_; }
+
+    bool isMarked(size_t slot) const { return state_[slot] == kMarked; }
+    // Returns true if the slot was not marked before.
+    bool mark(size_t slot);
+    size_t markedCount() const { return marked_; }
+
+    // Visit keys in slot order: f(const TagKey& key, bool marked)
+    template <typename F>
+    void forEach(F f) const {
+        for (size_t slot = 0; slot < state_.size(); slot++) {
+            if (state_[slot] != kEmpty) {
+                f(keys_[slot], state_[slot] == kMarked);
+            }
+        }
+    }
+
+private:
+    enum : uint8_t { kEmpty = 0, kPresent, kMarked };
+
+    size_t probe(const TagKey& key) const;
+    void rehash(size_t capacity);
+
+    std::vector<TagKey> keys_;
+    std::vector<uint8_t> state_;
+    size_t mask_;
+    size_t size_;
+    size_t marked_;
+};
+
+}
+
+#endif
@@ -0,0 +1,452 @@
+//
+//  TraceLog.cpp
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#include "TraceLog.h"
+
+#include <cstdarg>
+#include <ctime>
+
+#include <pthread.h>
+
+namespace flx {
+
+struct TraceLog::Buffer {
+    std::vector<uint8_t> data;
+    size_t mask;
+    std::atomic<uint64_t> head;     // written by the owning thread
+    std::atomic<uint64_t> tail;     // written by the drain
+    uint64_t reserved;              // head after the record being written
+    std::atomic<uint64_t> records;
+    std::atomic<uint64_t> dropped;
+    std::atomic<bool> retired;      // the thread has exited
+    unsigned thread;
+};
+
+std::atomic<bool> TraceLog::enabled_(false);
+std::atomic<size_t> TraceLog::bufferSize_(256 * 1024);
+std::mutex TraceLog::mutex_;
+std::vector<TraceLog::Buffer*> TraceLog::buffers_;
+std::vector<TraceLog::Site> TraceLog::sites_;
+std::mutex TraceLog::drainMutex_;
+uint64_t TraceLog::formatted_ = 0;
+uint64_t TraceLog::retiredRecords_ = 0;
+uint64_t TraceLog::retiredDropped_ = 0;
+
+std::mutex TraceLog::writerMutex_;
+std::condition_variable TraceLog::writerWake_;
+std::condition_variable TraceLog::writerDone_;
+std::thread TraceLog::writer_;
+std::string TraceLog::writerPath_;
+FILE* TraceLog::writerFile_ = NULL;
+uint32_t TraceLog::writerIntervalMs_ = 500;
+size_t TraceLog::writerMaxBytes_ = 4 << 20;
+bool TraceLog::writerStopping_ = false;
+std::atomic<bool> TraceLog::drainWanted_(false);
+uint64_t TraceLog::flushRequested_ = 0;
+uint64_t TraceLog::flushCompleted_ = 0;
+
+namespace {
+
+pthread_key_t bufferKey;
+pthread_once_t bufferKeyOnce = PTHREAD_ONCE_INIT;
+unsigned nextThread = 1;
+
+
+template <typename T>
+T readValue(const uint8_t* p) {
+    T value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+struct Argument {
+    uint8_t type;
+    int64_t integer;
+    double number;
+    const uint8_t* bytes;
+    size_t length;
+};
+
+const char* baseName(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+void appendFormatted(std::string& line, const char* spec, ...) __attribute__((format(printf, 2, 3)));
+
+void appendFormatted(std::string& line, const char* spec, ...) {
+    char text[512];
+    va_list arguments;
+    va_start(arguments, spec);
+    int length = vsnprintf(text, sizeof(text), spec, arguments);
+    va_end(arguments);
+    if (length > 0) {
+        line.append(text, std::min(static_cast<size_t>(length), sizeof(text) - 1));
+    }
+}
+
+// Render one conversion. spec is the conversion without its length
+// modifiers, conversion the final letter.
+void appendArgument(std::string& line, std::string spec, char conversion, const Argument& argument) {
+    bool integerConversion = strchr("diouxXc", conversion) != NULL;
+    bool floatConversion = strchr("fFeEgGaA", conversion) != NULL;
+    if (argument.type == kTraceString || argument.type == kTraceHex) {
+        std::string text;
+        if (argument.type == kTraceHex) {
+            static const char digits[] = "0123456789ABCDEF";
+            for (size_t i = 0; i < argument.length; i++) {
+                text.push_back(digits[argument.bytes[i] >> 4]);
+                text.push_back(digits[argument.bytes[i] & 0x0F]);
+            }
+        }
+        else {
+            text.assign(reinterpret_cast<const char*>(argument.bytes), argument.length);
+        }
+        if (conversion != 's') {
+            spec = "%";
+        }
+        appendFormatted(line, (spec + "s").c_str(), text.c_str());
+    }
+    else if (argument.type == kTraceDouble) {
+        if (!floatConversion) {
+            spec = "%";
+            conversion = 'g';
+        }
+        appendFormatted(line, (spec + conversion).c_str(), argument.number);
+    }
+    else {
+        if (floatConversion) {
+            appendFormatted(line, (spec + conversion).c_str(), static_cast<double>(argument.integer));
+        }
+        else if (conversion == 'c') {
+            appendFormatted(line, (spec + "c").c_str(), static_cast<int>(argument.integer));
+        }
+        else {
+            if (!integerConversion) {
+                spec = "%";
+                conversion = argument.type == kTraceSigned ? 'd' : 'u';
+            }
+            else if (conversion == 'd' || conversion == 'i') {
+                conversion = argument.type == kTraceSigned ? 'd' : 'u';
+            }
+            if (conversion == 'd') {
+                appendFormatted(line, (spec + "lld").c_str(), static_cast<long long>(argument.integer));
+            }
+            else {
+                appendFormatted(line, (spec + "ll" + conversion).c_str(), static_cast<unsigned long long>(argument.integer));
+            }
+        }
+    }
+}
+
+// printf-style, but each argument is rendered as the type it was logged as
+void formatMessage(std::string& line, const char* format, const Argument* arguments, size_t count) {
+    size_t next = 0;
+    for (const char* p = format; *p; p++) {
+        if (*p != '%') {
+            line.push_back(*p);
+            continue;
+        }
+        if (p[1] == '%') {
+            line.push_back('%');
+            p++;
+            continue;
+        }
+        const char* start = p++;
+        std::string spec("%");
+        while (*p && strchr("-+ #0123456789.*", *p)) {
+            spec.push_back(*p++);
+        }
+        while (*p && strchr("hlLqjzt", *p)) {
+            p++;
+        }
+        if (!*p) {
+            line.append(start);
+            break;
+        }
+        if (next >= count || spec.find('*') != std::string::npos) {
+            line.append(start, p + 1 - start);
+            continue;
+        }
+        appendArgument(line, spec, *p, arguments[next++]);
+    }
+}
+
+}
+
+uint16_t TraceLog::addSite(const char* file, int line, const char* format) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (sites_.size() >= kTraceOverflowSite) {
+        return kTraceOverflowSite;
+    }
+    Site site = { file, line, format };
+    sites_.push_back(site);
+    return static_cast<uint16_t>(sites_.size() - 1);
+}
+
+void TraceLog::setBufferSize(size_t bytes) {
+    size_t size = 4096;
+    while (size < bytes) {
+        size *= 2;
+    }
+    bufferSize_.store(size, std::memory_order_relaxed);
+}
+
+// The thread is exiting: the drain frees the buffer once it has emptied it
+void TraceLog::retire(void* buffer) {
+    static_cast<Buffer*>(buffer)->retired.store(true, std::memory_order_release);
+}
+
+void TraceLog::createBufferKey() {
+    pthread_key_create(&bufferKey, &TraceLog::retire);
+}
+
+TraceLog::Buffer* TraceLog::threadBuffer() {
+    pthread_once(&bufferKeyOnce, &TraceLog::createBufferKey);
+    Buffer* buffer = static_cast<Buffer*>(pthread_getspecific(bufferKey));
+    if (buffer) {
+        return buffer;
+    }
+    buffer = new Buffer();
+    buffer->data.resize(bufferSize_.load(std::memory_order_relaxed));
+    buffer->mask = buffer->data.size() - 1;
+    buffer->head = 0;
+    buffer->tail = 0;
+    buffer->reserved = 0;
+    buffer->records = 0;
+    buffer->dropped = 0;
+    buffer->retired = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer->thread = nextThread++;
+        buffers_.push_back(buffer);
+    }
+    pthread_setspecific(bufferKey, buffer);
+    return buffer;
+}
+
+uint8_t* TraceLog::reserve(Buffer* buffer, size_t size) {
+    uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    uint64_t tail = buffer->tail.load(std::memory_order_acquire);
+    size_t capacity = buffer->data.size();
+    if (size > 0xFFFF || size > capacity / 2) {
+        buffer->dropped.store(buffer->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return NULL;
+    }
+    // A record never wraps: if it does not fit before the end, the rest of
+    // the ring is skipped
+    size_t offset = head & buffer->mask;
+    uint64_t start = capacity - offset < size ? head + (capacity - offset) : head;
+    if (start + size - tail > capacity) {
+        buffer->dropped.store(buffer->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return NULL;
+    }
+    if (start != head) {
+        memcpy(&buffer->data[offset], &kTraceWrapSite, sizeof(kTraceWrapSite));
+    }
+    // Half full: wake the writer rather than wait out its interval. A wake
+    // that races the writer going to sleep is lost, and it drains on time.
+    if (start + size - tail > capacity / 2 && !drainWanted_.load(std::memory_order_relaxed) &&
+        !drainWanted_.exchange(true, std::memory_order_relaxed)) {
+        writerWake_.notify_one();
+    }
+    buffer->reserved = start + size;
+    return &buffer->data[start & buffer->mask];
+}
+
+void TraceLog::commit(Buffer* buffer) {
+    buffer->records.store(buffer->records.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    buffer->head.store(buffer->reserved, std::memory_order_release);
+}
+
+uint64_t TraceLog::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+size_t TraceLog::drain(const std::function<void(const char* line, size_t length)>& sink) {
+    std::lock_guard<std::mutex> drainLock(drainMutex_);
+    std::vector<Buffer*> buffers;
+    std::vector<Site> sites;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers = buffers_;
+        sites = sites_;
+    }
+
+    size_t count = 0;
+    std::string line;
+    Argument arguments[32];
+    for (size_t b = 0; b < buffers.size(); b++) {
+        Buffer* buffer = buffers[b];
+        bool retired = buffer->retired.load(std::memory_order_acquire);
+        uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        size_t capacity = buffer->data.size();
+        while (tail < head) {
+            const uint8_t* record = &buffer->data[tail & buffer->mask];
+            uint16_t site = readValue<uint16_t>(record);
+            if (site == kTraceWrapSite) {
+                tail += capacity - (tail & buffer->mask);
+                continue;
+            }
+            uint16_t size = readValue<uint16_t>(record + 2);
+            uint32_t argumentCount = readValue<uint32_t>(record + 4);
+            uint64_t time = readValue<uint64_t>(record + 8);
+
+            // A site registered after the snapshot was taken
+            if (site >= sites.size() && site != kTraceOverflowSite) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                sites = sites_;
+            }
+
+            size_t decoded = 0;
+            const uint8_t* p = record + kTraceRecordHeaderSize;
+            for (uint32_t i = 0; i < argumentCount && decoded < 32; i++) {
+                Argument& argument = arguments[decoded++];
+                argument.type = p[0];
+                if (argument.type == kTraceString || argument.type == kTraceHex) {
+                    argument.length = p[1];
+                    argument.bytes = p + 2;
+                    p += 2 + argument.length;
+                }
+                else {
+                    argument.integer = readValue<int64_t>(p + 1);
+                    argument.number = readValue<double>(p + 1);
+                    p += 9;
+                }
+            }
+
+            time_t seconds = static_cast<time_t>(time / 1000000000);
+            struct tm local;
+            localtime_r(&seconds, &local);
+            char stamp[32];
+            strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+            line.clear();
+            appendFormatted(line, "%s.%06u T%u ", stamp, static_cast<unsigned>(time % 1000000000 / 1000), buffer->thread);
+            if (site < sites.size()) {
+                appendFormatted(line, "%s:%d ", baseName(sites[site].file), sites[site].line);
+                formatMessage(line, sites[site].format, arguments, decoded);
+            }
+            line.push_back('\n');
+            sink(line.data(), line.size());
+            count++;
+            tail += size;
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+
+        // Nothing more can arrive from an exited thread
+        if (retired) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffers_.erase(std::find(buffers_.begin(), buffers_.end(), buffer));
+            retiredRecords_ += buffer->records.load(std::memory_order_relaxed);
+            retiredDropped_ += buffer->dropped.load(std::memory_order_relaxed);
+            delete buffer;
+        }
+    }
+    formatted_ += count;
+    return count;
+}
+
+bool TraceLog::startWriter(const std::string& path, uint32_t intervalMs, size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    if (writer_.joinable()) {
+        return false;
+    }
+    writerFile_ = fopen(path.c_str(), "a");
+    if (!writerFile_) {
+        return false;
+    }
+    writerPath_ = path;
+    writerIntervalMs_ = intervalMs;
+    writerMaxBytes_ = maxBytes;
+    writerStopping_ = false;
+    writer_ = std::thread(&TraceLog::writerLoop);
+    return true;
+}
+
+void TraceLog::stopWriter() {
+    {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        if (!writer_.joinable()) {
+            return;
+        }
+        writerStopping_ = true;
+    }
+    writerWake_.notify_all();
+    writer_.join();
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    fclose(writerFile_);
+    writerFile_ = NULL;
+    writerDone_.notify_all();
+}
+
+void TraceLog::flush() {
+    std::unique_lock<std::mutex> lock(writerMutex_);
+    if (!writer_.joinable()) {
+        return;
+    }
+    uint64_t target = ++flushRequested_;
+    writerWake_.notify_all();
+    while (flushCompleted_ < target && writer_.joinable() && !writerStopping_) {
+        writerDone_.wait(lock);
+    }
+}
+
+void TraceLog::writerLoop() {
+    std::unique_lock<std::mutex> lock(writerMutex_);
+    for (;;) {
+        bool stopping = writerStopping_;
+        uint64_t requested = flushRequested_;
+        FILE* file = writerFile_;
+        lock.unlock();
+
+        drainWanted_.store(false, std::memory_order_relaxed);
+        drain([file](const char* line, size_t length) {
+            fwrite(line, 1, length, file);
+        });
+        fflush(file);
+        if (ftell(file) > static_cast<long>(writerMaxBytes_)) {
+            fclose(file);
+            rename(writerPath_.c_str(), (writerPath_ + ".1").c_str());
+            file = fopen(writerPath_.c_str(), "a");
+        }
+
+        lock.lock();
+        writerFile_ = file;
+        flushCompleted_ = requested;
+        writerDone_.notify_all();
+        if (stopping || !file) {
+            break;
+        }
+        writerWake_.wait_for(lock, std::chrono::milliseconds(writerIntervalMs_), [requested] {
+            return writerStopping_ || flushRequested_ != requested || drainWanted_.load(std::memory_order_relaxed);
+        });
+    }
+}
+
+TraceStats TraceLog::stats() {
+    TraceStats stats;
+    memset(&stats, 0, sizeof(stats));
+    {
+        std::lock_guard<std::mutex> lock(drainMutex_);
+        stats.formatted = formatted_;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.records = retiredRecords_;
+    stats.dropped = retiredDropped_;
+    for (size_t i = 0; i < buffers_.size(); i++) {
+        stats.records += buffers_[i]->records.load(std::memory_order_relaxed);
+        stats.dropped += buffers_[i]->dropped.load(std::memory_order_relaxed);
+    }
+    stats.threads = buffers_.size();
+    stats.sites = sites_.size();
+    return stats;
+}
+
+}
@@ -0,0 +1,234 @@
+//
+//  TraceLog.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#ifndef TracVentory_TraceLog_h
+#define TracVentory_TraceLog_h
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Log a printf-style message to the TraceLog:
+//
+//     FLX_TRACE("tag %s read by %s in %u ms", flx::TraceHex(tag, length), name, ms);
+//
+// The call site's format is registered once; each call copies only its
+// arguments into the calling thread's ring, and nothing is formatted until
+// the log is drained. Arguments are rendered by their type, so integer
+// conversions need no length modifiers (%d, %u and %x take any integer).
+// When the log is disabled a call costs one relaxed load.
+#define FLX_TRACE(...) \
+    do { \
+        if (flx::TraceLog::enabled()) { \
+            static const uint16_t flxTraceSite = flx::TraceLog::registerSite(__FILE__, __LINE__, __VA_ARGS__); \
+            flx::TraceLog::record(flxTraceSite, __VA_ARGS__); \
+        } \
+    } while (0)
+
+namespace flx {
+
+// Bytes logged as hex, for a %s conversion: tag ids, packets
+struct TraceHex {
+    const void* data;
+    size_t length;
+
+    TraceHex(const void* bytes, size_t count) : data(bytes), length(count) {}
+};
+
+enum TraceArgumentType : uint8_t {
+    kTraceSigned,
+    kTraceUnsigned,
+    kTraceDouble,
+    kTraceString,   // 1-byte length, bytes
+    kTraceHex       // 1-byte length, bytes
+};
+
+const size_t kTraceMaxBytes = 255;     // longer strings and hex are cut
+
+struct TraceStats {
+    uint64_t records;
+    uint64_t dropped;       // a thread's ring was full
+    uint64_t formatted;
+    size_t threads;
+    size_t sites;
+};
+
+// TraceLog is a deferred-format binary log for hot paths where NSLog (a
+// synchronous formatted write to the system log) is far too slow. Each
+// thread appends records (call site id, timestamp, raw arguments) to its
+// own ring buffer without locks; a record that does not fit is dropped and
+// counted rather than waited for. Records are formatted only when drained:
+// by the writer thread, which appends them to a text file, or on export.
+// The writer drains every interval, and early when a ring is half full.
+//
+// All members are static: there is one log per process.
+class TraceLog {
+public:
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    // Bytes of ring per thread (default 256 KB, about 80 ms of tag reads
+    // at 50k/s), rounded up to a power of two; applies to threads that log
+    // for the first time afterwards.
+    static void setBufferSize(size_t bytes);
+
+    // Format and hand every record logged so far to sink, oldest first per
+    // thread. Lines end with a newline. Returns the number of records.
+    static size_t drain(const std::function<void(const char* line, size_t length)>& sink);
+
+    // Drain to the file at path every intervalMs on a background thread;
+    // when the file passes maxBytes it is moved to path.1 and restarted.
+    static bool startWriter(const std::string& path, uint32_t intervalMs = 500, size_t maxBytes = 4 << 20);
+    // Drain what is left and stop the writer.
+    static void stopWriter();
+    // Drain now (on the writer if there is one) and wait until written.
+    static void flush();
+
+    static TraceStats stats();
+
+    // Used by FLX_TRACE
+    template <typename... Args>
+    static uint16_t registerSite(const char* file, int line, const char* format, const Args&...) {
+        return addSite(file, line, format);
+    }
+    template <typename... Args>
+    static void record(uint16_t site, const char* format, const Args&... args);
+
+private:
+    struct Buffer;
+    struct Site {
+        const char* file;
+        int line;
+        const char* format;
+    };
+
+    static uint16_t addSite(const char* file, int line, const char* format);
+    static Buffer* threadBuffer();
+    static void createBufferKey();
+    static void retire(void* buffer);
+    static uint8_t* reserve(Buffer* buffer, size_t size);
+    static void commit(Buffer* buffer);
+    static uint64_t now();
+    static void writerLoop();
+
+    template <typename T>
+    static size_t argumentSize(const T&, typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type* = 0) { return 9; }
+    static size_t argumentSize(const char* string) { return 2 + (string ? strnlen(string, kTraceMaxBytes) : 0); }
+    static size_t argumentSize(const std::string& string) { return 2 + std::min(string.size(), kTraceMaxBytes); }
+    static size_t argumentSize(const TraceHex& hex) { return 2 + std::min(hex.length, kTraceMaxBytes); }
+
+    template <typename T>
+    static uint8_t* writeArgument(uint8_t* out, const T& value, typename std::enable_if<std::is_floating_point<T>::value>::type* = 0) {
+        double number = value;
+        *out = kTraceDouble;
+        memcpy(out + 1, &number, 8);
+        return out + 9;
+    }
+    template <typename T>
+    static uint8_t* writeArgument(uint8_t* out, const T& value, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type* = 0) {
+        bool isSigned = std::is_signed<T>::value;
+        int64_t number = isSigned ? static_cast<int64_t>(value) : static_cast<int64_t>(static_cast<uint64_t>(value));
+        *out = isSigned ? kTraceSigned : kTraceUnsigned;
+        memcpy(out + 1, &number, 8);
+        return out + 9;
+    }
+    static uint8_t* writeBytes(uint8_t* out, uint8_t type, const void* data, size_t length) {
+        length = std::min(length, kTraceMaxBytes);
+        out[0] = type;
+        out[1] = static_cast<uint8_t>(length);
+        if (length > 0) {
+            memcpy(out + 2, data, length);
+        }
+        return out + 2 + length;
+    }
+    static uint8_t* writeArgument(uint8_t* out, const char* string) {
+        return writeBytes(out, kTraceString, string, string ? strnlen(string, kTraceMaxBytes) : 0);
+    }
+    static uint8_t* writeArgument(uint8_t* out, const std::string& string) {
+        return writeBytes(out, kTraceString, string.data(), string.size());
+    }
+    static uint8_t* writeArgument(uint8_t* out, const TraceHex& hex) {
+        return writeBytes(out, kTraceHex, hex.data, hex.length);
+    }
+
+    static size_t totalSize() { return 0; }
+    template <typename T, typename... Rest>
+    static size_t totalSize(const T& first, const Rest&... rest) { return argumentSize(first) + totalSize(rest...); }
+
+    static uint8_t* writeAll(uint8_t* out) { return out; }
+    template <typename T, typename... Rest>
+    static uint8_t* writeAll(uint8_t* out, const T& first, const Rest&... rest) {
+        return writeAll(writeArgument(out, first), rest...);
+    }
+
+    static std::atomic<bool> enabled_;
+    static std::atomic<size_t> bufferSize_;
+    static std::mutex mutex_;               // buffers_, sites_
+    static std::vector<Buffer*> buffers_;
+    static std::vector<Site> sites_;
+    static uint64_t retiredRecords_;        // of buffers freed after their thread exited
+    static uint64_t retiredDropped_;
+    static std::mutex drainMutex_;          // one drain at a time; formatted_
+    static uint64_t formatted_;
+
+    static std::mutex writerMutex_;
+    static std::condition_variable writerWake_;
+    static std::condition_variable writerDone_;
+    static std::thread writer_;
+    static std::string writerPath_;
+    static FILE* writerFile_;
+    static uint32_t writerIntervalMs_;
+    static size_t writerMaxBytes_;
+    static bool writerStopping_;
+    static std::atomic<bool> drainWanted_;  // a ring passed its high-water mark
+    static uint64_t flushRequested_;
+    static uint64_t flushCompleted_;
+};
+
+// Record layout in a ring: site (2), size of the whole record (2), argument
+// count (4), timestamp in nanoseconds (8), arguments (type byte and value),
+// padded to 8 bytes. Site kTraceWrapSite means "continue at the start";
+// call sites past the table all get kTraceOverflowSite and are drained with
+// their time and thread but no message.
+const size_t kTraceRecordHeaderSize = 16;
+const uint16_t kTraceWrapSite = 0xFFFF;
+const uint16_t kTraceOverflowSite = 0xFFFE;
+
+template <typename... Args>
+void TraceLog::record(uint16_t site, const char*, const Args&... args) {
+    size_t size = (kTraceRecordHeaderSize + totalSize(args...) + 7) & ~static_cast<size_t>(7);
+    Buffer* buffer = threadBuffer();
+    uint8_t* out = buffer ? reserve(buffer, size) : NULL;
+    if (!out) {
+        return;
+    }
+    uint16_t size16 = static_cast<uint16_t>(size);
+    uint32_t count = sizeof...(args);
+    uint64_t time = now();
+    memcpy(out, &site, 2);
+    memcpy(out + 2, &size16, 2);
+    memcpy(out + 4, &count, 4);
+    memcpy(out + 8, &time, 8);
+    writeAll(out + kTraceRecordHeaderSize, args...);
+    commit(buffer);
+}
+
+}
+
+#endif
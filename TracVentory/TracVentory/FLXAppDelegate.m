@@ -8,6 +8,15 @@
 
 #import "FLXAppDelegate.h"
 #import <Parse/Parse.h>
+#import "FLXLocalStore.h"
+#import "FLXSearchIndex.h"
+#import "FLXLocationIndex.h"
+#import "FLXInventoryTotals.h"
+#import "FLXCheckInOutEngine.h"
+#import "FLXTagInfoCache.h"
+#import "FLXTraceLog.h"
+#import "FLXScannerBus.h"
+#import "FLXScanSources.h"
 
 @implementation FLXAppDelegate
 
@@ -18,7 +27,28 @@
                   clientKey:@"ov2EFXzG0hbyX0wMHQ3idM8SSLox4jIKcRKlMLNy"];
     
     [PFAnalytics trackAppOpenedWithLaunchOptions:launchOptions];
+
+    // The scan path logs with FLX_TRACE; records are written out in the background
+    [FLXTraceLog start];
     
+    // Items and Locations are queried offline through FLXLocalQuery
+    FLXLocalStore* store = [FLXLocalStore sharedStore];
+    [store ensureIndexForKey:@"itemID" inClass:@"Items"];
+    [store ensureIndexForKey:@"locationID" inClass:@"Items"];
+    [store ensureIndexForKey:@"locationID" inClass:@"Locations"];
+    [self syncLocalStore];
+
+    // Build the item search index in the background before the first search
+    [FLXSearchIndex sharedIndex];
+    // and the location index before the check-in screen asks where it is
+    [FLXLocationIndex sharedIndex];
+    // Counts and valuation are kept up to date as items change
+    [FLXInventoryTotals sharedTotals];
+
+    // Every scanner publishes into the bus; screens only listen to it
+    FLXScannerBus* scanners = [FLXScannerBus sharedBus];
+    [scanners addSource:[[FLXIDBlueScanSource alloc] init]];
+    [scanners addSource:[[FLXCameraScanSource alloc] init]];
     
     NSLog(@"%f, %f", [[UIScreen mainScreen] bounds].size.width, [[UIScreen mainScreen] bounds].size.height);
 
@@ -35,6 +65,10 @@
 {
     // Use this method to release shared resources, save user data, invalidate timers, and store enough application state information to restore your application to its current state in case it is terminated later. 
     // If your application supports background execution, this method is called instead of applicationWillTerminate: when the user quits.
+    [[FLXCheckInOutEngine sharedEngine] flush];
+    [[FLXLocalStore sharedStore] flush];
+    [[FLXTagInfoCache sharedCache] save];
+    [FLXTraceLog flush];
 }
 
 - (void)applicationWillEnterForeground:(UIApplication *)application
@@ -45,11 +79,34 @@
 - (void)applicationDidBecomeActive:(UIApplication *)application
 {
     // Restart any tasks that were paused (or not yet started) while the application was inactive. If the application was previously in the background, optionally refresh the user interface.
+    [self syncLocalStore];
 }
 
 - (void)applicationWillTerminate:(UIApplication *)application
 {
     // Called when the application is about to terminate. Save data if appropriate. See also applicationDidEnterBackground:.
+    [[FLXCheckInOutEngine sharedEngine] flush];
+    [[FLXLocalStore sharedStore] flush];
+    [[FLXTagInfoCache sharedCache] save];
+    [FLXTraceLog flush];
+}
+
+- (void)syncLocalStore
+{
+    for (NSString* className in @[@"Items", @"Locations"]) {
+        [[FLXLocalStore sharedStore] syncClassName:className completion:^(BOOL succeeded, NSError *error) {
+            if (!succeeded) {
+                NSLog(@"Sync of %@ failed: %@", className, error);
+                return;
+            }
+            if ([className isEqualToString:@"Items"]) {
+                // Scans Parse has not seen yet go back on the synced items
+                dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+                    [[FLXCheckInOutEngine sharedEngine] replayLog];
+                });
+            }
+        }];
+    }
 }
 
 
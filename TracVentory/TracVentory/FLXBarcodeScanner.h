@@ -0,0 +1,58 @@
+//
+//  FLXBarcodeScanner.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <AVFoundation/AVFoundation.h>
+
+typedef NS_ENUM(NSInteger, FLXBarcodeType) {
+    FLXBarcodeEan13,
+    FLXBarcodeEan8,
+    FLXBarcodeUpcA,
+    FLXBarcodeCode128,
+    FLXBarcodeQR
+};
+
+@interface FLXBarcode : NSObject
+@property (nonatomic, readonly) FLXBarcodeType type;
+@property (nonatomic, readonly) NSString* text;
+@property (nonatomic, readonly) NSDate* scanTime;
+
+-(id) initWithType: (FLXBarcodeType) type text: (NSString*) text scanTime: (NSDate*) scanTime;
+@end
+
+// FLXBarcodeScanner reads barcodes with the back camera. Frames come in as
+// 1280x720 luma (no color conversion), turned upright, and are decoded on a
+// background queue: a band across the middle of the frame, each scanline
+// averaged over four rows, goes through the portable EAN/UPC/Code 128
+// decoder of Core/BarcodeDecoder.h. Frames arriving while one is decoded
+// are dropped rather than queued, so a slow device reads fewer frames
+// instead of falling behind. QR codes are left to AVFoundation's own
+// detector.
+//
+// Core/Benchmarks/BarcodeDecoderBenchmark.cpp measures the same pipeline on
+// Linux.
+@interface FLXBarcodeScanner : NSObject
+
+// Called on the main thread for every read, which is once a frame while a
+// barcode is in view; FLXScannerBus drops the repeats within its dedup window
+@property (nonatomic, copy) void (^barcodeScanned)(FLXBarcode* barcode);
+
+// Shows what the camera sees; valid once started
+@property (nonatomic, readonly) AVCaptureVideoPreviewLayer* previewLayer;
+@property (nonatomic, readonly) BOOL isRunning;
+
+// Since the scanner was created
+@property (nonatomic, readonly) NSUInteger framesDecoded;
+@property (nonatomic, readonly) NSUInteger framesDropped;
+
+// NO if there is no camera or it may not be used. The camera starts and
+// stops on a queue of the scanner's own, so isRunning follows shortly after.
+-(BOOL) start;
+-(void) stop;
+
+@end
@@ -0,0 +1,211 @@
+//
+//  FLXBarcodeScanner.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXBarcodeScanner.h"
+#include <atomic>
+#include "BarcodeDecoder.h"
+#include "TraceLog.h"
+
+// Decoded band: the middle quarter of the upright frame, rows averaged in 4s
+static const unsigned kFLXBarcodeRowsAveraged = 4;
+static const unsigned kFLXBarcodeScanlines = 12;
+
+static FLXBarcodeType FLXBarcodeTypeFor(flx::BarcodeFormat format) {
+    switch (format) {
+        case flx::kBarcodeEan8:     return FLXBarcodeEan8;
+        case flx::kBarcodeUpcA:     return FLXBarcodeUpcA;
+        case flx::kBarcodeCode128:  return FLXBarcodeCode128;
+        default:                    return FLXBarcodeEan13;
+    }
+}
+
+@implementation FLXBarcode
+
+-(id) initWithType: (FLXBarcodeType) type text: (NSString*) text scanTime: (NSDate*) scanTime {
+    self = [super init];
+    if (self) {
+        _type = type;
+        _text = [text copy];
+        _scanTime = scanTime;
+    }
+    return self;
+}
+
+@end
+
+
+@interface FLXBarcodeScanner () <AVCaptureVideoDataOutputSampleBufferDelegate, AVCaptureMetadataOutputObjectsDelegate> {
+    AVCaptureSession* _session;
+    // startRunning and stopRunning block for as long as the camera takes;
+    // they run here, in order, never on the main thread
+    dispatch_queue_t _sessionQueue;
+    dispatch_queue_t _decodeQueue;
+    // Used on _decodeQueue only
+    flx::LumaFrame _frame;
+    flx::BarcodeDecoder _decoder;
+    std::atomic<NSUInteger> _framesDecoded;
+    std::atomic<NSUInteger> _framesDropped;
+}
+@property (nonatomic, readwrite) AVCaptureVideoPreviewLayer* previewLayer;
+@end
+
+@implementation FLXBarcodeScanner
+
+-(id) init {
+    self = [super init];
+    if (self) {
+        _sessionQueue = dispatch_queue_create("com.filelogix.tracventory.barcode.session", DISPATCH_QUEUE_SERIAL);
+        _decodeQueue = dispatch_queue_create("com.filelogix.tracventory.barcode", DISPATCH_QUEUE_SERIAL);
+        _decoder = flx::BarcodeDecoder(kFLXBarcodeScanlines);
+        _framesDecoded = 0;
+        _framesDropped = 0;
+    }
+    return self;
+}
+
+-(void) dealloc {
+    AVCaptureSession* session = _session;
+    if (session) {
+        dispatch_async(_sessionQueue, ^{
+            [session stopRunning];
+        });
+    }
+}
+
+-(BOOL) isRunning {
+    return [_session isRunning];
+}
+
+-(NSUInteger) framesDecoded {
+    return _framesDecoded;
+}
+
+-(NSUInteger) framesDropped {
+    return _framesDropped;
+}
+
+-(BOOL) start {
+    if (_session) {
+        [self startSession];
+        return YES;
+    }
+    AVCaptureDevice* camera = [AVCaptureDevice defaultDeviceWithMediaType:AVMediaTypeVideo];
+    NSError* error = nil;
+    AVCaptureDeviceInput* input = camera ? [AVCaptureDeviceInput deviceInputWithDevice:camera error:&error] : nil;
+    if (!input) {
+        NSLog(@"No camera for barcodes: %@", error);
+        return NO;
+    }
+
+    AVCaptureSession* session = [[AVCaptureSession alloc] init];
+    if ([session canSetSessionPreset:AVCaptureSessionPreset1280x720]) {
+        session.sessionPreset = AVCaptureSessionPreset1280x720;
+    }
+    [session addInput:input];
+
+    // Luma straight from the sensor: the Y plane of 4:2:0 is all we need
+    AVCaptureVideoDataOutput* video = [[AVCaptureVideoDataOutput alloc] init];
+    video.videoSettings = @{ (id) kCVPixelBufferPixelFormatTypeKey : @(kCVPixelFormatType_420YpCbCr8BiPlanarFullRange) };
+    video.alwaysDiscardsLateVideoFrames = YES;
+    [video setSampleBufferDelegate:self queue:_decodeQueue];
+    if (![session canAddOutput:video]) {
+        return NO;
+    }
+    [session addOutput:video];
+    AVCaptureConnection* connection = [video connectionWithMediaType:AVMediaTypeVideo];
+    if ([connection isVideoOrientationSupported]) {
+        // Bars of a barcode held level on screen run down the frame
+        connection.videoOrientation = AVCaptureVideoOrientationPortrait;
+    }
+
+    AVCaptureMetadataOutput* metadata = [[AVCaptureMetadataOutput alloc] init];
+    if ([session canAddOutput:metadata]) {
+        [session addOutput:metadata];
+        [metadata setMetadataObjectsDelegate:self queue:dispatch_get_main_queue()];
+        if ([[metadata availableMetadataObjectTypes] containsObject:AVMetadataObjectTypeQRCode]) {
+            metadata.metadataObjectTypes = @[ AVMetadataObjectTypeQRCode ];
+        }
+    }
+
+    _session = session;
+    self.previewLayer = [AVCaptureVideoPreviewLayer layerWithSession:session];
+    self.previewLayer.videoGravity = AVLayerVideoGravityResizeAspectFill;
+    [self startSession];
+    return YES;
+}
+
+-(void) startSession {
+    AVCaptureSession* session = _session;
+    dispatch_async(_sessionQueue, ^{
+        [session startRunning];
+    });
+}
+
+-(void) stop {
+    AVCaptureSession* session = _session;
+    if (!session) {
+        return;
+    }
+    dispatch_async(_sessionQueue, ^{
+        [session stopRunning];
+    });
+}
+
+#pragma mark - Decoding
+
+-(void) captureOutput: (AVCaptureOutput*) output didDropSampleBuffer: (CMSampleBufferRef) sampleBuffer fromConnection: (AVCaptureConnection*) connection {
+    // Late: the previous frame was still being decoded
+    _framesDropped++;
+}
+
+-(void) captureOutput: (AVCaptureOutput*) output didOutputSampleBuffer: (CMSampleBufferRef) sampleBuffer fromConnection: (AVCaptureConnection*) connection {
+    CVPixelBufferRef pixels = CMSampleBufferGetImageBuffer(sampleBuffer);
+    if (!pixels || CVPixelBufferLockBaseAddress(pixels, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess) {
+        return;
+    }
+    size_t width = CVPixelBufferGetWidthOfPlane(pixels, 0);
+    size_t height = CVPixelBufferGetHeightOfPlane(pixels, 0);
+    flx::FrameRegion band = { 0, height * 3 / 8, width, height / 4 };
+    _frame.fromLuma(static_cast<const uint8_t*>(CVPixelBufferGetBaseAddressOfPlane(pixels, 0)), width, height,
+                    CVPixelBufferGetBytesPerRowOfPlane(pixels, 0), band, 1, kFLXBarcodeRowsAveraged);
+    CVPixelBufferUnlockBaseAddress(pixels, kCVPixelBufferLock_ReadOnly);
+
+    flx::Barcode barcode;
+    bool read = _decoder.decode(_frame, barcode);
+    _framesDecoded++;
+    if (!read) {
+        return;
+    }
+    FLX_TRACE("Barcode %s in frame %lu", barcode.text.c_str(), (unsigned long) _framesDecoded);
+    FLXBarcode* result = [[FLXBarcode alloc] initWithType:FLXBarcodeTypeFor(barcode.format)
+                                                     text:[NSString stringWithUTF8String:barcode.text.c_str()]
+                                                 scanTime:[NSDate date]];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self report:result];
+    });
+}
+
+-(void) captureOutput: (AVCaptureOutput*) output didOutputMetadataObjects: (NSArray*) objects fromConnection: (AVCaptureConnection*) connection {
+    for (AVMetadataObject* object in objects) {
+        if ([object isKindOfClass:[AVMetadataMachineReadableCodeObject class]] && [object.type isEqualToString:AVMetadataObjectTypeQRCode]) {
+            NSString* text = [(AVMetadataMachineReadableCodeObject*) object stringValue];
+            if (text) {
+                [self report:[[FLXBarcode alloc] initWithType:FLXBarcodeQR text:text scanTime:[NSDate date]]];
+            }
+        }
+    }
+}
+
+// Main thread. Every read is reported; FLXScannerBus drops repeats.
+-(void) report: (FLXBarcode*) barcode {
+    if (self.barcodeScanned) {
+        self.barcodeScanned(barcode);
+    }
+}
+
+@end
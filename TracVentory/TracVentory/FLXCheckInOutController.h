@@ -7,7 +7,43 @@
 //
 
 #import <UIKit/UIKit.h>
+#import "FLXCheckInOutEngine.h"
+
+@class IDBlueSdk;
+@class FLXLocationAudit;
+@class FLXAuditReport;
 
 @interface FLXCheckInOutController : UIViewController
 
+// What a scan records; this screen checks items out by default
+@property (nonatomic) FLXCheckDirection direction;
+// Location items are checked in to. Until one is set, the location
+// nearest the device is proposed and used.
+@property (strong, nonatomic) NSString* locationID;
+// Local store record of the location proposed from where the device is,
+// nil if none is near
+@property (strong, nonatomic, readonly) NSDictionary* nearestLocation;
+// Scans arrive from every source on FLXScannerBus; this is the IDBLUE pen
+// among them, nil if the app has not added one
+@property (strong, nonatomic, readonly) IDBlueSdk* idBlue;
+
+// The audit of locationID under way, nil if none. While one runs, item
+// scans are counted against the items expected there instead of being
+// checked in or out.
+@property (strong, nonatomic, readonly) FLXLocationAudit* audit;
+
+// Read the tag in front of the pen now, as its scan button does
+-(void) scanTag;
+
+// Start auditing locationID; NO if no location is set or one is under way
+-(BOOL) startAudit;
+// End the audit and show what is missing and what does not belong there;
+// nil if none was under way
+-(FLXAuditReport*) finishAudit;
+// The Audit button: start an audit, or finish the one under way
+-(IBAction) auditLocation: (id) sender;
+
+// Show the camera and read a barcode with it; again to put it away
+-(IBAction) scanBarcode: (id) sender;
+
 @end
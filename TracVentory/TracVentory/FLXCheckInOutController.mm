@@ -0,0 +1,336 @@
+//
+//  FLXCheckInOutController.mm
+//  TracVentory
+//
+//  Created by Administrator on 4/16/14.
+//  Copyright (c) 2014 FileLogix. All rights reserved.
+//
+
+#import "FLXCheckInOutController.h"
+#import "FLXScannerBus.h"
+#import "FLXScanSources.h"
+#import "FLXEpc.h"
+#import "FLXScanLatencyHarness.h"
+#import "FLXLocationIndex.h"
+#import "FLXLocationAudit.h"
+#import "FLXItemCursor.h"
+#include "TraceLog.h"
+
+// Locations further than this from the device are not proposed
+static const CLLocationDistance kFLXNearestLocationRadius = 500;
+
+// Fixes less accurate than this are not used to propose a location
+static const CLLocationAccuracy kFLXNearestLocationAccuracy = 200;
+
+// Missing items named in the audit summary; the rest are counted
+static const NSUInteger kFLXAuditSummaryItems = 10;
+
+@interface FLXCheckInOutController () <CLLocationManagerDelegate> {
+    CLLocationManager* _locationManager;
+    // Whether locationID came from nearestLocation rather than being set
+    BOOL _locationProposed;
+}
+@property (weak, nonatomic) IBOutlet UITextField *textField;
+@property (weak, nonatomic) IBOutlet UILabel *locationLabel;
+@property (strong, nonatomic, readwrite) NSDictionary* nearestLocation;
+@property (strong, nonatomic, readwrite) FLXLocationAudit* audit;
+@end
+
+@implementation FLXCheckInOutController
+
+- (id)initWithStyle:(UITableViewStyle)style
+{
+    self = [super init];
+    if (self) {
+        // Custom initialization
+        _direction = FLXCheckOut;
+    }
+    return self;
+}
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super initWithCoder:aDecoder];
+    if (self) {
+        _direction = FLXCheckOut;
+    }
+    return self;
+}
+
+- (void)viewDidLoad
+{
+    [super viewDidLoad];
+    
+    // Uncomment the following line to preserve selection between presentations.
+    // self.clearsSelectionOnViewWillAppear = NO;
+    
+    // Uncomment the following line to display an Edit button in the navigation bar for this view controller.
+    // self.navigationItem.rightBarButtonItem = self.editButtonItem;
+
+    self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithTitle:@"Audit"
+                                                                              style:UIBarButtonItemStylePlain
+                                                                             target:self
+                                                                             action:@selector(auditLocation:)];
+
+    // Whichever scanners the app has added to the bus
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(scanReceived:)
+                                                 name:FLXScanNotification
+                                               object:[FLXScannerBus sharedBus]];
+
+    _locationManager = [[CLLocationManager alloc] init];
+    _locationManager.delegate = self;
+    _locationManager.desiredAccuracy = kCLLocationAccuracyNearestTenMeters;
+    _locationManager.distanceFilter = 25;
+}
+
+- (void)viewWillAppear:(BOOL)animated
+{
+    [super viewWillAppear:animated];
+    // The last fix proposes a location at once; updates refine it
+    if (_locationManager.location) {
+        [self proposeLocationNear:_locationManager.location];
+    }
+    [_locationManager startUpdatingLocation];
+}
+
+- (void)viewWillDisappear:(BOOL)animated
+{
+    [super viewWillDisappear:animated];
+    [_locationManager stopUpdatingLocation];
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    _locationManager.delegate = nil;
+    [self stopBarcodeScanner];
+}
+
+- (void)didReceiveMemoryWarning
+{
+    [super didReceiveMemoryWarning];
+    // Dispose of any resources that can be recreated.
+}
+
+
+
+
+#pragma mark - Nearest location
+
+-(void) setLocationID: (NSString*) locationID {
+    _locationID = locationID;
+    _locationProposed = NO;
+}
+
+-(void) locationManager: (CLLocationManager*) manager didUpdateLocations: (NSArray*) locations {
+    [self proposeLocationNear:[locations lastObject]];
+}
+
+-(void) locationManager: (CLLocationManager*) manager didFailWithError: (NSError*) error {
+    NSLog(@"Location update failed: %@", error);
+}
+
+// Looked up in the local index, so this works offline
+-(void) proposeLocationNear: (CLLocation*) fix {
+    if (fix.horizontalAccuracy < 0 || fix.horizontalAccuracy > kFLXNearestLocationAccuracy) {
+        return;
+    }
+    __weak FLXCheckInOutController* weakSelf = self;
+    [[FLXLocationIndex sharedIndex] nearestLocationToCoordinate:fix.coordinate
+                                                   withinMeters:kFLXNearestLocationRadius
+                                                     completion:^(NSDictionary* location, CLLocationDistance distance) {
+        [weakSelf showNearestLocation:location distance:distance];
+    }];
+}
+
+-(void) showNearestLocation: (NSDictionary*) location distance: (CLLocationDistance) distance {
+    self.nearestLocation = location;
+    if (!self.locationID || _locationProposed) {
+        _locationID = location[@"locationID"];
+        _locationProposed = _locationID != nil;
+    }
+    if (location) {
+        NSString* name = location[@"name"] ?: location[@"locationID"];
+        self.locationLabel.text = [NSString stringWithFormat:@"%@ (%.0f m)", name, distance];
+        FLX_TRACE("Nearest location %s at %.0f m", [[name description] UTF8String], distance);
+    }
+    else {
+        self.locationLabel.text = @"current location";
+    }
+}
+
+#pragma mark - Scanning
+
+-(IDBlueSdk*) idBlue {
+    FLXIDBlueScanSource* source = (FLXIDBlueScanSource*) [[FLXScannerBus sharedBus] sourceOfType:FLXScanSourceIDBlue];
+    return source.idBlue;
+}
+
+-(FLXCameraScanSource*) camera {
+    return (FLXCameraScanSource*) [[FLXScannerBus sharedBus] sourceOfType:FLXScanSourceCamera];
+}
+
+-(void) scanReceived: (NSNotification*) notification {
+    FLXScan* scan = notification.userInfo[FLXScanKey];
+    FLX_TRACE("Scanned %s, direction %d", [scan.text UTF8String], self.direction);
+
+    if (scan.source == FLXScanSourceCamera) {
+        [self stopBarcodeScanner];
+    }
+
+    // GS1 tags read better as their identity, e.g. sgtin:0614141.812345.6789
+    NSString* identity = nil;
+    if (scan.symbology == FLXSymbologyEpc) {
+        identity = [FLXEpc identityForBytes:(const uint8_t*) [scan.data bytes] length:[scan.data length]];
+    }
+    if (identity) {
+        [[self textField] setText:[identity stringByReplacingOccurrencesOfString:@"urn:epc:id:" withString:@""]];
+    }
+    else if (scan.symbology == FLXSymbologyEpc) {
+        [[self textField] setText:[self trimZero:scan.text]];
+    }
+    else {
+        [[self textField] setText:scan.text];
+    }
+    if (scan.symbology == FLXSymbologyEpc &&
+        [FLXScanLatencyHarness tagObserved:(const uint8_t*) [scan.data bytes] length:[scan.data length]]) {
+        // Shown like any scan, but nothing was checked in or out
+        return;
+    }
+
+    if (self.audit) {
+        [self.audit recordScan:scan];
+        [self showAuditProgress];
+        return;
+    }
+
+    // Asset labels print the tag id as Code 128 or QR and go the way of an
+    // RFID read; EAN/UPC name a product rather than an item, and are only shown
+    if ([scan isItemCode]) {
+        NSError* error = nil;
+        if (![[FLXCheckInOutEngine sharedEngine] recordTagId:scan.text
+                                                   direction:self.direction
+                                                  locationID:self.locationID
+                                                    readerID:scan.readerID
+                                                    scanTime:scan.scanTime
+                                                       error:&error] && error) {
+            // The item did not move; whoever is scanning has to know
+            [[[UIAlertView alloc] initWithTitle:@"Scan not recorded"
+                                        message:[error localizedDescription]
+                                       delegate:nil
+                              cancelButtonTitle:@"OK"
+                              otherButtonTitles:nil] show];
+        }
+    }
+}
+
+-(void) scanTag {
+    FLXIDBlueScanSource* source = (FLXIDBlueScanSource*) [[FLXScannerBus sharedBus] sourceOfType:FLXScanSourceIDBlue];
+    __weak FLXCheckInOutController* weakSelf = self;
+    [source scanWithCompletion:^(BOOL read) {
+        if (!read) {
+            [[weakSelf textField] setText:@"..."];
+        }
+    }];
+}
+
+-(IBAction) scanBarcode: (id) sender {
+    FLXCameraScanSource* camera = [self camera];
+    // Shown from the moment it is started; isCameraRunning lags behind
+    if (camera.previewLayer.superlayer == self.view.layer) {
+        [self stopBarcodeScanner];
+        return;
+    }
+    if (![camera startCamera]) {
+        return;
+    }
+    CALayer* preview = camera.previewLayer;
+    CGRect bounds = self.view.bounds;
+    preview.frame = CGRectMake(0, self.topLayoutGuide.length, bounds.size.width, bounds.size.height / 3);
+    [self.view.layer addSublayer:preview];
+}
+
+-(void) stopBarcodeScanner {
+    FLXCameraScanSource* camera = [self camera];
+    if (![self isViewLoaded] || camera.previewLayer.superlayer != self.view.layer) {
+        return;
+    }
+    [camera stopCamera];
+    [camera.previewLayer removeFromSuperlayer];
+}
+
+#pragma mark - Location audit
+
+-(BOOL) startAudit {
+    if (self.audit || !self.locationID) {
+        return NO;
+    }
+    self.audit = [[FLXLocationAudit alloc] initWithLocationID:self.locationID store:[FLXLocalStore sharedStore]];
+    self.navigationItem.rightBarButtonItem.title = @"Finish";
+    [self showAuditProgress];
+    return YES;
+}
+
+-(FLXAuditReport*) finishAudit {
+    FLXAuditReport* report = [self.audit finish];
+    if (!report) {
+        return nil;
+    }
+    self.audit = nil;
+    self.navigationItem.rightBarButtonItem.title = @"Audit";
+    self.navigationItem.prompt = nil;
+
+    NSMutableString* message = [NSMutableString stringWithFormat:@"%lu of %lu items found, %lu reads.",
+                                (unsigned long) [report.foundItems count],
+                                (unsigned long) ([report.foundItems count] + [report.missingItems count]),
+                                (unsigned long) report.readCount];
+    if ([report.missingItems count] > 0) {
+        [message appendString:@"\n\nMissing:"];
+        NSUInteger shown = MIN([report.missingItems count], kFLXAuditSummaryItems);
+        for (NSUInteger i = 0; i < shown; i++) {
+            [message appendFormat:@"\n%@", [[FLXItemCellModel alloc] initWithRecord:report.missingItems[i]].title];
+        }
+        if ([report.missingItems count] > shown) {
+            [message appendFormat:@"\nand %lu more", (unsigned long) ([report.missingItems count] - shown)];
+        }
+    }
+    if ([report.unexpectedTagIds count] > 0) {
+        [message appendFormat:@"\n\n%lu tags read that do not belong here.", (unsigned long) [report.unexpectedTagIds count]];
+    }
+    [[[UIAlertView alloc] initWithTitle:[NSString stringWithFormat:@"Audit of %@", report.locationID]
+                                message:message
+                               delegate:nil
+                      cancelButtonTitle:@"OK"
+                      otherButtonTitles:nil] show];
+    return report;
+}
+
+-(IBAction) auditLocation: (id) sender {
+    if (self.audit) {
+        [self finishAudit];
+    }
+    else if (![self startAudit]) {
+        self.locationLabel.text = @"choose a location to audit";
+    }
+}
+
+-(void) showAuditProgress {
+    FLXLocationAudit* audit = self.audit;
+    self.navigationItem.prompt = [NSString stringWithFormat:@"Audit: %lu of %lu found, %lu unexpected",
+                                  (unsigned long) audit.foundCount,
+                                  (unsigned long) audit.expectedCount,
+                                  (unsigned long) audit.unexpectedCount];
+}
+
+-(NSString *)trimZero:(NSString*)inputString {
+    
+    NSScanner *scanner = [NSScanner scannerWithString:inputString];
+    NSCharacterSet *zeros = [NSCharacterSet
+                             characterSetWithCharactersInString:@"0"];
+    [scanner scanCharactersFromSet:zeros intoString:NULL];
+    
+    return [inputString substringFromIndex:[scanner scanLocation]];
+}
+
+@end
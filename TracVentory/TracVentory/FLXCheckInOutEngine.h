@@ -0,0 +1,124 @@
+//
+//  FLXCheckInOutEngine.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "FLXLocalStore.h"
+
+@class RfidResponse;
+
+typedef NS_ENUM(NSInteger, FLXCheckDirection) {
+    FLXCheckIn,
+    FLXCheckOut
+};
+
+extern NSString* const FLXCheckInOutErrorDomain;
+
+typedef NS_ENUM(NSInteger, FLXCheckInOutErrorCode) {
+    // The journal is full (it keeps every event Parse has not confirmed)
+    // or could not be opened; the scan was not recorded
+    FLXCheckInOutErrorNotJournaled = 1
+};
+
+// One check-in or check-out scan. The eventId is derived from the reader,
+// tag, scan time and direction, so a read delivered twice maps to the same
+// event and is applied once.
+@interface FLXCheckEvent : NSObject
+@property (nonatomic, readonly) NSString* eventId;
+@property (nonatomic, readonly) NSString* itemID;          // canonical tag id
+@property (nonatomic, readonly) NSString* tagId;           // as scanned
+@property (nonatomic, readonly) NSString* locationID;
+@property (nonatomic, readonly) FLXCheckDirection direction;
+@property (nonatomic, readonly) NSString* readerID;
+@property (nonatomic, readonly) NSDate* scanTime;
+@property (nonatomic, readonly) NSString* transactionID;   // set for events of a transaction
+
+-(id) initWithDictionary: (NSDictionary*) dictionary;
+-(NSDictionary*) dictionaryRepresentation;
+@end
+
+// FLXCheckInOutEngine turns scans into check-in/out events. Each event is
+// appended to a journal (a memory mapped, checksummed flx::ScanJournal)
+// before anything else happens; appending never waits for the disk, the
+// journal syncs in groups a few milliseconds apart. Recording does nothing
+// else, so a scan never waits behind a batch. Item state (status,
+// locationID, lastCheckAt) is then updated write-behind on a queue of its
+// own: the item a tag names is looked up, changes are coalesced per item
+// and written to the local store and Parse in one batch every
+// flushInterval. An event scanned before the item's lastCheckAt, such
+// as a delayed read from another reader, is journaled but does not change
+// the item.
+//
+// One batch is in flight at a time. A batch Parse fails is merged into the
+// next, which waits twice as long as the last attempt (up to five
+// minutes). Once a batch has reached the store and Parse, its events are
+// marked applied. Compacting the journal folds them into a snapshot (the
+// latest event of each item, written next to the journal) before dropping
+// them, so the snapshot and the journal can always rebuild item state: see
+// replayLog. Events Parse has not confirmed stay in the journal; when it is
+// full, recording fails with FLXCheckInOutErrorNotJournaled rather than
+// losing the scan. After a crash the journal keeps every event up to the
+// last group sync; those not yet applied are staged again when the engine
+// opens and go out with its first batch.
+//
+// Events recorded between beginTransaction and commitTransaction: (a cart)
+// are logged as a single entry and applied as a single batch.
+//
+// All methods are thread safe.
+@interface FLXCheckInOutEngine : NSObject
+
+// Seconds between write-behind batches (default 2)
+@property (nonatomic) NSTimeInterval flushInterval;
+
+// Whether batches are also saved to Parse (default YES)
+@property (nonatomic) BOOL savesToParse;
+
+// Engine journaling to Documents/FLXCheckInOut.journal over the shared
+// store. Entries of an FLXCheckInOut.log from earlier versions are moved in.
++(FLXCheckInOutEngine*) sharedEngine;
+
+-(id) initWithLogPath: (NSString*) logPath store: (FLXLocalStore*) store;
+
+// Record a scan. Returns nil if the same event was already recorded, or
+// with error set if it could not be journaled.
+-(FLXCheckEvent*) recordTagId: (NSString*) tagId
+                    direction: (FLXCheckDirection) direction
+                   locationID: (NSString*) locationID
+                     readerID: (NSString*) readerID
+                     scanTime: (NSDate*) scanTime
+                        error: (NSError**) error;
+
+// Record the tag and reader timestamp of a read tag id response.
+-(FLXCheckEvent*) recordResponse: (RfidResponse*) response
+                       direction: (FLXCheckDirection) direction
+                      locationID: (NSString*) locationID
+                        readerID: (NSString*) readerID
+                           error: (NSError**) error;
+
+// The Items record a tag id names: by EPC identity when it is a GS1 tag,
+// else by itemID, as scanned or canonical. nil if none or not a tag id.
+-(NSDictionary*) itemForTagId: (NSString*) tagId;
+
+-(void) beginTransaction;
+// Log and apply the events recorded since beginTransaction. Returns the
+// number of events committed; 0 with error set if they could not be
+// journaled, leaving the transaction open.
+-(NSUInteger) commitTransaction: (NSError**) error;
+// Drop the events recorded since beginTransaction.
+-(void) rollbackTransaction;
+
+// Apply pending state changes now and sync the log to disk.
+-(void) flush;
+
+// Give every item in the local store the state of its latest journaled or
+// snapshot event, unless it already holds that scan or a later one: after
+// the store was purged and synced again from Parse, scans Parse has not
+// seen are back. Waits for the write-behind batch; call it off the main
+// thread. Returns the number of items updated.
+-(NSUInteger) replayLog;
+
+@end
@@ -0,0 +1,706 @@
+//
+//  FLXCheckInOutEngine.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXCheckInOutEngine.h"
+#import "FLXEpc.h"
+#import "FLXTimestamp.h"
+#import <IDBLUE/RfidResponse.h>
+#import <Parse/Parse.h>
+#include "ScanJournal.h"
+
+// A batch is written early once this many items are waiting
+static const NSUInteger kFLXCheckMaxPendingItems = 500;
+
+// The journal is compacted once applied entries take this much of it
+static const size_t kFLXCheckCompactBytes = 256 * 1024;
+
+// A failed batch is retried after twice the wait of the one before, from
+// twice flushInterval up to this many seconds
+static const NSTimeInterval kFLXCheckMaxRetryInterval = 300;
+
+NSString* const FLXCheckInOutErrorDomain = @"FLXCheckInOutErrorDomain";
+
+static NSString* FLXDirectionName(FLXCheckDirection direction) {
+    return direction == FLXCheckIn ? @"in" : @"out";
+}
+
+// Hex digits only, uppercase, without leading zeros: "00 00 e0 04" -> "E004"
+static NSString* FLXCanonicalTagId(NSString* tagId) {
+    NSMutableString* canonical = [[NSMutableString alloc] initWithCapacity:[tagId length]];
+    for (NSUInteger i = 0; i < [tagId length]; i++) {
+        unichar c = [tagId characterAtIndex:i];
+        if (c == '0' && [canonical length] == 0) {
+            continue;
+        }
+        if ((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F')) {
+            [canonical appendFormat:@"%C", c];
+        }
+        else if (c >= 'a' && c <= 'f') {
+            [canonical appendFormat:@"%C", (unichar) (c - 'a' + 'A')];
+        }
+        else if (c != ' ' && c != ':' && c != '-') {
+            return nil;
+        }
+    }
+    return [canonical length] > 0 ? canonical : nil;
+}
+
+
+@interface FLXCheckEvent ()
+// Journal entry holding the event, 0 until journaled
+@property (nonatomic) uint64_t sequence;
+@end
+
+@implementation FLXCheckEvent
+
+// IDBLUE timestamps have one second resolution
++(NSString*) eventIdForItemID: (NSString*) itemID
+                    direction: (FLXCheckDirection) direction
+                     readerID: (NSString*) readerID
+                     scanTime: (NSDate*) scanTime {
+    return [NSString stringWithFormat:@"%@|%@|%.0f|%@", readerID ?: @"", itemID, floor([scanTime timeIntervalSince1970]), FLXDirectionName(direction)];
+}
+
+-(id) initWithItemID: (NSString*) itemID
+               tagId: (NSString*) tagId
+          locationID: (NSString*) locationID
+           direction: (FLXCheckDirection) direction
+            readerID: (NSString*) readerID
+            scanTime: (NSDate*) scanTime
+       transactionID: (NSString*) transactionID {
+    self = [super init];
+    if (self) {
+        _itemID = [itemID copy];
+        _tagId = [tagId copy] ?: _itemID;
+        _locationID = [locationID copy];
+        _direction = direction;
+        _readerID = [readerID copy] ?: @"";
+        _scanTime = scanTime;
+        _transactionID = [transactionID copy];
+        _eventId = [FLXCheckEvent eventIdForItemID:_itemID direction:direction readerID:_readerID scanTime:scanTime];
+    }
+    return self;
+}
+
+-(id) initWithDictionary: (NSDictionary*) dictionary {
+    NSString* itemID = dictionary[@"itemID"];
+    NSNumber* scanTime = dictionary[@"scanTime"];
+    if (![itemID isKindOfClass:[NSString class]] || ![scanTime isKindOfClass:[NSNumber class]]) {
+        return nil;
+    }
+    return [self initWithItemID:itemID
+                          tagId:dictionary[@"tagId"]
+                     locationID:dictionary[@"locationID"]
+                      direction:[dictionary[@"direction"] isEqualToString:@"in"] ? FLXCheckIn : FLXCheckOut
+                       readerID:dictionary[@"readerID"]
+                       scanTime:[NSDate dateWithTimeIntervalSince1970:[scanTime doubleValue]]
+                  transactionID:dictionary[@"transactionID"]];
+}
+
+-(NSDictionary*) dictionaryRepresentation {
+    NSMutableDictionary* dictionary = [[NSMutableDictionary alloc] init];
+    dictionary[@"id"] = _eventId;
+    dictionary[@"itemID"] = _itemID;
+    dictionary[@"direction"] = FLXDirectionName(_direction);
+    dictionary[@"readerID"] = _readerID;
+    dictionary[@"scanTime"] = @([_scanTime timeIntervalSince1970]);
+    if (![_tagId isEqualToString:_itemID]) {
+        dictionary[@"tagId"] = _tagId;
+    }
+    if (_locationID) {
+        dictionary[@"locationID"] = _locationID;
+    }
+    if (_transactionID) {
+        dictionary[@"transactionID"] = _transactionID;
+    }
+    return dictionary;
+}
+
+@end
+
+
+@interface FLXCheckInOutEngine () {
+    FLXLocalStore* _store;
+    NSString* _logPath;
+    flx::ScanJournal _journal;
+    // Recording: the event ids seen, transactions and the journal. Nothing
+    // on it waits for the store or the network.
+    dispatch_queue_t _queue;
+    NSMutableSet* _eventIds;
+    NSMutableArray* _transactionEvents;
+    NSString* _transactionID;
+    // Latest event per itemID of the entries compacted away, as of journal
+    // entry _snapshotSequence; kept in _snapshotPath
+    NSString* _snapshotPath;
+    NSMutableDictionary* _snapshot;
+    uint64_t _snapshotSequence;
+
+    // Write-behind: everything below. One batch is in flight at a time;
+    // events staged meanwhile, and those of a batch that failed, wait in
+    // _pendingEvents for the next.
+    dispatch_queue_t _flushQueue;
+    // Latest event per item objectId, waiting for the next batch
+    NSMutableDictionary* _pendingEvents;
+    // Last journal entry whose events have been staged, and applied
+    uint64_t _stagedSequence;
+    uint64_t _appliedSequence;
+    BOOL _batchInFlight;
+    // Seconds until the next attempt after a failed batch, 0 if none failed
+    NSTimeInterval _retryInterval;
+    // Counts flushes, so a timer set before one does not fire another early
+    NSUInteger _flushGeneration;
+    BOOL _flushScheduled;
+}
+@end
+
+@implementation FLXCheckInOutEngine
+
++(FLXCheckInOutEngine*) sharedEngine {
+    static FLXCheckInOutEngine* sharedEngine = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString* documents = [NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES) firstObject];
+        sharedEngine = [[FLXCheckInOutEngine alloc] initWithLogPath:[documents stringByAppendingPathComponent:@"FLXCheckInOut.journal"]
+                                                               store:[FLXLocalStore sharedStore]];
+    });
+    return sharedEngine;
+}
+
+-(id) initWithLogPath: (NSString*) logPath store: (FLXLocalStore*) store {
+    self = [super init];
+    if (self) {
+        _store = store;
+        _logPath = [logPath copy];
+        _snapshotPath = [[_logPath stringByDeletingPathExtension] stringByAppendingPathExtension:@"snapshot"];
+        _queue = dispatch_queue_create("com.filelogix.tracventory.checkinout", DISPATCH_QUEUE_SERIAL);
+        _flushQueue = dispatch_queue_create("com.filelogix.tracventory.checkinout.flush", DISPATCH_QUEUE_SERIAL);
+        _eventIds = [[NSMutableSet alloc] init];
+        _pendingEvents = [[NSMutableDictionary alloc] init];
+        _flushInterval = 2.0;
+        _savesToParse = YES;
+
+        [_store ensureIndexForKey:@"itemID" inClass:@"Items"];
+        [FLXEpc ensureIndexesInStore:_store];
+
+        if (!_journal.open([_logPath fileSystemRepresentation])) {
+            NSLog(@"Cannot open the check-in/out journal at %@", _logPath);
+        }
+        flx::JournalStats stats = _journal.stats();
+        if (stats.truncatedBytes > 0) {
+            NSLog(@"Dropped %llu bytes of incomplete check-in/out journal entry", (unsigned long long) stats.truncatedBytes);
+        }
+        [self migrateLegacyLog:[[_logPath stringByDeletingPathExtension] stringByAppendingPathExtension:@"log"]];
+        [self loadSnapshot];
+
+        // Events after the applied mark never reached the store (or Parse)
+        // before the app went away; they go into the first batch
+        for (FLXCheckEvent* event in [self journalEventsAfter:0]) {
+            [_eventIds addObject:event.eventId];
+        }
+        NSArray* unapplied = [self journalEventsAfter:_journal.appliedSequence()];
+        _stagedSequence = _appliedSequence = _journal.appliedSequence();
+        dispatch_async(_flushQueue, ^{
+            for (FLXCheckEvent* event in unapplied) {
+                [self stageEvent:event];
+            }
+            [self scheduleFlush];
+        });
+    }
+    return self;
+}
+
+-(void) dealloc {
+    _journal.close();
+}
+
+#pragma mark - Journal
+
++(void) addEventsOfEntry: (NSData*) data sequence: (uint64_t) sequence toArray: (NSMutableArray*) events {
+    NSDictionary* entry = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+    if (![entry isKindOfClass:[NSDictionary class]]) {
+        return;
+    }
+    NSArray* entryEvents = entry[@"events"] ?: @[entry];
+    for (NSDictionary* dictionary in entryEvents) {
+        FLXCheckEvent* event = [[FLXCheckEvent alloc] initWithDictionary:dictionary];
+        if (event) {
+            event.sequence = sequence;
+            [events addObject:event];
+        }
+    }
+}
+
+// The events of journal entries after sequence, in order
+-(NSArray*) journalEventsAfter: (uint64_t) sequence {
+    NSMutableArray* events = [[NSMutableArray alloc] init];
+    _journal.forEach([events, sequence](uint64_t entrySequence, const uint8_t* data, size_t length) {
+        if (entrySequence <= sequence) {
+            return;
+        }
+        [FLXCheckInOutEngine addEventsOfEntry:[NSData dataWithBytesNoCopy:(void*) data length:length freeWhenDone:NO]
+                                     sequence:entrySequence
+                                      toArray:events];
+    });
+    return events;
+}
+
+// Entries of the JSON-lines log earlier versions kept are moved into the
+// journal once; a line cut short by a crash is dropped
+-(void) migrateLegacyLog: (NSString*) legacyPath {
+    if ([legacyPath isEqualToString:_logPath] || !_journal.isOpen()) {
+        return;
+    }
+    NSData* data = [NSData dataWithContentsOfFile:legacyPath options:0 error:NULL];
+    if (!data) {
+        return;
+    }
+    const char* bytes = (const char*) [data bytes];
+    NSUInteger start = 0;
+    for (NSUInteger i = 0; i < [data length]; i++) {
+        if (bytes[i] == '\n') {
+            if (i > start) {
+                _journal.append(bytes + start, i - start);
+            }
+            start = i + 1;
+        }
+    }
+    _journal.commit();
+    [[NSFileManager defaultManager] removeItemAtPath:legacyPath error:NULL];
+}
+
+// Must be called on _queue. One entry is one journal record; appending
+// copies it into the mapped journal and never waits for the disk. Returns
+// the entry's sequence, 0 if it could not be journaled.
+-(uint64_t) appendEntry: (NSDictionary*) entry {
+    NSData* data = [NSJSONSerialization dataWithJSONObject:entry options:0 error:NULL];
+    uint64_t sequence = _journal.append([data bytes], [data length]);
+    if (sequence == 0 && [self compactJournal]) {
+        sequence = _journal.append([data bytes], [data length]);
+    }
+    if (sequence == 0) {
+        NSLog(@"Cannot journal check-in/out entry");
+    }
+    return sequence;
+}
+
+// Keep event in latest (itemID -> event) unless it holds a later one
++(void) keepLatestEvent: (FLXCheckEvent*) event in: (NSMutableDictionary*) latest {
+    FLXCheckEvent* current = latest[event.itemID];
+    if (!current || [event.scanTime compare:current.scanTime] != NSOrderedAscending) {
+        latest[event.itemID] = event;
+    }
+}
+
+-(void) loadSnapshot {
+    _snapshot = [[NSMutableDictionary alloc] init];
+    NSData* data = [NSData dataWithContentsOfFile:_snapshotPath options:0 error:NULL];
+    NSDictionary* snapshot = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL] : nil;
+    if (![snapshot isKindOfClass:[NSDictionary class]]) {
+        return;
+    }
+    _snapshotSequence = [snapshot[@"sequence"] unsignedLongLongValue];
+    for (NSDictionary* dictionary in snapshot[@"events"]) {
+        FLXCheckEvent* event = [[FLXCheckEvent alloc] initWithDictionary:dictionary];
+        if (event) {
+            [FLXCheckInOutEngine keepLatestEvent:event in:_snapshot];
+        }
+    }
+}
+
+// Must be called on _queue. Applied entries are folded into the snapshot,
+// which is written out before the journal drops them, so the journal and
+// the snapshot together always hold the latest event of every item.
+-(BOOL) compactJournal {
+    uint64_t applied = _journal.appliedSequence();
+    if (applied > _snapshotSequence) {
+        NSMutableDictionary* snapshot = [_snapshot mutableCopy];
+        for (FLXCheckEvent* event in [self journalEventsAfter:_snapshotSequence]) {
+            if (event.sequence > applied) {
+                break;
+            }
+            [FLXCheckInOutEngine keepLatestEvent:event in:snapshot];
+        }
+        NSMutableArray* events = [[NSMutableArray alloc] initWithCapacity:[snapshot count]];
+        for (FLXCheckEvent* event in [snapshot allValues]) {
+            [events addObject:[event dictionaryRepresentation]];
+        }
+        NSData* data = [NSJSONSerialization dataWithJSONObject:@{@"sequence": @(applied), @"events": events} options:0 error:NULL];
+        if (![data writeToFile:_snapshotPath atomically:YES]) {
+            NSLog(@"Cannot write the check-in/out snapshot to %@; the journal is not compacted", _snapshotPath);
+            return NO;
+        }
+        _snapshot = snapshot;
+        _snapshotSequence = applied;
+    }
+    return _journal.compact();
+}
+
+// Must be called on _queue
+-(void) markApplied: (uint64_t) sequence {
+    _journal.markApplied(sequence);
+    if (_journal.appliedBytes() >= kFLXCheckCompactBytes) {
+        [self compactJournal];
+    }
+}
+
+// Must be called on _flushQueue. Journal entries up to sequence have
+// reached the store (and Parse) and are dropped at the next compaction.
+-(void) batchOfSequence: (uint64_t) sequence events: (NSDictionary*) events finished: (BOOL) succeeded {
+    _batchInFlight = NO;
+    if (succeeded) {
+        _retryInterval = 0;
+        if (sequence > _appliedSequence) {
+            _appliedSequence = sequence;
+            dispatch_async(_queue, ^{
+                [self markApplied:sequence];
+            });
+        }
+    }
+    else {
+        // Back off while Parse is out of reach; the events go out with the
+        // next batch unless a newer event has superseded them
+        _retryInterval = MIN(MAX(_retryInterval * 2, _flushInterval * 2), kFLXCheckMaxRetryInterval);
+        [events enumerateKeysAndObjectsUsingBlock:^(NSString* objectId, FLXCheckEvent* event, BOOL *stop) {
+            [self stageEvent:event forItem:objectId];
+        }];
+    }
+    [self scheduleFlush];
+}
+
+#pragma mark - Recording
+
++(NSError*) notJournaledError {
+    return [NSError errorWithDomain:FLXCheckInOutErrorDomain
+                               code:FLXCheckInOutErrorNotJournaled
+                           userInfo:@{NSLocalizedDescriptionKey: @"The check-in/out journal on this device is full or unavailable, so the scan was not recorded."}];
+}
+
+-(NSDictionary*) itemForTagId: (NSString*) tagId {
+    NSString* itemID = FLXCanonicalTagId(tagId);
+    return itemID ? [self itemForTagId:tagId itemID:itemID] : nil;
+}
+
+-(NSDictionary*) itemForTagId: (NSString*) tagId itemID: (NSString*) itemID {
+    // An EPC finds its item by identity, whatever the filter value or
+    // formatting of the itemID
+    NSString* identity = [FLXEpc identityForTagId:itemID];
+    NSDictionary* item = nil;
+    if (identity) {
+        item = [[_store recordsInClass:@"Items" withKey:FLXEpcIdentityKey inValues:@[identity]] firstObject];
+    }
+    if (!item) {
+        // Items may carry the tag id as scanned ("E0 04 ...") or canonical
+        NSMutableArray* candidates = [NSMutableArray arrayWithObject:itemID];
+        if (![tagId isEqualToString:itemID]) {
+            [candidates addObject:tagId];
+        }
+        item = [[_store recordsInClass:@"Items" withKey:@"itemID" inValues:candidates] firstObject];
+    }
+    return item;
+}
+
+-(FLXCheckEvent*) recordTagId: (NSString*) tagId
+                    direction: (FLXCheckDirection) direction
+                   locationID: (NSString*) locationID
+                     readerID: (NSString*) readerID
+                     scanTime: (NSDate*) scanTime
+                        error: (NSError**) error {
+    NSString* itemID = FLXCanonicalTagId(tagId);
+    if (!itemID) {
+        return nil;
+    }
+
+    NSDate* time = scanTime ?: [NSDate date];
+
+    __block FLXCheckEvent* event = nil;
+    __block BOOL journaled = YES;
+    dispatch_sync(_queue, ^{
+        if ([self->_eventIds containsObject:[FLXCheckEvent eventIdForItemID:itemID direction:direction readerID:readerID scanTime:time]]) {
+            return;
+        }
+
+        event = [[FLXCheckEvent alloc] initWithItemID:itemID
+                                                tagId:tagId
+                                           locationID:locationID
+                                            direction:direction
+                                             readerID:readerID
+                                             scanTime:time
+                                        transactionID:self->_transactionID];
+
+        [self->_eventIds addObject:event.eventId];
+        if (self->_transactionEvents) {
+            [self->_transactionEvents addObject:event];
+            return;
+        }
+        event.sequence = [self appendEntry:[event dictionaryRepresentation]];
+        if (event.sequence == 0) {
+            [self->_eventIds removeObject:event.eventId];
+            event = nil;
+            journaled = NO;
+            return;
+        }
+        [self stageEvents:@[event] flushNow:NO];
+    });
+    if (!journaled && error) {
+        *error = [FLXCheckInOutEngine notJournaledError];
+    }
+    return event;
+}
+
+-(FLXCheckEvent*) recordResponse: (RfidResponse*) response
+                       direction: (FLXCheckDirection) direction
+                      locationID: (NSString*) locationID
+                        readerID: (NSString*) readerID
+                           error: (NSError**) error {
+    RfidTag* tag = [response rfidTag];
+    if (!tag) {
+        return nil;
+    }
+    return [self recordTagId:[tag toString]
+                   direction:direction
+                  locationID:locationID
+                    readerID:readerID
+                    scanTime:[FLXTimestamp dateForTimestamp:[response scanTime]]
+                       error:error];
+}
+
+#pragma mark - Transactions
+
+-(void) beginTransaction {
+    dispatch_sync(_queue, ^{
+        if (self->_transactionEvents) {
+            return;
+        }
+        self->_transactionEvents = [[NSMutableArray alloc] init];
+        self->_transactionID = [[NSUUID UUID] UUIDString];
+    });
+}
+
+-(NSUInteger) commitTransaction: (NSError**) error {
+    __block NSUInteger count = 0;
+    __block BOOL journaled = YES;
+    dispatch_sync(_queue, ^{
+        NSArray* events = self->_transactionEvents;
+        NSString* transactionID = self->_transactionID;
+        if ([events count] == 0) {
+            self->_transactionEvents = nil;
+            self->_transactionID = nil;
+            return;
+        }
+
+        NSMutableArray* entries = [[NSMutableArray alloc] initWithCapacity:[events count]];
+        for (FLXCheckEvent* event in events) {
+            [entries addObject:[event dictionaryRepresentation]];
+        }
+        uint64_t sequence = [self appendEntry:@{@"transaction": transactionID, @"events": entries}];
+        if (sequence == 0) {
+            // Left open, to commit again or roll back
+            journaled = NO;
+            return;
+        }
+        self->_transactionEvents = nil;
+        self->_transactionID = nil;
+        for (FLXCheckEvent* event in events) {
+            event.sequence = sequence;
+        }
+        [self stageEvents:events flushNow:YES];
+        count = [events count];
+    });
+    if (!journaled && error) {
+        *error = [FLXCheckInOutEngine notJournaledError];
+    }
+    return count;
+}
+
+-(void) rollbackTransaction {
+    dispatch_sync(_queue, ^{
+        for (FLXCheckEvent* event in self->_transactionEvents) {
+            [self->_eventIds removeObject:event.eventId];
+        }
+        self->_transactionEvents = nil;
+        self->_transactionID = nil;
+    });
+}
+
+#pragma mark - Item state
+
+// The item fields an event sets
++(void) applyEvent: (FLXCheckEvent*) event toItem: (NSMutableDictionary*) item {
+    item[@"status"] = event.direction == FLXCheckIn ? @"Checked In" : @"Checked Out";
+    item[@"lastCheckAt"] = event.scanTime;
+    if (event.direction == FLXCheckIn && event.locationID) {
+        item[@"locationID"] = event.locationID;
+    }
+}
+
+// Whether the item already holds the state of a later scan: a redelivered
+// or delayed event must not take it back
++(BOOL) isEvent: (FLXCheckEvent*) event olderThanItem: (NSDictionary*) item {
+    id lastCheckAt = item[@"lastCheckAt"];
+    return [lastCheckAt isKindOfClass:[NSDate class]] && [event.scanTime compare:lastCheckAt] == NSOrderedAscending;
+}
+
+// Must be called on _queue. Hands journaled events to the write-behind
+// queue, which looks up their items there.
+-(void) stageEvents: (NSArray*) events flushNow: (BOOL) flushNow {
+    dispatch_async(_flushQueue, ^{
+        for (FLXCheckEvent* event in events) {
+            [self stageEvent:event];
+        }
+        if (flushNow) {
+            [self flushPending];
+        }
+        else {
+            [self scheduleFlush];
+        }
+    });
+}
+
+// Must be called on _flushQueue. An event whose tag names no item sets no
+// item state.
+-(void) stageEvent: (FLXCheckEvent*) event {
+    _stagedSequence = MAX(_stagedSequence, event.sequence);
+    NSString* objectId = [self itemForTagId:event.tagId itemID:event.itemID][@"objectId"];
+    if (objectId) {
+        [self stageEvent:event forItem:objectId];
+    }
+}
+
+// Must be called on _flushQueue
+-(void) stageEvent: (FLXCheckEvent*) event forItem: (NSString*) objectId {
+    FLXCheckEvent* pending = _pendingEvents[objectId];
+    if (!pending || [event.scanTime compare:pending.scanTime] != NSOrderedAscending) {
+        _pendingEvents[objectId] = event;
+    }
+}
+
+// Must be called on _flushQueue
+-(void) scheduleFlush {
+    if (_batchInFlight) {
+        // Rescheduled when it finishes
+        return;
+    }
+    if ([_pendingEvents count] >= kFLXCheckMaxPendingItems && _retryInterval == 0) {
+        [self flushPending];
+        return;
+    }
+    if (_flushScheduled || ([_pendingEvents count] == 0 && _stagedSequence <= _appliedSequence)) {
+        return;
+    }
+    _flushScheduled = YES;
+    NSUInteger generation = _flushGeneration;
+    NSTimeInterval interval = _retryInterval > 0 ? _retryInterval : _flushInterval;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t) (interval * NSEC_PER_SEC)), _flushQueue, ^{
+        if (generation == self->_flushGeneration) {
+            [self flushPending];
+        }
+    });
+}
+
+// Must be called on _flushQueue
+-(void) flushPending {
+    _flushScheduled = NO;
+    _flushGeneration++;
+    if (_batchInFlight) {
+        return;
+    }
+
+    // Every staged event is in this batch, in an earlier one that
+    // succeeded, or sets no item state
+    uint64_t sequence = _stagedSequence;
+    if ([_pendingEvents count] == 0) {
+        [self batchOfSequence:sequence events:nil finished:YES];
+        return;
+    }
+
+    NSDictionary* pendingEvents = [_pendingEvents copy];
+    [_pendingEvents removeAllObjects];
+
+    NSMutableArray* records = [[NSMutableArray alloc] initWithCapacity:[pendingEvents count]];
+    NSMutableArray* objects = [[NSMutableArray alloc] initWithCapacity:[pendingEvents count]];
+    [pendingEvents enumerateKeysAndObjectsUsingBlock:^(NSString* objectId, FLXCheckEvent* event, BOOL *stop) {
+        NSMutableDictionary* record = [[self->_store recordWithId:objectId inClass:@"Items"] mutableCopy];
+        if ([FLXCheckInOutEngine isEvent:event olderThanItem:record]) {
+            return;
+        }
+        if (record) {
+            [FLXCheckInOutEngine applyEvent:event toItem:record];
+            [records addObject:record];
+        }
+
+        PFObject* object = [PFObject objectWithoutDataWithClassName:@"Items" objectId:objectId];
+        NSMutableDictionary* fields = [[NSMutableDictionary alloc] init];
+        [FLXCheckInOutEngine applyEvent:event toItem:fields];
+        [fields enumerateKeysAndObjectsUsingBlock:^(NSString* key, id value, BOOL *stop) {
+            object[key] = value;
+        }];
+        [objects addObject:object];
+    }];
+
+    _batchInFlight = YES;
+    [_store putRecords:records inClass:@"Items"];
+
+    if (!_savesToParse) {
+        [self batchOfSequence:sequence events:pendingEvents finished:YES];
+        return;
+    }
+    [PFObject saveAllInBackground:objects block:^(BOOL succeeded, NSError *error) {
+        if (!succeeded) {
+            NSLog(@"Saving %lu checked items failed: %@", (unsigned long) [objects count], error);
+        }
+        dispatch_async(self->_flushQueue, ^{
+            [self batchOfSequence:sequence events:pendingEvents finished:succeeded];
+        });
+    }];
+}
+
+-(void) flush {
+    // Whatever was recorded before this call is staged ahead of the batch
+    dispatch_sync(_queue, ^{
+    });
+    dispatch_sync(_flushQueue, ^{
+        [self flushPending];
+    });
+    _journal.commit();
+}
+
+#pragma mark - Replay
+
+// Whether replaying event changes item: the item holds no check, or only
+// an earlier one
++(BOOL) isEvent: (FLXCheckEvent*) event newerThanItem: (NSDictionary*) item {
+    id lastCheckAt = item[@"lastCheckAt"];
+    return ![lastCheckAt isKindOfClass:[NSDate class]] || [event.scanTime compare:lastCheckAt] == NSOrderedDescending;
+}
+
+-(NSUInteger) replayLog {
+    __block NSMutableDictionary* latest = nil;
+    dispatch_sync(_queue, ^{
+        latest = [self->_snapshot mutableCopy];
+        for (FLXCheckEvent* event in [self journalEventsAfter:self->_snapshotSequence]) {
+            [FLXCheckInOutEngine keepLatestEvent:event in:latest];
+        }
+    });
+
+    __block NSUInteger count = 0;
+    dispatch_sync(_flushQueue, ^{
+        NSMutableArray* records = [[NSMutableArray alloc] init];
+        for (FLXCheckEvent* event in [latest allValues]) {
+            NSMutableDictionary* record = [[self itemForTagId:event.tagId itemID:event.itemID] mutableCopy];
+            if (record && [FLXCheckInOutEngine isEvent:event newerThanItem:record]) {
+                [FLXCheckInOutEngine applyEvent:event toItem:record];
+                [records addObject:record];
+            }
+        }
+        [self->_store putRecords:records inClass:@"Items"];
+        count = [records count];
+    });
+    return count;
+}
+
+@end
@@ -0,0 +1,57 @@
+//
+//  FLXCommandCompletion.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <IDBLUE/ResponseHandler.h>
+#import <IDBLUE/SendStatus.h>
+
+// Called once per command: with its response, or with the NACK that failed
+// it. Both are nil if the session closed before IDBLUE answered.
+typedef void (^FLXResponseCompletion)(id response, NackResponse* nack);
+
+// Sends the command again with handler
+typedef SendStatus* (^FLXCommandSend)(id<IResponseHandler> handler);
+
+// FLXCommandCompletion is the handler IDBlueSdk passes with a single command,
+// so that command's response or NACK reaches exactly one block instead of
+// every registered IResponseHandler.
+//
+// A NACK with a transient status (timeout, checksum failed, buffer overflow,
+// incomplete operation) is not reported straight away: the command is sent
+// again as the retry policy for it allows (Core/RetryPolicy.h), so one bad
+// packet does not fail a whole getEntry download.
+@interface FLXCommandCompletion : NSObject <IResponseHandler>
+
+// Resends of this command so far
+@property (nonatomic, readonly) NSUInteger retries;
+
+-(id) initWithCommand: (CommandIdentifier) command
+                 send: (FLXCommandSend) send
+           completion: (FLXResponseCompletion) completion
+             finished: (void (^)(FLXCommandCompletion* completion)) finished;
+
+// Send the command for the first time
+-(BOOL) send;
+
+// Resolve the command; later calls do nothing.
+-(void) completeWithResponse: (id) response nack: (NackResponse*) nack;
+
+// Resends allowed per command, waiting initialBackoff and doubling up to
+// maxBackoff. Idempotent commands default to 3 resends from 20 ms; the rest
+// (clearEntries, writes) to none.
++(void) setMaxRetries: (NSUInteger) retries
+       initialBackoff: (NSTimeInterval) initialBackoff
+           maxBackoff: (NSTimeInterval) maxBackoff
+           forCommand: (CommandIdentifier) command;
+
+// Resends of all commands since launch, and NACKs reported without any
+// because no resend could cure them
++(NSUInteger) totalRetries;
++(NSUInteger) permanentFailures;
+
+@end
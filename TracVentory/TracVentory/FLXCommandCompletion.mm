@@ -0,0 +1,164 @@
+//
+//  FLXCommandCompletion.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXCommandCompletion.h"
+#import <IDBLUE/EpcReadTagResponse.h>
+#import <IDBLUE/GetTagInfoResponse.h>
+#include "RetryPolicy.h"
+
+// Handlers run on the main thread, so these need no lock
+static flx::RetryPolicyTable FLXRetryPolicies;
+static NSUInteger FLXTotalRetries = 0;
+static NSUInteger FLXPermanentFailures = 0;
+
+@implementation FLXCommandCompletion {
+    CommandIdentifier _command;
+    FLXCommandSend _send;
+    FLXResponseCompletion _completion;
+    void (^_finished)(FLXCommandCompletion*);
+}
+
+-(id) initWithCommand: (CommandIdentifier) command
+                 send: (FLXCommandSend) send
+           completion: (FLXResponseCompletion) completion
+             finished: (void (^)(FLXCommandCompletion* completion)) finished {
+    self = [super init];
+    if (self) {
+        _command = command;
+        _send = [send copy];
+        _completion = [completion copy];
+        _finished = [finished copy];
+    }
+    return self;
+}
+
+-(BOOL) send {
+    return [_send(self) successful];
+}
+
+-(void) completeWithResponse: (id) response nack: (NackResponse*) nack {
+    FLXResponseCompletion completion = _completion;
+    void (^finished)(FLXCommandCompletion*) = _finished;
+    _completion = nil;
+    _finished = nil;
+    _send = nil;
+    if (completion) {
+        completion(response, nack);
+    }
+    if (finished) {
+        finished(self);
+    }
+}
+
+// Resend after a transient NACK if the policy allows, else report it
+-(void) failedWithNack: (NackResponse*) nack {
+    if (!_completion) {
+        return;
+    }
+    uint16_t status = (uint16_t) [nack status];
+    if (!flx::isTransientStatus(status)) {
+        FLXPermanentFailures++;
+        [self completeWithResponse:nil nack:nack];
+        return;
+    }
+    const flx::RetryPolicy& policy = FLXRetryPolicies.get((uint8_t) _command);
+    if (_retries >= policy.maxRetries) {
+        [self completeWithResponse:nil nack:nack];
+        return;
+    }
+    _retries++;
+    FLXTotalRetries++;
+    dispatch_time_t when = dispatch_time(DISPATCH_TIME_NOW, (int64_t) policy.backoffNanoseconds((uint8_t) _retries));
+    dispatch_after(when, dispatch_get_main_queue(), ^{
+        // Closed in the meantime
+        if (!_send) {
+            return;
+        }
+        if (![self send]) {
+            [self completeWithResponse:nil nack:nack];
+        }
+    });
+}
+
++(void) setMaxRetries: (NSUInteger) retries
+       initialBackoff: (NSTimeInterval) initialBackoff
+           maxBackoff: (NSTimeInterval) maxBackoff
+           forCommand: (CommandIdentifier) command {
+    flx::RetryPolicy policy = { (uint8_t) MIN(retries, (NSUInteger) UINT8_MAX),
+                                (uint32_t) (initialBackoff * 1000.0),
+                                (uint32_t) (maxBackoff * 1000.0) };
+    FLXRetryPolicies.set((uint8_t) command, policy);
+}
+
++(NSUInteger) totalRetries {
+    return FLXTotalRetries;
+}
+
++(NSUInteger) permanentFailures {
+    return FLXPermanentFailures;
+}
+
+#pragma mark - IResponseHandler
+
+-(void) readTagIdResponse: (IDBlueCommand*) command withResponse: (ReadTagIdResponse*) response {
+    [self completeWithResponse:response nack:nil];
+}
+
+-(void) readTagIdFailed: (IDBlueCommand*) command withResponse: (NackResponse*) response {
+    [self failedWithNack:response];
+}
+
+-(void) getEntryResponse: (IDBlueCommand*) command withResponse: (GetEntryResponse*) response {
+    [self completeWithResponse:response nack:nil];
+}
+
+-(void) getEntryFailed: (IDBlueCommand*) command withResponse: (NackResponse*) response {
+    [self failedWithNack:response];
+}
+
+-(void) getEntryCountResponse: (IDBlueCommand*) command withResponse: (GetEntryCountResponse*) response {
+    [self completeWithResponse:response nack:nil];
+}
+
+-(void) getEntryCountFailed: (IDBlueCommand*) command withResponse: (NackResponse*) response {
+    [self failedWithNack:response];
+}
+
+-(void) clearEntriesResponse: (IDBlueCommand*) command withResponse: (IDBlueResponse*) response {
+    [self completeWithResponse:response nack:nil];
+}
+
+-(void) clearEntriesFailed: (IDBlueCommand*) command withResponse: (NackResponse*) response {
+    [self failedWithNack:response];
+}
+
+-(void) beepResponse: (IDBlueCommand*) command withResponse: (IDBlueResponse*) response {
+    [self completeWithResponse:response nack:nil];
+}
+
+-(void) beepFailed: (IDBlueCommand*) command withResponse: (NackResponse*) response {
+    [self failedWithNack:response];
+}
+
+-(void) getTagInfoResponse: (IDBlueCommand*) command withResponse: (GetTagInfoResponse*) response {
+    [self completeWithResponse:response nack:nil];
+}
+
+-(void) getTagInfoFailed: (IDBlueCommand*) command withResponse: (NackResponse*) response {
+    [self failedWithNack:response];
+}
+
+-(void) epcReadResponse: (IDBlueCommand*) command withResponse: (EpcReadTagResponse*) response {
+    [self completeWithResponse:response nack:nil];
+}
+
+-(void) epcReadFailed: (IDBlueCommand*) command withResponse: (NackResponse*) response {
+    [self failedWithNack:response];
+}
+
+@end
@@ -7,8 +7,12 @@
 //
 
 #import "FLXDetailViewController.h"
+#import "FLXThumbnailPipeline.h"
+#import <Parse/Parse.h>
 
-@interface FLXDetailViewController ()
+static const CGFloat FLXPhotoQuality = 0.8;
+
+@interface FLXDetailViewController () <UIImagePickerControllerDelegate, UINavigationControllerDelegate>
 - (void)configureView;
 @end
 
@@ -40,6 +44,55 @@
     [super viewDidLoad];
 	// Do any additional setup after loading the view, typically from a nib.
     [self configureView];
+
+    // Items are shown as store records; a photo is taken of one that is saved
+    if ([self.detailItem isKindOfClass:[NSDictionary class]] && self.detailItem[@"objectId"]
+        && [UIImagePickerController isSourceTypeAvailable:UIImagePickerControllerSourceTypeCamera]) {
+        self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithBarButtonSystemItem:UIBarButtonSystemItemCamera
+                                                                                               target:self
+                                                                                               action:@selector(takePhoto:)];
+    }
+}
+
+#pragma mark - Item photo
+
+- (IBAction)takePhoto:(id)sender
+{
+    UIImagePickerController *picker = [[UIImagePickerController alloc] init];
+    picker.sourceType = UIImagePickerControllerSourceTypeCamera;
+    picker.delegate = self;
+    [self presentViewController:picker animated:YES completion:nil];
+}
+
+- (void)imagePickerController:(UIImagePickerController *)picker didFinishPickingMediaWithInfo:(NSDictionary *)info
+{
+    [self dismissViewControllerAnimated:YES completion:nil];
+    UIImage *image = info[UIImagePickerControllerOriginalImage];
+    PFObject *item = [PFObject objectWithoutDataWithClassName:@"Items" objectId:self.detailItem[@"objectId"]];
+    UIBarButtonItem *cameraButton = self.navigationItem.rightBarButtonItem;
+    cameraButton.enabled = NO;
+    // The thumbnail is made and cached as the photo is attached, so the list
+    // never decodes the full-size photo
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSData *photoData = UIImageJPEGRepresentation(image, FLXPhotoQuality);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [[FLXThumbnailPipeline sharedPipeline] attachPhotoData:photoData toItem:item completion:^(BOOL succeeded, NSError *error) {
+                cameraButton.enabled = YES;
+                if (!succeeded) {
+                    [[[UIAlertView alloc] initWithTitle:@"Photo not saved"
+                                                message:[error localizedDescription]
+                                               delegate:nil
+                                      cancelButtonTitle:@"OK"
+                                      otherButtonTitles:nil] show];
+                }
+            }];
+        });
+    });
+}
+
+- (void)imagePickerControllerDidCancel:(UIImagePickerController *)picker
+{
+    [self dismissViewControllerAnimated:YES completion:nil];
 }
 
 - (void)didReceiveMemoryWarning
@@ -0,0 +1,35 @@
+//
+//  FLXEpc.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class FLXLocalStore;
+
+// Derived index keys of Items (see ensureIndexesInStore:): the pure identity
+// URI of the itemID's EPC, and the GTIN-14 (NSNumber) of an SGTIN
+extern NSString* const FLXEpcIdentityKey;
+extern NSString* const FLXEpcGtinKey;
+
+// FLXEpc reads the GS1 identity out of SGTIN-96, GRAI-96 and GIAI-96 tag
+// ids with the bit-level decoder of Core/EpcDecoder.h. The identity ignores
+// the filter value and any formatting of the hex, so a scan finds its item
+// however the itemID was typed in.
+@interface FLXEpc : NSObject
+
+// e.g. urn:epc:id:sgtin:0614141.812345.6789; nil if the tag is not one of
+// the three schemes.
++(NSString*) identityForBytes: (const uint8_t*) bytes length: (NSUInteger) length;
+// tagId is hex as scanned or as stored in itemID
++(NSString*) identityForTagId: (NSString*) tagId;
++(NSNumber*) gtinForTagId: (NSString*) tagId;
+
+// Index the Items of store by FLXEpcIdentityKey and FLXEpcGtinKey, decoded
+// from each item's itemID.
++(void) ensureIndexesInStore: (FLXLocalStore*) store;
+
+@end
@@ -0,0 +1,74 @@
+//
+//  FLXEpc.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXEpc.h"
+#import "FLXLocalStore.h"
+#include "EpcDecoder.h"
+#include "TagSet.h"
+
+NSString* const FLXEpcIdentityKey = @"epcIdentity";
+NSString* const FLXEpcGtinKey = @"gtin";
+
+// The 12 EPC bytes of a hex tag id, which may have lost its leading zeros
+static BOOL FLXEpcBytesFromTagId(NSString* tagId, uint8_t* bytes) {
+    if (![tagId isKindOfClass:[NSString class]]) {
+        return NO;
+    }
+    const char* hex = [tagId UTF8String];
+    flx::TagKey key;
+    if (!hex || !flx::tagKeyFromHex(hex, strlen(hex), key) || key.hi >> 32) {
+        return NO;
+    }
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (uint8_t) (key.hi >> (24 - i * 8));
+    }
+    for (int i = 0; i < 8; i++) {
+        bytes[4 + i] = (uint8_t) (key.lo >> (56 - i * 8));
+    }
+    return YES;
+}
+
+@implementation FLXEpc
+
++(NSString*) identityForBytes: (const uint8_t*) bytes length: (NSUInteger) length {
+    flx::Epc epc;
+    char uri[64];
+    if (!bytes || !flx::decodeEpc(bytes, length, epc) || !flx::formatEpcUri(epc, uri, sizeof(uri))) {
+        return nil;
+    }
+    return [NSString stringWithUTF8String:uri];
+}
+
++(NSString*) identityForTagId: (NSString*) tagId {
+    uint8_t bytes[flx::kEpc96Size];
+    if (!FLXEpcBytesFromTagId(tagId, bytes)) {
+        return nil;
+    }
+    return [self identityForBytes:bytes length:sizeof(bytes)];
+}
+
++(NSNumber*) gtinForTagId: (NSString*) tagId {
+    uint8_t bytes[flx::kEpc96Size];
+    flx::Epc epc;
+    if (!FLXEpcBytesFromTagId(tagId, bytes) || !flx::decodeEpc(bytes, sizeof(bytes), epc)) {
+        return nil;
+    }
+    uint64_t gtin = flx::epcGtin(epc);
+    return gtin ? @(gtin) : nil;
+}
+
++(void) ensureIndexesInStore: (FLXLocalStore*) store {
+    [store ensureIndexForKey:FLXEpcIdentityKey inClass:@"Items" derivedBy:^id(NSDictionary* record) {
+        return [FLXEpc identityForTagId:record[@"itemID"]];
+    }];
+    [store ensureIndexForKey:FLXEpcGtinKey inClass:@"Items" derivedBy:^id(NSDictionary* record) {
+        return [FLXEpc gtinForTagId:record[@"itemID"]];
+    }];
+}
+
+@end
@@ -0,0 +1,50 @@
+//
+//  FLXImageCache.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+// FLXImageCache keeps images in two tiers, both bounded by bytes and
+// least recently used first out (flx::ByteLruCache, Core/ImageCache.h):
+// decoded images in memory, charged at their bitmap size, and the encoded
+// files on disk under Library/Caches. Images are decoded off the main
+// thread, into the bitmap Core Animation draws from, so showing one never
+// decodes on the main thread. Keys are file names or URLs.
+//
+// The memory tier is emptied on a memory warning. Disk recency is kept in
+// memory; across launches files count as used when they were written.
+//
+// Thread safe.
+@interface FLXImageCache : NSObject
+
+// 16 MB in memory, 64 MB in Library/Caches/FLXImages
++(FLXImageCache*) sharedCache;
+
+// A nil directory keeps no disk tier
+-(id) initWithDirectory: (NSString*) directory memoryBudget: (NSUInteger) memoryBudget diskBudget: (NSUInteger) diskBudget;
+
+// The memory tier alone; never touches or waits on the disk tier
+-(UIImage*) memoryImageForKey: (NSString*) key;
+
+// From memory, else read and decoded from disk in the background.
+// completion runs on the main queue, with nil if neither tier has it.
+-(void) imageForKey: (NSString*) key completion: (void (^)(UIImage* image)) completion;
+
+// Write encoded image data to disk and put the decoded image in memory.
+// Returns the decoded image, nil if data is not an image. Decodes on the
+// calling thread; call it in the background.
+-(UIImage*) storeImageData: (NSData*) data forKey: (NSString*) key;
+
+-(void) removeImageForKey: (NSString*) key;
+-(void) removeAllImages;
+
+@property (nonatomic, readonly) NSUInteger memoryBytes;
+@property (nonatomic, readonly) NSUInteger diskBytes;
+// Memory tier lookups since launch
+@property (nonatomic, readonly) double memoryHitRate;
+
+@end
@@ -0,0 +1,296 @@
+//
+//  FLXImageCache.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXImageCache.h"
+#import <ImageIO/ImageIO.h>
+#include <pthread.h>
+#include "ImageCache.h"
+
+static const NSUInteger FLXImageCacheMemoryBudget = 16 << 20;
+static const NSUInteger FLXImageCacheDiskBudget = 64 << 20;
+
+// Decode into a bitmap in the layout Core Animation draws directly, so the
+// image is not decoded again (on the main thread) when first shown
+static UIImage* FLXDecodedImage(NSData* data, CGFloat scale, NSUInteger* bytes) {
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef) data, NULL);
+    if (!source) {
+        return nil;
+    }
+    CGImageRef image = CGImageSourceCreateImageAtIndex(source, 0, NULL);
+    CFRelease(source);
+    if (!image) {
+        return nil;
+    }
+    size_t width = CGImageGetWidth(image);
+    size_t height = CGImageGetHeight(image);
+    CGColorSpaceRef space = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, space,
+                                                 kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+    CGColorSpaceRelease(space);
+    UIImage* decoded = nil;
+    if (context) {
+        CGContextDrawImage(context, CGRectMake(0, 0, width, height), image);
+        CGImageRef bitmap = CGBitmapContextCreateImage(context);
+        *bytes = CGBitmapContextGetBytesPerRow(context) * height;
+        CGContextRelease(context);
+        if (bitmap) {
+            decoded = [UIImage imageWithCGImage:bitmap scale:scale orientation:UIImageOrientationUp];
+            CGImageRelease(bitmap);
+        }
+    }
+    CGImageRelease(image);
+    return decoded;
+}
+
+@interface FLXImageCache () {
+    NSString* _directory;
+    CGFloat _scale;
+    // The memory tier has a lock of its own, so a lookup on the main
+    // thread never waits behind the disk tier's bookkeeping on _queue.
+    // Reads, writes and decoding happen on _ioQueue.
+    pthread_mutex_t _memoryLock;
+    flx::ByteLruCache<UIImage*>* _memory;
+    dispatch_queue_t _queue;
+    dispatch_queue_t _ioQueue;
+    flx::ByteLruCache<bool>* _disk;
+}
+@end
+
+@implementation FLXImageCache
+
++(FLXImageCache*) sharedCache {
+    static FLXImageCache* sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString* caches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+        sharedCache = [[FLXImageCache alloc] initWithDirectory:[caches stringByAppendingPathComponent:@"FLXImages"]
+                                                  memoryBudget:FLXImageCacheMemoryBudget
+                                                    diskBudget:FLXImageCacheDiskBudget];
+    });
+    return sharedCache;
+}
+
+-(id) initWithDirectory: (NSString*) directory memoryBudget: (NSUInteger) memoryBudget diskBudget: (NSUInteger) diskBudget {
+    self = [super init];
+    if (self) {
+        _directory = [directory copy];
+        _scale = [[UIScreen mainScreen] scale];
+        _queue = dispatch_queue_create("com.filelogix.tracventory.imagecache", DISPATCH_QUEUE_SERIAL);
+        _ioQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+        pthread_mutex_init(&_memoryLock, NULL);
+        _memory = new flx::ByteLruCache<UIImage*>(memoryBudget);
+        _disk = new flx::ByteLruCache<bool>(_directory ? diskBudget : 0);
+        if (_directory) {
+            [[NSFileManager defaultManager] createDirectoryAtPath:_directory withIntermediateDirectories:YES attributes:nil error:NULL];
+            // Queued first, so every other use of the disk tier sees the index
+            dispatch_async(_queue, ^{
+                [self loadDiskIndex];
+            });
+        }
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(didReceiveMemoryWarning:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+-(void) dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    delete _memory;
+    delete _disk;
+    pthread_mutex_destroy(&_memoryLock);
+}
+
+-(void) didReceiveMemoryWarning: (NSNotification*) notification {
+    pthread_mutex_lock(&_memoryLock);
+    _memory->clear();
+    pthread_mutex_unlock(&_memoryLock);
+}
+
+-(void) insertMemoryImage: (UIImage*) image bytes: (NSUInteger) bytes forKey: (const std::string&) cacheKey {
+    pthread_mutex_lock(&_memoryLock);
+    _memory->insert(cacheKey, image, bytes);
+    pthread_mutex_unlock(&_memoryLock);
+}
+
+-(NSString*) pathForKey: (NSString*) key {
+    std::string name = flx::cacheFileName([key UTF8String]);
+    return [_directory stringByAppendingPathComponent:[NSString stringWithUTF8String:name.c_str()]];
+}
+
+// On _queue. Oldest files first, so the newest are the most recently used.
+-(void) loadDiskIndex {
+    NSFileManager* manager = [NSFileManager defaultManager];
+    NSMutableArray* files = [NSMutableArray array];
+    for (NSString* name in [manager contentsOfDirectoryAtPath:_directory error:NULL]) {
+        NSDictionary* attributes = [manager attributesOfItemAtPath:[_directory stringByAppendingPathComponent:name] error:NULL];
+        if (attributes) {
+            [files addObject:@{ @"name": name, @"date": [attributes fileModificationDate] ?: [NSDate distantPast],
+                                @"size": @([attributes fileSize]) }];
+        }
+    }
+    [files sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"date" ascending:YES]]];
+    std::vector<std::string> evicted;
+    for (NSDictionary* file in files) {
+        _disk->insert([file[@"name"] UTF8String], true, [file[@"size"] unsignedIntegerValue], &evicted);
+    }
+    [self removeFiles:evicted];
+}
+
+// Index keys are file names
+-(void) removeFiles: (const std::vector<std::string>&) names {
+    if (names.empty()) {
+        return;
+    }
+    NSMutableArray* paths = [NSMutableArray arrayWithCapacity:names.size()];
+    for (size_t i = 0; i < names.size(); i++) {
+        [paths addObject:[_directory stringByAppendingPathComponent:[NSString stringWithUTF8String:names[i].c_str()]]];
+    }
+    dispatch_async(_ioQueue, ^{
+        for (NSString* path in paths) {
+            [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+        }
+    });
+}
+
+#pragma mark - Lookup
+
+-(UIImage*) memoryImageForKey: (NSString*) key {
+    if (!key) {
+        return nil;
+    }
+    std::string cacheKey([key UTF8String]);
+    UIImage* image = nil;
+    pthread_mutex_lock(&_memoryLock);
+    _memory->lookup(cacheKey, image);
+    pthread_mutex_unlock(&_memoryLock);
+    return image;
+}
+
+-(void) imageForKey: (NSString*) key completion: (void (^)(UIImage* image)) completion {
+    UIImage* cached = [self memoryImageForKey:key];
+    if (cached || !key || !_directory) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(cached);
+        });
+        return;
+    }
+    NSString* path = [self pathForKey:key];
+    std::string fileName([[path lastPathComponent] UTF8String]);
+    std::string cacheKey([key UTF8String]);
+    // Asynchronous: the disk index may still be loading
+    dispatch_async(_queue, ^{
+        bool unused;
+        // Counts the read as a use
+        if (!self->_disk->lookup(fileName, unused)) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(nil);
+            });
+            return;
+        }
+        dispatch_async(self->_ioQueue, ^{
+            NSData* data = [NSData dataWithContentsOfFile:path];
+            NSUInteger bytes = 0;
+            UIImage* image = data ? FLXDecodedImage(data, self->_scale, &bytes) : nil;
+            if (image) {
+                [self insertMemoryImage:image bytes:bytes forKey:cacheKey];
+            }
+            else {
+                // Gone or torn; forget it
+                dispatch_async(self->_queue, ^{
+                    self->_disk->erase(fileName);
+                });
+            }
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(image);
+            });
+        });
+    });
+}
+
+#pragma mark - Storing
+
+-(UIImage*) storeImageData: (NSData*) data forKey: (NSString*) key {
+    if (!data || !key) {
+        return nil;
+    }
+    NSUInteger bytes = 0;
+    UIImage* image = FLXDecodedImage(data, _scale, &bytes);
+    if (!image) {
+        return nil;
+    }
+    NSString* path = _directory ? [self pathForKey:key] : nil;
+    BOOL written = path && [data writeToFile:path atomically:YES];
+    [self insertMemoryImage:image bytes:bytes forKey:std::string([key UTF8String])];
+    if (written) {
+        dispatch_sync(_queue, ^{
+            std::vector<std::string> evicted;
+            self->_disk->insert([[path lastPathComponent] UTF8String], true, [data length], &evicted);
+            [self removeFiles:evicted];
+        });
+    }
+    return image;
+}
+
+-(void) removeImageForKey: (NSString*) key {
+    if (!key) {
+        return;
+    }
+    std::string cacheKey([key UTF8String]);
+    NSString* path = _directory ? [self pathForKey:key] : nil;
+    pthread_mutex_lock(&_memoryLock);
+    _memory->erase(cacheKey);
+    pthread_mutex_unlock(&_memoryLock);
+    dispatch_sync(_queue, ^{
+        if (path && self->_disk->erase([[path lastPathComponent] UTF8String])) {
+            [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+        }
+    });
+}
+
+-(void) removeAllImages {
+    pthread_mutex_lock(&_memoryLock);
+    _memory->clear();
+    pthread_mutex_unlock(&_memoryLock);
+    dispatch_sync(_queue, ^{
+        self->_disk->clear();
+        if (self->_directory) {
+            NSFileManager* manager = [NSFileManager defaultManager];
+            for (NSString* name in [manager contentsOfDirectoryAtPath:self->_directory error:NULL]) {
+                [manager removeItemAtPath:[self->_directory stringByAppendingPathComponent:name] error:NULL];
+            }
+        }
+    });
+}
+
+#pragma mark - Statistics
+
+-(NSUInteger) memoryBytes {
+    pthread_mutex_lock(&_memoryLock);
+    NSUInteger bytes = _memory->bytes();
+    pthread_mutex_unlock(&_memoryLock);
+    return bytes;
+}
+
+-(NSUInteger) diskBytes {
+    __block NSUInteger bytes = 0;
+    dispatch_sync(_queue, ^{
+        bytes = self->_disk->bytes();
+    });
+    return bytes;
+}
+
+-(double) memoryHitRate {
+    pthread_mutex_lock(&_memoryLock);
+    double rate = _memory->stats().hitRate();
+    pthread_mutex_unlock(&_memoryLock);
+    return rate;
+}
+
+@end
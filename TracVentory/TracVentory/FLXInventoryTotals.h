@@ -0,0 +1,59 @@
+//
+//  FLXInventoryTotals.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "FLXLocalStore.h"
+
+// Posted on the main queue after changed items have been applied to the
+// totals; the object is the FLXInventoryTotals
+extern NSString* const FLXInventoryTotalsDidChangeNotification;
+
+// Totals over a group of items
+@interface FLXInventorySummary : NSObject
+
+@property (nonatomic, readonly) NSUInteger count;
+// Sum of the items' cost, in cents
+@property (nonatomic, readonly) long long costCents;
+// Item counts by condition and by status (NSString -> NSNumber); items
+// without one are counted under @""
+@property (nonatomic, readonly) NSDictionary* countsByCondition;
+@property (nonatomic, readonly) NSDictionary* countsByStatus;
+
+@end
+
+// FLXInventoryTotals keeps item count, total cost and counts by condition
+// and status for all items, per location and per category, so valuation
+// and count screens never scan the items. It wraps flx::InventoryTotals
+// (Core/InventoryTotals.h): every change the store reports, whether a
+// check-in or out, an edit or a sync, moves one item between totals in
+// constant time. Queries run on its own serial queue and block only until
+// pending changes have been applied.
+@interface FLXInventoryTotals : NSObject
+
+// Totals over the Items class of the shared local store
++(FLXInventoryTotals*) sharedTotals;
+
+// Starts building the totals from the records already in the store.
+-(id) initWithStore: (FLXLocalStore*) store className: (NSString*) className;
+
+// Throw the totals away and add up the store's records again
+-(void) rebuild;
+
+-(FLXInventorySummary*) total;
+-(FLXInventorySummary*) summaryForLocationID: (NSString*) locationID;
+-(FLXInventorySummary*) summaryForCategory: (NSString*) category;
+-(FLXInventorySummary*) summaryForLocationID: (NSString*) locationID category: (NSString*) category;
+
+// Every location or category holding items (NSString -> FLXInventorySummary)
+-(NSDictionary*) summariesByLocationID;
+-(NSDictionary*) summariesByCategory;
+
+// When the last change was applied: what the totals are "as of"
+@property (nonatomic, readonly) NSDate* asOf;
+
+@end
@@ -0,0 +1,239 @@
+//
+//  FLXInventoryTotals.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXInventoryTotals.h"
+#include <cmath>
+#include "InventoryTotals.h"
+
+NSString* const FLXInventoryTotalsDidChangeNotification = @"FLXInventoryTotalsDidChangeNotification";
+
+@interface FLXInventorySummary ()
+@property (nonatomic, readwrite) NSUInteger count;
+@property (nonatomic, readwrite) long long costCents;
+@property (nonatomic, readwrite) NSDictionary* countsByCondition;
+@property (nonatomic, readwrite) NSDictionary* countsByStatus;
+@end
+
+@implementation FLXInventorySummary
+
+static NSDictionary* FLXCounts(const std::vector<std::pair<std::string, uint64_t> >& counts) {
+    NSMutableDictionary* dictionary = [[NSMutableDictionary alloc] initWithCapacity:counts.size()];
+    for (size_t i = 0; i < counts.size(); i++) {
+        dictionary[[NSString stringWithUTF8String:counts[i].first.c_str()]] = @(counts[i].second);
+    }
+    return dictionary;
+}
+
++(FLXInventorySummary*) summaryWithSummary: (const flx::InventorySummary&) summary {
+    FLXInventorySummary* result = [[FLXInventorySummary alloc] init];
+    result.count = (NSUInteger) summary.count;
+    result.costCents = summary.costCents;
+    result.countsByCondition = FLXCounts(summary.byCondition);
+    result.countsByStatus = FLXCounts(summary.byStatus);
+    return result;
+}
+
+-(NSString*) description {
+    // Signed as a whole, so -0.50 does not lose its minus with the dollars
+    long long cents = self.costCents;
+    unsigned long long magnitude = cents < 0 ? 0 - (unsigned long long) cents : (unsigned long long) cents;
+    return [NSString stringWithFormat:@"%lu items, %s%llu.%02llu", (unsigned long) self.count, cents < 0 ? "-" : "",
+            magnitude / 100, magnitude % 100];
+}
+
+@end
+
+@interface FLXInventoryTotals () {
+    FLXLocalStore* _store;
+    NSString* _className;
+    dispatch_queue_t _queue;
+    flx::InventoryTotals _totals;
+    NSDate* _lastChange;
+}
+@end
+
+@implementation FLXInventoryTotals
+
++(FLXInventoryTotals*) sharedTotals {
+    static FLXInventoryTotals* sharedTotals = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedTotals = [[FLXInventoryTotals alloc] initWithStore:[FLXLocalStore sharedStore] className:@"Items"];
+    });
+    return sharedTotals;
+}
+
+-(id) initWithStore: (FLXLocalStore*) store className: (NSString*) className {
+    self = [super init];
+    if (self) {
+        _store = store;
+        _className = [className copy];
+        _queue = dispatch_queue_create("com.filelogix.tracventory.inventorytotals", DISPATCH_QUEUE_SERIAL);
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(localStoreDidChange:)
+                                                     name:FLXLocalStoreDidChangeNotification
+                                                   object:store];
+        [self rebuild];
+    }
+    return self;
+}
+
+-(void) dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+-(void) rebuild {
+    dispatch_async(_queue, ^{
+        self->_totals.clear();
+        for (NSDictionary* record in [self->_store allRecordsInClass:self->_className]) {
+            [self addRecord:record];
+        }
+        [self didChange];
+    });
+}
+
+static std::string FLXFactText(id value) {
+    if ([value isKindOfClass:[NSNumber class]]) {
+        value = [value stringValue];
+    }
+    if (![value isKindOfClass:[NSString class]]) {
+        return std::string();
+    }
+    const char* utf8 = [value UTF8String];
+    return utf8 ? std::string(utf8) : std::string();
+}
+
+// Cost is entered as a number, or as text such as "$1,299.00"
+static int64_t FLXCostCents(id value) {
+    if ([value isKindOfClass:[NSString class]]) {
+        NSCharacterSet* notNumber = [[NSCharacterSet characterSetWithCharactersInString:@"0123456789.-"] invertedSet];
+        value = @([[[value componentsSeparatedByCharactersInSet:notNumber] componentsJoinedByString:@""] doubleValue]);
+    }
+    if (![value isKindOfClass:[NSNumber class]]) {
+        return 0;
+    }
+    return llround([value doubleValue] * 100);
+}
+
+// Must be called on _queue
+-(void) addRecord: (NSDictionary*) record {
+    NSString* objectId = record[@"objectId"];
+    if (!objectId) {
+        return;
+    }
+    flx::ItemFacts facts;
+    facts.locationID = FLXFactText(record[@"locationID"]);
+    facts.category = FLXFactText(record[@"category"]);
+    facts.condition = FLXFactText(record[@"condition"]);
+    facts.status = FLXFactText(record[@"status"]);
+    facts.costCents = FLXCostCents(record[@"cost"]);
+    _totals.put([objectId UTF8String], facts);
+}
+
+// Must be called on _queue
+-(void) didChange {
+    _lastChange = [NSDate date];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:FLXInventoryTotalsDidChangeNotification object:self];
+    });
+}
+
+-(void) localStoreDidChange: (NSNotification*) notification {
+    if (![notification.userInfo[FLXLocalStoreClassNameKey] isEqualToString:_className]) {
+        return;
+    }
+    NSSet* updatedIds = notification.userInfo[FLXLocalStoreUpdatedIdsKey];
+    NSSet* removedIds = notification.userInfo[FLXLocalStoreRemovedIdsKey];
+
+    dispatch_async(_queue, ^{
+        for (NSString* objectId in removedIds) {
+            self->_totals.remove([objectId UTF8String]);
+        }
+        for (NSString* objectId in updatedIds) {
+            NSDictionary* record = [self->_store recordWithId:objectId inClass:self->_className];
+            if (record) {
+                [self addRecord:record];
+            }
+        }
+        [self didChange];
+    });
+}
+
+#pragma mark - Queries
+
+-(FLXInventorySummary*) total {
+    __block FLXInventorySummary* summary = nil;
+    dispatch_sync(_queue, ^{
+        summary = [FLXInventorySummary summaryWithSummary:self->_totals.total()];
+    });
+    return summary;
+}
+
+-(FLXInventorySummary*) summaryForLocationID: (NSString*) locationID {
+    __block FLXInventorySummary* summary = nil;
+    std::string location = FLXFactText(locationID);
+    dispatch_sync(_queue, ^{
+        summary = [FLXInventorySummary summaryWithSummary:self->_totals.location(location)];
+    });
+    return summary;
+}
+
+-(FLXInventorySummary*) summaryForCategory: (NSString*) category {
+    __block FLXInventorySummary* summary = nil;
+    std::string name = FLXFactText(category);
+    dispatch_sync(_queue, ^{
+        summary = [FLXInventorySummary summaryWithSummary:self->_totals.category(name)];
+    });
+    return summary;
+}
+
+-(FLXInventorySummary*) summaryForLocationID: (NSString*) locationID category: (NSString*) category {
+    __block FLXInventorySummary* summary = nil;
+    std::string location = FLXFactText(locationID);
+    std::string name = FLXFactText(category);
+    dispatch_sync(_queue, ^{
+        summary = [FLXInventorySummary summaryWithSummary:self->_totals.locationCategory(location, name)];
+    });
+    return summary;
+}
+
+static NSDictionary* FLXSummaries(const std::vector<std::pair<std::string, flx::InventorySummary> >& summaries) {
+    NSMutableDictionary* dictionary = [[NSMutableDictionary alloc] initWithCapacity:summaries.size()];
+    for (size_t i = 0; i < summaries.size(); i++) {
+        dictionary[[NSString stringWithUTF8String:summaries[i].first.c_str()]] =
+            [FLXInventorySummary summaryWithSummary:summaries[i].second];
+    }
+    return dictionary;
+}
+
+-(NSDictionary*) summariesByLocationID {
+    __block NSDictionary* summaries = nil;
+    dispatch_sync(_queue, ^{
+        summaries = FLXSummaries(self->_totals.locations());
+    });
+    return summaries;
+}
+
+-(NSDictionary*) summariesByCategory {
+    __block NSDictionary* summaries = nil;
+    dispatch_sync(_queue, ^{
+        summaries = FLXSummaries(self->_totals.categories());
+    });
+    return summaries;
+}
+
+-(NSDate*) asOf {
+    __block NSDate* asOf = nil;
+    dispatch_sync(_queue, ^{
+        asOf = self->_lastChange;
+    });
+    return asOf;
+}
+
+@end
@@ -0,0 +1,62 @@
+//
+//  FLXItemCursor.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "FLXLocalStore.h"
+
+// Display strings for one row of the item list, formatted once per page
+// instead of on every cellForRowAtIndexPath:.
+@interface FLXItemCellModel : NSObject
+@property (nonatomic, readonly) NSString* objectId;
+@property (nonatomic, readonly) NSString* title;
+@property (nonatomic, readonly) NSString* subtitle;
+
+-(id) initWithRecord: (NSDictionary*) record;
+@end
+
+// The row changes between two cursor snapshots, expressed the way
+// UITableView batch updates expect them: deletions and reloads use row
+// numbers in the old snapshot, insertions use row numbers in the new one.
+@interface FLXItemCursorDiff : NSObject
+@property (nonatomic, readonly) NSIndexSet* deletedRows;
+@property (nonatomic, readonly) NSIndexSet* insertedRows;
+@property (nonatomic, readonly) NSIndexSet* reloadedRows;
+
+-(BOOL) isEmpty;
+@end
+
+// FLXItemCursor is a sorted view over one class of FLXLocalStore. It keeps
+// only record references in sort order; cell models are built a page at a
+// time as rows are displayed and cached until the record changes. Store
+// changes are applied incrementally (binary search on the sort order) on a
+// background queue, producing a diff that can be applied in one batch.
+//
+// The cursor is read from the main thread.
+@interface FLXItemCursor : NSObject
+
+@property (nonatomic, readonly) NSUInteger count;
+
+// sortDescriptors are applied in order, with objectId as the final tiebreak.
+-(id) initWithStore: (FLXLocalStore*) store
+          className: (NSString*) className
+    sortDescriptors: (NSArray*) sortDescriptors;
+
+-(NSDictionary*) recordAtIndex: (NSUInteger) index;
+-(FLXItemCellModel*) cellModelAtIndex: (NSUInteger) index;
+
+// Load the full snapshot in the background. completion runs on the main queue.
+-(void) reloadWithCompletion: (void (^)(void)) completion;
+
+// Apply a coalesced set of store changes. The new snapshot is installed on
+// the main queue right before completion is called with the diff, so the
+// table must apply the diff inside completion.
+-(void) applyUpdatedIds: (NSSet*) updatedIds
+             removedIds: (NSSet*) removedIds
+             completion: (void (^)(FLXItemCursorDiff* diff)) completion;
+
+@end
@@ -0,0 +1,259 @@
+//
+//  FLXItemCursor.m
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXItemCursor.h"
+
+// Number of cell models built together when a row without one is displayed
+static const NSUInteger kFLXCursorPageSize = 50;
+
+@implementation FLXItemCellModel
+
+-(id) initWithRecord: (NSDictionary*) record {
+    self = [super init];
+    if (self) {
+        static NSDateFormatter* formatter = nil;
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            formatter = [[NSDateFormatter alloc] init];
+            [formatter setDateStyle:NSDateFormatterShortStyle];
+            [formatter setTimeStyle:NSDateFormatterNoStyle];
+        });
+
+        _objectId = record[@"objectId"];
+
+        NSMutableArray* parts = [[NSMutableArray alloc] initWithCapacity:2];
+        for (NSString* key in @[@"make", @"model"]) {
+            NSString* value = record[key];
+            if ([value isKindOfClass:[NSString class]] && [value length] > 0) {
+                [parts addObject:value];
+            }
+        }
+        NSString* itemID = [record[@"itemID"] isKindOfClass:[NSString class]] ? record[@"itemID"] : nil;
+        _title = [parts count] > 0 ? [parts componentsJoinedByString:@" "] : (itemID ?: @"Untitled Item");
+
+        NSDate* itemDate = [record[@"itemDate"] isKindOfClass:[NSDate class]] ? record[@"itemDate"] : nil;
+        if (itemID && itemDate) {
+            _subtitle = [NSString stringWithFormat:@"ID: %@  %@", itemID, [formatter stringFromDate:itemDate]];
+        }
+        else if (itemID) {
+            _subtitle = [NSString stringWithFormat:@"ID: %@", itemID];
+        }
+        else {
+            _subtitle = itemDate ? [formatter stringFromDate:itemDate] : @"";
+        }
+    }
+    return self;
+}
+
+@end
+
+
+@implementation FLXItemCursorDiff
+
+-(id) initWithDeletedRows: (NSIndexSet*) deletedRows insertedRows: (NSIndexSet*) insertedRows reloadedRows: (NSIndexSet*) reloadedRows {
+    self = [super init];
+    if (self) {
+        _deletedRows = deletedRows;
+        _insertedRows = insertedRows;
+        _reloadedRows = reloadedRows;
+    }
+    return self;
+}
+
+-(BOOL) isEmpty {
+    return [_deletedRows count] == 0 && [_insertedRows count] == 0 && [_reloadedRows count] == 0;
+}
+
+@end
+
+
+@interface FLXItemCursor () {
+    FLXLocalStore* _store;
+    NSString* _className;
+    NSComparator _comparator;
+
+    // Snapshot displayed by the table (main thread)
+    NSArray* _records;
+    NSCache* _cellModels;
+
+    // Latest sorted records and their objectIds, owned by _queue. Updates are
+    // applied here first and then published to _records.
+    dispatch_queue_t _queue;
+    NSMutableArray* _workingRecords;
+    NSMutableDictionary* _workingById;
+}
+@end
+
+@implementation FLXItemCursor
+
+-(id) initWithStore: (FLXLocalStore*) store
+          className: (NSString*) className
+    sortDescriptors: (NSArray*) sortDescriptors {
+    self = [super init];
+    if (self) {
+        _store = store;
+        _className = [className copy];
+        NSArray* descriptors = [sortDescriptors copy];
+        _comparator = [^NSComparisonResult(NSDictionary* a, NSDictionary* b) {
+            for (NSSortDescriptor* descriptor in descriptors) {
+                NSComparisonResult result = [descriptor compareObject:a toObject:b];
+                if (result != NSOrderedSame) {
+                    return result;
+                }
+            }
+            return [(NSString*) a[@"objectId"] compare:b[@"objectId"]];
+        } copy];
+
+        _records = @[];
+        _cellModels = [[NSCache alloc] init];
+        _queue = dispatch_queue_create("com.filelogix.tracventory.itemcursor", DISPATCH_QUEUE_SERIAL);
+        _workingRecords = [[NSMutableArray alloc] init];
+        _workingById = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+-(NSUInteger) count {
+    return [_records count];
+}
+
+-(NSDictionary*) recordAtIndex: (NSUInteger) index {
+    return index < [_records count] ? _records[index] : nil;
+}
+
+-(FLXItemCellModel*) cellModelAtIndex: (NSUInteger) index {
+    NSDictionary* record = [self recordAtIndex:index];
+    if (!record) {
+        return nil;
+    }
+    FLXItemCellModel* model = [_cellModels objectForKey:record[@"objectId"]];
+    if (model) {
+        return model;
+    }
+
+    // Build the whole page so scrolling through it hits the cache
+    NSUInteger start = index - index % kFLXCursorPageSize;
+    NSUInteger end = MIN(start + kFLXCursorPageSize, [_records count]);
+    for (NSUInteger i = start; i < end; i++) {
+        NSDictionary* pageRecord = _records[i];
+        if (![_cellModels objectForKey:pageRecord[@"objectId"]]) {
+            FLXItemCellModel* pageModel = [[FLXItemCellModel alloc] initWithRecord:pageRecord];
+            [_cellModels setObject:pageModel forKey:pageRecord[@"objectId"]];
+            if (i == index) {
+                model = pageModel;
+            }
+        }
+    }
+    return model ?: [_cellModels objectForKey:record[@"objectId"]];
+}
+
+-(void) reloadWithCompletion: (void (^)(void)) completion {
+    dispatch_async(_queue, ^{
+        NSArray* sorted = [[self->_store allRecordsInClass:self->_className] sortedArrayWithOptions:NSSortConcurrent usingComparator:self->_comparator];
+        self->_workingRecords = [sorted mutableCopy];
+        [self->_workingById removeAllObjects];
+        for (NSDictionary* record in sorted) {
+            self->_workingById[record[@"objectId"]] = record;
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            self->_records = sorted;
+            [self->_cellModels removeAllObjects];
+            if (completion) {
+                completion();
+            }
+        });
+    });
+}
+
+// Must be called on _queue
+-(NSUInteger) workingIndexOfRecord: (NSDictionary*) record {
+    return [_workingRecords indexOfObject:record
+                            inSortedRange:NSMakeRange(0, [_workingRecords count])
+                                  options:NSBinarySearchingFirstEqual
+                          usingComparator:_comparator];
+}
+
+-(void) applyUpdatedIds: (NSSet*) updatedIds
+             removedIds: (NSSet*) removedIds
+             completion: (void (^)(FLXItemCursorDiff* diff)) completion {
+    NSSet* updated = [updatedIds copy];
+    NSSet* removed = [removedIds copy];
+
+    dispatch_async(_queue, ^{
+        NSMutableIndexSet* deletedRows = [[NSMutableIndexSet alloc] init];
+        NSMutableIndexSet* reloadedRows = [[NSMutableIndexSet alloc] init];
+        NSMutableDictionary* replacements = [[NSMutableDictionary alloc] init];
+        NSMutableArray* inserted = [[NSMutableArray alloc] init];
+
+        NSMutableSet* changedIds = [updated mutableCopy];
+        [changedIds unionSet:removed];
+
+        // Locate every changed record in the current order first, so that
+        // deleted and reloaded rows are expressed in old row numbers.
+        for (NSString* objectId in changedIds) {
+            NSDictionary* old = self->_workingById[objectId];
+            NSDictionary* record = [removed containsObject:objectId] ? nil : [self->_store recordWithId:objectId inClass:self->_className];
+            if (!old && !record) {
+                continue;
+            }
+            if (old) {
+                NSUInteger row = [self workingIndexOfRecord:old];
+                if (row == NSNotFound) {
+                    continue;
+                }
+                if (record && self->_comparator(old, record) == NSOrderedSame) {
+                    // Sort position is unchanged
+                    [reloadedRows addIndex:row];
+                    replacements[@(row)] = record;
+                    self->_workingById[objectId] = record;
+                    continue;
+                }
+                [deletedRows addIndex:row];
+                [self->_workingById removeObjectForKey:objectId];
+            }
+            if (record) {
+                [inserted addObject:record];
+                self->_workingById[objectId] = record;
+            }
+        }
+
+        [replacements enumerateKeysAndObjectsUsingBlock:^(NSNumber* row, NSDictionary* record, BOOL *stop) {
+            self->_workingRecords[[row unsignedIntegerValue]] = record;
+        }];
+        [self->_workingRecords removeObjectsAtIndexes:deletedRows];
+        for (NSDictionary* record in inserted) {
+            NSUInteger row = [self->_workingRecords indexOfObject:record
+                                                     inSortedRange:NSMakeRange(0, [self->_workingRecords count])
+                                                           options:NSBinarySearchingInsertionIndex
+                                                   usingComparator:self->_comparator];
+            [self->_workingRecords insertObject:record atIndex:row];
+        }
+
+        // Inserted rows are numbered in the final order
+        NSMutableIndexSet* insertedRows = [[NSMutableIndexSet alloc] init];
+        for (NSDictionary* record in inserted) {
+            [insertedRows addIndex:[self workingIndexOfRecord:record]];
+        }
+
+        NSArray* snapshot = [self->_workingRecords copy];
+        FLXItemCursorDiff* diff = [[FLXItemCursorDiff alloc] initWithDeletedRows:deletedRows insertedRows:insertedRows reloadedRows:reloadedRows];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            self->_records = snapshot;
+            for (NSString* objectId in changedIds) {
+                [self->_cellModels removeObjectForKey:objectId];
+            }
+            if (completion) {
+                completion(diff);
+            }
+        });
+    });
+}
+
+@end
@@ -0,0 +1,69 @@
+//
+//  FLXLocalQuery.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "FLXLocalStore.h"
+
+@class PFQuery;
+
+// FLXLocalQuery evaluates the PFQuery constraints below against FLXLocalStore,
+// so searches and location lookups work without connectivity. equalTo: and
+// containedIn: constraints on indexed keys are answered from the store's hash
+// indexes; everything else is filtered in memory.
+//
+// Results are sorted the way Parse sorts them: records missing a key come
+// first, and values of different types are ordered by type (numbers, then
+// strings, ..., then dates).
+//
+// Local results are store records (NSDictionary). When the class has not been
+// synced, findObjectsInBackgroundWithBlock: runs the equivalent PFQuery and
+// returns PFObjects instead. Both can be read with object[@"key"].
+@interface FLXLocalQuery : NSObject
+
+@property (nonatomic, readonly) NSString* parseClassName;
+// At most 100 results by default, as with PFQuery; -1 for no limit locally
+@property (nonatomic, assign) NSInteger limit;
+@property (nonatomic, assign) NSInteger skip;
+
++(FLXLocalQuery*) queryWithClassName: (NSString*) className;
+-(id) initWithClassName: (NSString*) className store: (FLXLocalStore*) store;
+
+-(void) whereKeyExists: (NSString*) key;
+-(void) whereKeyDoesNotExist: (NSString*) key;
+-(void) whereKey: (NSString*) key equalTo: (id) object;
+-(void) whereKey: (NSString*) key notEqualTo: (id) object;
+-(void) whereKey: (NSString*) key lessThan: (id) object;
+-(void) whereKey: (NSString*) key lessThanOrEqualTo: (id) object;
+-(void) whereKey: (NSString*) key greaterThan: (id) object;
+-(void) whereKey: (NSString*) key greaterThanOrEqualTo: (id) object;
+-(void) whereKey: (NSString*) key containedIn: (NSArray*) array;
+-(void) whereKey: (NSString*) key notContainedIn: (NSArray*) array;
+// A prefix that is not a string (nil) matches nothing
+-(void) whereKey: (NSString*) key hasPrefix: (NSString*) prefix;
+
+-(void) orderByAscending: (NSString*) key;
+-(void) orderByDescending: (NSString*) key;
+-(void) addAscendingOrder: (NSString*) key;
+-(void) addDescendingOrder: (NSString*) key;
+
+// Whether the class is synced and the query can be answered locally
+-(BOOL) canEvaluateLocally;
+
+// Synchronous local evaluation. These return nil / 0 if the class is not synced.
+-(NSArray*) findObjects;
+-(id) getFirstObject;
+-(NSInteger) countObjects;
+
+// Evaluate locally when possible, otherwise fall back to the network.
+// The block is invoked on the main queue.
+-(void) findObjectsInBackgroundWithBlock: (void (^)(NSArray* objects, NSError* error)) block;
+
+// The equivalent network query
+-(PFQuery*) parseQuery;
+
+@end
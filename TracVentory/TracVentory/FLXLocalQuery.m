@@ -0,0 +1,368 @@
+//
+//  FLXLocalQuery.m
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXLocalQuery.h"
+#import <Parse/Parse.h>
+
+typedef NS_ENUM(NSInteger, FLXQueryOperator) {
+    FLXQueryExists,
+    FLXQueryDoesNotExist,
+    FLXQueryEqualTo,
+    FLXQueryNotEqualTo,
+    FLXQueryLessThan,
+    FLXQueryLessThanOrEqualTo,
+    FLXQueryGreaterThan,
+    FLXQueryGreaterThanOrEqualTo,
+    FLXQueryContainedIn,
+    FLXQueryNotContainedIn,
+    FLXQueryHasPrefix
+};
+
+@interface FLXQueryConstraint : NSObject
+@property (strong, nonatomic) NSString* key;
+@property (assign, nonatomic) FLXQueryOperator op;
+@property (strong, nonatomic) id value;
+// value as records hold it, for matching locally
+@property (strong, nonatomic) id storeValue;
+@end
+
+@implementation FLXQueryConstraint
+
+// Parse matches a scalar constraint against an array key if any element matches
+static BOOL FLXValueEquals(id recordValue, id value) {
+    if ([recordValue isKindOfClass:[NSArray class]]) {
+        return [recordValue containsObject:value];
+    }
+    return [recordValue isEqual:value];
+}
+
+static BOOL FLXValueComparable(id recordValue, id value) {
+    return ([recordValue isKindOfClass:[NSNumber class]] && [value isKindOfClass:[NSNumber class]]) ||
+           ([recordValue isKindOfClass:[NSString class]] && [value isKindOfClass:[NSString class]]) ||
+           ([recordValue isKindOfClass:[NSDate class]] && [value isKindOfClass:[NSDate class]]);
+}
+
+-(BOOL) matches: (NSDictionary*) record {
+    id recordValue = record[self.key];
+
+    switch (self.op) {
+        case FLXQueryExists:
+            return recordValue != nil;
+        case FLXQueryDoesNotExist:
+            return recordValue == nil;
+        case FLXQueryEqualTo:
+            return recordValue && FLXValueEquals(recordValue, self.storeValue);
+        case FLXQueryNotEqualTo:
+            return !recordValue || !FLXValueEquals(recordValue, self.storeValue);
+        case FLXQueryContainedIn:
+            for (id value in self.storeValue) {
+                if (recordValue && FLXValueEquals(recordValue, value)) {
+                    return YES;
+                }
+            }
+            return NO;
+        case FLXQueryNotContainedIn:
+            for (id value in self.storeValue) {
+                if (recordValue && FLXValueEquals(recordValue, value)) {
+                    return NO;
+                }
+            }
+            return YES;
+        case FLXQueryHasPrefix:
+            return [recordValue isKindOfClass:[NSString class]] && [recordValue hasPrefix:self.storeValue];
+        default:
+            break;
+    }
+
+    if (!FLXValueComparable(recordValue, self.storeValue)) {
+        return NO;
+    }
+    NSComparisonResult result = [recordValue compare:self.storeValue];
+    switch (self.op) {
+        case FLXQueryLessThan:
+            return result == NSOrderedAscending;
+        case FLXQueryLessThanOrEqualTo:
+            return result != NSOrderedDescending;
+        case FLXQueryGreaterThan:
+            return result == NSOrderedDescending;
+        case FLXQueryGreaterThanOrEqualTo:
+            return result != NSOrderedAscending;
+        default:
+            return NO;
+    }
+}
+
+-(void) applyToQuery: (PFQuery*) query {
+    switch (self.op) {
+        case FLXQueryExists:               [query whereKeyExists:self.key]; break;
+        case FLXQueryDoesNotExist:         [query whereKeyDoesNotExist:self.key]; break;
+        case FLXQueryEqualTo:              [query whereKey:self.key equalTo:self.value]; break;
+        case FLXQueryNotEqualTo:           [query whereKey:self.key notEqualTo:self.value]; break;
+        case FLXQueryLessThan:             [query whereKey:self.key lessThan:self.value]; break;
+        case FLXQueryLessThanOrEqualTo:    [query whereKey:self.key lessThanOrEqualTo:self.value]; break;
+        case FLXQueryGreaterThan:          [query whereKey:self.key greaterThan:self.value]; break;
+        case FLXQueryGreaterThanOrEqualTo: [query whereKey:self.key greaterThanOrEqualTo:self.value]; break;
+        case FLXQueryContainedIn:          [query whereKey:self.key containedIn:self.value]; break;
+        case FLXQueryNotContainedIn:       [query whereKey:self.key notContainedIn:self.value]; break;
+        case FLXQueryHasPrefix:            [query whereKey:self.key hasPrefix:self.value]; break;
+    }
+}
+
+@end
+
+
+// Sort order of values of different types, as Parse orders them: missing
+// first, then numbers, strings, dictionaries (pointers, geo points, files),
+// arrays, data and dates. Booleans are NSNumbers here.
+static NSInteger FLXValueTypeRank(id value) {
+    if (!value || value == [NSNull null])             return 0;
+    if ([value isKindOfClass:[NSNumber class]])       return 1;
+    if ([value isKindOfClass:[NSString class]])       return 2;
+    if ([value isKindOfClass:[NSDictionary class]])   return 3;
+    if ([value isKindOfClass:[NSArray class]])        return 4;
+    if ([value isKindOfClass:[NSData class]])         return 5;
+    if ([value isKindOfClass:[NSDate class]])         return 6;
+    return 7;
+}
+
+// Orders any two record values without raising: by type first, then by
+// value for numbers, strings and dates; other values of one type tie
+static NSComparisonResult FLXCompareValues(id a, id b) {
+    NSInteger rankA = FLXValueTypeRank(a);
+    NSInteger rankB = FLXValueTypeRank(b);
+    if (rankA != rankB) {
+        return rankA < rankB ? NSOrderedAscending : NSOrderedDescending;
+    }
+    if (rankA == 1 || rankA == 2 || rankA == 6) {
+        return [a compare:b];
+    }
+    return NSOrderedSame;
+}
+
+
+@interface FLXLocalQuery () {
+    FLXLocalStore* _store;
+    NSMutableArray* _constraints;
+    NSMutableArray* _sortDescriptors;
+}
+@end
+
+@implementation FLXLocalQuery
+
++(FLXLocalQuery*) queryWithClassName: (NSString*) className {
+    return [[FLXLocalQuery alloc] initWithClassName:className store:[FLXLocalStore sharedStore]];
+}
+
+-(id) initWithClassName: (NSString*) className store: (FLXLocalStore*) store {
+    self = [super init];
+    if (self) {
+        _parseClassName = [className copy];
+        _store = store;
+        _constraints = [[NSMutableArray alloc] init];
+        _sortDescriptors = [[NSMutableArray alloc] init];
+        // Parse's default
+        _limit = 100;
+        _skip = 0;
+    }
+    return self;
+}
+
+#pragma mark - Constraints
+
+-(void) addConstraint: (FLXQueryOperator) op forKey: (NSString*) key value: (id) value {
+    FLXQueryConstraint* constraint = [[FLXQueryConstraint alloc] init];
+    constraint.key = key;
+    constraint.op = op;
+    constraint.value = value;
+    // Pointers, geo points and files are compared the way records store them
+    constraint.storeValue = [FLXLocalStore storeValueFromValue:value];
+    [_constraints addObject:constraint];
+}
+
+-(void) whereKeyExists: (NSString*) key                          { [self addConstraint:FLXQueryExists forKey:key value:nil]; }
+-(void) whereKeyDoesNotExist: (NSString*) key                    { [self addConstraint:FLXQueryDoesNotExist forKey:key value:nil]; }
+-(void) whereKey: (NSString*) key equalTo: (id) object {
+    if (!object) {
+        [self whereKeyDoesNotExist:key];
+        return;
+    }
+    [self addConstraint:FLXQueryEqualTo forKey:key value:object];
+}
+
+-(void) whereKey: (NSString*) key notEqualTo: (id) object        { [self addConstraint:FLXQueryNotEqualTo forKey:key value:object]; }
+-(void) whereKey: (NSString*) key lessThan: (id) object          { [self addConstraint:FLXQueryLessThan forKey:key value:object]; }
+-(void) whereKey: (NSString*) key lessThanOrEqualTo: (id) object { [self addConstraint:FLXQueryLessThanOrEqualTo forKey:key value:object]; }
+-(void) whereKey: (NSString*) key greaterThan: (id) object       { [self addConstraint:FLXQueryGreaterThan forKey:key value:object]; }
+-(void) whereKey: (NSString*) key greaterThanOrEqualTo: (id) object { [self addConstraint:FLXQueryGreaterThanOrEqualTo forKey:key value:object]; }
+-(void) whereKey: (NSString*) key containedIn: (NSArray*) array   { [self addConstraint:FLXQueryContainedIn forKey:key value:[array copy]]; }
+-(void) whereKey: (NSString*) key notContainedIn: (NSArray*) array { [self addConstraint:FLXQueryNotContainedIn forKey:key value:[array copy]]; }
+
+-(void) whereKey: (NSString*) key hasPrefix: (NSString*) prefix {
+    if (![prefix isKindOfClass:[NSString class]]) {
+        // Matches nothing, locally and on Parse ($in of nothing)
+        NSLog(@"Query on %@: hasPrefix: needs a string, not %@", key, prefix);
+        [self addConstraint:FLXQueryContainedIn forKey:key value:@[]];
+        return;
+    }
+    [self addConstraint:FLXQueryHasPrefix forKey:key value:prefix];
+}
+
+-(void) orderByAscending: (NSString*) key {
+    [_sortDescriptors removeAllObjects];
+    [self addAscendingOrder:key];
+}
+
+-(void) orderByDescending: (NSString*) key {
+    [_sortDescriptors removeAllObjects];
+    [self addDescendingOrder:key];
+}
+
+-(void) addAscendingOrder: (NSString*) key {
+    [_sortDescriptors addObject:[NSSortDescriptor sortDescriptorWithKey:key ascending:YES]];
+}
+
+-(void) addDescendingOrder: (NSString*) key {
+    [_sortDescriptors addObject:[NSSortDescriptor sortDescriptorWithKey:key ascending:NO]];
+}
+
+#pragma mark - Local evaluation
+
+-(BOOL) canEvaluateLocally {
+    return [_store isClassSynced:_parseClassName];
+}
+
+// Pick the candidate records: the rows of the first indexed equalTo: (or,
+// failing that, containedIn:) constraint, or every record in the class.
+-(NSArray*) candidateRecords: (FLXQueryConstraint**) usedConstraint {
+    FLXQueryConstraint* best = nil;
+    for (FLXQueryConstraint* constraint in _constraints) {
+        if (constraint.op != FLXQueryEqualTo && constraint.op != FLXQueryContainedIn) {
+            continue;
+        }
+        if (!constraint.storeValue || ![_store hasIndexForKey:constraint.key inClass:_parseClassName]) {
+            continue;
+        }
+        if (!best || (best.op == FLXQueryContainedIn && constraint.op == FLXQueryEqualTo)) {
+            best = constraint;
+        }
+    }
+
+    if (best) {
+        NSArray* values = best.op == FLXQueryEqualTo ? @[best.storeValue] : best.storeValue;
+        NSArray* records = [_store recordsInClass:_parseClassName withKey:best.key inValues:values];
+        if (records) {
+            *usedConstraint = best;
+            return records;
+        }
+    }
+    *usedConstraint = nil;
+    return [_store allRecordsInClass:_parseClassName];
+}
+
+-(NSArray*) evaluate {
+    FLXQueryConstraint* usedConstraint = nil;
+    NSArray* candidates = [self candidateRecords:&usedConstraint];
+
+    NSMutableArray* results = [[NSMutableArray alloc] init];
+    for (NSDictionary* record in candidates) {
+        BOOL matches = YES;
+        for (FLXQueryConstraint* constraint in _constraints) {
+            if (constraint != usedConstraint && ![constraint matches:record]) {
+                matches = NO;
+                break;
+            }
+        }
+        if (matches) {
+            [results addObject:record];
+        }
+    }
+
+    if ([_sortDescriptors count] > 0) {
+        NSArray* sortDescriptors = _sortDescriptors;
+        [results sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(NSDictionary* a, NSDictionary* b) {
+            for (NSSortDescriptor* descriptor in sortDescriptors) {
+                NSComparisonResult result = FLXCompareValues(a[[descriptor key]], b[[descriptor key]]);
+                if (result != NSOrderedSame) {
+                    return [descriptor ascending] ? result : (NSComparisonResult) -result;
+                }
+            }
+            return NSOrderedSame;
+        }];
+    }
+
+    NSUInteger start = MIN((NSUInteger) MAX(_skip, 0), [results count]);
+    NSUInteger length = [results count] - start;
+    if (_limit >= 0) {
+        length = MIN(length, (NSUInteger) _limit);
+    }
+    if (start == 0 && length == [results count]) {
+        return results;
+    }
+    return [results subarrayWithRange:NSMakeRange(start, length)];
+}
+
+-(NSArray*) findObjects {
+    if (![self canEvaluateLocally]) {
+        return nil;
+    }
+    return [self evaluate];
+}
+
+-(id) getFirstObject {
+    NSInteger limit = _limit;
+    _limit = 1;
+    NSArray* results = [self findObjects];
+    _limit = limit;
+    return [results firstObject];
+}
+
+-(NSInteger) countObjects {
+    NSInteger limit = _limit;
+    NSInteger skip = _skip;
+    _limit = -1;
+    _skip = 0;
+    NSInteger count = [[self findObjects] count];
+    _limit = limit;
+    _skip = skip;
+    return count;
+}
+
+-(void) findObjectsInBackgroundWithBlock: (void (^)(NSArray* objects, NSError* error)) block {
+    if ([self canEvaluateLocally]) {
+        NSArray* results = [self evaluate];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            block(results, nil);
+        });
+        return;
+    }
+    [[self parseQuery] findObjectsInBackgroundWithBlock:block];
+}
+
+#pragma mark - Network fallback
+
+-(PFQuery*) parseQuery {
+    PFQuery* query = [PFQuery queryWithClassName:_parseClassName];
+    for (FLXQueryConstraint* constraint in _constraints) {
+        [constraint applyToQuery:query];
+    }
+    for (NSSortDescriptor* descriptor in _sortDescriptors) {
+        if ([descriptor ascending]) {
+            [query addAscendingOrder:[descriptor key]];
+        }
+        else {
+            [query addDescendingOrder:[descriptor key]];
+        }
+    }
+    if (_limit >= 0) {
+        query.limit = _limit;
+    }
+    query.skip = _skip;
+    return query;
+}
+
+@end
@@ -0,0 +1,91 @@
+//
+//  FLXLocalStore.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class PFObject;
+
+// Posted on the main queue after records are put or removed. Changes made in
+// quick succession are delivered as separate notifications; observers are
+// expected to coalesce them.
+extern NSString* const FLXLocalStoreDidChangeNotification;
+
+// userInfo keys of FLXLocalStoreDidChangeNotification
+extern NSString* const FLXLocalStoreClassNameKey;   // NSString
+extern NSString* const FLXLocalStoreUpdatedIdsKey;  // NSSet of inserted or replaced objectIds
+extern NSString* const FLXLocalStoreRemovedIdsKey;  // NSSet of removed objectIds
+
+// The value a derived index files a record under
+typedef id (^FLXStoreIndexDeriver)(NSDictionary* record);
+
+// FLXLocalStore keeps a synced, on-device copy of Parse classes (Items,
+// Locations, ...) so they can be queried without a network round trip.
+// Each object is held as an immutable NSDictionary record with the object's
+// keys plus objectId / createdAt / updatedAt. Records only contain property
+// list types: pointers are stored as their objectId, and geo points and files
+// are stored as dictionaries tagged with "__type", the way the Parse REST API
+// encodes them.
+//
+// All methods are thread safe.
+@interface FLXLocalStore : NSObject
+
+// The store in Library/Application Support/FLXLocalStore. One kept in
+// Caches by earlier versions is moved there.
++(FLXLocalStore*) sharedStore;
+
+// Create a store that persists to the given directory (nil keeps it in memory).
+-(id) initWithDirectory: (NSString*) directory;
+
+// Convert a PFObject into a store record
++(NSDictionary*) recordFromObject: (PFObject*) object;
+// Convert a Parse value into the form it takes in a record; nil for values
+// not kept offline (ACLs, relations)
++(id) storeValueFromValue: (id) value;
+
+// Whether the class has completed at least one sync (or is local-only) and
+// can therefore be queried locally.
+-(BOOL) isClassSynced: (NSString*) className;
+
+// Mark a class that is never synced with Parse ("Local Storage Only").
+-(void) markClassLocalOnly: (NSString*) className;
+
+// Pull the objects of the class changed since the last sync. The completion
+// block is invoked on the main queue.
+-(void) syncClassName: (NSString*) className
+           completion: (void (^)(BOOL succeeded, NSError* error)) completion;
+// Pull every object of the class again and drop the records of objects
+// since deleted on Parse, which an incremental sync does not see.
+-(void) resyncClassName: (NSString*) className
+             completion: (void (^)(BOOL succeeded, NSError* error)) completion;
+
+// Maintain a hash index on key, used by FLXLocalQuery for equalTo: and
+// containedIn: constraints.
+-(void) ensureIndexForKey: (NSString*) key inClass: (NSString*) className;
+// An index on a value computed from each record (the block is called on
+// the store's queue and returns nil, a value or an array of values), found
+// by recordsInClass:withKey:inValues: under key. key should not be a field
+// of the records.
+-(void) ensureIndexForKey: (NSString*) key inClass: (NSString*) className derivedBy: (FLXStoreIndexDeriver) derive;
+-(BOOL) hasIndexForKey: (NSString*) key inClass: (NSString*) className;
+
+// Records whose value for key equals one of values, using the index on key.
+// Returns nil if there is no index on key.
+-(NSArray*) recordsInClass: (NSString*) className withKey: (NSString*) key inValues: (NSArray*) values;
+
+-(NSDictionary*) recordWithId: (NSString*) objectId inClass: (NSString*) className;
+-(NSArray*) allRecordsInClass: (NSString*) className;
+-(NSUInteger) countOfClass: (NSString*) className;
+
+// Insert or replace records, matched on objectId.
+-(void) putRecords: (NSArray*) records inClass: (NSString*) className;
+-(void) removeRecordsWithIds: (NSArray*) objectIds inClass: (NSString*) className;
+
+// Write modified classes to disk now instead of waiting for the next save.
+-(void) flush;
+
+@end
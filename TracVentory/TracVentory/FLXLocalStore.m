@@ -0,0 +1,598 @@
+//
+//  FLXLocalStore.m
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXLocalStore.h"
+#import <Parse/Parse.h>
+
+NSString* const FLXLocalStoreDidChangeNotification = @"FLXLocalStoreDidChangeNotification";
+NSString* const FLXLocalStoreClassNameKey = @"className";
+NSString* const FLXLocalStoreUpdatedIdsKey = @"updatedIds";
+NSString* const FLXLocalStoreRemovedIdsKey = @"removedIds";
+
+// Objects pulled from Parse per request while syncing
+static const NSInteger kFLXSyncPageSize = 1000;
+
+// Seconds to wait after a change before writing a class to disk
+static const NSTimeInterval kFLXSaveDelay = 2.0;
+
+// One synced Parse class. Rows are never reused while the table is live, so
+// an index can refer to records by row number; removed rows hold NSNull until
+// the table is compacted.
+@interface FLXStoreTable : NSObject
+@property (strong, nonatomic) NSMutableArray* rows;
+@property (strong, nonatomic) NSMutableDictionary* rowForId;
+@property (strong, nonatomic) NSMutableDictionary* indexes;
+// Keys whose indexed value is computed from the record rather than stored
+@property (strong, nonatomic) NSMutableDictionary* derivers;
+@property (strong, nonatomic) NSDate* lastSync;
+@property (assign, nonatomic) NSUInteger removedRows;
+@property (assign, nonatomic) BOOL synced;
+@property (assign, nonatomic) BOOL localOnly;
+@property (assign, nonatomic) BOOL dirty;
+@end
+
+@implementation FLXStoreTable
+
+-(id) init {
+    self = [super init];
+    if (self) {
+        _rows = [[NSMutableArray alloc] init];
+        _rowForId = [[NSMutableDictionary alloc] init];
+        _indexes = [[NSMutableDictionary alloc] init];
+        _derivers = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+-(id) indexValueOfRecord: (NSDictionary*) record forKey: (NSString*) key {
+    FLXStoreIndexDeriver derive = self.derivers[key];
+    return derive ? derive(record) : record[key];
+}
+
+-(void) addRecord: (NSDictionary*) record toIndex: (NSMutableDictionary*) index forKey: (NSString*) key row: (NSUInteger) row {
+    id value = [self indexValueOfRecord:record forKey:key];
+    if (!value) {
+        return;
+    }
+    // Like Parse, equalTo: on an array key matches any element of the array
+    NSArray* values = [value isKindOfClass:[NSArray class]] ? value : @[value];
+    for (id v in values) {
+        NSMutableIndexSet* rows = index[v];
+        if (!rows) {
+            rows = [[NSMutableIndexSet alloc] init];
+            index[v] = rows;
+        }
+        [rows addIndex:row];
+    }
+}
+
+-(void) removeRecord: (NSDictionary*) record fromIndex: (NSMutableDictionary*) index forKey: (NSString*) key row: (NSUInteger) row {
+    id value = [self indexValueOfRecord:record forKey:key];
+    if (!value) {
+        return;
+    }
+    NSArray* values = [value isKindOfClass:[NSArray class]] ? value : @[value];
+    for (id v in values) {
+        NSMutableIndexSet* rows = index[v];
+        [rows removeIndex:row];
+        if ([rows count] == 0) {
+            [index removeObjectForKey:v];
+        }
+    }
+}
+
+-(void) buildIndexForKey: (NSString*) key {
+    NSMutableDictionary* index = [[NSMutableDictionary alloc] init];
+    [self.rows enumerateObjectsUsingBlock:^(id record, NSUInteger row, BOOL *stop) {
+        if (record != [NSNull null]) {
+            [self addRecord:record toIndex:index forKey:key row:row];
+        }
+    }];
+    self.indexes[key] = index;
+}
+
+-(void) putRecord: (NSDictionary*) record {
+    NSString* objectId = record[@"objectId"];
+    if (!objectId) {
+        return;
+    }
+    NSNumber* existing = self.rowForId[objectId];
+    if (existing) {
+        NSUInteger row = [existing unsignedIntegerValue];
+        NSDictionary* old = self.rows[row];
+        [self.indexes enumerateKeysAndObjectsUsingBlock:^(NSString* key, NSMutableDictionary* index, BOOL *stop) {
+            [self removeRecord:old fromIndex:index forKey:key row:row];
+            [self addRecord:record toIndex:index forKey:key row:row];
+        }];
+        self.rows[row] = record;
+    }
+    else {
+        NSUInteger row = [self.rows count];
+        [self.rows addObject:record];
+        self.rowForId[objectId] = @(row);
+        [self.indexes enumerateKeysAndObjectsUsingBlock:^(NSString* key, NSMutableDictionary* index, BOOL *stop) {
+            [self addRecord:record toIndex:index forKey:key row:row];
+        }];
+    }
+    self.dirty = YES;
+}
+
+-(void) removeRecordWithId: (NSString*) objectId {
+    NSNumber* existing = self.rowForId[objectId];
+    if (!existing) {
+        return;
+    }
+    NSUInteger row = [existing unsignedIntegerValue];
+    NSDictionary* old = self.rows[row];
+    [self.indexes enumerateKeysAndObjectsUsingBlock:^(NSString* key, NSMutableDictionary* index, BOOL *stop) {
+        [self removeRecord:old fromIndex:index forKey:key row:row];
+    }];
+    self.rows[row] = [NSNull null];
+    [self.rowForId removeObjectForKey:objectId];
+    self.removedRows++;
+    self.dirty = YES;
+
+    if (self.removedRows > 64 && self.removedRows * 2 > [self.rows count]) {
+        [self compact];
+    }
+}
+
+-(void) compact {
+    NSArray* records = [self liveRecords];
+    NSArray* keys = [self.indexes allKeys];
+    [self.rows removeAllObjects];
+    [self.rowForId removeAllObjects];
+    [self.indexes removeAllObjects];
+    self.removedRows = 0;
+    for (NSDictionary* record in records) {
+        self.rowForId[record[@"objectId"]] = @([self.rows count]);
+        [self.rows addObject:record];
+    }
+    for (NSString* key in keys) {
+        [self buildIndexForKey:key];
+    }
+}
+
+-(NSArray*) liveRecords {
+    if (self.removedRows == 0) {
+        return [self.rows copy];
+    }
+    NSMutableArray* records = [[NSMutableArray alloc] initWithCapacity:[self.rowForId count]];
+    for (id record in self.rows) {
+        if (record != [NSNull null]) {
+            [records addObject:record];
+        }
+    }
+    return records;
+}
+
+@end
+
+
+@interface FLXLocalStore () {
+    dispatch_queue_t _queue;
+    NSMutableDictionary* _tables;
+    NSString* _directory;
+    BOOL _saveScheduled;
+}
+@end
+
+@implementation FLXLocalStore
+
++(FLXLocalStore*) sharedStore {
+    static FLXLocalStore* sharedStore = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        // Not in Caches, which iOS may purge: local-only classes have no
+        // copy on Parse to sync back from
+        NSString* support = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) firstObject];
+        NSString* directory = [support stringByAppendingPathComponent:@"FLXLocalStore"];
+        NSString* caches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+        NSString* legacyDirectory = [caches stringByAppendingPathComponent:@"FLXLocalStore"];
+        NSFileManager* fileManager = [NSFileManager defaultManager];
+        if ([fileManager fileExistsAtPath:legacyDirectory] && ![fileManager fileExistsAtPath:directory]) {
+            [fileManager createDirectoryAtPath:support withIntermediateDirectories:YES attributes:nil error:NULL];
+            NSError* error = nil;
+            if (![fileManager moveItemAtPath:legacyDirectory toPath:directory error:&error]) {
+                NSLog(@"Cannot move the local store out of Caches: %@", error);
+            }
+        }
+        sharedStore = [[FLXLocalStore alloc] initWithDirectory:directory];
+    });
+    return sharedStore;
+}
+
+-(id) init {
+    return [self initWithDirectory:nil];
+}
+
+-(id) initWithDirectory: (NSString*) directory {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("com.filelogix.tracventory.localstore", DISPATCH_QUEUE_SERIAL);
+        _tables = [[NSMutableDictionary alloc] init];
+        _directory = [directory copy];
+        if (_directory) {
+            [[NSFileManager defaultManager] createDirectoryAtPath:_directory withIntermediateDirectories:YES attributes:nil error:NULL];
+        }
+    }
+    return self;
+}
+
+#pragma mark - Records
+
++(id) storeValueFromValue: (id) value {
+    if ([value isKindOfClass:[PFObject class]]) {
+        return [(PFObject*) value objectId];
+    }
+    if ([value isKindOfClass:[PFGeoPoint class]]) {
+        PFGeoPoint* point = value;
+        return @{@"__type": @"GeoPoint", @"latitude": @(point.latitude), @"longitude": @(point.longitude)};
+    }
+    if ([value isKindOfClass:[PFFile class]]) {
+        PFFile* file = value;
+        NSMutableDictionary* encoded = [NSMutableDictionary dictionaryWithObject:@"File" forKey:@"__type"];
+        if (file.name) encoded[@"name"] = file.name;
+        if (file.url) encoded[@"url"] = file.url;
+        return encoded;
+    }
+    if ([value isKindOfClass:[NSArray class]]) {
+        NSMutableArray* values = [[NSMutableArray alloc] initWithCapacity:[value count]];
+        for (id element in value) {
+            id converted = [self storeValueFromValue:element];
+            if (converted) {
+                [values addObject:converted];
+            }
+        }
+        return values;
+    }
+    if ([value isKindOfClass:[NSString class]] || [value isKindOfClass:[NSNumber class]] ||
+        [value isKindOfClass:[NSDate class]] || [value isKindOfClass:[NSData class]] ||
+        [value isKindOfClass:[NSDictionary class]]) {
+        return value;
+    }
+    // ACLs, relations, etc. are not needed offline
+    return nil;
+}
+
++(NSDictionary*) recordFromObject: (PFObject*) object {
+    NSMutableDictionary* record = [[NSMutableDictionary alloc] init];
+    for (NSString* key in [object allKeys]) {
+        id value = [self storeValueFromValue:object[key]];
+        if (value) {
+            record[key] = value;
+        }
+    }
+    if (object.objectId) record[@"objectId"] = object.objectId;
+    if (object.createdAt) record[@"createdAt"] = object.createdAt;
+    if (object.updatedAt) record[@"updatedAt"] = object.updatedAt;
+    return record;
+}
+
+// Must be called on _queue
+-(FLXStoreTable*) tableForClass: (NSString*) className {
+    FLXStoreTable* table = _tables[className];
+    if (!table) {
+        table = [self loadTableForClass:className];
+        if (!table) {
+            table = [[FLXStoreTable alloc] init];
+        }
+        _tables[className] = table;
+    }
+    return table;
+}
+
+-(BOOL) isClassSynced: (NSString*) className {
+    __block BOOL synced = NO;
+    dispatch_sync(_queue, ^{
+        FLXStoreTable* table = [self tableForClass:className];
+        synced = table.synced || table.localOnly;
+    });
+    return synced;
+}
+
+-(void) markClassLocalOnly: (NSString*) className {
+    dispatch_sync(_queue, ^{
+        FLXStoreTable* table = [self tableForClass:className];
+        table.localOnly = YES;
+        table.dirty = YES;
+        [self scheduleSave];
+    });
+}
+
+-(void) ensureIndexForKey: (NSString*) key inClass: (NSString*) className {
+    dispatch_sync(_queue, ^{
+        FLXStoreTable* table = [self tableForClass:className];
+        if (!table.indexes[key]) {
+            [table buildIndexForKey:key];
+        }
+    });
+}
+
+-(void) ensureIndexForKey: (NSString*) key inClass: (NSString*) className derivedBy: (FLXStoreIndexDeriver) derive {
+    dispatch_sync(_queue, ^{
+        FLXStoreTable* table = [self tableForClass:className];
+        if (!table.indexes[key]) {
+            table.derivers[key] = [derive copy];
+            [table buildIndexForKey:key];
+        }
+    });
+}
+
+-(BOOL) hasIndexForKey: (NSString*) key inClass: (NSString*) className {
+    __block BOOL hasIndex = NO;
+    dispatch_sync(_queue, ^{
+        hasIndex = [self tableForClass:className].indexes[key] != nil;
+    });
+    return hasIndex;
+}
+
+-(NSArray*) recordsInClass: (NSString*) className withKey: (NSString*) key inValues: (NSArray*) values {
+    __block NSMutableArray* records = nil;
+    dispatch_sync(_queue, ^{
+        FLXStoreTable* table = [self tableForClass:className];
+        NSDictionary* index = table.indexes[key];
+        if (!index) {
+            return;
+        }
+        NSMutableIndexSet* rows = [[NSMutableIndexSet alloc] init];
+        for (id value in values) {
+            NSIndexSet* matches = index[value];
+            if (matches) {
+                [rows addIndexes:matches];
+            }
+        }
+        records = [[NSMutableArray alloc] initWithCapacity:[rows count]];
+        [rows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+            [records addObject:table.rows[row]];
+        }];
+    });
+    return records;
+}
+
+-(NSDictionary*) recordWithId: (NSString*) objectId inClass: (NSString*) className {
+    __block NSDictionary* record = nil;
+    dispatch_sync(_queue, ^{
+        FLXStoreTable* table = [self tableForClass:className];
+        NSNumber* row = table.rowForId[objectId];
+        if (row) {
+            record = table.rows[[row unsignedIntegerValue]];
+        }
+    });
+    return record;
+}
+
+-(NSArray*) allRecordsInClass: (NSString*) className {
+    __block NSArray* records = nil;
+    dispatch_sync(_queue, ^{
+        records = [[self tableForClass:className] liveRecords];
+    });
+    return records;
+}
+
+-(NSUInteger) countOfClass: (NSString*) className {
+    __block NSUInteger count = 0;
+    dispatch_sync(_queue, ^{
+        count = [[self tableForClass:className].rowForId count];
+    });
+    return count;
+}
+
+-(void) putRecords: (NSArray*) records inClass: (NSString*) className {
+    if ([records count] == 0) {
+        return;
+    }
+    NSMutableSet* updatedIds = [[NSMutableSet alloc] initWithCapacity:[records count]];
+    dispatch_sync(_queue, ^{
+        FLXStoreTable* table = [self tableForClass:className];
+        for (NSDictionary* record in records) {
+            [table putRecord:[record copy]];
+            if (record[@"objectId"]) {
+                [updatedIds addObject:record[@"objectId"]];
+            }
+        }
+        [self scheduleSave];
+    });
+    [self postChangeForClass:className updatedIds:updatedIds removedIds:[NSSet set]];
+}
+
+-(void) removeRecordsWithIds: (NSArray*) objectIds inClass: (NSString*) className {
+    if ([objectIds count] == 0) {
+        return;
+    }
+    dispatch_sync(_queue, ^{
+        FLXStoreTable* table = [self tableForClass:className];
+        for (NSString* objectId in objectIds) {
+            [table removeRecordWithId:objectId];
+        }
+        [self scheduleSave];
+    });
+    [self postChangeForClass:className updatedIds:[NSSet set] removedIds:[NSSet setWithArray:objectIds]];
+}
+
+-(void) postChangeForClass: (NSString*) className updatedIds: (NSSet*) updatedIds removedIds: (NSSet*) removedIds {
+    NSDictionary* userInfo = @{FLXLocalStoreClassNameKey: className,
+                               FLXLocalStoreUpdatedIdsKey: updatedIds,
+                               FLXLocalStoreRemovedIdsKey: removedIds};
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:FLXLocalStoreDidChangeNotification object:self userInfo:userInfo];
+    });
+}
+
+#pragma mark - Sync
+
+-(void) syncClassName: (NSString*) className
+           completion: (void (^)(BOOL succeeded, NSError* error)) completion {
+    __block NSDate* since = nil;
+    dispatch_sync(_queue, ^{
+        since = [self tableForClass:className].lastSync;
+    });
+    [self syncClassName:className since:since cursor:nil cursorObjectId:nil fetchedIds:nil completion:completion];
+}
+
+-(void) resyncClassName: (NSString*) className
+             completion: (void (^)(BOOL succeeded, NSError* error)) completion {
+    [self syncClassName:className since:nil cursor:nil cursorObjectId:nil fetchedIds:[[NSMutableSet alloc] init]
+             completion:completion];
+}
+
+// Pages by (updatedAt, objectId) rather than skip, which Parse caps at
+// 10,000: each page starts after the last object of the previous one, in
+// that order, however many objects share an updatedAt. Objects deleted on
+// Parse are not reported by an updatedAt query; fetchedIds collects every
+// object of a full sync so the records without one can be dropped at the
+// end.
+-(void) syncClassName: (NSString*) className
+                since: (NSDate*) since
+               cursor: (NSDate*) cursor
+       cursorObjectId: (NSString*) cursorObjectId
+           fetchedIds: (NSMutableSet*) fetchedIds
+           completion: (void (^)(BOOL succeeded, NSError* error)) completion {
+    PFQuery* query = nil;
+    if (cursor) {
+        PFQuery* later = [PFQuery queryWithClassName:className];
+        [later whereKey:@"updatedAt" greaterThan:cursor];
+        PFQuery* tied = [PFQuery queryWithClassName:className];
+        [tied whereKey:@"updatedAt" equalTo:cursor];
+        [tied whereKey:@"objectId" greaterThan:cursorObjectId];
+        query = [PFQuery orQueryWithSubqueries:@[later, tied]];
+    }
+    else {
+        query = [PFQuery queryWithClassName:className];
+        if (since) {
+            [query whereKey:@"updatedAt" greaterThan:since];
+        }
+    }
+    [query orderByAscending:@"updatedAt"];
+    [query addAscendingOrder:@"objectId"];
+    query.limit = kFLXSyncPageSize;
+
+    [query findObjectsInBackgroundWithBlock:^(NSArray *objects, NSError *error) {
+        if (error) {
+            if (completion) {
+                completion(NO, error);
+            }
+            return;
+        }
+
+        NSMutableArray* records = [[NSMutableArray alloc] initWithCapacity:[objects count]];
+        for (PFObject* object in objects) {
+            [records addObject:[FLXLocalStore recordFromObject:object]];
+            [fetchedIds addObject:object.objectId];
+        }
+        PFObject* last = [objects lastObject];
+        NSDate* nextCursor = last ? last.updatedAt : cursor;
+        [self putRecords:records inClass:className];
+
+        if ([objects count] == kFLXSyncPageSize) {
+            [self syncClassName:className since:since cursor:nextCursor cursorObjectId:last.objectId fetchedIds:fetchedIds
+                     completion:completion];
+            return;
+        }
+
+        if (fetchedIds) {
+            NSMutableArray* deletedIds = [[NSMutableArray alloc] init];
+            for (NSDictionary* record in [self allRecordsInClass:className]) {
+                if (![fetchedIds containsObject:record[@"objectId"]]) {
+                    [deletedIds addObject:record[@"objectId"]];
+                }
+            }
+            [self removeRecordsWithIds:deletedIds inClass:className];
+        }
+
+        dispatch_sync(self->_queue, ^{
+            FLXStoreTable* table = [self tableForClass:className];
+            table.synced = YES;
+            table.lastSync = nextCursor ? nextCursor : since;
+            table.dirty = YES;
+            [self scheduleSave];
+        });
+        if (completion) {
+            completion(YES, nil);
+        }
+    }];
+}
+
+#pragma mark - Persistence
+
+-(NSString*) pathForClass: (NSString*) className {
+    return [[_directory stringByAppendingPathComponent:className] stringByAppendingPathExtension:@"plist"];
+}
+
+// Must be called on _queue
+-(FLXStoreTable*) loadTableForClass: (NSString*) className {
+    if (!_directory) {
+        return nil;
+    }
+    NSData* data = [NSData dataWithContentsOfFile:[self pathForClass:className]];
+    if (!data) {
+        return nil;
+    }
+    NSDictionary* saved = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:NULL];
+    if (![saved isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+
+    FLXStoreTable* table = [[FLXStoreTable alloc] init];
+    table.synced = [saved[@"synced"] boolValue];
+    table.localOnly = [saved[@"localOnly"] boolValue];
+    table.lastSync = saved[@"lastSync"];
+    for (NSDictionary* record in saved[@"records"]) {
+        [table putRecord:record];
+    }
+    table.dirty = NO;
+    return table;
+}
+
+// Must be called on _queue
+-(void) scheduleSave {
+    if (!_directory || _saveScheduled) {
+        return;
+    }
+    _saveScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kFLXSaveDelay * NSEC_PER_SEC)), _queue, ^{
+        self->_saveScheduled = NO;
+        [self saveDirtyTables];
+    });
+}
+
+// Must be called on _queue
+-(void) saveDirtyTables {
+    [_tables enumerateKeysAndObjectsUsingBlock:^(NSString* className, FLXStoreTable* table, BOOL *stop) {
+        if (!table.dirty) {
+            return;
+        }
+        NSMutableDictionary* saved = [[NSMutableDictionary alloc] init];
+        saved[@"synced"] = @(table.synced);
+        saved[@"localOnly"] = @(table.localOnly);
+        if (table.lastSync) {
+            saved[@"lastSync"] = table.lastSync;
+        }
+        saved[@"records"] = [table liveRecords];
+
+        NSError* error = nil;
+        NSData* data = [NSPropertyListSerialization dataWithPropertyList:saved format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+        if (data && [data writeToFile:[self pathForClass:className] atomically:YES]) {
+            table.dirty = NO;
+        }
+        else {
+            NSLog(@"Failed to save local store class %@: %@", className, error);
+        }
+    }];
+}
+
+-(void) flush {
+    if (!_directory) {
+        return;
+    }
+    dispatch_sync(_queue, ^{
+        [self saveDirtyTables];
+    });
+}
+
+@end
@@ -0,0 +1,67 @@
+//
+//  FLXLocationAudit.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "FLXLocalStore.h"
+
+@class RfidTag;
+@class FLXScan;
+
+typedef NS_ENUM(NSInteger, FLXAuditScanResult) {
+    FLXAuditScanFound,                  // expected here, first read
+    FLXAuditScanDuplicate,              // expected here, already found
+    FLXAuditScanUnexpected,             // not expected here, first read
+    FLXAuditScanUnexpectedDuplicate,    // not expected here, already reported
+    FLXAuditScanInvalid                 // not a usable tag id
+};
+
+// The outcome of a location audit. Items are local store records.
+@interface FLXAuditReport : NSObject
+@property (nonatomic, readonly) NSString* locationID;
+@property (nonatomic, readonly) NSDate* startedAt;
+@property (nonatomic, readonly) NSDate* finishedAt;
+@property (nonatomic, readonly) NSUInteger readCount;
+@property (nonatomic, readonly) NSArray* foundItems;
+@property (nonatomic, readonly) NSArray* missingItems;
+// Tag ids read at the location that belong to no item expected there,
+// formatted like itemID.
+@property (nonatomic, readonly) NSArray* unexpectedTagIds;
+@end
+
+// FLXLocationAudit is a cycle count of one location: it loads the tags of the
+// items whose locationID matches into a compact hash set (Core/LocationAudit.h)
+// and reconciles reads against it as they arrive, keeping the found, missing
+// and unexpected counts current in constant time per read.
+//
+// FLXCheckInOutController runs one while the user audits a location, feeding
+// it the scans FLXScannerBus delivers.
+//
+// Not thread safe; feed it from the reader's callback thread.
+@interface FLXLocationAudit : NSObject
+
+@property (nonatomic, readonly) NSString* locationID;
+@property (nonatomic, readonly) NSUInteger expectedCount;
+@property (nonatomic, readonly) NSUInteger foundCount;
+@property (nonatomic, readonly) NSUInteger missingCount;
+@property (nonatomic, readonly) NSUInteger unexpectedCount;
+@property (nonatomic, readonly) NSUInteger readCount;
+
+-(id) initWithLocationID: (NSString*) locationID store: (FLXLocalStore*) store;
+
+-(FLXAuditScanResult) recordTag: (RfidTag*) tag;
+-(FLXAuditScanResult) recordTagBytes: (const uint8_t*) bytes length: (NSUInteger) length;
+// A tag id in hex, as stored in itemID or shown by CByteArray toString
+-(FLXAuditScanResult) recordTagId: (NSString*) tagId;
+// A scan from FLXScannerBus: EPC tags by their bytes, asset labels (Code 128,
+// QR) by the tag id printed on them. Product barcodes are invalid.
+-(FLXAuditScanResult) recordScan: (FLXScan*) scan;
+
+// Build the discrepancy report. The audit can keep taking reads afterwards.
+-(FLXAuditReport*) finish;
+
+@end
@@ -0,0 +1,145 @@
+//
+//  FLXLocationAudit.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXLocationAudit.h"
+#import "FLXScannerBus.h"
+#import <IDBLUE/RfidTag.h>
+#include "LocationAudit.h"
+
+static BOOL FLXTagKeyFromString(NSString* tagId, flx::TagKey& key) {
+    if (![tagId isKindOfClass:[NSString class]]) {
+        return NO;
+    }
+    const char* hex = [tagId UTF8String];
+    return hex && flx::tagKeyFromHex(hex, strlen(hex), key);
+}
+
+static FLXAuditScanResult FLXScanResult(flx::AuditOutcome outcome) {
+    switch (outcome) {
+        case flx::kAuditFound:               return FLXAuditScanFound;
+        case flx::kAuditDuplicate:           return FLXAuditScanDuplicate;
+        case flx::kAuditUnexpected:          return FLXAuditScanUnexpected;
+        case flx::kAuditUnexpectedDuplicate: return FLXAuditScanUnexpectedDuplicate;
+    }
+    return FLXAuditScanInvalid;
+}
+
+@interface FLXAuditReport ()
+@property (nonatomic, readwrite) NSString* locationID;
+@property (nonatomic, readwrite) NSDate* startedAt;
+@property (nonatomic, readwrite) NSDate* finishedAt;
+@property (nonatomic, readwrite) NSUInteger readCount;
+@property (nonatomic, readwrite) NSArray* foundItems;
+@property (nonatomic, readwrite) NSArray* missingItems;
+@property (nonatomic, readwrite) NSArray* unexpectedTagIds;
+@end
+
+@implementation FLXAuditReport
+@end
+
+
+@interface FLXLocationAudit () {
+    flx::LocationAudit _audit;
+    NSArray* _expectedItems;
+    NSDate* _startedAt;
+}
+@end
+
+@implementation FLXLocationAudit
+
+-(id) initWithLocationID: (NSString*) locationID store: (FLXLocalStore*) store {
+    self = [super init];
+    if (self) {
+        _locationID = [locationID copy];
+        _startedAt = [NSDate date];
+
+        [store ensureIndexForKey:@"locationID" inClass:@"Items"];
+        _expectedItems = [store recordsInClass:@"Items" withKey:@"locationID" inValues:@[locationID]];
+
+        _audit = flx::LocationAudit([_expectedItems count]);
+        for (NSDictionary* item in _expectedItems) {
+            flx::TagKey key;
+            if (FLXTagKeyFromString(item[@"itemID"], key)) {
+                _audit.addExpected(key);
+            }
+            else {
+                NSLog(@"Audit of %@: item %@ has no usable itemID", locationID, item[@"objectId"]);
+            }
+        }
+    }
+    return self;
+}
+
+-(NSUInteger) expectedCount   { return _audit.expectedCount(); }
+-(NSUInteger) foundCount      { return _audit.foundCount(); }
+-(NSUInteger) missingCount    { return _audit.missingCount(); }
+-(NSUInteger) unexpectedCount { return _audit.unexpectedCount(); }
+-(NSUInteger) readCount       { return _audit.readCount(); }
+
+-(FLXAuditScanResult) recordTag: (RfidTag*) tag {
+    if (!tag) {
+        return FLXAuditScanInvalid;
+    }
+    return [self recordTagBytes:[tag data] length:[tag arrayLength]];
+}
+
+-(FLXAuditScanResult) recordTagBytes: (const uint8_t*) bytes length: (NSUInteger) length {
+    flx::TagKey key;
+    if (!bytes || !flx::tagKeyFromBytes(bytes, length, key)) {
+        return FLXAuditScanInvalid;
+    }
+    return FLXScanResult(_audit.recordRead(key));
+}
+
+-(FLXAuditScanResult) recordTagId: (NSString*) tagId {
+    flx::TagKey key;
+    if (!FLXTagKeyFromString(tagId, key)) {
+        return FLXAuditScanInvalid;
+    }
+    return FLXScanResult(_audit.recordRead(key));
+}
+
+-(FLXAuditScanResult) recordScan: (FLXScan*) scan {
+    if (![scan isItemCode]) {
+        return FLXAuditScanInvalid;
+    }
+    if (scan.symbology == FLXSymbologyEpc) {
+        return [self recordTagBytes:(const uint8_t*) [scan.data bytes] length:[scan.data length]];
+    }
+    return [self recordTagId:scan.text];
+}
+
+-(FLXAuditReport*) finish {
+    NSMutableArray* found = [[NSMutableArray alloc] initWithCapacity:_audit.foundCount()];
+    NSMutableArray* missing = [[NSMutableArray alloc] initWithCapacity:_audit.missingCount()];
+    for (NSDictionary* item in _expectedItems) {
+        flx::TagKey key;
+        if (!FLXTagKeyFromString(item[@"itemID"], key)) {
+            continue;
+        }
+        [(_audit.isFound(key) ? found : missing) addObject:item];
+    }
+
+    std::vector<flx::TagKey> unexpectedKeys = _audit.unexpectedKeys();
+    NSMutableArray* unexpected = [[NSMutableArray alloc] initWithCapacity:unexpectedKeys.size()];
+    for (size_t i = 0; i < unexpectedKeys.size(); i++) {
+        [unexpected addObject:[NSString stringWithUTF8String:flx::tagKeyToHex(unexpectedKeys[i]).c_str()]];
+    }
+
+    FLXAuditReport* report = [[FLXAuditReport alloc] init];
+    report.locationID = _locationID;
+    report.startedAt = _startedAt;
+    report.finishedAt = [NSDate date];
+    report.readCount = _audit.readCount();
+    report.foundItems = found;
+    report.missingItems = missing;
+    report.unexpectedTagIds = unexpected;
+    return report;
+}
+
+@end
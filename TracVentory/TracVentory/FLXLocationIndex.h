@@ -0,0 +1,44 @@
+//
+//  FLXLocationIndex.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+#import "FLXLocalStore.h"
+
+// Location key holding its coordinates (a PFGeoPoint on Parse, a
+// "__type": "GeoPoint" dictionary in FLXLocalStore records)
+extern NSString* const FLXLocationGeoPointKey;
+
+// FLXLocationIndex finds the locations nearest a coordinate from the local
+// store, without the round trip of a whereKey:nearGeoPoint: query, so it
+// answers offline and in microseconds. It wraps flx::GeoIndex
+// (Core/GeoIndex.h), a geohash index of the synced locations' coordinates,
+// keeps it current from FLXLocalStoreDidChangeNotification, and runs
+// queries on its own serial queue. Locations without coordinates are left
+// out.
+@interface FLXLocationIndex : NSObject
+
+// Index over the Locations class of the shared local store
++(FLXLocationIndex*) sharedIndex;
+
+// Starts building the index from the records already in the store.
+-(id) initWithStore: (FLXLocalStore*) store className: (NSString*) className;
+
+// objectIds of up to limit locations within meters of coordinate, nearest
+// first. Blocks until any pending index updates have been applied.
+-(NSArray*) objectIdsNearestToCoordinate: (CLLocationCoordinate2D) coordinate
+                                   limit: (NSUInteger) limit
+                            withinMeters: (CLLocationDistance) meters;
+
+// The record of the location nearest coordinate and how far it is.
+// completion runs on the main queue, with nil if none is within meters.
+-(void) nearestLocationToCoordinate: (CLLocationCoordinate2D) coordinate
+                       withinMeters: (CLLocationDistance) meters
+                         completion: (void (^)(NSDictionary* location, CLLocationDistance distance)) completion;
+
+@end
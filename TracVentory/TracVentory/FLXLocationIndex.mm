@@ -0,0 +1,141 @@
+//
+//  FLXLocationIndex.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXLocationIndex.h"
+#include "GeoIndex.h"
+
+NSString* const FLXLocationGeoPointKey = @"geoPoint";
+
+@interface FLXLocationIndex () {
+    FLXLocalStore* _store;
+    NSString* _className;
+    dispatch_queue_t _queue;
+    flx::GeoIndex _index;
+}
+@end
+
+@implementation FLXLocationIndex
+
++(FLXLocationIndex*) sharedIndex {
+    static FLXLocationIndex* sharedIndex = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedIndex = [[FLXLocationIndex alloc] initWithStore:[FLXLocalStore sharedStore] className:@"Locations"];
+    });
+    return sharedIndex;
+}
+
+-(id) initWithStore: (FLXLocalStore*) store className: (NSString*) className {
+    self = [super init];
+    if (self) {
+        _store = store;
+        _className = [className copy];
+        _queue = dispatch_queue_create("com.filelogix.tracventory.locationindex", DISPATCH_QUEUE_SERIAL);
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(localStoreDidChange:)
+                                                     name:FLXLocalStoreDidChangeNotification
+                                                   object:store];
+
+        dispatch_async(_queue, ^{
+            for (NSDictionary* record in [self->_store allRecordsInClass:self->_className]) {
+                [self indexRecord:record];
+            }
+        });
+    }
+    return self;
+}
+
+-(void) dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+// Must be called on _queue. A location whose coordinates were cleared or
+// are not valid drops out of the index.
+-(void) indexRecord: (NSDictionary*) record {
+    NSString* objectId = record[@"objectId"];
+    if (!objectId) {
+        return;
+    }
+    id point = record[FLXLocationGeoPointKey];
+    BOOL indexed = NO;
+    if ([point isKindOfClass:[NSDictionary class]] && [point[@"__type"] isEqual:@"GeoPoint"]) {
+        id latitude = point[@"latitude"];
+        id longitude = point[@"longitude"];
+        if ([latitude isKindOfClass:[NSNumber class]] && [longitude isKindOfClass:[NSNumber class]]) {
+            indexed = _index.put([objectId UTF8String], [latitude doubleValue], [longitude doubleValue]);
+        }
+    }
+    if (!indexed) {
+        _index.remove([objectId UTF8String]);
+    }
+}
+
+-(void) localStoreDidChange: (NSNotification*) notification {
+    if (![notification.userInfo[FLXLocalStoreClassNameKey] isEqualToString:_className]) {
+        return;
+    }
+    NSSet* updatedIds = notification.userInfo[FLXLocalStoreUpdatedIdsKey];
+    NSSet* removedIds = notification.userInfo[FLXLocalStoreRemovedIdsKey];
+
+    dispatch_async(_queue, ^{
+        for (NSString* objectId in removedIds) {
+            self->_index.remove([objectId UTF8String]);
+        }
+        for (NSString* objectId in updatedIds) {
+            NSDictionary* record = [self->_store recordWithId:objectId inClass:self->_className];
+            if (record) {
+                [self indexRecord:record];
+            }
+        }
+    });
+}
+
+// Must be called on _queue
+-(std::vector<flx::GeoHit>) hitsNearCoordinate: (CLLocationCoordinate2D) coordinate
+                                         limit: (NSUInteger) limit
+                                  withinMeters: (CLLocationDistance) meters {
+    if (!CLLocationCoordinate2DIsValid(coordinate)) {
+        return std::vector<flx::GeoHit>();
+    }
+    return _index.nearest(coordinate.latitude, coordinate.longitude, limit, meters);
+}
+
+-(NSArray*) objectIdsNearestToCoordinate: (CLLocationCoordinate2D) coordinate
+                                   limit: (NSUInteger) limit
+                            withinMeters: (CLLocationDistance) meters {
+    __block std::vector<flx::GeoHit> hits;
+    dispatch_sync(_queue, ^{
+        hits = [self hitsNearCoordinate:coordinate limit:limit withinMeters:meters];
+    });
+    NSMutableArray* objectIds = [[NSMutableArray alloc] initWithCapacity:hits.size()];
+    for (size_t i = 0; i < hits.size(); i++) {
+        [objectIds addObject:[NSString stringWithUTF8String:hits[i].key.c_str()]];
+    }
+    return objectIds;
+}
+
+-(void) nearestLocationToCoordinate: (CLLocationCoordinate2D) coordinate
+                       withinMeters: (CLLocationDistance) meters
+                         completion: (void (^)(NSDictionary* location, CLLocationDistance distance)) completion {
+    dispatch_async(_queue, ^{
+        std::vector<flx::GeoHit> hits = [self hitsNearCoordinate:coordinate limit:1 withinMeters:meters];
+        NSDictionary* location = nil;
+        CLLocationDistance distance = 0;
+        if (!hits.empty()) {
+            location = [self->_store recordWithId:[NSString stringWithUTF8String:hits[0].key.c_str()]
+                                          inClass:self->_className];
+            distance = hits[0].meters;
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(location, distance);
+        });
+    });
+}
+
+@end
@@ -8,7 +8,12 @@
 
 #import <UIKit/UIKit.h>
 
+@class FLXItemCursor;
+
 @interface FLXMasterViewController : UITableViewController
 
+// Rows shown by the list. Defaults to the Items class of the shared local
+// store, most recently updated first.
+@property (strong, nonatomic) FLXItemCursor* itemCursor;
 
 @end
@@ -8,13 +8,41 @@
 
 #import "FLXMasterViewController.h"
 #import "FLXDetailViewController.h"
+#import "FLXItemCursor.h"
+#import "FLXLocalStore.h"
+#import "FLXSearchIndex.h"
+#import "FLXThumbnailPipeline.h"
 #import <Parse/Parse.h>
 
+// Store notifications arriving within this interval are applied as one batch
+static const NSTimeInterval kFLXListCoalesceInterval = 0.1;
 
-@interface FLXMasterViewController () <UIActionSheetDelegate, UITabBarControllerDelegate, UITabBarDelegate> {
-    NSMutableArray *_objects;
+// Search results shown for the text in the search bar
+static const NSUInteger kFLXSearchResultLimit = 200;
+
+// Rows past the visible ones whose thumbnails are fetched ahead of scrolling
+static const NSInteger kFLXPrefetchRows = 20;
+
+// Side of a row's image, in points
+static const CGFloat kFLXThumbnailPoints = 40;
+
+
+@interface FLXMasterViewController () <UIActionSheetDelegate, UITabBarControllerDelegate, UITabBarDelegate, UISearchBarDelegate> {
     UIActionSheet * actionSheetDelete;
 
+    NSMutableSet* _pendingUpdatedIds;
+    NSMutableSet* _pendingRemovedIds;
+    BOOL _applyScheduled;
+
+    // Non-nil while the search bar has text; the table then shows these
+    // records instead of the cursor.
+    NSArray* _searchRecords;
+    NSArray* _searchModels;
+
+    // Where thumbnails were last prefetched from
+    CGFloat _lastContentOffset;
+    NSInteger _lastPrefetchRow;
+    UIImage* _placeholderImage;
 }
 @end
 
@@ -40,6 +68,33 @@
 
     NSLog(@"%@", [self.tabBarController.tabBar items]);
 
+    _pendingUpdatedIds = [[NSMutableSet alloc] init];
+    _pendingRemovedIds = [[NSMutableSet alloc] init];
+    _lastPrefetchRow = NSNotFound;
+
+    if (!self.itemCursor) {
+        self.itemCursor = [[FLXItemCursor alloc] initWithStore:[FLXLocalStore sharedStore]
+                                                     className:@"Items"
+                                               sortDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"updatedAt" ascending:NO]]];
+    }
+
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(localStoreDidChange:)
+                                                 name:FLXLocalStoreDidChangeNotification
+                                               object:nil];
+
+    if ([self.tableView.tableHeaderView isKindOfClass:[UISearchBar class]]) {
+        ((UISearchBar *)self.tableView.tableHeaderView).delegate = self;
+    }
+
+    [self.itemCursor reloadWithCompletion:^{
+        [self.tableView reloadData];
+    }];
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
 }
 
 - (void)viewDidAppear:(BOOL)animated {
@@ -68,14 +123,118 @@
     // Dispose of any resources that can be recreated.
 }
 
-- (void)insertNewObject:(id)sender
+#pragma mark - Local Store
+
+- (void)localStoreDidChange:(NSNotification *)notification
 {
-    if (!_objects) {
-        _objects = [[NSMutableArray alloc] init];
+    if (![notification.userInfo[FLXLocalStoreClassNameKey] isEqualToString:@"Items"]) {
+        return;
     }
-    [_objects insertObject:[NSDate date] atIndex:0];
-    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:0 inSection:0];
-    [self.tableView insertRowsAtIndexPaths:@[indexPath] withRowAnimation:UITableViewRowAnimationAutomatic];
+
+    // A sync delivers one notification per page; collect them and update the
+    // table once.
+    NSSet *updatedIds = notification.userInfo[FLXLocalStoreUpdatedIdsKey];
+    NSSet *removedIds = notification.userInfo[FLXLocalStoreRemovedIdsKey];
+    if (updatedIds) {
+        [_pendingRemovedIds minusSet:updatedIds];
+        [_pendingUpdatedIds unionSet:updatedIds];
+    }
+    if (removedIds) {
+        [_pendingUpdatedIds minusSet:removedIds];
+        [_pendingRemovedIds unionSet:removedIds];
+    }
+
+    if (!_applyScheduled) {
+        _applyScheduled = YES;
+        [self performSelector:@selector(applyPendingChanges) withObject:nil afterDelay:kFLXListCoalesceInterval];
+    }
+}
+
+- (void)applyPendingChanges
+{
+    _applyScheduled = NO;
+    if ([_pendingUpdatedIds count] == 0 && [_pendingRemovedIds count] == 0) {
+        return;
+    }
+
+    NSSet *updatedIds = [_pendingUpdatedIds copy];
+    NSSet *removedIds = [_pendingRemovedIds copy];
+    [_pendingUpdatedIds removeAllObjects];
+    [_pendingRemovedIds removeAllObjects];
+
+    [self.itemCursor applyUpdatedIds:updatedIds removedIds:removedIds completion:^(FLXItemCursorDiff *diff) {
+        if (_searchRecords) {
+            // Rows are search results; the cursor diff does not apply to them
+            [self runSearch];
+            return;
+        }
+        if ([diff isEmpty]) {
+            return;
+        }
+        [self.tableView beginUpdates];
+        [self.tableView deleteRowsAtIndexPaths:[self indexPathsForRows:diff.deletedRows] withRowAnimation:UITableViewRowAnimationFade];
+        [self.tableView insertRowsAtIndexPaths:[self indexPathsForRows:diff.insertedRows] withRowAnimation:UITableViewRowAnimationAutomatic];
+        [self.tableView reloadRowsAtIndexPaths:[self indexPathsForRows:diff.reloadedRows] withRowAnimation:UITableViewRowAnimationNone];
+        [self.tableView endUpdates];
+    }];
+}
+
+- (NSArray *)indexPathsForRows:(NSIndexSet *)rows
+{
+    NSMutableArray *indexPaths = [[NSMutableArray alloc] initWithCapacity:[rows count]];
+    [rows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        [indexPaths addObject:[NSIndexPath indexPathForRow:row inSection:0]];
+    }];
+    return indexPaths;
+}
+
+#pragma mark - Search
+
+- (void)searchBar:(UISearchBar *)searchBar textDidChange:(NSString *)searchText
+{
+    if ([searchText length] == 0) {
+        _searchRecords = nil;
+        _searchModels = nil;
+        [self.tableView reloadData];
+        return;
+    }
+    [self runSearch];
+}
+
+- (void)searchBarSearchButtonClicked:(UISearchBar *)searchBar
+{
+    [searchBar resignFirstResponder];
+}
+
+- (void)runSearch
+{
+    UISearchBar *searchBar = (UISearchBar *)self.tableView.tableHeaderView;
+    NSString *searchText = searchBar.text;
+    [[FLXSearchIndex sharedIndex] searchText:searchText limit:kFLXSearchResultLimit completion:^(NSArray *objectIds) {
+        if (![searchBar.text isEqualToString:searchText]) {
+            return;
+        }
+        NSMutableArray *records = [[NSMutableArray alloc] initWithCapacity:[objectIds count]];
+        NSMutableArray *models = [[NSMutableArray alloc] initWithCapacity:[objectIds count]];
+        for (NSString *objectId in objectIds) {
+            NSDictionary *record = [[FLXLocalStore sharedStore] recordWithId:objectId inClass:@"Items"];
+            if (record) {
+                [records addObject:record];
+                [models addObject:[[FLXItemCellModel alloc] initWithRecord:record]];
+            }
+        }
+        _searchRecords = records;
+        _searchModels = models;
+        [self.tableView reloadData];
+    }];
+}
+
+- (NSDictionary *)recordAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (_searchRecords) {
+        return indexPath.row < [_searchRecords count] ? _searchRecords[indexPath.row] : nil;
+    }
+    return [self.itemCursor recordAtIndex:indexPath.row];
 }
 
 #pragma mark - Table View
@@ -87,18 +246,92 @@
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section
 {
-    return _objects.count;
+    return _searchRecords ? [_searchRecords count] : self.itemCursor.count;
 }
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
 {
     UITableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:@"Cell" forIndexPath:indexPath];
 
-    NSDate *object = _objects[indexPath.row];
-    cell.textLabel.text = [object description];
+    FLXItemCellModel *model = _searchModels ? _searchModels[indexPath.row] : [self.itemCursor cellModelAtIndex:indexPath.row];
+    cell.textLabel.text = model.title;
+    cell.detailTextLabel.text = model.subtitle;
+
+    // Only thumbnails are shown, never a photo; one still being fetched
+    // holds its place so the text does not shift when it arrives
+    NSDictionary *record = [self recordAtIndexPath:indexPath];
+    FLXThumbnailPipeline *thumbnails = [FLXThumbnailPipeline sharedPipeline];
+    if ([thumbnails recordHasPhoto:record]) {
+        UIImage *thumbnail = [thumbnails cachedThumbnailForRecord:record];
+        cell.imageView.image = thumbnail ?: [self placeholderImage];
+        if (!thumbnail) {
+            NSString *objectId = record[@"objectId"];
+            [thumbnails thumbnailForRecord:record completion:^(UIImage *image) {
+                [self showThumbnail:image forObjectId:objectId];
+            }];
+        }
+    }
+    else {
+        cell.imageView.image = nil;
+    }
     return cell;
 }
 
+#pragma mark - Thumbnails
+
+- (UIImage *)placeholderImage
+{
+    if (!_placeholderImage) {
+        UIGraphicsBeginImageContextWithOptions(CGSizeMake(kFLXThumbnailPoints, kFLXThumbnailPoints), NO, 0);
+        _placeholderImage = UIGraphicsGetImageFromCurrentImageContext();
+        UIGraphicsEndImageContext();
+    }
+    return _placeholderImage;
+}
+
+- (void)showThumbnail:(UIImage *)image forObjectId:(NSString *)objectId
+{
+    if (!image) {
+        return;
+    }
+    for (NSIndexPath *indexPath in [self.tableView indexPathsForVisibleRows]) {
+        if ([[self recordAtIndexPath:indexPath][@"objectId"] isEqualToString:objectId]) {
+            UITableViewCell *cell = [self.tableView cellForRowAtIndexPath:indexPath];
+            cell.imageView.image = image;
+            [cell setNeedsLayout];
+        }
+    }
+}
+
+// Fetch the thumbnails of the rows about to scroll into view, in the
+// direction of travel, each time a new row appears
+- (void)scrollViewDidScroll:(UIScrollView *)scrollView
+{
+    NSArray *visible = [self.tableView indexPathsForVisibleRows];
+    if ([visible count] == 0) {
+        return;
+    }
+    BOOL down = scrollView.contentOffset.y >= _lastContentOffset;
+    _lastContentOffset = scrollView.contentOffset.y;
+    NSInteger edge = down ? [[visible lastObject] row] : [[visible firstObject] row];
+    if (edge == _lastPrefetchRow) {
+        return;
+    }
+    _lastPrefetchRow = edge;
+
+    NSInteger rows = [self tableView:self.tableView numberOfRowsInSection:0];
+    NSInteger first = down ? edge + 1 : MAX(edge - kFLXPrefetchRows, 0);
+    NSInteger end = down ? MIN(edge + 1 + kFLXPrefetchRows, rows) : edge;
+    NSMutableArray *records = [NSMutableArray arrayWithCapacity:kFLXPrefetchRows];
+    for (NSInteger row = first; row < end; row++) {
+        NSDictionary *record = [self recordAtIndexPath:[NSIndexPath indexPathForRow:row inSection:0]];
+        if (record) {
+            [records addObject:record];
+        }
+    }
+    [[FLXThumbnailPipeline sharedPipeline] prefetchThumbnailsForRecords:records];
+}
+
 - (BOOL)tableView:(UITableView *)tableView canEditRowAtIndexPath:(NSIndexPath *)indexPath
 {
     // Return NO if you do not want the specified item to be editable.
@@ -108,8 +341,12 @@
 - (void)tableView:(UITableView *)tableView commitEditingStyle:(UITableViewCellEditingStyle)editingStyle forRowAtIndexPath:(NSIndexPath *)indexPath
 {
     if (editingStyle == UITableViewCellEditingStyleDelete) {
-        [_objects removeObjectAtIndex:indexPath.row];
-        [tableView deleteRowsAtIndexPaths:@[indexPath] withRowAnimation:UITableViewRowAnimationFade];
+        // The row goes away with the next batch of store changes
+        NSString *objectId = [self recordAtIndexPath:indexPath][@"objectId"];
+        if (objectId) {
+            [[FLXLocalStore sharedStore] removeRecordsWithIds:@[objectId] inClass:@"Items"];
+            [[PFObject objectWithoutDataWithClassName:@"Items" objectId:objectId] deleteEventually];
+        }
     } else if (editingStyle == UITableViewCellEditingStyleInsert) {
         // Create a new instance of the appropriate class, insert it into the array, and add a new row to the table view.
     }
@@ -135,8 +372,8 @@
 {
     if ([[segue identifier] isEqualToString:@"showDetail"]) {
         NSIndexPath *indexPath = [self.tableView indexPathForSelectedRow];
-        NSDate *object = _objects[indexPath.row];
-        [[segue destinationViewController] setDetailItem:object];
+        NSDictionary *record = [self recordAtIndexPath:indexPath];
+        [[segue destinationViewController] setDetailItem:record];
     }
 }
 
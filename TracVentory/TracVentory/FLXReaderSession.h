@@ -0,0 +1,51 @@
+//
+//  FLXReaderSession.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <IDBLUE/iOSSession.h>
+
+// Counts from a capture replay
+@interface FLXReplayStats : NSObject
+@property (nonatomic, readonly) NSUInteger recordCount;
+@property (nonatomic, readonly) NSUInteger inboundBytes;
+@property (nonatomic, readonly) NSTimeInterval capturedDuration;
+@property (nonatomic, readonly) NSTimeInterval replayDuration;
+@property (nonatomic, readonly) BOOL truncated;
+@end
+
+// FLXReaderSession is the IDBLUE session the app talks through. It can record
+// the raw bytes of a session to a capture file (Core/SessionCapture.h), and
+// replay a capture back through the SDK's packet queue and response
+// processor as if a reader were sending it, so field problems can be
+// reproduced at the desk. The same files replay on Linux with
+// Core/Benchmarks/CaptureReplay.cpp.
+@interface FLXReaderSession : iOSSession
+
+@property (nonatomic, readonly) BOOL isCapturing;
+@property (nonatomic, readonly) BOOL isReplaying;
+
+// Start recording inbound (onDataReceived:withLen:) and outbound (write:)
+// bytes to path, replacing any existing file.
+-(BOOL) startCaptureToPath: (NSString*) path;
+-(void) stopCapture;
+
+// Serve the reader's tag events and raw bytes to local consumers with the
+// gateway protocol of Core/TagGateway.h, on 127.0.0.1:port and/or a Unix
+// socket path (0 / nil for neither).
+@property (nonatomic, readonly) BOOL isServingGateway;
+-(BOOL) startGatewayOnPort: (uint16_t) port unixSocketPath: (NSString*) path;
+-(void) stopGateway;
+
+// Replay the inbound records of a capture into onDataReceived:withLen: on
+// the main thread, where the input stream normally delivers them. speed 1.0
+// keeps the recorded pace, 0 replays as fast as the SDK can take it.
+-(BOOL) replayCaptureAtPath: (NSString*) path
+                      speed: (double) speed
+                 completion: (void (^)(FLXReplayStats* stats)) completion;
+
+@end
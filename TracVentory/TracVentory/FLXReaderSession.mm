@@ -0,0 +1,204 @@
+//
+//  FLXReaderSession.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXReaderSession.h"
+#import <IDBLUE/CByteArray.h>
+#include <memory>
+#include <vector>
+#include "SessionCapture.h"
+#include "TagGateway.h"
+
+// Records handed to the main thread per turn at maximum speed, so a replay
+// does not starve the UI
+static const size_t FLXReplayBatchSize = 256;
+
+@interface FLXReplayStats ()
+@property (nonatomic, readwrite) NSUInteger recordCount;
+@property (nonatomic, readwrite) NSUInteger inboundBytes;
+@property (nonatomic, readwrite) NSTimeInterval capturedDuration;
+@property (nonatomic, readwrite) NSTimeInterval replayDuration;
+@property (nonatomic, readwrite) BOOL truncated;
+@end
+
+@implementation FLXReplayStats
+@end
+
+
+// Decodes a copy of the inbound stream for the gateway. It sends nothing,
+// so only the reads IDBLUE sends on its own (button, continuous scan) come
+// out as tag events; answers to the SDK's commands pass through as raw.
+struct FLXGatewayTap : public flx::Transport {
+    flx::CommandSession decoder;
+    flx::TagGateway gateway;
+
+    FLXGatewayTap() : decoder(*this) {
+        decoder.addHandler(&gateway);
+    }
+    virtual void write(const uint8_t*, size_t) {}
+};
+
+@interface FLXReaderSession () {
+    flx::CaptureWriter _writer;
+    std::unique_ptr<FLXGatewayTap> _gateway;
+    dispatch_queue_t _replayQueue;
+    volatile BOOL _replaying;
+}
+@end
+
+@implementation FLXReaderSession
+
+-(id) init {
+    self = [super init];
+    if (self) {
+        _replayQueue = dispatch_queue_create("com.filelogix.tracventory.replay", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+-(void) dealloc {
+    _writer.close();
+    [self stopGateway];
+}
+
+-(BOOL) isCapturing {
+    return _writer.isOpen();
+}
+
+-(BOOL) isReplaying {
+    return _replaying;
+}
+
+-(BOOL) startCaptureToPath: (NSString*) path {
+    if (_writer.isOpen()) {
+        return NO;
+    }
+    if (!_writer.open([path fileSystemRepresentation])) {
+        NSLog(@"Cannot create capture %@", path);
+        return NO;
+    }
+    NSLog(@"Capturing reader session to %@", path);
+    return YES;
+}
+
+-(void) stopCapture {
+    if (_writer.isOpen()) {
+        NSLog(@"Captured %llu records, %llu bytes",
+              (unsigned long long) _writer.recordCount(), (unsigned long long) _writer.byteCount());
+    }
+    _writer.close();
+}
+
+#pragma mark - Gateway
+
+-(BOOL) isServingGateway {
+    return _gateway != nullptr;
+}
+
+-(BOOL) startGatewayOnPort: (uint16_t) port unixSocketPath: (NSString*) path {
+    if (_gateway) {
+        return NO;
+    }
+    std::unique_ptr<FLXGatewayTap> tap(new FLXGatewayTap());
+    if ((port && !tap->gateway.listenTcp(port)) ||
+        (path && !tap->gateway.listenUnix([path fileSystemRepresentation])) ||
+        !tap->gateway.start()) {
+        NSLog(@"Cannot start the tag gateway");
+        return NO;
+    }
+    NSLog(@"Serving tag events on port %u %@", port, path ?: @"");
+    _gateway = std::move(tap);
+    return YES;
+}
+
+-(void) stopGateway {
+    if (_gateway) {
+        _gateway->gateway.stop();
+        _gateway.reset();
+    }
+}
+
+#pragma mark - Session data
+
+-(void) onDataReceived: (byte*) data withLen: (size_t) len {
+    _writer.record(flx::kCaptureInbound, data, len);
+    if (_gateway) {
+        _gateway->gateway.publishRaw(data, len);
+        _gateway->decoder.onDataReceived(data, len);
+    }
+    [super onDataReceived:data withLen:len];
+}
+
+-(int) write: (CByteArray*) data {
+    _writer.record(flx::kCaptureOutbound, [data data], [data arrayLength]);
+    return [super write:data];
+}
+
+#pragma mark - Replay
+
+-(BOOL) replayCaptureAtPath: (NSString*) path
+                      speed: (double) speed
+                 completion: (void (^)(FLXReplayStats* stats)) completion {
+    if (_replaying) {
+        return NO;
+    }
+    std::shared_ptr<flx::CaptureReader> reader(new flx::CaptureReader());
+    if (!reader->open([path fileSystemRepresentation])) {
+        NSLog(@"Cannot read capture %@", path);
+        return NO;
+    }
+    _replaying = YES;
+
+    dispatch_async(_replayQueue, ^{
+        FLXReplayStats* stats = [[FLXReplayStats alloc] init];
+        std::vector<flx::CaptureRecord> batch;
+        batch.reserve(FLXReplayBatchSize);
+        std::vector<flx::CaptureRecord>* pending = &batch;
+        __block NSUInteger inboundBytes = 0;
+        uint64_t lastTimestamp = 0;
+
+        // Records point into the mapping, which outlives each synchronous hop
+        void (^deliver)(void) = ^{
+            for (size_t i = 0; i < pending->size(); i++) {
+                const flx::CaptureRecord& record = (*pending)[i];
+                inboundBytes += record.length;
+                [super onDataReceived:const_cast<byte*>(record.data) withLen:record.length];
+            }
+        };
+
+        NSDate* start = [NSDate date];
+        uint64_t count = flx::replayCapture(*reader, speed, [&](const flx::CaptureRecord& record) {
+            lastTimestamp = record.timestampNs;
+            if (record.direction != flx::kCaptureInbound) {
+                return;
+            }
+            batch.push_back(record);
+            if (speed > 0 || batch.size() == FLXReplayBatchSize) {
+                dispatch_sync(dispatch_get_main_queue(), deliver);
+                batch.clear();
+            }
+        });
+        if (!batch.empty()) {
+            dispatch_sync(dispatch_get_main_queue(), deliver);
+        }
+
+        stats.recordCount = (NSUInteger) count;
+        stats.inboundBytes = inboundBytes;
+        stats.capturedDuration = lastTimestamp / 1e9;
+        stats.replayDuration = -[start timeIntervalSinceNow];
+        stats.truncated = reader->truncated();
+        dispatch_async(dispatch_get_main_queue(), ^{
+            _replaying = NO;
+            if (completion) {
+                completion(stats);
+            }
+        });
+    });
+    return YES;
+}
+
+@end
@@ -0,0 +1,57 @@
+//
+//  FLXScanLatencyHarness.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class FLXReaderSession;
+
+// Latency distribution and frame drops of one harness run, in milliseconds
+@interface FLXScanLatencyReport : NSObject
+@property (nonatomic, readonly) NSUInteger scans;
+@property (nonatomic, readonly) NSUInteger observed;
+@property (nonatomic, readonly) double p50;
+@property (nonatomic, readonly) double p90;
+@property (nonatomic, readonly) double p99;
+@property (nonatomic, readonly) double max;
+@property (nonatomic, readonly) NSUInteger frames;
+@property (nonatomic, readonly) NSUInteger droppedFrames;
+@property (nonatomic, readonly) double longestFrame;
+@end
+
+// FLXScanLatencyHarness measures scan-to-screen latency. It presses the
+// reader's button at a controlled rate by injecting what IDBLUE sends for
+// one (an async Button packet, then the async tag read) into the session on
+// the main thread, where the accessory stream delivers bytes, and times each
+// scan until the UI-bound handler reports it with +tagObserved:length:. A
+// display link counts the frames the main thread misses meanwhile.
+//
+// Harness tags are recognisable (see Core/ScanLatency.h) and take the real
+// path up to the point a scan would be recorded; while a run is in progress
+// they never reach the check-in/out engine. Core/Benchmarks/ScanLatencyHarness.cpp runs the same
+// measurement on Linux against a simulated main thread.
+@interface FLXScanLatencyHarness : NSObject
+
+-(id) initWithSession: (FLXReaderSession*) session;
+
+@property (nonatomic, readonly) BOOL isRunning;
+
+// Inject count button scans at scansPerSecond, evenly spaced or (random)
+// as Poisson arrivals, then call completion on the main thread once every
+// scan was observed or a second after the last one went in. Returns NO if a
+// run is already in progress, in this or another harness.
+-(BOOL) runScans: (NSUInteger) count
+       perSecond: (double) scansPerSecond
+          random: (BOOL) random
+      completion: (void (^)(FLXScanLatencyReport* report)) completion;
+
+// Called by the UI-bound handler, on the main thread, once it has shown a
+// scanned tag. YES if it is a tag of the run in progress, which the handler
+// must not record further; NO for every tag while no run is in progress.
++(BOOL) tagObserved: (const uint8_t*) tagId length: (NSUInteger) length;
+
+@end
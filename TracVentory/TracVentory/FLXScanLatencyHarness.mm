@@ -0,0 +1,157 @@
+//
+//  FLXScanLatencyHarness.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXScanLatencyHarness.h"
+#import "FLXReaderSession.h"
+#import <QuartzCore/QuartzCore.h>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include "ScanLatency.h"
+
+static const double FLXFrameIntervalMs = 1000.0 / 60;
+
+// The run whose tags +tagObserved:length: looks for; main thread only
+static __weak FLXScanLatencyHarness* FLXActiveHarness;
+
+static uint64_t FLXNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+@interface FLXScanLatencyReport ()
+@property (nonatomic, readwrite) NSUInteger scans;
+@property (nonatomic, readwrite) NSUInteger observed;
+@property (nonatomic, readwrite) double p50;
+@property (nonatomic, readwrite) double p90;
+@property (nonatomic, readwrite) double p99;
+@property (nonatomic, readwrite) double max;
+@property (nonatomic, readwrite) NSUInteger frames;
+@property (nonatomic, readwrite) NSUInteger droppedFrames;
+@property (nonatomic, readwrite) double longestFrame;
+@end
+
+@implementation FLXScanLatencyReport
+
+-(NSString*) description {
+    return [NSString stringWithFormat:@"%lu/%lu scans, p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms, %lu frames, %lu dropped, longest %.1f ms",
+            (unsigned long) self.observed, (unsigned long) self.scans, self.p50, self.p90, self.p99, self.max,
+            (unsigned long) self.frames, (unsigned long) self.droppedFrames, self.longestFrame];
+}
+
+@end
+
+
+@interface FLXScanLatencyHarness () {
+    FLXReaderSession* _session;
+    std::unique_ptr<flx::ScanLatencyRecorder> _recorder;
+    dispatch_queue_t _injectQueue;
+    CADisplayLink* _displayLink;
+}
+@end
+
+@implementation FLXScanLatencyHarness
+
+-(id) initWithSession: (FLXReaderSession*) session {
+    self = [super init];
+    if (self) {
+        _session = session;
+        _injectQueue = dispatch_queue_create("com.filelogix.tracventory.scanlatency", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+-(BOOL) isRunning {
+    return _recorder != nullptr;
+}
+
++(BOOL) tagObserved: (const uint8_t*) tagId length: (NSUInteger) length {
+    // With no run in progress, a tag that happens to look like a probe is a
+    // real tag
+    FLXScanLatencyHarness* harness = FLXActiveHarness;
+    uint64_t index;
+    if (!harness || !harness->_recorder || !flx::scanProbeIndex(tagId, length, index)) {
+        return NO;
+    }
+    harness->_recorder->observed(index, FLXNowNs());
+    return YES;
+}
+
+-(void) displayRefreshed: (CADisplayLink*) link {
+    _recorder->frame(FLXNowNs());
+}
+
+-(BOOL) runScans: (NSUInteger) count
+       perSecond: (double) scansPerSecond
+          random: (BOOL) random
+      completion: (void (^)(FLXScanLatencyReport* report)) completion {
+    if (FLXActiveHarness || count == 0 || scansPerSecond <= 0) {
+        return NO;
+    }
+    _recorder.reset(new flx::ScanLatencyRecorder(count, FLXFrameIntervalMs));
+    flx::ScanLatencyRecorder* recorder = _recorder.get();
+    FLXActiveHarness = self;
+    _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayRefreshed:)];
+    [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+
+    FLXReaderSession* session = _session;
+    dispatch_async(_injectQueue, ^{
+        std::mt19937 generator(42);
+        std::exponential_distribution<double> gap(scansPerSecond);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        double due = 0;
+        for (NSUInteger i = 0; i < count; i++) {
+            due += random ? gap(generator) : 1 / scansPerSecond;
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(due)));
+
+            uint32_t second = static_cast<uint32_t>(due);
+            flx::ReaderTimestamp time = { 26, 10, 19, 12, static_cast<uint8_t>(second / 60 % 60), static_cast<uint8_t>(second % 60) };
+            std::shared_ptr<std::vector<uint8_t> > bytes(new std::vector<uint8_t>(2 * flx::kMaxPacketSize));
+            bytes->resize(flx::encodeButtonScan(i, time, bytes->data(), bytes->size()));
+            recorder->injected(i, FLXNowNs());
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [session onDataReceived:bytes->data() withLen:bytes->size()];
+            });
+        }
+
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (recorder->observedCount() < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self finishWithCompletion:completion];
+        });
+    });
+    return YES;
+}
+
+-(void) finishWithCompletion: (void (^)(FLXScanLatencyReport* report)) completion {
+    [_displayLink invalidate];
+    _displayLink = nil;
+    FLXActiveHarness = nil;
+
+    flx::ScanLatencyReport summary = _recorder->report();
+    _recorder.reset();
+    FLXScanLatencyReport* report = [[FLXScanLatencyReport alloc] init];
+    report.scans = summary.scans;
+    report.observed = summary.observed;
+    report.p50 = summary.p50Ms;
+    report.p90 = summary.p90Ms;
+    report.p99 = summary.p99Ms;
+    report.max = summary.maxMs;
+    report.frames = summary.frames;
+    report.droppedFrames = summary.droppedFrames;
+    report.longestFrame = summary.longestFrameMs;
+    NSLog(@"Scan latency: %@", report);
+    if (completion) {
+        completion(report);
+    }
+}
+
+@end
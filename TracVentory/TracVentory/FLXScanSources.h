@@ -0,0 +1,66 @@
+//
+//  FLXScanSources.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <AVFoundation/AVFoundation.h>
+#import "FLXScannerBus.h"
+
+@class IDBlueSdk;
+@class FLXBarcodeScanner;
+
+// The IDBLUE pen. Button scans are published with the pen's own timestamp.
+// The session is opened when the source starts and stays open whether or
+// not a pen is paired yet.
+@interface FLXIDBlueScanSource : NSObject <FLXScanSource>
+
+// Valid once started
+@property (nonatomic, readonly) IDBlueSdk* idBlue;
+
+// Read the tag in front of the pen now, as its button does. completion runs
+// on the main queue with whether a tag was read and published.
+-(BOOL) scanWithCompletion: (void (^)(BOOL read)) completion;
+
+@end
+
+// The back camera, through FLXBarcodeScanner. The camera is only on between
+// startCamera and stopCamera, which a screen calls while it shows the preview.
+@interface FLXCameraScanSource : NSObject <FLXScanSource>
+
+@property (nonatomic, readonly) FLXBarcodeScanner* barcodeScanner;
+@property (nonatomic, readonly) AVCaptureVideoPreviewLayer* previewLayer;
+@property (nonatomic, readonly) BOOL isCameraRunning;
+
+// NO if there is no camera or it may not be used
+-(BOOL) startCamera;
+-(void) stopCamera;
+
+@end
+
+// A scanner for tests and demos: it publishes whatever it is told to, as
+// the source type it plays.
+@interface FLXSimulatedScanSource : NSObject <FLXScanSource>
+
+-(id) initWithSourceType: (FLXScanSourceType) sourceType readerID: (NSString*) readerID;
+
+// NO if the bus dropped the scan, or tagId is not hex
+-(BOOL) scanTagId: (NSString*) tagId;
+-(BOOL) scanBarcode: (NSString*) text symbology: (FLXSymbology) symbology;
+
+// Scan each code in turn, perSecond of them a second, from a background
+// queue; tag ids when symbology is FLXSymbologyEpc. completion runs on the
+// main queue after the last.
+-(void) playCodes: (NSArray*) codes
+        symbology: (FLXSymbology) symbology
+        perSecond: (double) perSecond
+       completion: (void (^)(void)) completion;
+
+@end
+
+// A Linea Pro sled would publish as FLXScanSourceLinea: barcodes with their
+// symbology and tags from its RFID head as FLXSymbologyEpc. Its SDK is not
+// part of the project yet.
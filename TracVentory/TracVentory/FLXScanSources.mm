@@ -0,0 +1,266 @@
+//
+//  FLXScanSources.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXScanSources.h"
+#import "IDBlueSdk.h"
+#import "FLXBarcodeScanner.h"
+#import "FLXTimestamp.h"
+#include "TraceLog.h"
+
+#pragma mark - IDBLUE
+
+@interface FLXIDBlueScanSource ()
+@property (nonatomic, readwrite) IDBlueSdk* idBlue;
+@property (nonatomic, weak) FLXScannerBus* bus;
+@end
+
+@implementation FLXIDBlueScanSource
+
+-(FLXScanSourceType) sourceType {
+    return FLXScanSourceIDBlue;
+}
+
+-(NSString*) readerID {
+    return [self.idBlue readerID];
+}
+
+-(BOOL) startWithBus: (FLXScannerBus*) bus {
+    self.bus = bus;
+    self.idBlue = [[IDBlueSdk alloc] init];
+
+    // Only button scans come this way; commands sent answer their own completions
+    __weak FLXIDBlueScanSource* weakSelf = self;
+    self.idBlue.tagScanned = ^(ReadTagIdResponse* response) {
+        [weakSelf publishResponse:response];
+    };
+
+    if ([self.idBlue openIDBlueSession]) {
+        NSLog(@"ID Blue Session Opened");
+    }
+    else {
+        NSLog(@"ID Blue Session Not Found");
+    }
+    return YES;
+}
+
+-(void) stop {
+    self.idBlue.tagScanned = nil;
+    [self.idBlue closeIDBlueSession];
+    self.bus = nil;
+}
+
+-(BOOL) publishResponse: (ReadTagIdResponse*) response {
+    RfidTag* tag = [response rfidTag];
+    if (!tag) {
+        FLX_TRACE("Scan response without a tag");
+        return NO;
+    }
+    FLX_TRACE("Scanned %s", flx::TraceHex([tag data], [tag arrayLength]));
+    return [self.bus publishBytes:[tag data]
+                           length:[tag arrayLength]
+                        symbology:FLXSymbologyEpc
+                           source:FLXScanSourceIDBlue
+                         scanTime:[FLXTimestamp dateForTimestamp:[response scanTime]]];
+}
+
+-(BOOL) scanWithCompletion: (void (^)(BOOL read)) completion {
+    __weak FLXIDBlueScanSource* weakSelf = self;
+    return [self.idBlue readTagIdWithCompletion:^(ReadTagIdResponse* response, NackResponse* nack) {
+        BOOL read = NO;
+        if (response) {
+            read = [weakSelf publishResponse:response];
+        }
+        else {
+            FLX_TRACE("ReadTagId failed with status 0x%x", nack ? [nack status] : 0);
+        }
+        if (completion) {
+            completion(read);
+        }
+    }];
+}
+
+@end
+
+
+#pragma mark - Camera
+
+static FLXSymbology FLXSymbologyForBarcodeType(FLXBarcodeType type) {
+    switch (type) {
+        case FLXBarcodeEan8:        return FLXSymbologyEan8;
+        case FLXBarcodeUpcA:        return FLXSymbologyUpcA;
+        case FLXBarcodeCode128:     return FLXSymbologyCode128;
+        case FLXBarcodeQR:          return FLXSymbologyQR;
+        default:                    return FLXSymbologyEan13;
+    }
+}
+
+@interface FLXCameraScanSource ()
+@property (nonatomic, readwrite) FLXBarcodeScanner* barcodeScanner;
+@property (nonatomic, weak) FLXScannerBus* bus;
+@end
+
+@implementation FLXCameraScanSource
+
+-(FLXScanSourceType) sourceType {
+    return FLXScanSourceCamera;
+}
+
+-(NSString*) readerID {
+    return @"camera";
+}
+
+-(BOOL) startWithBus: (FLXScannerBus*) bus {
+    self.bus = bus;
+    self.barcodeScanner = [[FLXBarcodeScanner alloc] init];
+    __weak FLXCameraScanSource* weakSelf = self;
+    self.barcodeScanner.barcodeScanned = ^(FLXBarcode* barcode) {
+        [weakSelf.bus publishText:barcode.text
+                        symbology:FLXSymbologyForBarcodeType(barcode.type)
+                           source:FLXScanSourceCamera
+                         scanTime:barcode.scanTime];
+    };
+    return YES;
+}
+
+-(void) stop {
+    [self stopCamera];
+    self.barcodeScanner.barcodeScanned = nil;
+    self.bus = nil;
+}
+
+-(AVCaptureVideoPreviewLayer*) previewLayer {
+    return self.barcodeScanner.previewLayer;
+}
+
+-(BOOL) isCameraRunning {
+    return self.barcodeScanner.isRunning;
+}
+
+-(BOOL) startCamera {
+    return [self.barcodeScanner start];
+}
+
+-(void) stopCamera {
+    // Not isRunning: the camera may not have finished starting
+    if (!self.barcodeScanner.previewLayer) {
+        return;
+    }
+    [self.barcodeScanner stop];
+    NSLog(@"Barcode scanner decoded %lu frames, dropped %lu", (unsigned long) self.barcodeScanner.framesDecoded,
+          (unsigned long) self.barcodeScanner.framesDropped);
+}
+
+@end
+
+
+#pragma mark - Simulated
+
+@interface FLXSimulatedScanSource () {
+    dispatch_queue_t _playQueue;
+}
+@property (nonatomic, readwrite) FLXScanSourceType sourceType;
+@property (nonatomic, readwrite) NSString* readerID;
+@property (nonatomic, weak) FLXScannerBus* bus;
+@end
+
+@implementation FLXSimulatedScanSource
+
+-(id) init {
+    return [self initWithSourceType:FLXScanSourceSimulated readerID:@"simulated"];
+}
+
+-(id) initWithSourceType: (FLXScanSourceType) sourceType readerID: (NSString*) readerID {
+    self = [super init];
+    if (self) {
+        _sourceType = sourceType;
+        _readerID = [readerID copy];
+        _playQueue = dispatch_queue_create("com.filelogix.tracventory.simulatedscanner", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+-(BOOL) startWithBus: (FLXScannerBus*) bus {
+    self.bus = bus;
+    return YES;
+}
+
+-(void) stop {
+    self.bus = nil;
+}
+
+-(BOOL) scanTagId: (NSString*) tagId {
+    NSMutableData* bytes = [NSMutableData dataWithCapacity:[tagId length] / 2];
+    int high = -1;
+    for (NSUInteger i = 0; i < [tagId length]; i++) {
+        unichar c = [tagId characterAtIndex:i];
+        int nibble;
+        if (c >= '0' && c <= '9') {
+            nibble = c - '0';
+        }
+        else if (c >= 'A' && c <= 'F') {
+            nibble = c - 'A' + 10;
+        }
+        else if (c >= 'a' && c <= 'f') {
+            nibble = c - 'a' + 10;
+        }
+        else if (c == ' ' || c == ':' || c == '-') {
+            continue;
+        }
+        else {
+            return NO;
+        }
+        if (high < 0) {
+            high = nibble;
+        }
+        else {
+            uint8_t byte = (uint8_t) (high << 4 | nibble);
+            [bytes appendBytes:&byte length:1];
+            high = -1;
+        }
+    }
+    if (high >= 0 || [bytes length] == 0) {
+        return NO;
+    }
+    return [self.bus publishBytes:[bytes bytes]
+                           length:[bytes length]
+                        symbology:FLXSymbologyEpc
+                           source:self.sourceType
+                         scanTime:nil];
+}
+
+-(BOOL) scanBarcode: (NSString*) text symbology: (FLXSymbology) symbology {
+    return [self.bus publishText:text symbology:symbology source:self.sourceType scanTime:nil];
+}
+
+-(void) playCodes: (NSArray*) codes
+        symbology: (FLXSymbology) symbology
+        perSecond: (double) perSecond
+       completion: (void (^)(void)) completion {
+    NSArray* playing = [codes copy];
+    dispatch_async(_playQueue, ^{
+        NSTimeInterval interval = perSecond > 0 ? 1.0 / perSecond : 0;
+        NSDate* start = [NSDate date];
+        for (NSUInteger i = 0; i < [playing count]; i++) {
+            NSTimeInterval wait = i * interval - [[NSDate date] timeIntervalSinceDate:start];
+            if (wait > 0) {
+                [NSThread sleepForTimeInterval:wait];
+            }
+            if (symbology == FLXSymbologyEpc) {
+                [self scanTagId:playing[i]];
+            }
+            else {
+                [self scanBarcode:playing[i] symbology:symbology];
+            }
+        }
+        if (completion) {
+            dispatch_async(dispatch_get_main_queue(), completion);
+        }
+    });
+}
+
+@end
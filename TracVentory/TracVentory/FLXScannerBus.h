@@ -0,0 +1,113 @@
+//
+//  FLXScannerBus.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class FLXScannerBus;
+
+// The values of flx::ScanSource and flx::ScanSymbology
+typedef NS_ENUM(NSInteger, FLXScanSourceType) {
+    FLXScanSourceIDBlue = 1,
+    FLXScanSourceLinea,
+    FLXScanSourceCamera,
+    FLXScanSourceSimulated
+};
+
+typedef NS_ENUM(NSInteger, FLXSymbology) {
+    FLXSymbologyEpc = 1,
+    FLXSymbologyEan13,
+    FLXSymbologyEan8,
+    FLXSymbologyUpcA,
+    FLXSymbologyCode128,
+    FLXSymbologyQR
+};
+
+// Posted on the main queue for each scan the bus delivers; the object is
+// the bus
+extern NSString* const FLXScanNotification;
+extern NSString* const FLXScanKey;      // FLXScan
+
+// One code read by a scanner
+@interface FLXScan : NSObject
+@property (nonatomic, readonly) FLXScanSourceType source;
+@property (nonatomic, readonly) FLXSymbology symbology;
+@property (nonatomic, readonly) NSData* data;           // the tag id, or the barcode's text
+@property (nonatomic, readonly) NSString* text;         // the tag id in hex, or the barcode's text
+@property (nonatomic, readonly) NSDate* scanTime;
+@property (nonatomic, readonly) NSString* readerID;     // of the source that read it
+
+// Whether the code names an item (EPC, Code 128 or QR) rather than a
+// product: tag ids are printed on asset labels as Code 128 or QR, and
+// EAN/UPC name a product, never an item. Subscribers that want the item
+// look it up themselves (FLXCheckInOutEngine itemForTagId:), off the main
+// thread; the bus never waits on the store.
+-(BOOL) isItemCode;
+@end
+
+// A scanner that publishes what it reads into a bus, from any thread
+@protocol FLXScanSource <NSObject>
+@property (nonatomic, readonly) FLXScanSourceType sourceType;
+@property (nonatomic, readonly) NSString* readerID;
+// Called when the source is added to a bus; NO if the scanner cannot be used
+-(BOOL) startWithBus: (FLXScannerBus*) bus;
+-(void) stop;
+@end
+
+// FLXScannerBus is where every scanner's reads go: the IDBLUE pen, a Linea
+// sled, the camera, or a simulated source in tests. Sources publish from
+// whatever thread their SDK calls back on into a lock-free queue
+// (Core/ScanEventBus.h); a single consumer queue drains it, drops repeats
+// of a code within dedupWindow whichever source read them, and posts
+// FLXScanNotification. Screens observe the notification and never
+// see a scanner SDK, so sources can be swapped or combined in one place.
+//
+// A burst of reads schedules a single drain; a scan reaches the main queue
+// two hops after its source called publish. Thread safe.
+@interface FLXScannerBus : NSObject
+
++(FLXScannerBus*) sharedBus;
+
+// capacity is the number of scans that may wait for the consumer; more are
+// dropped and counted
+-(id) initWithCapacity: (NSUInteger) capacity dedupWindow: (NSTimeInterval) dedupWindow;
+
+// Seconds within which the same code is delivered once (default 2: IDBLUE
+// stamps its reads to the second). Compared on scan times, which are wall
+// clock: the reader's own for IDBLUE, the bus's for the rest.
+@property (nonatomic) NSTimeInterval dedupWindow;
+
+// Start the source and publish its reads; NO if it did not start
+-(BOOL) addSource: (id<FLXScanSource>) source;
+-(void) removeSource: (id<FLXScanSource>) source;
+-(NSArray*) sources;
+// The first source of the type added, if any
+-(id<FLXScanSource>) sourceOfType: (FLXScanSourceType) type;
+
+// For sources. scanTime is when the scanner read it (nil for now); NO if
+// the scan was dropped.
+-(BOOL) publishBytes: (const void*) bytes
+              length: (NSUInteger) length
+           symbology: (FLXSymbology) symbology
+              source: (FLXScanSourceType) source
+            scanTime: (NSDate*) scanTime;
+-(BOOL) publishText: (NSString*) text
+          symbology: (FLXSymbology) symbology
+             source: (FLXScanSourceType) source
+           scanTime: (NSDate*) scanTime;
+
+// Drain what was published so far now rather than when the consumer gets
+// to it; the scans are posted on the next turn of the main queue. For tests.
+-(void) flush;
+
+// Scans published, dropped, delivered and suppressed as duplicates
+@property (nonatomic, readonly) NSUInteger published;
+@property (nonatomic, readonly) NSUInteger dropped;
+@property (nonatomic, readonly) NSUInteger delivered;
+@property (nonatomic, readonly) NSUInteger duplicates;
+
+@end
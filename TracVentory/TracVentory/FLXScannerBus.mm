@@ -0,0 +1,226 @@
+//
+//  FLXScannerBus.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXScannerBus.h"
+#include "ScanEventBus.h"
+#include "TraceLog.h"
+
+NSString* const FLXScanNotification = @"FLXScanNotification";
+NSString* const FLXScanKey = @"scan";
+
+static const NSUInteger FLXScannerBusCapacity = 256;
+static const NSTimeInterval FLXScannerBusDedupWindow = 2.0;
+
+@interface FLXScan ()
+@property (nonatomic, readwrite) NSString* readerID;
+@end
+
+@implementation FLXScan
+
+-(id) initWithEvent: (const flx::ScanEvent&) event {
+    self = [super init];
+    if (self) {
+        _source = (FLXScanSourceType) event.source;
+        _symbology = (FLXSymbology) event.symbology;
+        _data = [NSData dataWithBytes:event.bytes length:event.length];
+        _scanTime = [NSDate dateWithTimeIntervalSince1970:event.timeUs / 1e6];
+        if (_symbology == FLXSymbologyEpc) {
+            NSMutableString* hex = [NSMutableString stringWithCapacity:event.length * 2];
+            for (uint16_t i = 0; i < event.length; i++) {
+                [hex appendFormat:@"%02X", event.bytes[i]];
+            }
+            _text = hex;
+        }
+        else {
+            _text = [[NSString alloc] initWithData:_data encoding:NSUTF8StringEncoding] ?:
+                    [[NSString alloc] initWithData:_data encoding:NSISOLatin1StringEncoding];
+        }
+    }
+    return self;
+}
+
+-(BOOL) isItemCode {
+    return _symbology == FLXSymbologyEpc || _symbology == FLXSymbologyCode128 || _symbology == FLXSymbologyQR;
+}
+
+-(NSString*) description {
+    return [NSString stringWithFormat:@"<FLXScan %@ from %ld at %@>", _text, (long) _source, _scanTime];
+}
+
+@end
+
+
+@interface FLXScannerBus () {
+    flx::ScanEventBus* _bus;
+    // The consumer: drains _bus, and guards _sources
+    dispatch_queue_t _queue;
+    NSMutableArray* _sources;
+}
+@end
+
+@implementation FLXScannerBus
+
++(FLXScannerBus*) sharedBus {
+    static FLXScannerBus* sharedBus = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedBus = [[FLXScannerBus alloc] initWithCapacity:FLXScannerBusCapacity dedupWindow:FLXScannerBusDedupWindow];
+    });
+    return sharedBus;
+}
+
+-(id) initWithCapacity: (NSUInteger) capacity dedupWindow: (NSTimeInterval) dedupWindow {
+    self = [super init];
+    if (self) {
+        _bus = new flx::ScanEventBus(capacity, (uint64_t) (dedupWindow * 1e6));
+        _dedupWindow = dedupWindow;
+        _queue = dispatch_queue_create("com.filelogix.tracventory.scanner", DISPATCH_QUEUE_SERIAL);
+        _sources = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+-(void) dealloc {
+    for (id<FLXScanSource> source in _sources) {
+        [source stop];
+    }
+    delete _bus;
+}
+
+-(void) setDedupWindow: (NSTimeInterval) dedupWindow {
+    _dedupWindow = dedupWindow;
+    dispatch_async(_queue, ^{
+        self->_bus->setDedupWindow((uint64_t) (dedupWindow * 1e6));
+    });
+}
+
+#pragma mark - Sources
+
+-(BOOL) addSource: (id<FLXScanSource>) source {
+    if (![source startWithBus:self]) {
+        NSLog(@"Scanner source %@ did not start", source);
+        return NO;
+    }
+    dispatch_sync(_queue, ^{
+        [self->_sources addObject:source];
+    });
+    return YES;
+}
+
+-(void) removeSource: (id<FLXScanSource>) source {
+    __block BOOL found = NO;
+    dispatch_sync(_queue, ^{
+        found = [self->_sources containsObject:source];
+        [self->_sources removeObject:source];
+    });
+    if (found) {
+        [source stop];
+    }
+}
+
+-(NSArray*) sources {
+    __block NSArray* sources = nil;
+    dispatch_sync(_queue, ^{
+        sources = [self->_sources copy];
+    });
+    return sources;
+}
+
+-(id<FLXScanSource>) sourceOfType: (FLXScanSourceType) type {
+    for (id<FLXScanSource> source in [self sources]) {
+        if (source.sourceType == type) {
+            return source;
+        }
+    }
+    return nil;
+}
+
+#pragma mark - Publishing
+
+-(BOOL) publishBytes: (const void*) bytes
+              length: (NSUInteger) length
+           symbology: (FLXSymbology) symbology
+              source: (FLXScanSourceType) source
+            scanTime: (NSDate*) scanTime {
+    NSTimeInterval time = scanTime ? [scanTime timeIntervalSince1970] : [[NSDate date] timeIntervalSince1970];
+    bool wake = false;
+    if (!_bus->publish((flx::ScanSource) source, (flx::ScanSymbology) symbology, (const uint8_t*) bytes, length,
+                       (uint64_t) (time * 1e6), wake)) {
+        FLX_TRACE("Scan from source %d dropped, %u bytes", (int) source, (unsigned) length);
+        return NO;
+    }
+    if (wake) {
+        dispatch_async(_queue, ^{
+            [self drain];
+        });
+    }
+    return YES;
+}
+
+-(BOOL) publishText: (NSString*) text
+          symbology: (FLXSymbology) symbology
+             source: (FLXScanSourceType) source
+           scanTime: (NSDate*) scanTime {
+    NSData* data = [text dataUsingEncoding:NSUTF8StringEncoding];
+    return [self publishBytes:[data bytes] length:[data length] symbology:symbology source:source scanTime:scanTime];
+}
+
+-(void) flush {
+    dispatch_sync(_queue, ^{
+        [self drain];
+    });
+}
+
+#pragma mark - Consumer
+
+// On _queue
+-(void) drain {
+    NSMutableArray* scans = [NSMutableArray array];
+    _bus->drain([&](const flx::ScanEvent& event) {
+        FLXScan* scan = [[FLXScan alloc] initWithEvent:event];
+        FLX_TRACE("Scan %s from source %d delivered", flx::TraceHex(event.bytes, event.length), (int) event.source);
+        [scans addObject:scan];
+    });
+    if ([scans count] == 0) {
+        return;
+    }
+    NSArray* sources = [_sources copy];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        for (FLXScan* scan in scans) {
+            for (id<FLXScanSource> source in sources) {
+                if (source.sourceType == scan.source) {
+                    scan.readerID = source.readerID;
+                    break;
+                }
+            }
+            [[NSNotificationCenter defaultCenter] postNotificationName:FLXScanNotification
+                                                                object:self
+                                                              userInfo:@{ FLXScanKey: scan }];
+        }
+    });
+}
+
+#pragma mark - Statistics
+
+-(NSUInteger) published {
+    return (NSUInteger) _bus->stats().published;
+}
+
+-(NSUInteger) dropped {
+    return (NSUInteger) _bus->stats().dropped;
+}
+
+-(NSUInteger) delivered {
+    return (NSUInteger) _bus->stats().delivered;
+}
+
+-(NSUInteger) duplicates {
+    return (NSUInteger) _bus->stats().duplicates;
+}
+
+@end
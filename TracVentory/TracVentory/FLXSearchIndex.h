@@ -0,0 +1,36 @@
+//
+//  FLXSearchIndex.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "FLXLocalStore.h"
+
+// FLXSearchIndex provides search-as-you-type over the item ID, make, model,
+// category and notes of one FLXLocalStore class. It wraps the portable
+// flx::SearchIndex (Core/SearchIndex.h), keeps it current from
+// FLXLocalStoreDidChangeNotification, and runs queries on its own serial
+// queue.
+@interface FLXSearchIndex : NSObject
+
+// Index over the Items class of the shared local store
++(FLXSearchIndex*) sharedIndex;
+
+// Starts building the index from the records already in the store.
+-(id) initWithStore: (FLXLocalStore*) store className: (NSString*) className;
+
+// objectIds of the best matches for text, best first. Blocks until any
+// pending index updates have been applied.
+-(NSArray*) objectIdsMatchingText: (NSString*) text limit: (NSUInteger) limit;
+
+// Asynchronous variant for the search bar. completion runs on the main queue,
+// and only for the most recent call: searches superseded by a later keystroke
+// are dropped.
+-(void) searchText: (NSString*) text
+             limit: (NSUInteger) limit
+        completion: (void (^)(NSArray* objectIds)) completion;
+
+@end
@@ -0,0 +1,143 @@
+//
+//  FLXSearchIndex.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXSearchIndex.h"
+#import <libkern/OSAtomic.h>
+#include "SearchIndex.h"
+
+@interface FLXSearchIndex () {
+    FLXLocalStore* _store;
+    NSString* _className;
+    dispatch_queue_t _queue;
+    flx::SearchIndex _index;
+    volatile int32_t _latestSearch;
+}
+@end
+
+@implementation FLXSearchIndex
+
++(FLXSearchIndex*) sharedIndex {
+    static FLXSearchIndex* sharedIndex = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedIndex = [[FLXSearchIndex alloc] initWithStore:[FLXLocalStore sharedStore] className:@"Items"];
+    });
+    return sharedIndex;
+}
+
+-(id) initWithStore: (FLXLocalStore*) store className: (NSString*) className {
+    self = [super init];
+    if (self) {
+        _store = store;
+        _className = [className copy];
+        _queue = dispatch_queue_create("com.filelogix.tracventory.searchindex", DISPATCH_QUEUE_SERIAL);
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(localStoreDidChange:)
+                                                     name:FLXLocalStoreDidChangeNotification
+                                                   object:store];
+
+        dispatch_async(_queue, ^{
+            for (NSDictionary* record in [self->_store allRecordsInClass:self->_className]) {
+                [self indexRecord:record];
+            }
+        });
+    }
+    return self;
+}
+
+-(void) dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+// Case and diacritics are folded here; the core index only lowercases ASCII.
+static std::string FLXSearchText(id value) {
+    if ([value isKindOfClass:[NSNumber class]]) {
+        value = [value stringValue];
+    }
+    if (![value isKindOfClass:[NSString class]]) {
+        return std::string();
+    }
+    NSString* folded = [value stringByFoldingWithOptions:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch locale:nil];
+    const char* utf8 = [folded UTF8String];
+    return utf8 ? std::string(utf8) : std::string();
+}
+
+// Must be called on _queue
+-(void) indexRecord: (NSDictionary*) record {
+    NSString* objectId = record[@"objectId"];
+    if (!objectId) {
+        return;
+    }
+    flx::SearchDocument document;
+    document[flx::kSearchFieldItemId] = FLXSearchText(record[@"itemID"]);
+    document[flx::kSearchFieldMake] = FLXSearchText(record[@"make"]);
+    document[flx::kSearchFieldModel] = FLXSearchText(record[@"model"]);
+    document[flx::kSearchFieldCategory] = FLXSearchText(record[@"category"]);
+    document[flx::kSearchFieldNotes] = FLXSearchText(record[@"notes"]);
+    _index.put([objectId UTF8String], document);
+}
+
+-(void) localStoreDidChange: (NSNotification*) notification {
+    if (![notification.userInfo[FLXLocalStoreClassNameKey] isEqualToString:_className]) {
+        return;
+    }
+    NSSet* updatedIds = notification.userInfo[FLXLocalStoreUpdatedIdsKey];
+    NSSet* removedIds = notification.userInfo[FLXLocalStoreRemovedIdsKey];
+
+    dispatch_async(_queue, ^{
+        for (NSString* objectId in removedIds) {
+            self->_index.remove([objectId UTF8String]);
+        }
+        for (NSString* objectId in updatedIds) {
+            NSDictionary* record = [self->_store recordWithId:objectId inClass:self->_className];
+            if (record) {
+                [self indexRecord:record];
+            }
+        }
+    });
+}
+
+// Must be called on _queue
+-(NSArray*) searchIndexForText: (NSString*) text limit: (NSUInteger) limit {
+    std::vector<flx::SearchHit> hits = _index.search(FLXSearchText(text), limit);
+    NSMutableArray* objectIds = [[NSMutableArray alloc] initWithCapacity:hits.size()];
+    for (size_t i = 0; i < hits.size(); i++) {
+        [objectIds addObject:[NSString stringWithUTF8String:hits[i].key.c_str()]];
+    }
+    return objectIds;
+}
+
+-(NSArray*) objectIdsMatchingText: (NSString*) text limit: (NSUInteger) limit {
+    __block NSArray* objectIds = nil;
+    dispatch_sync(_queue, ^{
+        objectIds = [self searchIndexForText:text limit:limit];
+    });
+    return objectIds;
+}
+
+-(void) searchText: (NSString*) text
+             limit: (NSUInteger) limit
+        completion: (void (^)(NSArray* objectIds)) completion {
+    int32_t search = OSAtomicIncrement32(&_latestSearch);
+    NSString* query = [text copy];
+
+    dispatch_async(_queue, ^{
+        if (search != self->_latestSearch) {
+            return;
+        }
+        NSArray* objectIds = [self searchIndexForText:query limit:limit];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (search == self->_latestSearch) {
+                completion(objectIds);
+            }
+        });
+    });
+}
+
+@end
@@ -0,0 +1,56 @@
+//
+//  FLXTagInfoCache.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <IDBLUE/RfidTag.h>
+
+typedef NS_ENUM(uint8_t, FLXTagInfoKind) {
+    FLXTagInfoGeometry = 0,     // getTagInfo: block count and size
+    FLXTagInfoTid = 1           // epcRead of the TID bank
+};
+
+// What getTagInfo: reports about a tag's user memory
+@interface FLXTagInfo : NSObject
+@property (nonatomic, readonly) NSData* tagId;
+@property (nonatomic, readonly) NSUInteger blockCount;
+@property (nonatomic, readonly) NSUInteger bytesPerBlock;
+// Answered from FLXTagInfoCache rather than by IDBLUE
+@property (nonatomic, readonly) BOOL cached;
+
+-(id) initWithTagId: (NSData*) tagId blockCount: (NSUInteger) blockCount bytesPerBlock: (NSUInteger) bytesPerBlock cached: (BOOL) cached;
+@end
+
+// FLXTagInfoCache remembers the GetTagInfo geometry and TID of the tags
+// IDBlueSdk has asked about, which never change for a tag, so the next
+// cycle count over the same stock skips those round trips. It wraps the
+// portable flx::TagInfoCache (Core/TagInfoCache.h): bounded, least recently
+// used entries go first, and saved to a file to last across sessions.
+//
+// Used on the main thread, where IDBLUE responses arrive.
+@interface FLXTagInfoCache : NSObject
+
+// Kept in Library/Caches/FLXTagInfo.cache and loaded on first use
++(FLXTagInfoCache*) sharedCache;
+
+// Loads path if it holds a saved cache.
+-(id) initWithPath: (NSString*) path capacity: (NSUInteger) capacity;
+
+// nil on a miss
+-(NSData*) infoForTag: (RfidTag*) tag kind: (FLXTagInfoKind) kind;
+-(void) setInfo: (NSData*) info forTag: (RfidTag*) tag kind: (FLXTagInfoKind) kind;
+-(void) removeAllInfo;
+
+-(BOOL) save;
+
+@property (nonatomic, readonly) NSUInteger count;
+// Lookups since launch
+@property (nonatomic, readonly) NSUInteger hits;
+@property (nonatomic, readonly) NSUInteger misses;
+@property (nonatomic, readonly) double hitRate;
+
+@end
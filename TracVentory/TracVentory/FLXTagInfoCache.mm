@@ -0,0 +1,103 @@
+//
+//  FLXTagInfoCache.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXTagInfoCache.h"
+#include <vector>
+#include "TagInfoCache.h"
+
+// Tags of a few large cycle counts
+static const NSUInteger FLXTagInfoCacheCapacity = 16384;
+
+@implementation FLXTagInfo
+
+-(id) initWithTagId: (NSData*) tagId blockCount: (NSUInteger) blockCount bytesPerBlock: (NSUInteger) bytesPerBlock cached: (BOOL) cached {
+    self = [super init];
+    if (self) {
+        _tagId = [tagId copy];
+        _blockCount = blockCount;
+        _bytesPerBlock = bytesPerBlock;
+        _cached = cached;
+    }
+    return self;
+}
+
+@end
+
+
+@interface FLXTagInfoCache () {
+    NSString* _path;
+    flx::TagInfoCache _cache;
+}
+@end
+
+@implementation FLXTagInfoCache
+
++(FLXTagInfoCache*) sharedCache {
+    static FLXTagInfoCache* sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString* caches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+        sharedCache = [[FLXTagInfoCache alloc] initWithPath:[caches stringByAppendingPathComponent:@"FLXTagInfo.cache"]
+                                                   capacity:FLXTagInfoCacheCapacity];
+    });
+    return sharedCache;
+}
+
+-(id) initWithPath: (NSString*) path capacity: (NSUInteger) capacity {
+    self = [super init];
+    if (self) {
+        _path = [path copy];
+        _cache.setCapacity(capacity);
+        if (_cache.load([_path fileSystemRepresentation])) {
+            NSLog(@"Loaded %lu cached tag infos", (unsigned long) _cache.size());
+        }
+    }
+    return self;
+}
+
+-(NSData*) infoForTag: (RfidTag*) tag kind: (FLXTagInfoKind) kind {
+    std::vector<uint8_t> info;
+    if (!_cache.lookup(static_cast<flx::TagInfoKind>(kind), [tag data], [tag arrayLength], info)) {
+        return nil;
+    }
+    return [NSData dataWithBytes:info.data() length:info.size()];
+}
+
+-(void) setInfo: (NSData*) info forTag: (RfidTag*) tag kind: (FLXTagInfoKind) kind {
+    _cache.insert(static_cast<flx::TagInfoKind>(kind), [tag data], [tag arrayLength],
+                  static_cast<const uint8_t*>([info bytes]), [info length]);
+}
+
+-(void) removeAllInfo {
+    _cache.clear();
+}
+
+-(BOOL) save {
+    const flx::TagInfoCacheStats& stats = _cache.stats();
+    NSLog(@"Tag info cache: %lu entries, %llu hits, %llu misses (%.0f%%)", (unsigned long) _cache.size(),
+          (unsigned long long) stats.hits, (unsigned long long) stats.misses, stats.hitRate() * 100);
+    return _cache.save([_path fileSystemRepresentation]);
+}
+
+-(NSUInteger) count {
+    return _cache.size();
+}
+
+-(NSUInteger) hits {
+    return (NSUInteger) _cache.stats().hits;
+}
+
+-(NSUInteger) misses {
+    return (NSUInteger) _cache.stats().misses;
+}
+
+-(double) hitRate {
+    return _cache.stats().hitRate();
+}
+
+@end
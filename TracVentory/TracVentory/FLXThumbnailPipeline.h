@@ -0,0 +1,60 @@
+//
+//  FLXThumbnailPipeline.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+@class PFObject;
+@class FLXImageCache;
+
+// Item keys holding photo files (PFFile on Parse, a "__type": "File"
+// dictionary in FLXLocalStore records)
+extern NSString* const FLXItemPhotoKey;         // full size, as taken
+extern NSString* const FLXItemThumbnailKey;     // made from it when taken
+
+// FLXThumbnailPipeline gives lists small images of item photos without
+// ever decoding a full-size one. Thumbnails are made when a photo is taken
+// and saved next to it; an item synced without one gets a thumbnail made
+// from its photo by ImageIO, which scales while decoding, and that is cached
+// in its place. Thumbnails come from the FLXImageCache tiers first and from
+// Parse only when neither has them; requests for the same image share one
+// fetch.
+//
+// Used on the main thread.
+@interface FLXThumbnailPipeline : NSObject
+
++(FLXThumbnailPipeline*) sharedPipeline;
+
+-(id) initWithCache: (FLXImageCache*) cache;
+
+// Longest side of a thumbnail in pixels (default 120: a 40 point row
+// image on a 3x screen)
+@property (nonatomic) NSUInteger maxPixelSize;
+
+// The JPEG of a thumbnail of image data (any format ImageIO reads), nil if
+// it is not an image
++(NSData*) thumbnailDataForImageData: (NSData*) data maxPixelSize: (NSUInteger) maxPixelSize;
+
+// Attach a photo as it is taken: the photo and its thumbnail are saved as
+// files, set on the item and the item saved. The thumbnail goes into the
+// cache, so the list shows it without a download. completion runs on the
+// main queue.
+-(void) attachPhotoData: (NSData*) photoData
+                 toItem: (PFObject*) item
+             completion: (void (^)(BOOL succeeded, NSError* error)) completion;
+
+// Whether the record has a photo to show
+-(BOOL) recordHasPhoto: (NSDictionary*) record;
+// The record's thumbnail if decoded in memory; never blocks on the disk
+-(UIImage*) cachedThumbnailForRecord: (NSDictionary*) record;
+// Fetch the record's thumbnail; completion runs on the main queue, with nil
+// if it has no photo or the fetch failed
+-(void) thumbnailForRecord: (NSDictionary*) record completion: (void (^)(UIImage* image)) completion;
+// Fetch thumbnails of rows about to be shown
+-(void) prefetchThumbnailsForRecords: (NSArray*) records;
+
+@end
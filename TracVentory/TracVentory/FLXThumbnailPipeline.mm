@@ -0,0 +1,243 @@
+//
+//  FLXThumbnailPipeline.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXThumbnailPipeline.h"
+#import "FLXImageCache.h"
+#import "FLXLocalStore.h"
+#import <ImageIO/ImageIO.h>
+#import <Parse/Parse.h>
+#include "TraceLog.h"
+
+NSString* const FLXItemPhotoKey = @"photo";
+NSString* const FLXItemThumbnailKey = @"thumbnail";
+
+static const NSUInteger FLXThumbnailMaxPixelSize = 120;
+static const double FLXThumbnailQuality = 0.8;
+
+// Cache key of a thumbnail made from a photo rather than taken with it
+static NSString* const FLXDerivedThumbnailPrefix = @"thumbnail-";
+
+// A file value of a store record: {"__type": "File", "name": ..., "url": ...}
+static NSDictionary* FLXRecordFile(NSDictionary* record, NSString* key) {
+    id file = record[key];
+    if (![file isKindOfClass:[NSDictionary class]] || ![file[@"__type"] isEqual:@"File"]) {
+        return nil;
+    }
+    return file;
+}
+
+static NSString* FLXFileKey(NSDictionary* file) {
+    return file[@"name"] ?: file[@"url"];
+}
+
+static NSURL* FLXFileURL(NSDictionary* file) {
+    return file[@"url"] ? [NSURL URLWithString:file[@"url"]] : nil;
+}
+
+@interface FLXThumbnailPipeline () {
+    FLXImageCache* _cache;
+    // Completions waiting for each thumbnail being fetched, by cache key
+    NSMutableDictionary* _pending;
+}
+@end
+
+@implementation FLXThumbnailPipeline
+
++(FLXThumbnailPipeline*) sharedPipeline {
+    static FLXThumbnailPipeline* sharedPipeline = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedPipeline = [[FLXThumbnailPipeline alloc] initWithCache:[FLXImageCache sharedCache]];
+    });
+    return sharedPipeline;
+}
+
+-(id) initWithCache: (FLXImageCache*) cache {
+    self = [super init];
+    if (self) {
+        _cache = cache;
+        _pending = [[NSMutableDictionary alloc] init];
+        _maxPixelSize = FLXThumbnailMaxPixelSize;
+    }
+    return self;
+}
+
+#pragma mark - Making thumbnails
+
++(NSData*) thumbnailDataForImageData: (NSData*) data maxPixelSize: (NSUInteger) maxPixelSize {
+    if (!data) {
+        return nil;
+    }
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef) data, NULL);
+    if (!source) {
+        return nil;
+    }
+    // Scaled while decoding (a JPEG is decoded at a fraction of its size),
+    // so the full-size bitmap never exists; upright whatever the EXIF says
+    NSDictionary* options = @{ (__bridge id) kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+                               (__bridge id) kCGImageSourceThumbnailMaxPixelSize: @(maxPixelSize),
+                               (__bridge id) kCGImageSourceCreateThumbnailWithTransform: @YES };
+    CGImageRef thumbnail = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef) options);
+    CFRelease(source);
+    if (!thumbnail) {
+        return nil;
+    }
+    NSMutableData* jpeg = [NSMutableData data];
+    CGImageDestinationRef destination = CGImageDestinationCreateWithData((__bridge CFMutableDataRef) jpeg,
+                                                                         CFSTR("public.jpeg"), 1, NULL);
+    BOOL encoded = NO;
+    if (destination) {
+        NSDictionary* properties = @{ (__bridge id) kCGImageDestinationLossyCompressionQuality: @(FLXThumbnailQuality) };
+        CGImageDestinationAddImage(destination, thumbnail, (__bridge CFDictionaryRef) properties);
+        encoded = CGImageDestinationFinalize(destination);
+        CFRelease(destination);
+    }
+    CGImageRelease(thumbnail);
+    return encoded ? jpeg : nil;
+}
+
+-(void) attachPhotoData: (NSData*) photoData
+                 toItem: (PFObject*) item
+             completion: (void (^)(BOOL succeeded, NSError* error)) completion {
+    void (^finish)(BOOL, NSError*) = ^(BOOL succeeded, NSError* error) {
+        if (completion) {
+            completion(succeeded, error);
+        }
+    };
+    NSData* thumbnailData = [FLXThumbnailPipeline thumbnailDataForImageData:photoData maxPixelSize:self.maxPixelSize];
+    if (!thumbnailData) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            finish(NO, nil);
+        });
+        return;
+    }
+    FLXImageCache* cache = _cache;
+    PFFile* photo = [PFFile fileWithName:@"photo.jpg" data:photoData];
+    PFFile* thumbnail = [PFFile fileWithName:@"thumbnail.jpg" data:thumbnailData];
+    [thumbnail saveInBackgroundWithBlock:^(BOOL succeeded, NSError* error) {
+        if (!succeeded) {
+            finish(NO, error);
+            return;
+        }
+        // Parse names the file as it is uploaded; the list asks for that name
+        NSString* key = thumbnail.name;
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            [cache storeImageData:thumbnailData forKey:key];
+        });
+        [photo saveInBackgroundWithBlock:^(BOOL succeeded, NSError* error) {
+            if (!succeeded) {
+                finish(NO, error);
+                return;
+            }
+            item[FLXItemPhotoKey] = photo;
+            item[FLXItemThumbnailKey] = thumbnail;
+            [item saveInBackgroundWithBlock:^(BOOL succeeded, NSError* error) {
+                if (succeeded && item.objectId) {
+                    // The item may hold only the keys just set; keep the rest
+                    // of the record
+                    FLXLocalStore* store = [FLXLocalStore sharedStore];
+                    NSMutableDictionary* record = [[store recordWithId:item.objectId inClass:item.parseClassName] mutableCopy]
+                        ?: [NSMutableDictionary dictionary];
+                    [record addEntriesFromDictionary:[FLXLocalStore recordFromObject:item]];
+                    [store putRecords:@[record] inClass:item.parseClassName];
+                }
+                finish(succeeded, error);
+            }];
+        }];
+    }];
+}
+
+#pragma mark - Fetching
+
+-(BOOL) recordHasPhoto: (NSDictionary*) record {
+    return FLXRecordFile(record, FLXItemThumbnailKey) || FLXRecordFile(record, FLXItemPhotoKey);
+}
+
+-(NSString*) thumbnailKeyForRecord: (NSDictionary*) record {
+    NSDictionary* thumbnail = FLXRecordFile(record, FLXItemThumbnailKey);
+    if (thumbnail) {
+        return FLXFileKey(thumbnail);
+    }
+    NSString* photoKey = FLXFileKey(FLXRecordFile(record, FLXItemPhotoKey));
+    return photoKey ? [FLXDerivedThumbnailPrefix stringByAppendingString:photoKey] : nil;
+}
+
+-(UIImage*) cachedThumbnailForRecord: (NSDictionary*) record {
+    return [_cache memoryImageForKey:[self thumbnailKeyForRecord:record]];
+}
+
+-(void) thumbnailForRecord: (NSDictionary*) record completion: (void (^)(UIImage* image)) completion {
+    NSString* key = [self thumbnailKeyForRecord:record];
+    if (!key) {
+        if (completion) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(nil);
+            });
+        }
+        return;
+    }
+    NSMutableArray* waiting = _pending[key];
+    if (waiting) {
+        if (completion) {
+            [waiting addObject:[completion copy]];
+        }
+        return;
+    }
+    waiting = [NSMutableArray array];
+    if (completion) {
+        [waiting addObject:[completion copy]];
+    }
+    _pending[key] = waiting;
+
+    // Without a thumbnail the photo is fetched, and scaled as it is decoded
+    NSDictionary* thumbnailFile = FLXRecordFile(record, FLXItemThumbnailKey);
+    NSURL* url = thumbnailFile ? FLXFileURL(thumbnailFile) : FLXFileURL(FLXRecordFile(record, FLXItemPhotoKey));
+    BOOL fromPhoto = thumbnailFile == nil;
+    NSUInteger maxPixelSize = self.maxPixelSize;
+    FLXImageCache* cache = _cache;
+
+    [_cache imageForKey:key completion:^(UIImage* image) {
+        if (image || !url) {
+            [self finishThumbnailForKey:key image:image];
+            return;
+        }
+        NSURLSessionDataTask* task = [[NSURLSession sharedSession] dataTaskWithURL:url completionHandler:^(NSData* data, NSURLResponse* response, NSError* error) {
+            UIImage* fetched = nil;
+            NSInteger status = [response isKindOfClass:[NSHTTPURLResponse class]] ? [(NSHTTPURLResponse*) response statusCode] : 200;
+            if (data && status == 200) {
+                NSData* thumbnailData = fromPhoto ? [FLXThumbnailPipeline thumbnailDataForImageData:data maxPixelSize:maxPixelSize] : data;
+                fetched = [cache storeImageData:thumbnailData forKey:key];
+            }
+            else {
+                FLX_TRACE("Thumbnail fetch failed, status %d", (int) status);
+            }
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self finishThumbnailForKey:key image:fetched];
+            });
+        }];
+        [task resume];
+    }];
+}
+
+-(void) finishThumbnailForKey: (NSString*) key image: (UIImage*) image {
+    NSArray* waiting = _pending[key];
+    [_pending removeObjectForKey:key];
+    for (void (^completion)(UIImage*) in waiting) {
+        completion(image);
+    }
+}
+
+-(void) prefetchThumbnailsForRecords: (NSArray*) records {
+    for (NSDictionary* record in records) {
+        if ([self recordHasPhoto:record] && ![self cachedThumbnailForRecord:record]) {
+            [self thumbnailForRecord:record completion:nil];
+        }
+    }
+}
+
+@end
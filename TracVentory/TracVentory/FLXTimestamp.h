@@ -0,0 +1,36 @@
+//
+//  FLXTimestamp.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class IDBlueTimestamp;
+
+// FLXTimestamp converts IDBLUE timestamps without going through NSCalendar
+// the way IDBlueTimestamp toNSDate / initFromNSDate do: the six date bytes
+// are converted arithmetically (Core/ReaderTime.h) and the local time zone
+// offset is cached until the next daylight saving transition. Use the
+// array methods when draining entries. Thread safe.
+@interface FLXTimestamp : NSObject
+
+// NAN for bytes that are not a valid date
++(NSTimeInterval) timeIntervalSince1970ForTimestamp: (IDBlueTimestamp*) timestamp;
+// nil for bytes that are not a valid date
++(NSDate*) dateForTimestamp: (IDBlueTimestamp*) timestamp;
++(IDBlueTimestamp*) timestampForDate: (NSDate*) date;
+
+// Convert an array of IDBlueTimestamps in one pass; intervals holds
+// [timestamps count] values, NAN for invalid ones.
++(void) getTimeIntervals: (NSTimeInterval*) intervals forTimestamps: (NSArray*) timestamps;
+// NSDates for an array of IDBlueTimestamps, NSNull for invalid ones
++(NSArray*) datesForTimestamps: (NSArray*) timestamps;
+
+// Drop the cached time zone offset. Done automatically when the system
+// time zone changes.
++(void) resetTimeZoneCache;
+
+@end
@@ -0,0 +1,190 @@
+//
+//  FLXTimestamp.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXTimestamp.h"
+#import <IDBLUE/IDBlueTimestamp.h>
+#import <libkern/OSAtomic.h>
+#include <vector>
+#include "ReaderTime.h"
+
+static OSSpinLock FLXOffsetLock = OS_SPINLOCK_INIT;
+static flx::UtcOffsetWindow FLXOffsetWindow = { 0, 0, 0 };
+
+// Offsets are looked up for a year around the instant at most
+static const NSTimeInterval FLXOffsetSearchSpan = 366 * 86400.0;
+
+static void FLXObserveTimeZoneChanges(void) {
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        [[NSNotificationCenter defaultCenter] addObserverForName:NSSystemTimeZoneDidChangeNotification
+                                                          object:nil
+                                                           queue:nil
+                                                      usingBlock:^(NSNotification* note) {
+            [FLXTimestamp resetTimeZoneCache];
+        }];
+    });
+}
+
+// The local offset at seconds and the span around it where it holds
+static flx::UtcOffsetWindow FLXOffsetWindowAt(int64_t seconds) {
+    [NSTimeZone resetSystemTimeZone];
+    NSTimeZone* zone = [NSTimeZone localTimeZone];
+    NSDate* instant = [NSDate dateWithTimeIntervalSince1970:seconds];
+
+    flx::UtcOffsetWindow window;
+    window.offset = (int32_t) [zone secondsFromGMTForDate:instant];
+    window.validFrom = seconds - (int64_t) FLXOffsetSearchSpan;
+    window.validUntil = seconds + (int64_t) FLXOffsetSearchSpan;
+
+    NSDate* transition = [zone nextDaylightSavingTimeTransitionAfterDate:[instant dateByAddingTimeInterval:-FLXOffsetSearchSpan]];
+    while (transition) {
+        int64_t at = (int64_t) [transition timeIntervalSince1970];
+        if (at > seconds) {
+            window.validUntil = MIN(window.validUntil, at);
+            break;
+        }
+        window.validFrom = at;
+        transition = [zone nextDaylightSavingTimeTransitionAfterDate:transition];
+    }
+    return window;
+}
+
+static inline flx::UtcOffsetWindow FLXCurrentOffsetWindow(void) {
+    OSSpinLockLock(&FLXOffsetLock);
+    flx::UtcOffsetWindow window = FLXOffsetWindow;
+    OSSpinLockUnlock(&FLXOffsetLock);
+    return window;
+}
+
+// Refresh the cached window for a local time whose instant it did not cover
+static flx::UtcOffsetWindow FLXRefreshOffsetWindow(const flx::ReaderTimestamp& time, const flx::UtcOffsetWindow& stale) {
+    FLXObserveTimeZoneChanges();
+    flx::UtcOffsetWindow window = FLXOffsetWindowAt(flx::timestampToEpoch(time, stale.offset));
+    if (!window.covers(flx::timestampToEpoch(time, window.offset))) {
+        // Inside a transition; take the offset after it
+        window = FLXOffsetWindowAt(flx::timestampToEpoch(time, window.offset));
+    }
+    OSSpinLockLock(&FLXOffsetLock);
+    FLXOffsetWindow = window;
+    OSSpinLockUnlock(&FLXOffsetLock);
+    return window;
+}
+
+static inline flx::ReaderTimestamp FLXReaderTimestamp(IDBlueTimestamp* timestamp) {
+    flx::ReaderTimestamp time = { [timestamp year], [timestamp month], [timestamp day],
+                                  [timestamp hour], [timestamp minute], [timestamp second] };
+    return time;
+}
+
+static NSTimeInterval FLXTimeIntervalForReaderTimestamp(const flx::ReaderTimestamp& time, flx::UtcOffsetWindow& window) {
+    if (!flx::isValidTimestamp(time)) {
+        return NAN;
+    }
+    int64_t seconds = flx::timestampToEpoch(time, window.offset);
+    if (!window.covers(seconds)) {
+        window = FLXRefreshOffsetWindow(time, window);
+        seconds = flx::timestampToEpoch(time, window.offset);
+    }
+    return (NSTimeInterval) seconds;
+}
+
+@implementation FLXTimestamp
+
++(NSTimeInterval) timeIntervalSince1970ForTimestamp: (IDBlueTimestamp*) timestamp {
+    if (!timestamp) {
+        return NAN;
+    }
+    flx::UtcOffsetWindow window = FLXCurrentOffsetWindow();
+    return FLXTimeIntervalForReaderTimestamp(FLXReaderTimestamp(timestamp), window);
+}
+
++(NSDate*) dateForTimestamp: (IDBlueTimestamp*) timestamp {
+    NSTimeInterval interval = [self timeIntervalSince1970ForTimestamp:timestamp];
+    return isnan(interval) ? nil : [NSDate dateWithTimeIntervalSince1970:interval];
+}
+
++(IDBlueTimestamp*) timestampForDate: (NSDate*) date {
+    if (!date) {
+        return nil;
+    }
+    int64_t seconds = (int64_t) floor([date timeIntervalSince1970]);
+    flx::UtcOffsetWindow window = FLXCurrentOffsetWindow();
+    if (!window.covers(seconds)) {
+        FLXObserveTimeZoneChanges();
+        window = FLXOffsetWindowAt(seconds);
+        OSSpinLockLock(&FLXOffsetLock);
+        FLXOffsetWindow = window;
+        OSSpinLockUnlock(&FLXOffsetLock);
+    }
+    flx::ReaderTimestamp time = flx::timestampFromEpoch(seconds, window.offset);
+
+    IDBlueTimestamp* timestamp = [[IDBlueTimestamp alloc] init];
+    [timestamp setYear:time.year];
+    [timestamp setMonth:time.month];
+    [timestamp setDay:time.day];
+    [timestamp setHour:time.hour];
+    [timestamp setMinute:time.minute];
+    [timestamp setSecond:time.second];
+    return timestamp;
+}
+
++(void) getTimeIntervals: (NSTimeInterval*) intervals forTimestamps: (NSArray*) timestamps {
+    NSUInteger count = [timestamps count];
+    std::vector<flx::ReaderTimestamp> times(count);
+    std::vector<int64_t> seconds(count);
+    NSUInteger index = 0;
+    for (IDBlueTimestamp* timestamp in timestamps) {
+        if ([timestamp isKindOfClass:[IDBlueTimestamp class]]) {
+            times[index] = FLXReaderTimestamp(timestamp);
+        }
+        else {
+            memset(&times[index], 0, sizeof(flx::ReaderTimestamp));
+        }
+        index++;
+    }
+
+    // Convert runs under one offset; refresh it only where a run ends
+    flx::UtcOffsetWindow window = FLXCurrentOffsetWindow();
+    size_t done = 0;
+    while (done < count) {
+        if (!flx::isValidTimestamp(times[done])) {
+            intervals[done++] = NAN;
+            continue;
+        }
+        size_t converted = flx::timestampsToEpoch(&times[done], count - done, window, &seconds[done]);
+        for (size_t i = done; i < done + converted; i++) {
+            intervals[i] = flx::isValidTimestamp(times[i]) ? (NSTimeInterval) seconds[i] : NAN;
+        }
+        done += converted;
+        if (done < count && flx::isValidTimestamp(times[done])) {
+            intervals[done] = FLXTimeIntervalForReaderTimestamp(times[done], window);
+            done++;
+        }
+    }
+}
+
++(NSArray*) datesForTimestamps: (NSArray*) timestamps {
+    NSUInteger count = [timestamps count];
+    std::vector<NSTimeInterval> intervals(count);
+    [self getTimeIntervals:intervals.data() forTimestamps:timestamps];
+
+    NSMutableArray* dates = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [dates addObject:isnan(intervals[i]) ? (id) [NSNull null] : [NSDate dateWithTimeIntervalSince1970:intervals[i]]];
+    }
+    return dates;
+}
+
++(void) resetTimeZoneCache {
+    OSSpinLockLock(&FLXOffsetLock);
+    FLXOffsetWindow.validFrom = 0;
+    FLXOffsetWindow.validUntil = 0;
+    OSSpinLockUnlock(&FLXOffsetLock);
+}
+
+@end
@@ -0,0 +1,33 @@
+//
+//  FLXTraceLog.h
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// FLXTraceLog controls the process-wide flx::TraceLog (Core/TraceLog.h), the
+// binary log the scan path writes with FLX_TRACE instead of NSLog. Records
+// are formatted by a background writer and appended to a text file; at most
+// two files of maxBytes are kept (the older one with a ".1" suffix).
+//
+// FLX_TRACE itself is C++; use it from .mm files.
+@interface FLXTraceLog : NSObject
+
+// Start recording and writing to Library/Caches/FLXTrace.log
++(BOOL) start;
++(BOOL) startWritingToPath: (NSString*) path maxBytes: (NSUInteger) maxBytes;
+// Write what was recorded and stop recording
++(void) stop;
+
+// Write everything recorded so far before returning
++(void) flush;
+
++(BOOL) isEnabled;
+// Records lost because a thread logged faster than the writer drained
++(unsigned long long) droppedRecords;
++(NSString*) path;
+
+@end
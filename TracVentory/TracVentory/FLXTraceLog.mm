@@ -0,0 +1,65 @@
+//
+//  FLXTraceLog.mm
+//  TracVentory
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import "FLXTraceLog.h"
+#include "TraceLog.h"
+
+// Drain often enough that a continuous scan never fills a thread's ring
+static const uint32_t kFLXTraceWriteIntervalMs = 250;
+
+static NSString* FLXTracePath = nil;
+
+@implementation FLXTraceLog
+
++(BOOL) start {
+    NSString* caches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    return [self startWritingToPath:[caches stringByAppendingPathComponent:@"FLXTrace.log"] maxBytes:4 << 20];
+}
+
++(BOOL) startWritingToPath: (NSString*) path maxBytes: (NSUInteger) maxBytes {
+    @synchronized (self) {
+        if (FLXTracePath) {
+            return NO;
+        }
+        if (!flx::TraceLog::startWriter([path fileSystemRepresentation], kFLXTraceWriteIntervalMs, maxBytes)) {
+            NSLog(@"Cannot write the trace log to %@", path);
+            return NO;
+        }
+        FLXTracePath = [path copy];
+        flx::TraceLog::setEnabled(true);
+        return YES;
+    }
+}
+
++(void) stop {
+    @synchronized (self) {
+        flx::TraceLog::setEnabled(false);
+        flx::TraceLog::stopWriter();
+        FLXTracePath = nil;
+    }
+}
+
++(void) flush {
+    flx::TraceLog::flush();
+}
+
++(BOOL) isEnabled {
+    return flx::TraceLog::enabled();
+}
+
++(unsigned long long) droppedRecords {
+    return flx::TraceLog::stats().dropped;
+}
+
++(NSString*) path {
+    @synchronized (self) {
+        return FLXTracePath;
+    }
+}
+
+@end
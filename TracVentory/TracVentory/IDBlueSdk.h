@@ -14,16 +14,58 @@
 #import <IDBLUE/iOSSession.h>
 #import <IDBLUE/IDBLUE.h>
 
+@class FLXReaderSession;
+@class FLXTagInfo;
+@class FLXTagInfoCache;
+
+typedef void (^FLXReadTagIdCompletion)(ReadTagIdResponse* response, NackResponse* nack);
+typedef void (^FLXGetEntryCompletion)(GetEntryResponse* response, NackResponse* nack);
+typedef void (^FLXGetEntryCountCompletion)(GetEntryCountResponse* response, NackResponse* nack);
+typedef void (^FLXSimpleCompletion)(IDBlueResponse* response, NackResponse* nack);
+typedef void (^FLXTagInfoCompletion)(FLXTagInfo* info, NackResponse* nack);
+typedef void (^FLXTidCompletion)(NSData* tid, NackResponse* nack);
+
 // By subclassing IDBlueiOSSdk, IDBlueSdk is the only object from the IDBLUE
 // iOS SDK you need to instantiate. 
 @interface IDBlueSdk : IDBlueCoreApi {
     iOSSession* _iosSession;
+    NSMutableSet* _pendingCompletions;
 }
 
+// Tags scanned with the button on IDBLUE (asynchronous readTagId responses)
+@property (copy, nonatomic) void (^tagScanned)(ReadTagIdResponse* response);
+
 // Methods that illustarte how to use the IDBlueiOSSdk
 -(BOOL) openIDBlueSession;
 -(BOOL) closeIDBlueSession;
 -(BOOL) getTagId;
+
+// Send a command whose response or NACK goes to the completion alone rather
+// than to every registered IResponseHandler. The completion runs once, with
+// both arguments nil if the session closes before IDBLUE answers; it does not
+// run at all if the command could not be sent (NO is returned). Transient
+// NACKs are retried first; see FLXCommandCompletion.
+-(BOOL) readTagIdWithCompletion: (FLXReadTagIdCompletion) completion;
+-(BOOL) getEntry: (int) index completion: (FLXGetEntryCompletion) completion;
+-(BOOL) getEntryCountWithCompletion: (FLXGetEntryCountCompletion) completion;
+-(BOOL) clearEntriesWithCompletion: (FLXSimpleCompletion) completion;
+-(BOOL) beep: (BeepType) bt completion: (FLXSimpleCompletion) completion;
+
+// Per-tag metadata that never changes: the user memory geometry
+// (GET_TAG_INFO) and the TID bank of the tag in the field. tagInfoCache is
+// consulted first, and on a hit the completion runs on the next turn of the
+// main queue without a command being sent; answers from IDBLUE are cached.
+// readTidOfTag: reads the EPC before and after the TID to make sure tag is
+// the one that answered; if another tag did, the completion gets nil for
+// both arguments and nothing is cached.
+@property (strong, nonatomic) FLXTagInfoCache* tagInfoCache;
+-(BOOL) getTagInfo: (RfidTag*) tag completion: (FLXTagInfoCompletion) completion;
+-(BOOL) readTidOfTag: (RfidTag*) tag completion: (FLXTidCompletion) completion;
+
+// The session to the IDBLUE device, for capturing and replaying traffic
+-(FLXReaderSession*) readerSession;
+// Serial number of the connected IDBLUE device, nil if none
+-(NSString*) readerID;
 -(void) registerSessionHandler: (id<ISessionHandler>) handler;
 -(void) registerIDBlueResponseHandler: (id<IResponseHandler>) handler;
 @end
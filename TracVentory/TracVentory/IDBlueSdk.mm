@@ -0,0 +1,313 @@
+//
+//  IDBlueSdk.mm
+//  iPhoneSampleApp
+//
+//  Copyright 2010-2011 Cathexis Innovations Inc. All rights reserved.
+//
+
+#import "IDBlueSdk.h"
+#import "FLXReaderSession.h"
+#import "FLXCommandCompletion.h"
+#import "FLXTagInfoCache.h"
+#import <IDBLUE/EpcReadTagCommand.h>
+#import <IDBLUE/EpcReadTagResponse.h>
+#import <IDBLUE/GetTagInfoCommand.h>
+#import <IDBLUE/GetTagInfoResponse.h>
+#import <IDBLUE/IDBlueUhfApi.h>
+#include "TraceLog.h"
+
+// A 96-bit TID: class, vendor and model, then the chip serial
+static const byte FLXTidWords = 6;
+
+@implementation IDBlueSdk
+-(id) init {
+    _iosSession = [[FLXReaderSession alloc] init];
+    if (!_iosSession) {
+        return nil;
+    }
+    
+    self = [super initWithSession:_iosSession];
+    if (self) {
+        // Log the current version of the SDK we are using
+        NSLog(@"%@", [self sdkVersion]);
+        _pendingCompletions = [[NSMutableSet alloc] init];
+        _tagInfoCache = [FLXTagInfoCache sharedCache];
+    }
+    return self;
+}
+
+
+
+// This method illustrates one method for opening a session to an IDBLUE device.
+-(BOOL) openIDBlueSession {
+    // The External Accessory Framework only allows for one accessory to be 
+    // connected to the iOS based device (e.g. iPhone) at a time. So when
+    // we want to connect, we can just try to connect to the first IDBLUE
+    // device found (if one exists). That's exactly what the openFirstIDBlueDeice
+    // does.
+    BOOL sessionStarted = [_iosSession openFirstIDBlueDevice];
+    if (sessionStarted) {
+        NSLog(@"A session was started.");
+        // The session was started. We will be notified when the session is
+        // open via the onSessionOpened callback method of IDBlueSessionDelegate.
+    }
+    else {
+        NSLog(@"Failed to open a session. Is an IDBLUE device paired with the iPhone?");
+    }
+    return sessionStarted;
+}
+
+// This method illustrates how to close a session once it has been opened
+-(BOOL) closeIDBlueSession {
+    BOOL closeStarted = [self closeSession];
+    if (closeStarted) {
+        // Closing the session was started. We will be notified when the session is
+        // closed via the onSessionClosed callback method of IDBlueSessionDelegate.
+    }
+    else {
+        NSLog(@"Failed to close the session. We're we even connected?");
+    }
+    return closeStarted;
+}
+
+// Illustrates how to get IDBLUE to scan an RFID tag and give us back the tag id.
+// If IDBLUE finds a tag, the scanTagIdResponse callback method will be invoked.
+// If no RFID tag was found or an error occurred, the scanTagIdFailed callback 
+// method will be invoked.
+-(BOOL) getTagId {
+	SendStatus* status = [self readTagId:self];
+	if ([status successful]) {
+		FLX_TRACE("GetTagId sent");
+		return TRUE;
+	}
+	else {
+		FLX_TRACE("GetTagId could not be sent");
+		return FALSE;
+	} 
+}
+
+// Sends a command with its own handler and keeps the handler alive until
+// IDBLUE answers, since the SDK does not retain it
+-(BOOL) sendCommand: (CommandIdentifier) command
+               with: (FLXCommandSend) send
+         completion: (FLXResponseCompletion) completion {
+    __weak NSMutableSet* pending = _pendingCompletions;
+    FLXCommandCompletion* handler = [[FLXCommandCompletion alloc] initWithCommand:command
+                                                                             send:send
+                                                                       completion:completion
+                                                                         finished:^(FLXCommandCompletion* done) {
+        [pending removeObject:done];
+    }];
+    [_pendingCompletions addObject:handler];
+    if ([handler send]) {
+        return TRUE;
+    }
+    [_pendingCompletions removeObject:handler];
+    return FALSE;
+}
+
+-(BOOL) readTagIdWithCompletion: (FLXReadTagIdCompletion) completion {
+    __weak IDBlueSdk* weakSelf = self;
+    return [self sendCommand:CI_GET_TAG_ID with:^SendStatus* (id<IResponseHandler> handler) {
+        return [weakSelf readTagId:handler];
+    } completion:(FLXResponseCompletion) completion];
+}
+
+-(BOOL) getEntry: (int) index completion: (FLXGetEntryCompletion) completion {
+    __weak IDBlueSdk* weakSelf = self;
+    return [self sendCommand:CI_GET_ENTRY with:^SendStatus* (id<IResponseHandler> handler) {
+        return [weakSelf getEntry:index withHandler:handler];
+    } completion:(FLXResponseCompletion) completion];
+}
+
+-(BOOL) getEntryCountWithCompletion: (FLXGetEntryCountCompletion) completion {
+    __weak IDBlueSdk* weakSelf = self;
+    return [self sendCommand:CI_GET_ENTRY_COUNT with:^SendStatus* (id<IResponseHandler> handler) {
+        return [weakSelf getEntryCount:handler];
+    } completion:(FLXResponseCompletion) completion];
+}
+
+-(BOOL) clearEntriesWithCompletion: (FLXSimpleCompletion) completion {
+    __weak IDBlueSdk* weakSelf = self;
+    return [self sendCommand:CI_CLEAR_ENTRIES with:^SendStatus* (id<IResponseHandler> handler) {
+        return [weakSelf clearEntries:handler];
+    } completion:(FLXResponseCompletion) completion];
+}
+
+-(BOOL) beep: (BeepType) bt completion: (FLXSimpleCompletion) completion {
+    __weak IDBlueSdk* weakSelf = self;
+    return [self sendCommand:CI_BEEP with:^SendStatus* (id<IResponseHandler> handler) {
+        return [weakSelf beep:bt withHandler:handler];
+    } completion:(FLXResponseCompletion) completion];
+}
+
+-(BOOL) getTagInfo: (RfidTag*) tag completion: (FLXTagInfoCompletion) completion {
+    NSData* tagId = [NSData dataWithBytes:[tag data] length:[tag arrayLength]];
+    FLXTagInfoCache* cache = self.tagInfoCache;
+    NSData* cached = [cache infoForTag:tag kind:FLXTagInfoGeometry];
+    // Block count and bytes per block; anything shorter (a torn or foreign
+    // cache file) is asked of the reader again, which replaces it
+    if ([cached length] >= 2) {
+        const byte* geometry = (const byte*) [cached bytes];
+        FLXTagInfo* info = [[FLXTagInfo alloc] initWithTagId:tagId blockCount:geometry[0] bytesPerBlock:geometry[1] cached:YES];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(info, nil);
+        });
+        return TRUE;
+    }
+
+    __weak IDBlueSdk* weakSelf = self;
+    return [self sendCommand:CI_GET_TAG_INFO with:^SendStatus* (id<IResponseHandler> handler) {
+        GetTagInfoCommand* command = [[GetTagInfoCommand alloc] initWithTagId:[tag data] withLen:[tag arrayLength]];
+        return [weakSelf sendCommand:command withHandler:handler];
+    } completion:^(id response, NackResponse* nack) {
+        if (!response) {
+            completion(nil, nack);
+            return;
+        }
+        byte geometry[2] = { [response blockCount], [response bytesPerBlock] };
+        // Keyed by the tag that answered, as reported by IDBLUE
+        RfidTag* answered = [response rfidTag];
+        if (answered) {
+            [cache setInfo:[NSData dataWithBytes:geometry length:sizeof(geometry)] forTag:answered kind:FLXTagInfoGeometry];
+        }
+        completion([[FLXTagInfo alloc] initWithTagId:tagId blockCount:geometry[0] bytesPerBlock:geometry[1] cached:NO], nil);
+    }];
+}
+
+// Reads the EPC of whichever tag is in the field; isTag tells whether it is
+// tag. EpcRead responses carry no tag id, so this is the only way to know
+// which tag answered.
+-(BOOL) readEpcInFieldMatching: (RfidTag*) tag completion: (void (^)(BOOL isTag, NackResponse* nack)) completion {
+    // The EPC follows the CRC and PC words of the EPC bank
+    byte words = (byte) (([tag arrayLength] + 1) / 2);
+    NSData* expected = [NSData dataWithBytes:[tag data] length:[tag arrayLength]];
+    __weak IDBlueSdk* weakSelf = self;
+    return [self sendCommand:CI_READ_UHF with:^SendStatus* (id<IResponseHandler> handler) {
+        EpcReadTagCommand* command = [[EpcReadTagCommand alloc] initWithBank:BANK_EPC withAddr:2 withNumWords:words];
+        return [weakSelf sendCommand:command withHandler:handler];
+    } completion:^(id response, NackResponse* nack) {
+        if (!response) {
+            completion(NO, nack);
+            return;
+        }
+        CByteArray* data = [response tagData];
+        NSData* epc = [NSData dataWithBytes:[data data] length:MIN((NSUInteger) [data arrayLength], [expected length])];
+        completion([epc isEqualToData:expected], nil);
+    }];
+}
+
+-(BOOL) readTidOfTag: (RfidTag*) tag completion: (FLXTidCompletion) completion {
+    FLXTagInfoCache* cache = self.tagInfoCache;
+    NSData* cached = [cache infoForTag:tag kind:FLXTagInfoTid];
+    if (cached) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(cached, nil);
+        });
+        return TRUE;
+    }
+
+    // epcRead reads whichever tag is in the field, so the TID read is
+    // bracketed by EPC reads: it is tag's only if tag answered both
+    __weak IDBlueSdk* weakSelf = self;
+    return [self readEpcInFieldMatching:tag completion:^(BOOL isTagBefore, NackResponse* nack) {
+        if (!isTagBefore) {
+            completion(nil, nack);
+            return;
+        }
+        BOOL sent = [weakSelf sendCommand:CI_READ_UHF with:^SendStatus* (id<IResponseHandler> handler) {
+            EpcReadTagCommand* command = [[EpcReadTagCommand alloc] initWithBank:BANK_TID withAddr:0 withNumWords:FLXTidWords];
+            return [weakSelf sendCommand:command withHandler:handler];
+        } completion:^(id response, NackResponse* nack) {
+            if (!response) {
+                completion(nil, nack);
+                return;
+            }
+            CByteArray* data = [response tagData];
+            NSData* tid = [NSData dataWithBytes:[data data] length:[data arrayLength]];
+            BOOL sent = [weakSelf readEpcInFieldMatching:tag completion:^(BOOL isTagAfter, NackResponse* nack) {
+                if (!isTagAfter) {
+                    completion(nil, nack);
+                    return;
+                }
+                [cache setInfo:tid forTag:tag kind:FLXTagInfoTid];
+                completion(tid, nil);
+            }];
+            if (!sent) {
+                completion(nil, nil);
+            }
+        }];
+        if (!sent) {
+            completion(nil, nil);
+        }
+    }];
+}
+
+-(FLXReaderSession*) readerSession {
+    return (FLXReaderSession*) _iosSession;
+}
+
+-(NSString*) readerID {
+    EAAccessory* device = [_iosSession getDevice];
+    return [device serialNumber];
+}
+
+// You can use the IDBlueiOSSdk without subclassing it. If you do this,
+// your application has no way of receiving session events (e.g. open, 
+// close, etc.) unless you register a session delegate with the IDBlueiOSSdk
+// first. This method illustrates the use of addSessionDelegate.
+-(void) registerSessionHandler: (id<ISessionHandler>) handler {
+	[self addSessionHandler:handler];
+}
+
+// You can use the IDBlueiOSSdk without subclassing it. If you do this,
+// your application has no way of receiving responses from IDBLUE unless you 
+// register a receiver delegate with the IDBlueiOSSdk first. This method 
+// illustrates the use of addDelegate.
+-(void) registerIDBlueResponseHandler: (id<IResponseHandler>) handler {
+	[self addResponseHandler:handler];
+}
+
+// IDBlueSessionDelegate callback methods we are overriding
+-(void) onSessionOpened: (id) session {
+	[super onSessionOpened:session];
+	NSLog(@"IDBLUE session opened");
+}
+
+-(void) onSessionClosed: (id) session {
+	[super onSessionClosed:session];
+	NSLog(@"IDBLUE session closed");
+	// Nothing will answer the commands still outstanding
+	for (FLXCommandCompletion* handler in [_pendingCompletions allObjects]) {
+		[handler completeWithResponse:nil nack:nil];
+	}
+}
+
+-(void) onIDBlueDeviceAdded: (id) device {
+	if ([self isSessionOpen] == FALSE) {
+		[self openIDBlueSession];
+	}
+}
+
+-(void) onIDBlueDeviceRemoved: (id) device {
+
+}
+
+// IDBlueReceiverDelegate callback methods we are overriding
+-(void) readTagIdResponse: (IDBlueCommand*) command 
+			 withResponse: (ReadTagIdResponse*) response {
+	[super readTagIdResponse:command withResponse:response];
+	RfidTag* tag = [response rfidTag];
+	FLX_TRACE("Got tag id %s (async %d)", flx::TraceHex([tag data], [tag arrayLength]), [response async]);
+	if ([response async] && self.tagScanned) {
+		self.tagScanned(response);
+	}
+}
+
+-(void) readTagIdFailed: (IDBlueCommand*) command 
+		   withResponse: (NackResponse*) response {
+	[super readTagIdFailed:command withResponse:response];
+	FLX_TRACE("GetTagId failed with status 0x%x", [response status]);
+}
+
+@end
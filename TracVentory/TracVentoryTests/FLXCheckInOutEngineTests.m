@@ -0,0 +1,129 @@
+//
+//  FLXCheckInOutEngineTests.m
+//  TracVentoryTests
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "FLXCheckInOutEngine.h"
+#import "FLXLocalStore.h"
+
+@interface FLXCheckInOutEngineTests : XCTestCase {
+    NSString* _directory;
+    FLXLocalStore* _store;
+}
+@end
+
+@implementation FLXCheckInOutEngineTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    _directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [[NSFileManager defaultManager] createDirectoryAtPath:_directory withIntermediateDirectories:YES attributes:nil error:NULL];
+
+    // An in-memory store holding one tagged item
+    _store = [[FLXLocalStore alloc] initWithDirectory:nil];
+    [_store markClassLocalOnly:@"Items"];
+    [_store putRecords:@[@{@"objectId": @"item1", @"itemID": @"E0040000ABCD"}] inClass:@"Items"];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:_directory error:NULL];
+    [super tearDown];
+}
+
+- (FLXCheckInOutEngine *)engineWithLogName:(NSString *)name
+{
+    FLXCheckInOutEngine *engine = [[FLXCheckInOutEngine alloc] initWithLogPath:[_directory stringByAppendingPathComponent:name]
+                                                                         store:_store];
+    engine.savesToParse = NO;
+    return engine;
+}
+
+- (void)testRecoversEventsJournaledButNotApplied
+{
+    NSDate *scanTime = [NSDate dateWithTimeIntervalSince1970:1790000000];
+    FLXCheckInOutEngine *engine = [self engineWithLogName:@"crashed.journal"];
+    // The app goes away long before the batch would be written
+    engine.flushInterval = 3600;
+    XCTAssertNotNil([engine recordTagId:@"E0 04 00 00 AB CD" direction:FLXCheckIn locationID:@"dock" readerID:@"pen" scanTime:scanTime error:NULL]);
+    XCTAssertNil([_store recordWithId:@"item1" inClass:@"Items"][@"status"]);
+
+    // The journal as a crash leaves it: the event appended, nothing marked
+    // applied. The mapping is shared, so the file already holds the record.
+    NSError *error = nil;
+    XCTAssertTrue([[NSFileManager defaultManager] copyItemAtPath:[_directory stringByAppendingPathComponent:@"crashed.journal"]
+                                                          toPath:[_directory stringByAppendingPathComponent:@"reopened.journal"]
+                                                           error:&error], @"%@", error);
+
+    FLXCheckInOutEngine *reopened = [self engineWithLogName:@"reopened.journal"];
+    [reopened flush];
+
+    NSDictionary *item = [_store recordWithId:@"item1" inClass:@"Items"];
+    XCTAssertEqualObjects(item[@"status"], @"Checked In");
+    XCTAssertEqualObjects(item[@"locationID"], @"dock");
+    XCTAssertEqualObjects(item[@"lastCheckAt"], scanTime);
+
+    // The same read delivered again is still recognized
+    XCTAssertNil([reopened recordTagId:@"E0040000ABCD" direction:FLXCheckIn locationID:@"dock" readerID:@"pen" scanTime:scanTime error:NULL]);
+}
+
+- (void)testOlderScanDoesNotTakeItemBack
+{
+    NSDate *checkedOutAt = [NSDate dateWithTimeIntervalSince1970:1790000600];
+    FLXCheckInOutEngine *engine = [self engineWithLogName:@"stale.journal"];
+    XCTAssertNotNil([engine recordTagId:@"E0040000ABCD" direction:FLXCheckOut locationID:nil readerID:@"pen" scanTime:checkedOutAt error:NULL]);
+    [engine flush];
+
+    // A check-in read ten minutes earlier arrives late from another reader
+    XCTAssertNotNil([engine recordTagId:@"E0040000ABCD" direction:FLXCheckIn locationID:@"dock" readerID:@"gate"
+                               scanTime:[checkedOutAt dateByAddingTimeInterval:-600] error:NULL]);
+    [engine flush];
+
+    NSDictionary *item = [_store recordWithId:@"item1" inClass:@"Items"];
+    XCTAssertEqualObjects(item[@"status"], @"Checked Out");
+    XCTAssertNil(item[@"locationID"]);
+    XCTAssertEqualObjects(item[@"lastCheckAt"], checkedOutAt);
+}
+
+- (void)testReplayRebuildsPurgedItemFromSnapshotAndJournal
+{
+    FLXCheckInOutEngine *engine = [self engineWithLogName:@"replay.journal"];
+    // Enough applied entries for the journal to be compacted into the snapshot
+    NSDate *start = [NSDate dateWithTimeIntervalSince1970:1790000000];
+    NSUInteger count = 2000;
+    for (NSUInteger i = 0; i < count; i++) {
+        XCTAssertNotNil([engine recordTagId:@"E0040000ABCD" direction:i % 2 ? FLXCheckOut : FLXCheckIn
+                                 locationID:@"dock" readerID:@"pen" scanTime:[start dateByAddingTimeInterval:i] error:NULL]);
+    }
+    [engine flush];
+    // The applied mark (and compaction) follows the batch
+    [engine flush];
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:[_directory stringByAppendingPathComponent:@"replay.snapshot"]]);
+
+    // The snapshot holds the check-out compacted away last; a check-in
+    // after it is only in the journal
+    NSDate *checkedInAt = [start dateByAddingTimeInterval:count];
+    XCTAssertNotNil([engine recordTagId:@"E0040000ABCD" direction:FLXCheckIn locationID:@"shelf" readerID:@"pen" scanTime:checkedInAt error:NULL]);
+    [engine flush];
+
+    // The store comes back from Parse without the scans
+    [_store putRecords:@[@{@"objectId": @"item1", @"itemID": @"E0040000ABCD"}] inClass:@"Items"];
+    XCTAssertEqual([engine replayLog], (NSUInteger) 1);
+
+    NSDictionary *item = [_store recordWithId:@"item1" inClass:@"Items"];
+    XCTAssertEqualObjects(item[@"status"], @"Checked In");
+    XCTAssertEqualObjects(item[@"locationID"], @"shelf");
+    XCTAssertEqualObjects(item[@"lastCheckAt"], checkedInAt);
+
+    // Nothing left to rebuild
+    XCTAssertEqual([engine replayLog], (NSUInteger) 0);
+}
+
+@end
+
@@ -0,0 +1,163 @@
+//
+//  FLXLocalQueryTests.m
+//  TracVentoryTests
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <Parse/Parse.h>
+#import "FLXLocalQuery.h"
+
+@interface FLXLocalQueryTests : XCTestCase {
+    FLXLocalStore* _store;
+}
+@end
+
+@implementation FLXLocalQueryTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    // A local-only class is answered locally without a sync
+    _store = [[FLXLocalStore alloc] initWithDirectory:nil];
+    [_store markClassLocalOnly:@"Items"];
+    [_store ensureIndexForKey:@"locationID" inClass:@"Items"];
+    [_store putRecords:@[@{@"objectId": @"a", @"make": @"Acme", @"cost": @120, @"locationID": @"dock",
+                           @"tags": @[@"red", @"big"], @"itemDate": [NSDate dateWithTimeIntervalSince1970:1000]},
+                         @{@"objectId": @"b", @"make": @"Apex", @"cost": @80, @"locationID": @"dock",
+                           @"itemDate": [NSDate dateWithTimeIntervalSince1970:2000]},
+                         @{@"objectId": @"c", @"make": @"Bolt", @"cost": @"n/a", @"locationID": @"yard",
+                           @"tags": @[@"red"]},
+                         @{@"objectId": @"d", @"cost": @15, @"owner": @"user1"}]
+               inClass:@"Items"];
+}
+
+- (NSArray *)objectIdsOf:(FLXLocalQuery *)query
+{
+    NSArray *objects = [query findObjects];
+    XCTAssertNotNil(objects);
+    return [objects valueForKey:@"objectId"];
+}
+
+- (NSSet *)objectIdSetOf:(FLXLocalQuery *)query
+{
+    return [NSSet setWithArray:[self objectIdsOf:query]];
+}
+
+- (FLXLocalQuery *)query
+{
+    return [[FLXLocalQuery alloc] initWithClassName:@"Items" store:_store];
+}
+
+- (void)testEqualityOperators
+{
+    FLXLocalQuery *indexed = [self query];
+    [indexed whereKey:@"locationID" equalTo:@"dock"];
+    XCTAssertEqualObjects([self objectIdSetOf:indexed], ([NSSet setWithObjects:@"a", @"b", nil]));
+
+    FLXLocalQuery *notEqual = [self query];
+    [notEqual whereKey:@"locationID" notEqualTo:@"dock"];
+    XCTAssertEqualObjects([self objectIdSetOf:notEqual], ([NSSet setWithObjects:@"c", @"d", nil]));
+
+    // A scalar matches an array key if any element does
+    FLXLocalQuery *element = [self query];
+    [element whereKey:@"tags" equalTo:@"red"];
+    XCTAssertEqualObjects([self objectIdSetOf:element], ([NSSet setWithObjects:@"a", @"c", nil]));
+
+    // A pointer matches the objectId the record holds
+    FLXLocalQuery *pointer = [self query];
+    [pointer whereKey:@"owner" equalTo:[PFObject objectWithoutDataWithClassName:@"_User" objectId:@"user1"]];
+    XCTAssertEqualObjects([self objectIdsOf:pointer], @[@"d"]);
+
+    FLXLocalQuery *missing = [self query];
+    [missing whereKey:@"make" equalTo:nil];
+    XCTAssertEqualObjects([self objectIdsOf:missing], @[@"d"]);
+}
+
+- (void)testExistenceAndMembership
+{
+    FLXLocalQuery *exists = [self query];
+    [exists whereKeyExists:@"tags"];
+    XCTAssertEqualObjects([self objectIdSetOf:exists], ([NSSet setWithObjects:@"a", @"c", nil]));
+
+    FLXLocalQuery *doesNotExist = [self query];
+    [doesNotExist whereKeyDoesNotExist:@"locationID"];
+    XCTAssertEqualObjects([self objectIdsOf:doesNotExist], @[@"d"]);
+
+    FLXLocalQuery *containedIn = [self query];
+    [containedIn whereKey:@"locationID" containedIn:@[@"yard", @"office"]];
+    XCTAssertEqualObjects([self objectIdsOf:containedIn], @[@"c"]);
+
+    FLXLocalQuery *notContainedIn = [self query];
+    [notContainedIn whereKey:@"make" notContainedIn:@[@"Acme", @"Apex"]];
+    XCTAssertEqualObjects([self objectIdSetOf:notContainedIn], ([NSSet setWithObjects:@"c", @"d", nil]));
+}
+
+- (void)testComparisonsSkipValuesOfOtherTypes
+{
+    FLXLocalQuery *lessThan = [self query];
+    [lessThan whereKey:@"cost" lessThan:@100];
+    XCTAssertEqualObjects([self objectIdSetOf:lessThan], ([NSSet setWithObjects:@"b", @"d", nil]));
+
+    FLXLocalQuery *atMost = [self query];
+    [atMost whereKey:@"cost" lessThanOrEqualTo:@80];
+    XCTAssertEqualObjects([self objectIdSetOf:atMost], ([NSSet setWithObjects:@"b", @"d", nil]));
+
+    FLXLocalQuery *greaterThan = [self query];
+    [greaterThan whereKey:@"cost" greaterThan:@80];
+    XCTAssertEqualObjects([self objectIdsOf:greaterThan], @[@"a"]);
+
+    FLXLocalQuery *since = [self query];
+    [since whereKey:@"itemDate" greaterThanOrEqualTo:[NSDate dateWithTimeIntervalSince1970:2000]];
+    XCTAssertEqualObjects([self objectIdsOf:since], @[@"b"]);
+}
+
+- (void)testHasPrefix
+{
+    FLXLocalQuery *prefix = [self query];
+    [prefix whereKey:@"make" hasPrefix:@"A"];
+    XCTAssertEqualObjects([self objectIdSetOf:prefix], ([NSSet setWithObjects:@"a", @"b", nil]));
+
+    // Rejected when built: nothing matches, nothing raises
+    FLXLocalQuery *nilPrefix = [self query];
+    [nilPrefix whereKey:@"make" hasPrefix:nil];
+    XCTAssertEqualObjects([self objectIdsOf:nilPrefix], @[]);
+}
+
+- (void)testSortOrdersMissingAndMixedTypes
+{
+    // cost holds numbers and a string; make is missing on d
+    FLXLocalQuery *byCost = [self query];
+    [byCost orderByAscending:@"cost"];
+    XCTAssertEqualObjects([self objectIdsOf:byCost], (@[@"d", @"b", @"a", @"c"]));
+
+    FLXLocalQuery *byCostDescending = [self query];
+    [byCostDescending orderByDescending:@"cost"];
+    XCTAssertEqualObjects([self objectIdsOf:byCostDescending], (@[@"c", @"a", @"b", @"d"]));
+
+    FLXLocalQuery *byMake = [self query];
+    [byMake orderByAscending:@"make"];
+    XCTAssertEqualObjects([self objectIdsOf:byMake], (@[@"d", @"a", @"b", @"c"]));
+
+    // Ties on the first key fall to the second
+    FLXLocalQuery *byLocation = [self query];
+    [byLocation orderByDescending:@"locationID"];
+    [byLocation addAscendingOrder:@"make"];
+    XCTAssertEqualObjects([self objectIdsOf:byLocation], (@[@"c", @"a", @"b", @"d"]));
+}
+
+- (void)testLimitSkipAndCount
+{
+    FLXLocalQuery *page = [self query];
+    [page orderByAscending:@"objectId"];
+    page.skip = 1;
+    page.limit = 2;
+    XCTAssertEqualObjects([self objectIdsOf:page], (@[@"b", @"c"]));
+    XCTAssertEqual([page countObjects], (NSInteger) 4);
+    XCTAssertEqualObjects([page getFirstObject][@"objectId"], @"b");
+}
+
+@end
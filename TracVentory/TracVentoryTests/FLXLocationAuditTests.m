@@ -0,0 +1,106 @@
+//
+//  FLXLocationAuditTests.m
+//  TracVentoryTests
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "FLXLocationAudit.h"
+#import "FLXScannerBus.h"
+#import "FLXScanSources.h"
+
+@interface FLXLocationAuditTests : XCTestCase {
+    FLXLocalStore* _store;
+    FLXScannerBus* _bus;
+    FLXSimulatedScanSource* _pen;
+    FLXLocationAudit* _audit;
+}
+@end
+
+@implementation FLXLocationAuditTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    // Three items belong on the dock, one in the yard
+    _store = [[FLXLocalStore alloc] initWithDirectory:nil];
+    [_store markClassLocalOnly:@"Items"];
+    [_store putRecords:@[@{@"objectId": @"item1", @"itemID": @"3074257BF7194E4000001A85", @"locationID": @"dock"},
+                         @{@"objectId": @"item2", @"itemID": @"E0040000ABCD", @"locationID": @"dock"},
+                         @{@"objectId": @"item3", @"itemID": @"E0040000ABCE", @"locationID": @"dock"},
+                         @{@"objectId": @"item4", @"itemID": @"E0040000FFFF", @"locationID": @"yard"}]
+               inClass:@"Items"];
+
+    // Scans reach the audit the way the check-in/out screen feeds it
+    _audit = [[FLXLocationAudit alloc] initWithLocationID:@"dock" store:_store];
+    _bus = [[FLXScannerBus alloc] initWithCapacity:64 dedupWindow:2.0];
+    _pen = [[FLXSimulatedScanSource alloc] initWithSourceType:FLXScanSourceIDBlue readerID:@"pen"];
+    XCTAssertTrue([_bus addSource:_pen]);
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(scanReceived:)
+                                                 name:FLXScanNotification
+                                               object:_bus];
+}
+
+- (void)tearDown
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    [_bus removeSource:_pen];
+    [super tearDown];
+}
+
+- (void)scanReceived:(NSNotification *)notification
+{
+    [_audit recordScan:notification.userInfo[FLXScanKey]];
+}
+
+- (void)deliver
+{
+    [_bus flush];
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+}
+
+- (void)testScanSequenceReportsMissingAndUnexpected
+{
+    XCTAssertEqual(_audit.expectedCount, (NSUInteger) 3);
+
+    XCTAssertTrue([_pen scanTagId:@"3074257BF7194E4000001A85"]);
+    // An asset label printed with the tag id, spaced as the pen shows it
+    XCTAssertTrue([_pen scanBarcode:@"E0 04 00 00 AB CD" symbology:FLXSymbologyCode128]);
+    // The yard item, and a tag no item has
+    XCTAssertTrue([_pen scanTagId:@"E0040000FFFF"]);
+    XCTAssertTrue([_pen scanTagId:@"E00400001234"]);
+    // A product barcode names no item
+    XCTAssertTrue([_pen scanBarcode:@"5901234123457" symbology:FLXSymbologyEan13]);
+    [self deliver];
+
+    XCTAssertEqual(_audit.foundCount, (NSUInteger) 2);
+    XCTAssertEqual(_audit.missingCount, (NSUInteger) 1);
+    XCTAssertEqual(_audit.unexpectedCount, (NSUInteger) 2);
+
+    FLXAuditReport *report = [_audit finish];
+    XCTAssertEqualObjects(report.locationID, @"dock");
+    XCTAssertEqual(report.readCount, (NSUInteger) 4);
+    XCTAssertEqualObjects([NSSet setWithArray:[report.foundItems valueForKey:@"objectId"]], ([NSSet setWithObjects:@"item1", @"item2", nil]));
+    XCTAssertEqualObjects([report.missingItems valueForKey:@"objectId"], @[@"item3"]);
+    XCTAssertEqualObjects([NSSet setWithArray:report.unexpectedTagIds], ([NSSet setWithObjects:@"E0040000FFFF", @"E00400001234", nil]));
+}
+
+- (void)testRepeatedReadsCountOnce
+{
+    XCTAssertEqual([_audit recordTagId:@"E0040000ABCE"], FLXAuditScanFound);
+    XCTAssertEqual([_audit recordTagId:@"e0 04 00 00 ab ce"], FLXAuditScanDuplicate);
+    XCTAssertEqual([_audit recordTagId:@"E0040000FFFF"], FLXAuditScanUnexpected);
+    XCTAssertEqual([_audit recordTagId:@"E0040000FFFF"], FLXAuditScanUnexpectedDuplicate);
+    XCTAssertEqual([_audit recordTagId:@"not a tag"], FLXAuditScanInvalid);
+
+    FLXAuditReport *report = [_audit finish];
+    XCTAssertEqualObjects([report.foundItems valueForKey:@"objectId"], @[@"item3"]);
+    XCTAssertEqual([report.missingItems count], (NSUInteger) 2);
+    XCTAssertEqualObjects(report.unexpectedTagIds, @[@"E0040000FFFF"]);
+}
+
+@end
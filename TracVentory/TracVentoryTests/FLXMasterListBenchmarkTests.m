@@ -0,0 +1,171 @@
+//
+//  FLXMasterListBenchmarkTests.m
+//  TracVentoryTests
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "FLXLocalStore.h"
+#import "FLXItemCursor.h"
+#import "FLXMasterViewController.h"
+
+static const NSUInteger kFLXBenchmarkRows = 50000;
+
+// One frame at 60 fps
+static const CFTimeInterval kFLXFrameBudget = 1.0 / 60.0;
+
+@interface FLXMasterListBenchmarkTests : XCTestCase {
+    FLXLocalStore* _store;
+    FLXItemCursor* _cursor;
+}
+@end
+
+@implementation FLXMasterListBenchmarkTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    _store = [[FLXLocalStore alloc] initWithDirectory:nil];
+    [_store markClassLocalOnly:@"Items"];
+
+    NSMutableArray *records = [[NSMutableArray alloc] initWithCapacity:kFLXBenchmarkRows];
+    NSDate *now = [NSDate date];
+    for (NSUInteger i = 0; i < kFLXBenchmarkRows; i++) {
+        [records addObject:[self recordWithIndex:i updatedAt:[now dateByAddingTimeInterval:-(NSTimeInterval) i]]];
+    }
+    [_store putRecords:records inClass:@"Items"];
+
+    _cursor = [[FLXItemCursor alloc] initWithStore:_store
+                                         className:@"Items"
+                                   sortDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"updatedAt" ascending:NO]]];
+}
+
+- (NSDictionary *)recordWithIndex:(NSUInteger)i updatedAt:(NSDate *)updatedAt
+{
+    return @{@"objectId": [NSString stringWithFormat:@"obj%06lu", (unsigned long) i],
+             @"itemID": [NSString stringWithFormat:@"E2003412%08lX", (unsigned long) i],
+             @"make": @"Zebra",
+             @"model": [NSString stringWithFormat:@"MC%lu", (unsigned long) (i % 97)],
+             @"itemDate": updatedAt,
+             @"updatedAt": updatedAt};
+}
+
+// Cursor callbacks are delivered on the main queue, so spin the run loop.
+- (void)waitForFlag:(BOOL *)flag
+{
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:30.0];
+    while (!*flag && [timeout timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    XCTAssertTrue(*flag, @"Timed out waiting for the cursor");
+}
+
+- (void)loadCursor
+{
+    __block BOOL done = NO;
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    [_cursor reloadWithCompletion:^{
+        done = YES;
+    }];
+    [self waitForFlag:&done];
+    NSLog(@"Loaded %lu rows in %.1f ms", (unsigned long) _cursor.count, (CFAbsoluteTimeGetCurrent() - start) * 1000.0);
+    XCTAssertEqual(_cursor.count, kFLXBenchmarkRows);
+}
+
+- (void)testCellModelPagesFitInFrame
+{
+    [self loadCursor];
+
+    CFTimeInterval worst = 0;
+    for (NSUInteger row = 0; row < _cursor.count; row++) {
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        FLXItemCellModel *model = [_cursor cellModelAtIndex:row];
+        worst = MAX(worst, CFAbsoluteTimeGetCurrent() - start);
+        XCTAssertNotNil(model.title);
+    }
+    NSLog(@"Slowest cell model lookup (page build): %.2f ms", worst * 1000.0);
+    XCTAssertTrue(worst < kFLXFrameBudget, @"Slowest frame took %.2f ms", worst * 1000.0);
+}
+
+- (void)testScrollingFiftyThousandRows
+{
+    [self loadCursor];
+
+    FLXMasterViewController *controller = [[FLXMasterViewController alloc] initWithStyle:UITableViewStylePlain];
+    controller.itemCursor = _cursor;
+    UITableView *tableView = controller.tableView;
+    tableView.frame = CGRectMake(0, 0, 320, 568);
+    [tableView registerClass:[UITableViewCell class] forCellReuseIdentifier:@"Cell"];
+    [tableView reloadData];
+    [tableView layoutIfNeeded];
+
+    // Fling through the list four screens at a time, timing each layout pass
+    CFTimeInterval worst = 0;
+    CFTimeInterval total = 0;
+    NSUInteger frames = 0;
+    CGFloat maxOffset = tableView.contentSize.height - tableView.bounds.size.height;
+    for (CGFloat offset = 0; offset < maxOffset; offset += tableView.bounds.size.height * 4) {
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        tableView.contentOffset = CGPointMake(0, offset);
+        [tableView layoutIfNeeded];
+        CFTimeInterval elapsed = CFAbsoluteTimeGetCurrent() - start;
+        worst = MAX(worst, elapsed);
+        total += elapsed;
+        frames++;
+    }
+    NSLog(@"Scrolled %lu frames, average %.2f ms, slowest %.2f ms", (unsigned long) frames, total / frames * 1000.0, worst * 1000.0);
+    XCTAssertTrue(worst < kFLXFrameBudget, @"Slowest frame took %.2f ms", worst * 1000.0);
+}
+
+- (void)testDiffOfCoalescedChanges
+{
+    [self loadCursor];
+
+    // 250 in-place edits, 125 moves to the top, 125 removals
+    NSMutableArray *changed = [[NSMutableArray alloc] init];
+    NSMutableSet *updatedIds = [[NSMutableSet alloc] init];
+    NSMutableArray *removedIds = [[NSMutableArray alloc] init];
+    NSDate *future = [NSDate dateWithTimeIntervalSinceNow:3600];
+    for (NSUInteger i = 0; i < 500; i++) {
+        NSUInteger index = i * (kFLXBenchmarkRows / 500);
+        NSDictionary *record = [_store recordWithId:[NSString stringWithFormat:@"obj%06lu", (unsigned long) index] inClass:@"Items"];
+        if (i % 4 < 2) {
+            NSMutableDictionary *edited = [record mutableCopy];
+            edited[@"make"] = @"Motorola";
+            [changed addObject:edited];
+            [updatedIds addObject:record[@"objectId"]];
+        }
+        else if (i % 4 == 2) {
+            [changed addObject:[self recordWithIndex:index updatedAt:[future dateByAddingTimeInterval:i]]];
+            [updatedIds addObject:record[@"objectId"]];
+        }
+        else {
+            [removedIds addObject:record[@"objectId"]];
+        }
+    }
+    [_store putRecords:changed inClass:@"Items"];
+    [_store removeRecordsWithIds:removedIds inClass:@"Items"];
+
+    __block BOOL done = NO;
+    __block FLXItemCursorDiff *diff = nil;
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    [_cursor applyUpdatedIds:updatedIds removedIds:[NSSet setWithArray:removedIds] completion:^(FLXItemCursorDiff *result) {
+        diff = result;
+        done = YES;
+    }];
+    [self waitForFlag:&done];
+    NSLog(@"Diffed 500 changes over %lu rows in %.1f ms", (unsigned long) kFLXBenchmarkRows, (CFAbsoluteTimeGetCurrent() - start) * 1000.0);
+
+    XCTAssertEqual([diff.reloadedRows count], (NSUInteger) 250);
+    XCTAssertEqual([diff.deletedRows count], (NSUInteger) 250);
+    XCTAssertEqual([diff.insertedRows count], (NSUInteger) 125);
+    XCTAssertEqual([diff.insertedRows lastIndex], (NSUInteger) 124);
+    XCTAssertEqual(_cursor.count, kFLXBenchmarkRows - 125);
+    // obj000000 was edited in place and now follows the moved records
+    XCTAssertEqualObjects([_cursor cellModelAtIndex:125].title, @"Motorola MC0");
+}
+
+@end
@@ -0,0 +1,71 @@
+//
+//  FLXScanLatencyBenchmarkTests.m
+//  TracVentoryTests
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "FLXCheckInOutController.h"
+#import "FLXScanLatencyHarness.h"
+#import "IDBlueSdk.h"
+
+// One frame at 60 fps, in milliseconds
+static const double kFLXFrameBudgetMs = 1000.0 / 60.0;
+
+@interface FLXScanLatencyBenchmarkTests : XCTestCase {
+    FLXCheckInOutController* _controller;
+    FLXScanLatencyHarness* _harness;
+}
+@end
+
+@implementation FLXScanLatencyBenchmarkTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    // Loading the view opens the reader session the screen scans with; no
+    // reader needs to be paired, the harness plays its part
+    _controller = [[FLXCheckInOutController alloc] init];
+    [_controller view];
+    _harness = [[FLXScanLatencyHarness alloc] initWithSession:[_controller.idBlue readerSession]];
+}
+
+- (FLXScanLatencyReport *)runScans:(NSUInteger)count perSecond:(double)rate random:(BOOL)random
+{
+    __block FLXScanLatencyReport *result = nil;
+    XCTAssertTrue([_harness runScans:count perSecond:rate random:random completion:^(FLXScanLatencyReport *report) {
+        result = report;
+    }]);
+
+    // The harness injects and reports on the main queue, so spin the run loop
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:count / rate + 10.0];
+    while (!result && [timeout timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    XCTAssertNotNil(result, @"Timed out waiting for the harness");
+    NSLog(@"%.0f scans/s%@: %@", rate, random ? @" (random)" : @"", result);
+    return result;
+}
+
+// A user pressing the button as fast as they can
+- (void)testButtonScansReachScreenWithinAFrame
+{
+    FLXScanLatencyReport *report = [self runScans:50 perSecond:5 random:NO];
+    XCTAssertEqual(report.observed, report.scans);
+    XCTAssertTrue(report.p99 < kFLXFrameBudgetMs, @"p99 %.2f ms", report.p99);
+    XCTAssertTrue(report.droppedFrames * 20 <= report.frames, @"%lu of %lu frames dropped",
+                  (unsigned long) report.droppedFrames, (unsigned long) report.frames);
+}
+
+// Continuous scan through a tray of items
+- (void)testScanBurstsKeepUp
+{
+    FLXScanLatencyReport *report = [self runScans:500 perSecond:100 random:YES];
+    XCTAssertEqual(report.observed, report.scans);
+    XCTAssertTrue(report.p99 < 2 * kFLXFrameBudgetMs, @"p99 %.2f ms", report.p99);
+}
+
+@end
@@ -0,0 +1,120 @@
+//
+//  FLXScannerBusTests.m
+//  TracVentoryTests
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "FLXScannerBus.h"
+#import "FLXScanSources.h"
+
+@interface FLXScannerBusTests : XCTestCase {
+    FLXScannerBus* _bus;
+    FLXSimulatedScanSource* _pen;
+    FLXSimulatedScanSource* _sled;
+    NSMutableArray* _scans;
+}
+@end
+
+@implementation FLXScannerBusTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    // A bus of its own, without item lookups, fed by two simulated scanners
+    _bus = [[FLXScannerBus alloc] initWithCapacity:64 dedupWindow:2.0];
+    _pen = [[FLXSimulatedScanSource alloc] initWithSourceType:FLXScanSourceIDBlue readerID:@"pen"];
+    _sled = [[FLXSimulatedScanSource alloc] initWithSourceType:FLXScanSourceLinea readerID:@"sled"];
+    XCTAssertTrue([_bus addSource:_pen]);
+    XCTAssertTrue([_bus addSource:_sled]);
+
+    _scans = [NSMutableArray array];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(scanReceived:)
+                                                 name:FLXScanNotification
+                                               object:_bus];
+}
+
+- (void)tearDown
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    [_bus removeSource:_pen];
+    [_bus removeSource:_sled];
+    [super tearDown];
+}
+
+- (void)scanReceived:(NSNotification *)notification
+{
+    [_scans addObject:notification.userInfo[FLXScanKey]];
+}
+
+// Drain the bus and let the main queue post what it delivered
+- (void)deliver
+{
+    [_bus flush];
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+}
+
+- (void)testScansArriveInOrderWithTheirSource
+{
+    XCTAssertTrue([_pen scanTagId:@"3074257BF7194E4000001A85"]);
+    XCTAssertTrue([_sled scanBarcode:@"5901234123457" symbology:FLXSymbologyEan13]);
+    [self deliver];
+
+    XCTAssertEqual([_scans count], (NSUInteger) 2);
+    FLXScan *tag = _scans[0];
+    XCTAssertEqual(tag.source, FLXScanSourceIDBlue);
+    XCTAssertEqual(tag.symbology, FLXSymbologyEpc);
+    XCTAssertEqualObjects(tag.text, @"3074257BF7194E4000001A85");
+    XCTAssertEqualObjects(tag.readerID, @"pen");
+    XCTAssertTrue([tag isItemCode]);
+
+    FLXScan *barcode = _scans[1];
+    XCTAssertEqualObjects(barcode.text, @"5901234123457");
+    XCTAssertEqualObjects(barcode.readerID, @"sled");
+    XCTAssertFalse([barcode isItemCode]);
+}
+
+// A tag held under the pen, and read by the sled's RFID head too, is one scan
+- (void)testRepeatsFromAnySourceAreDroppedWithinTheWindow
+{
+    for (int i = 0; i < 5; i++) {
+        XCTAssertTrue([_pen scanTagId:@"E004010012345678"]);
+    }
+    XCTAssertTrue([_sled scanTagId:@"E0 04 01 00 12 34 56 78"]);
+    // The same bytes under another symbology are another code
+    XCTAssertTrue([_sled scanBarcode:@"E004010012345678" symbology:FLXSymbologyCode128]);
+    [self deliver];
+
+    XCTAssertEqual([_scans count], (NSUInteger) 2);
+    XCTAssertEqual(_bus.published, (NSUInteger) 7);
+    XCTAssertEqual(_bus.duplicates, (NSUInteger) 5);
+    XCTAssertEqual(_bus.delivered, (NSUInteger) 2);
+}
+
+- (void)testPlayedCodesAreAllDelivered
+{
+    NSMutableArray *codes = [NSMutableArray array];
+    for (int i = 0; i < 50; i++) {
+        [codes addObject:[NSString stringWithFormat:@"LOC-%04d", i]];
+    }
+    __block BOOL finished = NO;
+    [_sled playCodes:codes symbology:FLXSymbologyCode128 perSecond:500 completion:^{
+        finished = YES;
+    }];
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5.0];
+    while (!finished && [timeout timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    XCTAssertTrue(finished);
+    [self deliver];
+
+    XCTAssertEqual([_scans count], [codes count]);
+    XCTAssertEqual(_bus.dropped, (NSUInteger) 0);
+    XCTAssertEqualObjects([_scans valueForKey:@"text"], codes);
+}
+
+@end
@@ -0,0 +1,88 @@
+//
+//  FLXTimestampBenchmarkTests.m
+//  TracVentoryTests
+//
+//  Created by Wes Benwick on 10/19/26.
+//  Copyright (c) 2026 FileLogix. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <IDBLUE/IDBlueTimestamp.h>
+#import "FLXTimestamp.h"
+
+// A full getEntry drain
+static const NSUInteger kFLXBenchmarkEntries = 10000;
+
+@interface FLXTimestampBenchmarkTests : XCTestCase {
+    NSArray* _timestamps;
+}
+@end
+
+@implementation FLXTimestampBenchmarkTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    // Entries a minute apart, spanning a daylight saving transition in most zones
+    NSMutableArray *timestamps = [[NSMutableArray alloc] initWithCapacity:kFLXBenchmarkEntries];
+    NSDate *start = [NSDate dateWithTimeIntervalSince1970:1793000000];
+    for (NSUInteger i = 0; i < kFLXBenchmarkEntries; i++) {
+        [timestamps addObject:[[IDBlueTimestamp alloc] initFromNSDate:[start dateByAddingTimeInterval:i * 61.0]]];
+    }
+    _timestamps = timestamps;
+}
+
+- (void)testMatchesNSDatePath
+{
+    NSArray *dates = [FLXTimestamp datesForTimestamps:_timestamps];
+    for (NSUInteger i = 0; i < kFLXBenchmarkEntries; i++) {
+        IDBlueTimestamp *timestamp = _timestamps[i];
+        NSTimeInterval expected = [[timestamp toNSDate] timeIntervalSince1970];
+        XCTAssertEqualWithAccuracy([FLXTimestamp timeIntervalSince1970ForTimestamp:timestamp], expected, 0.5, @"entry %lu", (unsigned long) i);
+        XCTAssertEqualWithAccuracy([dates[i] timeIntervalSince1970], expected, 0.5, @"entry %lu", (unsigned long) i);
+    }
+}
+
+- (void)testRoundTripFromDate
+{
+    NSDate *date = [NSDate dateWithTimeIntervalSince1970:1792990000];
+    IDBlueTimestamp *timestamp = [FLXTimestamp timestampForDate:date];
+    XCTAssertEqualObjects([timestamp toString], [[[IDBlueTimestamp alloc] initFromNSDate:date] toString]);
+    XCTAssertEqualWithAccuracy([[FLXTimestamp dateForTimestamp:timestamp] timeIntervalSince1970], [date timeIntervalSince1970], 0.5);
+}
+
+- (void)testInvalidTimestamp
+{
+    IDBlueTimestamp *timestamp = [[IDBlueTimestamp alloc] init];
+    [timestamp setMonth:13];
+    [timestamp setDay:1];
+    XCTAssertNil([FLXTimestamp dateForTimestamp:timestamp]);
+    XCTAssertTrue(isnan([FLXTimestamp timeIntervalSince1970ForTimestamp:timestamp]));
+}
+
+- (void)testFasterThanNSDatePath
+{
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    NSTimeInterval sum = 0;
+    for (IDBlueTimestamp *timestamp in _timestamps) {
+        sum += [[timestamp toNSDate] timeIntervalSince1970];
+    }
+    CFTimeInterval calendar = CFAbsoluteTimeGetCurrent() - start;
+
+    start = CFAbsoluteTimeGetCurrent();
+    NSTimeInterval *intervals = malloc(sizeof(NSTimeInterval) * kFLXBenchmarkEntries);
+    [FLXTimestamp getTimeIntervals:intervals forTimestamps:_timestamps];
+    CFTimeInterval fast = CFAbsoluteTimeGetCurrent() - start;
+    for (NSUInteger i = 0; i < kFLXBenchmarkEntries; i++) {
+        sum -= intervals[i];
+    }
+    free(intervals);
+
+    NSLog(@"Converted %lu timestamps: toNSDate %.2f ms, FLXTimestamp %.2f ms",
+          (unsigned long) kFLXBenchmarkEntries, calendar * 1000.0, fast * 1000.0);
+    XCTAssertEqualWithAccuracy(sum, 0.0, kFLXBenchmarkEntries * 0.5);
+    XCTAssertTrue(fast * 5 < calendar, @"FLXTimestamp took %.2f ms, toNSDate %.2f ms", fast * 1000.0, calendar * 1000.0);
+}
+
+@end